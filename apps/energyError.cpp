@@ -0,0 +1,329 @@
+/*
+ * Copyright (c) 2014-2025 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+// Generates long-horizon energy error data for the symplectic integrators, the Runge-Kutta-Nystrom
+// integrators and RKF78. Each integrator propagates a Kepler orbit (unit gravitational parameter
+// and semi-major axis, eccentricity 0.5) over a large number of revolutions, sweeping the number
+// of steps per revolution (symplectic integrators) or the tolerance (Runge-Kutta-Nystrom
+// integrators and RKF78 with adaptive step size). For each run, the maximum relative energy error
+// over the horizon, the relative energy error at the end of the horizon, the position error at the
+// end of the horizon, the number of acceleration (or state derivative) evaluations and the wall
+// time are written as CSV. The energy error of the symplectic integrators remains bounded, whereas
+// the energy error of the adaptive integrators grows with the number of revolutions.
+//
+// Usage: integrate_energy_error [--output=<file>] [--revolutions=<n>]
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include "integrate/forestRuth.hpp"
+#include "integrate/rkf78.hpp"
+#include "integrate/rkn43.hpp"
+#include "integrate/rkn64.hpp"
+#include "integrate/statistics.hpp"
+#include "integrate/velocityVerlet.hpp"
+#include "integrate/yoshida.hpp"
+
+namespace integrate
+{
+namespace apps
+{
+namespace
+{
+
+//! Statistics collected by the steppers.
+typedef IntegrationStatistics<double> Statistics;
+
+//! Position or velocity of planar Kepler orbit.
+typedef std::array<double, 2> Vector;
+
+//! State of planar Kepler orbit, i.e., position and velocity.
+typedef std::array<double, 4> State;
+
+//! Period of Kepler orbit.
+const double period = 2.0 * 3.14159265358979323846;
+
+//! Eccentricity of Kepler orbit.
+const double eccentricity = 0.5;
+
+//! Result of a single run of an integrator.
+struct EnergyErrorResult
+{
+    std::string method;
+    double parameter;
+    double maximumEnergyError;
+    double finalEnergyError;
+    double finalPositionError;
+    long numberOfEvaluations;
+    double wallTime;
+};
+
+//! Compute acceleration of Kepler orbit.
+void computeAcceleration(const double, const Vector& position, Vector& acceleration)
+{
+    const double radiusSquared = position[0] * position[0] + position[1] * position[1];
+    const double factor = -1.0 / (radiusSquared * std::sqrt(radiusSquared));
+    acceleration[0] = factor * position[0];
+    acceleration[1] = factor * position[1];
+}
+
+//! Compute state derivative of Kepler orbit.
+void computeStateDerivative(const double, const State& state, State& stateDerivative)
+{
+    const double radiusSquared = state[0] * state[0] + state[1] * state[1];
+    const double factor = -1.0 / (radiusSquared * std::sqrt(radiusSquared));
+    stateDerivative[0] = state[2];
+    stateDerivative[1] = state[3];
+    stateDerivative[2] = factor * state[0];
+    stateDerivative[3] = factor * state[1];
+}
+
+//! Get initial position, i.e., periapsis.
+Vector getInitialPosition() { return Vector{{1.0 - eccentricity, 0.0}}; }
+
+//! Get initial velocity, i.e., velocity at periapsis.
+Vector getInitialVelocity()
+{
+    return Vector{{0.0, std::sqrt((1.0 + eccentricity) / (1.0 - eccentricity))}};
+}
+
+//! Compute energy of Kepler orbit.
+double computeEnergy(const double x, const double y, const double vx, const double vy)
+{
+    return 0.5 * (vx * vx + vy * vy) - 1.0 / std::sqrt(x * x + y * y);
+}
+
+//! Energy of Kepler orbit.
+const double energy = -0.5;
+
+//! Run symplectic integrator with given number of steps per revolution.
+template <template <typename, typename, typename> class Stepper>
+EnergyErrorResult runSymplectic(const std::string& method,
+                                const int numberOfStepsPerRevolution,
+                                const int numberOfRevolutions)
+{
+    EnergyErrorResult result = EnergyErrorResult();
+    result.method = method;
+    result.parameter = numberOfStepsPerRevolution;
+
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    Stepper<double, Vector, Statistics> stepper;
+    double time = 0.0;
+    Vector position = getInitialPosition();
+    Vector velocity = getInitialVelocity();
+    const double stepSize = period / numberOfStepsPerRevolution;
+    for (int revolution = 0; revolution < numberOfRevolutions; ++revolution)
+    {
+        for (int i = 0; i < numberOfStepsPerRevolution; ++i)
+        {
+            stepper.step(time, position, velocity, stepSize, &computeAcceleration);
+            const double energyError = std::fabs(
+                computeEnergy(position[0], position[1], velocity[0], velocity[1]) / energy - 1.0);
+            result.maximumEnergyError = std::max(result.maximumEnergyError, energyError);
+            result.finalEnergyError = energyError;
+        }
+    }
+    const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+    const Vector initialPosition = getInitialPosition();
+    result.finalPositionError = std::sqrt(
+        (position[0] - initialPosition[0]) * (position[0] - initialPosition[0])
+        + (position[1] - initialPosition[1]) * (position[1] - initialPosition[1]));
+    result.numberOfEvaluations = stepper.getStatistics().getNumberOfStateDerivativeEvaluations();
+    result.wallTime = std::chrono::duration<double>(end - start).count();
+    return result;
+}
+
+//! Run RKF78 with adaptive step size and given tolerance.
+/*!
+ * Runs RKF78 with adaptive step size, ending each revolution exactly at a multiple of the period,
+ * so that the energy error and the position error are evaluated at the same points as for the
+ * symplectic integrators.
+ */
+EnergyErrorResult runRKF78(const double tolerance, const int numberOfRevolutions)
+{
+    EnergyErrorResult result = EnergyErrorResult();
+    result.method = "rkf78";
+    result.parameter = tolerance;
+
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    RKF78Stepper<double, State, Statistics> stepper;
+    double time = 0.0;
+    const Vector initialPosition = getInitialPosition();
+    const Vector initialVelocity = getInitialVelocity();
+    State state = {{initialPosition[0], initialPosition[1],
+                    initialVelocity[0], initialVelocity[1]}};
+    double stepSize = 1.0e-3 * period;
+    for (int revolution = 0; revolution < numberOfRevolutions; ++revolution)
+    {
+        const double revolutionEndTime = (revolution + 1) * period;
+        while (time < revolutionEndTime)
+        {
+            // Truncate step at end of revolution, and continue with step size of truncated step.
+            double currentStepSize = std::min(stepSize, revolutionEndTime - time);
+            const bool isTruncated = currentStepSize < stepSize;
+            stepper.step(time, state, currentStepSize, &computeStateDerivative, tolerance,
+                         1.0e-12 * period, period);
+            if (!isTruncated || currentStepSize < stepSize)
+            {
+                stepSize = currentStepSize;
+            }
+
+            const double energyError
+                = std::fabs(computeEnergy(state[0], state[1], state[2], state[3]) / energy - 1.0);
+            result.maximumEnergyError = std::max(result.maximumEnergyError, energyError);
+            result.finalEnergyError = energyError;
+        }
+    }
+    const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+    result.finalPositionError = std::sqrt(
+        (state[0] - initialPosition[0]) * (state[0] - initialPosition[0])
+        + (state[1] - initialPosition[1]) * (state[1] - initialPosition[1]));
+    result.numberOfEvaluations = stepper.getStatistics().getNumberOfStateDerivativeEvaluations();
+    result.wallTime = std::chrono::duration<double>(end - start).count();
+    return result;
+}
+
+//! Run Runge-Kutta-Nystrom integrator with adaptive step size and given tolerance.
+/*!
+ * Runs Runge-Kutta-Nystrom integrator with adaptive step size, ending each revolution exactly at a
+ * multiple of the period, as for RKF78.
+ */
+template <template <typename, typename, typename> class Stepper>
+EnergyErrorResult runRungeKuttaNystrom(const std::string& method,
+                                       const double tolerance,
+                                       const int numberOfRevolutions)
+{
+    EnergyErrorResult result = EnergyErrorResult();
+    result.method = method;
+    result.parameter = tolerance;
+
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    Stepper<double, Vector, Statistics> stepper;
+    double time = 0.0;
+    Vector position = getInitialPosition();
+    Vector velocity = getInitialVelocity();
+    double stepSize = 1.0e-3 * period;
+    for (int revolution = 0; revolution < numberOfRevolutions; ++revolution)
+    {
+        const double revolutionEndTime = (revolution + 1) * period;
+        while (time < revolutionEndTime)
+        {
+            // Truncate step at end of revolution, and continue with step size of truncated step.
+            double currentStepSize = std::min(stepSize, revolutionEndTime - time);
+            const bool isTruncated = currentStepSize < stepSize;
+            stepper.step(time, position, velocity, currentStepSize, &computeAcceleration,
+                         tolerance, 1.0e-12 * period, period);
+            if (!isTruncated || currentStepSize < stepSize)
+            {
+                stepSize = currentStepSize;
+            }
+
+            const double energyError = std::fabs(
+                computeEnergy(position[0], position[1], velocity[0], velocity[1]) / energy - 1.0);
+            result.maximumEnergyError = std::max(result.maximumEnergyError, energyError);
+            result.finalEnergyError = energyError;
+        }
+    }
+    const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+    const Vector initialPosition = getInitialPosition();
+    result.finalPositionError = std::sqrt(
+        (position[0] - initialPosition[0]) * (position[0] - initialPosition[0])
+        + (position[1] - initialPosition[1]) * (position[1] - initialPosition[1]));
+    result.numberOfEvaluations = stepper.getStatistics().getNumberOfStateDerivativeEvaluations();
+    result.wallTime = std::chrono::duration<double>(end - start).count();
+    return result;
+}
+
+//! Write result as CSV row.
+void writeResult(std::FILE* file, const EnergyErrorResult& result)
+{
+    std::fprintf(file, "%s,%.17g,%.17g,%.17g,%.17g,%ld,%.9g\n",
+                 result.method.c_str(),
+                 result.parameter,
+                 result.maximumEnergyError,
+                 result.finalEnergyError,
+                 result.finalPositionError,
+                 result.numberOfEvaluations,
+                 result.wallTime);
+}
+
+//! Get value of command-line option of the form --name=value (empty if not given).
+std::string getOption(const int numberOfArguments,
+                      const char* arguments[],
+                      const std::string& name)
+{
+    const std::string prefix = "--" + name + "=";
+    for (int i = 1; i < numberOfArguments; ++i)
+    {
+        const std::string argument = arguments[i];
+        if (argument.compare(0, prefix.size(), prefix) == 0)
+        {
+            return argument.substr(prefix.size());
+        }
+    }
+    return "";
+}
+
+} // namespace
+} // namespace apps
+} // namespace integrate
+
+//! Generate long-horizon energy error data and write it as CSV.
+int main(const int numberOfArguments, const char* arguments[])
+{
+    using namespace integrate;
+    using namespace integrate::apps;
+
+    const std::string outputFilePath = getOption(numberOfArguments, arguments, "output");
+    const std::string revolutionsOption = getOption(numberOfArguments, arguments, "revolutions");
+    const int numberOfRevolutions
+        = revolutionsOption.empty() ? 1000 : std::max(1, std::atoi(revolutionsOption.c_str()));
+
+    std::FILE* file = outputFilePath.empty() ? stdout : std::fopen(outputFilePath.c_str(), "w");
+    if (file == nullptr)
+    {
+        std::fprintf(stderr, "Could not open output file: %s\n", outputFilePath.c_str());
+        return 1;
+    }
+
+    std::fprintf(file, "method,parameter,maximum_energy_error,final_energy_error,"
+                       "final_position_error,evaluations,wall_time\n");
+    for (int numberOfSteps = 32; numberOfSteps <= 1024; numberOfSteps *= 2)
+    {
+        writeResult(file, runSymplectic<VelocityVerletStepper>("velocityVerlet", numberOfSteps,
+                                                               numberOfRevolutions));
+        writeResult(file, runSymplectic<ForestRuthStepper>("forestRuth", numberOfSteps,
+                                                           numberOfRevolutions));
+        writeResult(file, runSymplectic<Yoshida4Stepper>("yoshida4", numberOfSteps,
+                                                         numberOfRevolutions));
+        writeResult(file, runSymplectic<Yoshida6Stepper>("yoshida6", numberOfSteps,
+                                                         numberOfRevolutions));
+        writeResult(file, runSymplectic<Yoshida8Stepper>("yoshida8", numberOfSteps,
+                                                         numberOfRevolutions));
+    }
+    for (int i = 4; i <= 14; ++i)
+    {
+        writeResult(file, runRungeKuttaNystrom<RKN43Stepper>("rkn43", std::pow(10.0, -i),
+                                                             numberOfRevolutions));
+        writeResult(file, runRungeKuttaNystrom<RKN64Stepper>("rkn64", std::pow(10.0, -i),
+                                                             numberOfRevolutions));
+        writeResult(file, runRKF78(std::pow(10.0, -i), numberOfRevolutions));
+    }
+
+    if (file != stdout)
+    {
+        std::fclose(file);
+    }
+    return 0;
+}
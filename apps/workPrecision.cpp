@@ -0,0 +1,468 @@
+/*
+ * Copyright (c) 2014-2025 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+// Generates work-precision data for all integrators. Each integrator is run on a set of reference
+// problems with known solutions, sweeping the step size (fixed step size) or the tolerance
+// (adaptive step size). For each run, the error at the final time is recorded against the number
+// of state derivative evaluations and the wall time. The results are written as CSV, with columns
+// that mark the efficiency frontier of each method and of all methods combined, i.e., the runs
+// for which no other run of the method (or of any method) reaches a smaller error with fewer
+// state derivative evaluations.
+//
+// Usage: integrate_work_precision [--output=<file>] [--repetitions=<n>] [--problem=<name>]
+//
+// The reference problems are:
+//
+//  - burdenFaires: y' = y - t^2 + 1, y(0) = 0.5, t in [0, 2] (analytical solution);
+//  - kepler: Kepler orbit with eccentricity 0.6 over one period (returns to initial state);
+//  - arenstorf: Arenstorf orbit of the restricted three-body problem over one period (returns
+//    to initial state; see Hairer et al., 1993, Section II.0).
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "integrate/adamsBashforthMoulton.hpp"
+#include "integrate/bulirschStoer.hpp"
+#include "integrate/dopri5.hpp"
+#include "integrate/euler.hpp"
+#include "integrate/integrateAdaptive.hpp"
+#include "integrate/rk4.hpp"
+#include "integrate/rkf45.hpp"
+#include "integrate/rkf78.hpp"
+#include "integrate/statistics.hpp"
+#include "integrate/stepSizeControl.hpp"
+
+namespace integrate
+{
+namespace apps
+{
+namespace
+{
+
+//! Statistics collected by the steppers.
+typedef IntegrationStatistics<double> Statistics;
+
+//! Result of a single run of an integrator on a reference problem.
+struct WorkPrecisionResult
+{
+    std::string problem;
+    std::string method;
+    std::string mode;
+    double parameter;
+    double error;
+    long numberOfEvaluations;
+    long numberOfAcceptedSteps;
+    long numberOfRejectedSteps;
+    double wallTime;
+    bool isMethodFrontier;
+    bool isFrontier;
+};
+
+//! Burden & Faires problem, i.e., y' = y - t^2 + 1.
+struct BurdenFairesProblem
+{
+    typedef std::array<double, 1> State;
+
+    static const char* getName() { return "burdenFaires"; }
+    static double getFinalTime() { return 2.0; }
+    static State getInitialState() { return State{{0.5}}; }
+
+    static State getFinalState()
+    {
+        const double finalTime = getFinalTime();
+        return State{{(finalTime + 1.0) * (finalTime + 1.0) - 0.5 * std::exp(finalTime)}};
+    }
+
+    void operator()(const double time, const State& state, State& stateDerivative) const
+    {
+        stateDerivative[0] = state[0] - time * time + 1.0;
+    }
+};
+
+//! Planar Kepler orbit with unit gravitational parameter and semi-major axis, starting at
+//! periapsis.
+struct KeplerProblem
+{
+    typedef std::array<double, 4> State;
+
+    static const char* getName() { return "kepler"; }
+    static double getFinalTime() { return 2.0 * 3.14159265358979323846; }
+
+    static State getInitialState()
+    {
+        const double eccentricity = 0.6;
+        return State{{1.0 - eccentricity, 0.0,
+                      0.0, std::sqrt((1.0 + eccentricity) / (1.0 - eccentricity))}};
+    }
+
+    static State getFinalState() { return getInitialState(); }
+
+    void operator()(const double, const State& state, State& stateDerivative) const
+    {
+        const double radiusSquared = state[0] * state[0] + state[1] * state[1];
+        const double factor = -1.0 / (radiusSquared * std::sqrt(radiusSquared));
+        stateDerivative[0] = state[2];
+        stateDerivative[1] = state[3];
+        stateDerivative[2] = factor * state[0];
+        stateDerivative[3] = factor * state[1];
+    }
+};
+
+//! Arenstorf orbit of the restricted three-body problem (Earth-Moon mass ratio).
+struct ArenstorfProblem
+{
+    typedef std::array<double, 4> State;
+
+    static const char* getName() { return "arenstorf"; }
+    static double getFinalTime() { return 17.0652165601579625588917206249; }
+
+    static State getInitialState()
+    {
+        return State{{0.994, 0.0, 0.0, -2.00158510637908252240537862224}};
+    }
+
+    static State getFinalState() { return getInitialState(); }
+
+    void operator()(const double, const State& state, State& stateDerivative) const
+    {
+        const double massRatio = 0.012277471;
+        const double complementaryMassRatio = 1.0 - massRatio;
+        const double x = state[0];
+        const double y = state[1];
+        const double firstDistance = std::sqrt((x + massRatio) * (x + massRatio) + y * y);
+        const double secondDistance
+            = std::sqrt((x - complementaryMassRatio) * (x - complementaryMassRatio) + y * y);
+        const double firstFactor
+            = complementaryMassRatio / (firstDistance * firstDistance * firstDistance);
+        const double secondFactor = massRatio / (secondDistance * secondDistance * secondDistance);
+
+        stateDerivative[0] = state[2];
+        stateDerivative[1] = state[3];
+        stateDerivative[2] = x + 2.0 * state[3] - firstFactor * (x + massRatio)
+                             - secondFactor * (x - complementaryMassRatio);
+        stateDerivative[3] = y - 2.0 * state[2] - firstFactor * y - secondFactor * y;
+    }
+};
+
+//! Compute maximum absolute error of state.
+template <typename State>
+double computeError(const State& state, const State& expectedState)
+{
+    double error = 0.0;
+    for (std::size_t i = 0; i < state.size(); ++i)
+    {
+        error = std::max(error, std::fabs(state[i] - expectedState[i]));
+    }
+    return error;
+}
+
+//! Integrate problem with fixed step size and given number of steps, and return final state.
+template <typename Problem, typename Stepper>
+typename Problem::State integrateFixedStepSize(Stepper& stepper, const double numberOfSteps)
+{
+    double time = 0.0;
+    typename Problem::State state = Problem::getInitialState();
+    const double stepSize = Problem::getFinalTime() / numberOfSteps;
+    for (long i = 0; i < static_cast<long>(numberOfSteps); ++i)
+    {
+        stepper.step(time, state, stepSize, Problem());
+    }
+    return state;
+}
+
+//! Integrate problem with adaptive step size and given tolerance, and return final state.
+/*!
+ * Integrates problem with adaptive step size. The mode "scalar" uses the scalar tolerance of the
+ * steppers; the mode "pi" uses a weighted root-mean-square error norm with the tolerance as
+ * absolute and relative tolerance, and the PI step size controller.
+ */
+template <typename Problem, typename Stepper>
+typename Problem::State integrateAdaptiveStepSize(Stepper& stepper,
+                                                  const std::string& mode,
+                                                  const double tolerance)
+{
+    const double finalTime = Problem::getFinalTime();
+    const double minimumStepSize = 1.0e-12 * finalTime;
+    const double maximumStepSize = finalTime;
+
+    double time = 0.0;
+    typename Problem::State state = Problem::getInitialState();
+    double stepSize = 1.0e-3 * finalTime;
+    if (mode == "pi")
+    {
+        const WeightedRootMeanSquareErrorNorm<double, typename Problem::State> errorNorm(
+            tolerance, tolerance);
+        StepSizeController<double> controller;
+        integrateAdaptive(stepper, time, state, stepSize, finalTime, Problem(), errorNorm,
+                          controller, minimumStepSize, maximumStepSize);
+    }
+    else
+    {
+        integrateAdaptive(stepper, time, state, stepSize, finalTime, Problem(), tolerance,
+                          minimumStepSize, maximumStepSize);
+    }
+    return state;
+}
+
+//! Integrate problem with fixed step size and given number of steps.
+template <typename Problem, typename Stepper>
+typename Problem::State integrateProblem(Stepper& stepper,
+                                         const std::string&,
+                                         const double numberOfSteps,
+                                         std::false_type)
+{
+    return integrateFixedStepSize<Problem>(stepper, numberOfSteps);
+}
+
+//! Integrate problem with adaptive step size, given mode and tolerance.
+template <typename Problem, typename Stepper>
+typename Problem::State integrateProblem(Stepper& stepper,
+                                         const std::string& mode,
+                                         const double tolerance,
+                                         std::true_type)
+{
+    return integrateAdaptiveStepSize<Problem>(stepper, mode, tolerance);
+}
+
+//! Run integrator on problem with given mode and parameter (number of steps or tolerance).
+/*!
+ * Runs integrator on problem once with statistics to obtain the error and the number of state
+ * derivative evaluations and steps. The wall time is the minimum over the given number of
+ * repetitions of runs without statistics, so that it does not include the overhead of the clock.
+ */
+template <typename Problem,
+          template <typename, typename, typename> class Stepper,
+          bool IsAdaptive>
+WorkPrecisionResult runIntegrator(const std::string& method,
+                                  const std::string& mode,
+                                  const double parameter,
+                                  const int numberOfRepetitions)
+{
+    typedef typename Problem::State State;
+    typedef std::integral_constant<bool, IsAdaptive> IsAdaptiveType;
+
+    WorkPrecisionResult result = WorkPrecisionResult();
+    result.problem = Problem::getName();
+    result.method = method;
+    result.mode = mode;
+    result.parameter = parameter;
+
+    Stepper<double, State, Statistics> stepper;
+    const State state = integrateProblem<Problem>(stepper, mode, parameter,
+                                                  IsAdaptiveType());
+    const Statistics& statistics = stepper.getStatistics();
+    result.error = computeError(state, Problem::getFinalState());
+    result.numberOfEvaluations = statistics.getNumberOfStateDerivativeEvaluations();
+    result.numberOfAcceptedSteps = statistics.getNumberOfAcceptedSteps();
+    result.numberOfRejectedSteps = statistics.getNumberOfRejectedSteps();
+
+    result.wallTime = std::numeric_limits<double>::infinity();
+    for (int repetition = 0; repetition < numberOfRepetitions; ++repetition)
+    {
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        Stepper<double, State, NullStatistics> timedStepper;
+        const State timedState = integrateProblem<Problem>(timedStepper, mode, parameter,
+                                                            IsAdaptiveType());
+        const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+        result.wallTime = std::min(result.wallTime,
+                                   std::chrono::duration<double>(end - start).count());
+
+        // Use final state, so that the timed integration is not optimized away.
+        volatile double finalStateElement = timedState[0];
+        static_cast<void>(finalStateElement);
+    }
+
+    return result;
+}
+
+//! Run integrator on problem and add result, reporting integrations that fail.
+template <typename Problem,
+          template <typename, typename, typename> class Stepper,
+          bool IsAdaptive>
+void addResult(const std::string& method,
+               const std::string& mode,
+               const double parameter,
+               const int numberOfRepetitions,
+               std::vector<WorkPrecisionResult>& results)
+{
+    try
+    {
+        results.push_back(runIntegrator<Problem, Stepper, IsAdaptive>(method, mode, parameter,
+                                                                      numberOfRepetitions));
+    }
+    catch (const std::runtime_error& error)
+    {
+        std::fprintf(stderr, "%s: %s (%s, %g): %s\n",
+                     Problem::getName(), method.c_str(), mode.c_str(), parameter, error.what());
+    }
+}
+
+//! Run all integrators on problem.
+template <typename Problem>
+void runProblem(const int numberOfRepetitions, std::vector<WorkPrecisionResult>& results)
+{
+    // Sweep number of steps for fixed step size (Euler converges slowly, so it gets more steps).
+    for (long numberOfSteps = 16; numberOfSteps <= (1L << 20); numberOfSteps *= 2)
+    {
+        addResult<Problem, EulerStepper, false>("euler", "fixed", numberOfSteps,
+                                                numberOfRepetitions, results);
+        if (numberOfSteps > (1L << 16))
+        {
+            continue;
+        }
+
+        addResult<Problem, RK4Stepper, false>("rk4", "fixed", numberOfSteps,
+                                              numberOfRepetitions, results);
+        addResult<Problem, RKF45Stepper, false>("rkf45", "fixed", numberOfSteps,
+                                                numberOfRepetitions, results);
+        addResult<Problem, RKF78Stepper, false>("rkf78", "fixed", numberOfSteps,
+                                                numberOfRepetitions, results);
+        addResult<Problem, DOPRI5Stepper, false>("dopri5", "fixed", numberOfSteps,
+                                                 numberOfRepetitions, results);
+    }
+
+    // Sweep tolerance for adaptive step size, from 1e-3 to 1e-12 in steps of half a decade.
+    const char* const modes[] = {"scalar", "pi"};
+    for (int i = 6; i <= 24; ++i)
+    {
+        const double tolerance = std::pow(10.0, -0.5 * i);
+        for (const char* const mode : modes)
+        {
+            addResult<Problem, RKF45Stepper, true>("rkf45", mode, tolerance,
+                                                   numberOfRepetitions, results);
+            addResult<Problem, RKF78Stepper, true>("rkf78", mode, tolerance,
+                                                   numberOfRepetitions, results);
+            addResult<Problem, DOPRI5Stepper, true>("dopri5", mode, tolerance,
+                                                    numberOfRepetitions, results);
+            addResult<Problem, AdamsBashforthMoultonStepper, true>("abm", mode, tolerance,
+                                                                   numberOfRepetitions, results);
+            addResult<Problem, BulirschStoerStepper, true>("bs", mode, tolerance,
+                                                           numberOfRepetitions, results);
+        }
+    }
+}
+
+//! Check if result is dominated by other result, i.e., other result is at least as accurate with
+//! at most as many evaluations, and is strictly better in one of both.
+bool isDominated(const WorkPrecisionResult& result, const WorkPrecisionResult& otherResult)
+{
+    return otherResult.error <= result.error
+           && otherResult.numberOfEvaluations <= result.numberOfEvaluations
+           && (otherResult.error < result.error
+               || otherResult.numberOfEvaluations < result.numberOfEvaluations);
+}
+
+//! Mark results on efficiency frontier of their method (and mode) and of all methods.
+void markFrontiers(std::vector<WorkPrecisionResult>& results)
+{
+    for (WorkPrecisionResult& result : results)
+    {
+        result.isMethodFrontier = std::isfinite(result.error);
+        result.isFrontier = std::isfinite(result.error);
+        for (const WorkPrecisionResult& otherResult : results)
+        {
+            if (otherResult.problem != result.problem || !isDominated(result, otherResult))
+            {
+                continue;
+            }
+
+            result.isFrontier = false;
+            if (otherResult.method == result.method && otherResult.mode == result.mode)
+            {
+                result.isMethodFrontier = false;
+            }
+        }
+    }
+}
+
+//! Get value of command-line option of the form --name=value (empty if not given).
+std::string getOption(const int numberOfArguments,
+                      const char* arguments[],
+                      const std::string& name)
+{
+    const std::string prefix = "--" + name + "=";
+    for (int i = 1; i < numberOfArguments; ++i)
+    {
+        const std::string argument = arguments[i];
+        if (argument.compare(0, prefix.size(), prefix) == 0)
+        {
+            return argument.substr(prefix.size());
+        }
+    }
+    return "";
+}
+
+} // namespace
+} // namespace apps
+} // namespace integrate
+
+//! Generate work-precision data for all integrators and write it as CSV.
+int main(const int numberOfArguments, const char* arguments[])
+{
+    using namespace integrate::apps;
+
+    const std::string outputFilePath = getOption(numberOfArguments, arguments, "output");
+    const std::string repetitionsOption = getOption(numberOfArguments, arguments, "repetitions");
+    const std::string problem = getOption(numberOfArguments, arguments, "problem");
+    const int numberOfRepetitions
+        = repetitionsOption.empty() ? 3 : std::max(1, std::atoi(repetitionsOption.c_str()));
+
+    std::vector<WorkPrecisionResult> results;
+    if (problem.empty() || problem == BurdenFairesProblem::getName())
+    {
+        runProblem<BurdenFairesProblem>(numberOfRepetitions, results);
+    }
+    if (problem.empty() || problem == KeplerProblem::getName())
+    {
+        runProblem<KeplerProblem>(numberOfRepetitions, results);
+    }
+    if (problem.empty() || problem == ArenstorfProblem::getName())
+    {
+        runProblem<ArenstorfProblem>(numberOfRepetitions, results);
+    }
+    markFrontiers(results);
+
+    std::FILE* file = outputFilePath.empty() ? stdout : std::fopen(outputFilePath.c_str(), "w");
+    if (file == nullptr)
+    {
+        std::fprintf(stderr, "Could not open output file: %s\n", outputFilePath.c_str());
+        return 1;
+    }
+
+    std::fprintf(file, "problem,method,mode,parameter,error,evaluations,accepted_steps,"
+                       "rejected_steps,wall_time,is_method_frontier,is_frontier\n");
+    for (const WorkPrecisionResult& result : results)
+    {
+        std::fprintf(file, "%s,%s,%s,%.17g,%.17g,%ld,%ld,%ld,%.9g,%d,%d\n",
+                     result.problem.c_str(),
+                     result.method.c_str(),
+                     result.mode.c_str(),
+                     result.parameter,
+                     result.error,
+                     result.numberOfEvaluations,
+                     result.numberOfAcceptedSteps,
+                     result.numberOfRejectedSteps,
+                     result.wallTime,
+                     result.isMethodFrontier ? 1 : 0,
+                     result.isFrontier ? 1 : 0);
+    }
+
+    if (file != stdout)
+    {
+        std::fclose(file);
+    }
+    return 0;
+}
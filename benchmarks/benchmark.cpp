@@ -0,0 +1,276 @@
+/*
+ * Copyright (c) 2014-2025 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "benchmark.hpp"
+
+namespace integrate
+{
+namespace benchmarks
+{
+
+std::vector<Benchmark>& getBenchmarks()
+{
+    static std::vector<Benchmark> benchmarks;
+    return benchmarks;
+}
+
+bool registerBenchmark(const std::string& name, const BenchmarkFunction& function)
+{
+    getBenchmarks().push_back(Benchmark{name, function});
+    return true;
+}
+
+//! Time given number of iterations of benchmark [s].
+static double timeBenchmark(const Benchmark& benchmark, const long numberOfIterations)
+{
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    benchmark.function(numberOfIterations);
+    const std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(end - start).count();
+}
+
+BenchmarkResult runBenchmark(const Benchmark& benchmark,
+                             const double minimumTime,
+                             const int numberOfRepetitions)
+{
+    // Execute a single untimed iteration, so that fixtures that benchmarks set up on first use,
+    // e.g., files, are not included in the calibration.
+    benchmark.function(1);
+
+    // Calibrate number of iterations, such that a single repetition takes at least the minimum
+    // time. This also serves as warm-up for caches and the branch predictor.
+    long numberOfIterations = 1;
+    double time = timeBenchmark(benchmark, numberOfIterations);
+    while (time < minimumTime)
+    {
+        const double growthFactor = time > 0.0 ? std::min(10.0, 1.2 * minimumTime / time) : 10.0;
+        numberOfIterations = static_cast<long>(numberOfIterations * growthFactor) + 1;
+        time = timeBenchmark(benchmark, numberOfIterations);
+    }
+
+    std::vector<double> nanosecondsPerIteration;
+    for (int i = 0; i < numberOfRepetitions; ++i)
+    {
+        nanosecondsPerIteration.push_back(
+            1.0e9 * timeBenchmark(benchmark, numberOfIterations) / numberOfIterations);
+    }
+    std::sort(nanosecondsPerIteration.begin(), nanosecondsPerIteration.end());
+
+    BenchmarkResult result;
+    result.name = benchmark.name;
+    result.numberOfIterations = numberOfIterations;
+    result.nanosecondsPerIteration = nanosecondsPerIteration[nanosecondsPerIteration.size() / 2];
+    result.minimumNanosecondsPerIteration = nanosecondsPerIteration.front();
+    return result;
+}
+
+//! Get value of command-line option of the form --name=value (empty if not given).
+static std::string getOption(const int numberOfArguments,
+                             const char* arguments[],
+                             const std::string& name)
+{
+    const std::string prefix = "--" + name + "=";
+    for (int i = 1; i < numberOfArguments; ++i)
+    {
+        const std::string argument = arguments[i];
+        if (argument.compare(0, prefix.size(), prefix) == 0)
+        {
+            return argument.substr(prefix.size());
+        }
+    }
+    return "";
+}
+
+//! Escape string for use in JSON document.
+static std::string escapeJson(const std::string& string)
+{
+    std::string escapedString;
+    for (const char character : string)
+    {
+        if (character == '"' || character == '\\')
+        {
+            escapedString += '\\';
+            escapedString += character;
+        }
+        else if (static_cast<unsigned char>(character) < 0x20)
+        {
+            char buffer[8];
+            std::snprintf(buffer, sizeof(buffer), "\\u%04x", character);
+            escapedString += buffer;
+        }
+        else
+        {
+            escapedString += character;
+        }
+    }
+    return escapedString;
+}
+
+//! Write benchmark results and the context in which they were obtained to JSON file.
+/*!
+ * Writes benchmark results to JSON file, in a layout that is similar to that of Google Benchmark,
+ * so that results of different library versions can be compared with existing tools. Times are
+ * given in nanoseconds per iteration.
+ */
+static bool writeJson(const std::string& filePath,
+                      const std::vector<BenchmarkResult>& results,
+                      const double minimumTime,
+                      const int numberOfRepetitions)
+{
+    std::FILE* file = filePath == "-" ? stdout : std::fopen(filePath.c_str(), "w");
+    if (file == nullptr)
+    {
+        return false;
+    }
+
+    char date[32] = "";
+    const std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+#if defined(__clang__)
+    const std::string compiler = "clang " __clang_version__;
+#elif defined(__GNUC__)
+    const std::string compiler = "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+    const std::string compiler = "msvc " + std::to_string(_MSC_VER);
+#else
+    const std::string compiler = "unknown";
+#endif
+
+#if defined(NDEBUG)
+    const char* const buildType = "release";
+#else
+    const char* const buildType = "debug";
+#endif
+
+#if defined(INTEGRATE_VERSION)
+    const char* const libraryVersion = INTEGRATE_VERSION;
+#else
+    const char* const libraryVersion = "unknown";
+#endif
+
+    std::fprintf(file, "{\n");
+    std::fprintf(file, "  \"context\": {\n");
+    std::fprintf(file, "    \"date\": \"%s\",\n", date);
+    std::fprintf(file, "    \"library_version\": \"%s\",\n", escapeJson(libraryVersion).c_str());
+    std::fprintf(file, "    \"compiler\": \"%s\",\n", escapeJson(compiler).c_str());
+    std::fprintf(file, "    \"library_build_type\": \"%s\",\n", buildType);
+    std::fprintf(file, "    \"num_cpus\": %u,\n", std::thread::hardware_concurrency());
+    std::fprintf(file, "    \"minimum_time\": %.17g,\n", minimumTime);
+    std::fprintf(file, "    \"repetitions\": %d\n", numberOfRepetitions);
+    std::fprintf(file, "  },\n");
+    std::fprintf(file, "  \"benchmarks\": [");
+    for (std::size_t i = 0; i < results.size(); ++i)
+    {
+        std::fprintf(file, "%s\n    {\n", i > 0 ? "," : "");
+        std::fprintf(file, "      \"name\": \"%s\",\n", escapeJson(results[i].name).c_str());
+        std::fprintf(file, "      \"iterations\": %ld,\n", results[i].numberOfIterations);
+        std::fprintf(file, "      \"real_time\": %.17g,\n", results[i].nanosecondsPerIteration);
+        std::fprintf(file, "      \"min_time\": %.17g,\n",
+                     results[i].minimumNanosecondsPerIteration);
+        std::fprintf(file, "      \"time_unit\": \"ns\"\n");
+        std::fprintf(file, "    }");
+    }
+    std::fprintf(file, "\n  ]\n}\n");
+
+    return file == stdout ? std::fflush(file) == 0 : std::fclose(file) == 0;
+}
+
+} // namespace benchmarks
+} // namespace integrate
+
+//! Run all registered benchmarks whose name contains the (optional) filter argument.
+/*!
+ * Runs all registered benchmarks whose name contains the filter argument, i.e., the first
+ * argument that is not an option, and prints the results in a table. The following options are
+ * supported:
+ *
+ *  - --json=<file>: also write results to given JSON file ("-" for standard output, in which case
+ *    the table is not printed)
+ *  - --minimum-time=<s>: minimum wall time per repetition (default: 0.1 s)
+ *  - --repetitions=<n>: number of timed repetitions (default: 5)
+ *  - --list: only list names of benchmarks that match filter
+ */
+int main(const int numberOfArguments, const char* arguments[])
+{
+    using namespace integrate::benchmarks;
+
+    std::string filter = "";
+    bool isListOnly = false;
+    for (int i = 1; i < numberOfArguments; ++i)
+    {
+        const std::string argument = arguments[i];
+        if (argument == "--list")
+        {
+            isListOnly = true;
+        }
+        else if (argument.compare(0, 2, "--") != 0)
+        {
+            filter = argument;
+        }
+    }
+
+    const std::string jsonFilePath = getOption(numberOfArguments, arguments, "json");
+    const std::string minimumTimeOption = getOption(numberOfArguments, arguments, "minimum-time");
+    const std::string repetitionsOption = getOption(numberOfArguments, arguments, "repetitions");
+    const double minimumTime
+        = minimumTimeOption.empty() ? 0.1 : std::atof(minimumTimeOption.c_str());
+    const int numberOfRepetitions
+        = repetitionsOption.empty() ? 5 : std::max(1, std::atoi(repetitionsOption.c_str()));
+    const bool isTablePrinted = jsonFilePath != "-";
+
+    if (isTablePrinted && !isListOnly)
+    {
+        std::printf("%-60s %14s %14s %12s\n",
+                    "Benchmark", "Median [ns]", "Min [ns]", "Iterations");
+    }
+
+    std::vector<BenchmarkResult> results;
+    for (const Benchmark& benchmark : getBenchmarks())
+    {
+        if (benchmark.name.find(filter) == std::string::npos)
+        {
+            continue;
+        }
+
+        if (isListOnly)
+        {
+            std::printf("%s\n", benchmark.name.c_str());
+            continue;
+        }
+
+        const BenchmarkResult result = runBenchmark(benchmark, minimumTime, numberOfRepetitions);
+        results.push_back(result);
+        if (isTablePrinted)
+        {
+            std::printf("%-60s %14.2f %14.2f %12ld\n",
+                        result.name.c_str(),
+                        result.nanosecondsPerIteration,
+                        result.minimumNanosecondsPerIteration,
+                        result.numberOfIterations);
+            std::fflush(stdout);
+        }
+    }
+
+    if (!jsonFilePath.empty() && !isListOnly
+        && !writeJson(jsonFilePath, results, minimumTime, numberOfRepetitions))
+    {
+        std::fprintf(stderr, "Could not write JSON file: %s\n", jsonFilePath.c_str());
+        return 1;
+    }
+
+    return 0;
+}
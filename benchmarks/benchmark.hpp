@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2014-2025 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace integrate
+{
+namespace benchmarks
+{
+
+//! Function that executes given number of iterations of a benchmark.
+typedef std::function<void(const long numberOfIterations)> BenchmarkFunction;
+
+//! Benchmark description.
+struct Benchmark
+{
+    //! Unique name of benchmark.
+    std::string name;
+
+    //! Function that executes benchmark.
+    BenchmarkFunction function;
+};
+
+//! Result of running a single benchmark.
+struct BenchmarkResult
+{
+    //! Name of benchmark.
+    std::string name;
+
+    //! Number of iterations executed per repetition.
+    long numberOfIterations;
+
+    //! Median wall time per iteration over all repetitions [ns].
+    double nanosecondsPerIteration;
+
+    //! Minimum wall time per iteration over all repetitions [ns].
+    double minimumNanosecondsPerIteration;
+};
+
+//! Get list of all registered benchmarks.
+std::vector<Benchmark>& getBenchmarks();
+
+//! Register benchmark.
+/*!
+ * Registers benchmark so that it is executed by the benchmark runner. Use the
+ * INTEGRATE_BENCHMARK macro to register a benchmark at static-initialization time.
+ *
+ * @param[in]  name      Unique name of benchmark
+ * @param[in]  function  Function that executes given number of iterations of benchmark
+ * @return               Dummy value, to enable registration at static-initialization time
+ */
+bool registerBenchmark(const std::string& name, const BenchmarkFunction& function);
+
+//! Run benchmark.
+/*!
+ * Runs benchmark by first executing a single untimed iteration, then calibrating the number of
+ * iterations such that a single repetition takes at least the given minimum time, and then timing
+ * the given number of repetitions.
+ *
+ * @param[in]  benchmark              Benchmark to run
+ * @param[in]  minimumTime            Minimum wall time per repetition [s]
+ * @param[in]  numberOfRepetitions    Number of timed repetitions
+ * @return                            Benchmark result
+ */
+BenchmarkResult runBenchmark(const Benchmark& benchmark,
+                             const double minimumTime,
+                             const int numberOfRepetitions);
+
+//! Prevent compiler from optimizing away computation of given value.
+template <typename Value>
+inline void doNotOptimize(const Value& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const void* sink;
+    sink = &value;
+#endif
+}
+
+} // namespace benchmarks
+} // namespace integrate
+
+//! Register benchmark with given name and function executing given number of iterations.
+#define INTEGRATE_BENCHMARK_CONCATENATE_IMPLEMENTATION(left, right) left##right
+#define INTEGRATE_BENCHMARK_CONCATENATE(left, right) \
+    INTEGRATE_BENCHMARK_CONCATENATE_IMPLEMENTATION(left, right)
+#define INTEGRATE_BENCHMARK(name, function)                                                      \
+    static const bool INTEGRATE_BENCHMARK_CONCATENATE(benchmarkRegistration, __LINE__)           \
+        = ::integrate::benchmarks::registerBenchmark(name, function)
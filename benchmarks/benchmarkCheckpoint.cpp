@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2014-2025 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+// Benchmarks checkpoints of an integration with the Adams-Bashforth-Moulton stepper, whose
+// history of up to 13 state derivatives dominates the checkpoint, for three uncoupled harmonic
+// oscillators (6 state elements). The stepper is first integrated to t = 10 on first use, so that
+// its history is full. One iteration either
+//
+//  - step: executes a single integration step, as reference for the cost of a checkpoint;
+//  - snapshot: takes a checkpoint in memory, which reuses the storage of the previous one;
+//  - save: takes a checkpoint and writes it to a file, which replaces the previous file.
+
+#include <cstdio>
+#include <vector>
+
+#include "integrate/adamsBashforthMoulton.hpp"
+#include "integrate/checkpoint.hpp"
+#include "integrate/integrateAdaptive.hpp"
+
+#include "benchmark.hpp"
+
+namespace integrate
+{
+namespace benchmarks
+{
+namespace
+{
+
+typedef std::vector<double> Vector;
+typedef AdamsBashforthMoultonStepper<double, Vector> Stepper;
+
+//! Name of checkpoint file written by benchmark.
+const char* const checkpointFileName = "benchmarkCheckpoint.bin";
+
+//! Three uncoupled harmonic oscillators with different angular frequencies.
+struct Oscillators
+{
+    void operator()(const double, const Vector& state, Vector& stateDerivative) const
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            const double frequency = 1.0 + 0.5 * i;
+            stateDerivative[2 * i] = state[2 * i + 1];
+            stateDerivative[2 * i + 1] = -frequency * frequency * state[2 * i];
+        }
+    }
+};
+
+//! Integration with full history.
+struct Integration
+{
+    Integration()
+        : time(0.0),
+          state({1.0, 0.0, 0.0, 1.0, 0.5, 0.5}),
+          stepSize(0.01)
+    {
+        integrateAdaptive(stepper, time, state, stepSize, 10.0, Oscillators(), 1.0e-10,
+                          1.0e-12, 1.0);
+    }
+
+    double time;
+    Vector state;
+    double stepSize;
+    Stepper stepper;
+};
+
+//! Get integration with full history, which is set up on first use.
+Integration& getIntegration()
+{
+    static Integration integration;
+    return integration;
+}
+
+void benchmarkStep(const long numberOfIterations)
+{
+    Integration& integration = getIntegration();
+    for (long i = 0; i < numberOfIterations; ++i)
+    {
+        integration.stepper.step(integration.time, integration.state, integration.stepSize,
+                                 Oscillators(), 1.0e-10, 1.0e-12, 1.0);
+    }
+    doNotOptimize(integration.state[0]);
+}
+
+void benchmarkSnapshot(const long numberOfIterations)
+{
+    const Integration& integration = getIntegration();
+    Checkpoint<double> checkpoint;
+    for (long i = 0; i < numberOfIterations; ++i)
+    {
+        saveCheckpoint(checkpoint, integration.time, integration.state, integration.stepSize,
+                       integration.stepper);
+        doNotOptimize(checkpoint.getSize());
+    }
+}
+
+void benchmarkSave(const long numberOfIterations)
+{
+    const Integration& integration = getIntegration();
+    Checkpoint<double> checkpoint;
+    for (long i = 0; i < numberOfIterations; ++i)
+    {
+        saveCheckpoint(checkpoint, integration.time, integration.state, integration.stepSize,
+                       integration.stepper);
+        checkpoint.save(checkpointFileName);
+    }
+    std::remove(checkpointFileName);
+}
+
+const bool isStepRegistered = registerBenchmark("checkpoint/step", &benchmarkStep);
+const bool isSnapshotRegistered = registerBenchmark("checkpoint/snapshot", &benchmarkSnapshot);
+const bool isSaveRegistered = registerBenchmark("checkpoint/save", &benchmarkSave);
+
+} // namespace
+} // namespace benchmarks
+} // namespace integrate
@@ -0,0 +1,274 @@
+/*
+ * Copyright (c) 2014-2025 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+// Benchmarks the integration of a stiff 2D diffusion-reaction problem (Fisher-KPP equation on the
+// unit square, discretized with central differences) at several grid sizes, up to more than 10^5
+// unknowns. One iteration integrates the problem from a Gaussian profile to the final time with
+// the matrix-free Newton-Krylov BDF stepper, without preconditioner and with an alternating
+// direction implicit preconditioner, and, on the smallest grid, with RKF45, whose step size is
+// limited by the stability of the diffusion term.
+
+#include <cmath>
+#include <cstddef>
+#include <sstream>
+#include <vector>
+
+#include "integrate/bdf.hpp"
+#include "integrate/integrateAdaptive.hpp"
+#include "integrate/rkf45.hpp"
+#include "integrate/stepSizeControl.hpp"
+
+#include "benchmark.hpp"
+
+namespace integrate
+{
+namespace benchmarks
+{
+namespace
+{
+
+typedef std::vector<double> Vector;
+
+//! Final time of integration.
+const double finalTime = 0.01;
+
+//! Fisher-KPP equation u_t = u_xx + u_yy + u (1 - u), with u = 0 on the boundary.
+struct DiffusionReaction
+{
+    explicit DiffusionReaction(const int gridSize)
+        : gridSize(gridSize),
+          scale(static_cast<double>(gridSize + 1) * (gridSize + 1))
+    { }
+
+    void operator()(const double, const Vector& state, Vector& stateDerivative) const
+    {
+        for (int j = 0; j < gridSize; ++j)
+        {
+            for (int i = 0; i < gridSize; ++i)
+            {
+                const std::size_t k = static_cast<std::size_t>(j) * gridSize + i;
+                const double u = state[k];
+                const double left = i > 0 ? state[k - 1] : 0.0;
+                const double right = i + 1 < gridSize ? state[k + 1] : 0.0;
+                const double below = j > 0 ? state[k - gridSize] : 0.0;
+                const double above = j + 1 < gridSize ? state[k + gridSize] : 0.0;
+                stateDerivative[k] = scale * (left + right + below + above - 4.0 * u)
+                                     + u * (1.0 - u);
+            }
+        }
+    }
+
+    //! Number of interior grid points per dimension.
+    int gridSize;
+
+    //! Inverse of square of grid spacing.
+    double scale;
+};
+
+//! Preconditioner that approximately factorizes I - gamma J into tridiagonal factors.
+/*!
+ * Preconditioner that approximates the iteration matrix with the product of the iteration
+ * matrices of the diffusion in x and the reaction, and of the diffusion in y (alternating
+ * direction implicit factorization), and solves the tridiagonal systems of both factors on all
+ * grid lines with the Thomas algorithm. Since the factor in y has constant coefficients, its
+ * elimination is computed once, and applied to all grid lines in y at once, row by row, so that
+ * the state is traversed contiguously.
+ */
+struct AlternatingDirectionPreconditioner
+{
+    explicit AlternatingDirectionPreconditioner(const int gridSize)
+        : gridSize(gridSize),
+          scale(static_cast<double>(gridSize + 1) * (gridSize + 1)),
+          upperCoefficients(gridSize),
+          inversePivots(gridSize)
+    { }
+
+    void operator()(const double,
+                    const Vector& state,
+                    const double gamma,
+                    const Vector& vector,
+                    Vector& result) const
+    {
+        const double offDiagonal = -gamma * scale;
+        const std::size_t size = static_cast<std::size_t>(gridSize);
+
+        // Solve factor in x on each grid line, with diagonal that depends on the state.
+        for (std::size_t offset = 0; offset < size * size; offset += size)
+        {
+            double pivot = 1.0 + gamma * (2.0 * scale - 1.0 + 2.0 * state[offset]);
+            result[offset] = vector[offset] / pivot;
+            for (std::size_t i = 1; i < size; ++i)
+            {
+                const std::size_t k = offset + i;
+                upperCoefficients[i - 1] = offDiagonal / pivot;
+                pivot = 1.0 + gamma * (2.0 * scale - 1.0 + 2.0 * state[k])
+                        - offDiagonal * upperCoefficients[i - 1];
+                result[k] = (vector[k] - offDiagonal * result[k - 1]) / pivot;
+            }
+            for (std::size_t i = size - 1; i-- > 0;)
+            {
+                result[offset + i] -= upperCoefficients[i] * result[offset + i + 1];
+            }
+        }
+
+        // Solve factor in y on all grid lines at once.
+        const double diagonal = 1.0 + 2.0 * gamma * scale;
+        inversePivots[0] = 1.0 / diagonal;
+        for (std::size_t j = 1; j < size; ++j)
+        {
+            upperCoefficients[j - 1] = offDiagonal * inversePivots[j - 1];
+            inversePivots[j] = 1.0 / (diagonal - offDiagonal * upperCoefficients[j - 1]);
+        }
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            result[i] *= inversePivots[0];
+        }
+        for (std::size_t j = 1; j < size; ++j)
+        {
+            double* const row = &result[j * size];
+            const double* const previousRow = row - size;
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                row[i] = (row[i] - offDiagonal * previousRow[i]) * inversePivots[j];
+            }
+        }
+        for (std::size_t j = size - 1; j-- > 0;)
+        {
+            double* const row = &result[j * size];
+            const double* const nextRow = row + size;
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                row[i] -= upperCoefficients[j] * nextRow[i];
+            }
+        }
+    }
+
+    //! Number of interior grid points per dimension.
+    int gridSize;
+
+    //! Inverse of square of grid spacing.
+    double scale;
+
+    //! Storage for upper coefficients of the eliminated systems.
+    mutable Vector upperCoefficients;
+
+    //! Storage for inverse pivots of the eliminated system in y.
+    mutable Vector inversePivots;
+};
+
+//! Get initial state, i.e., Gaussian profile centered in the unit square.
+Vector getInitialState(const int gridSize)
+{
+    Vector state(static_cast<std::size_t>(gridSize) * gridSize);
+    const double spacing = 1.0 / (gridSize + 1);
+    for (int j = 0; j < gridSize; ++j)
+    {
+        for (int i = 0; i < gridSize; ++i)
+        {
+            const double x = (i + 1) * spacing - 0.5;
+            const double y = (j + 1) * spacing - 0.5;
+            state[static_cast<std::size_t>(j) * gridSize + i]
+                = std::exp(-50.0 * (x * x + y * y));
+        }
+    }
+    return state;
+}
+
+void benchmarkBDF(const long numberOfIterations, const int gridSize)
+{
+    const DiffusionReaction model(gridSize);
+    const WeightedRootMeanSquareErrorNorm<double, Vector> errorNorm(1.0e-6, 1.0e-6);
+    for (long i = 0; i < numberOfIterations; ++i)
+    {
+        double time = 0.0;
+        Vector state = getInitialState(gridSize);
+        double stepSize = 1.0e-6;
+        StepSizeController<double> controller;
+        BDFStepper<double, Vector> stepper;
+        integrateAdaptive(stepper, time, state, stepSize, finalTime, model, errorNorm,
+                          controller, 1.0e-12, finalTime);
+        doNotOptimize(state[0]);
+    }
+}
+
+void benchmarkPreconditionedBDF(const long numberOfIterations, const int gridSize)
+{
+    const DiffusionReaction model(gridSize);
+    const AlternatingDirectionPreconditioner preconditioner(gridSize);
+    const WeightedRootMeanSquareErrorNorm<double, Vector> errorNorm(1.0e-6, 1.0e-6);
+    for (long i = 0; i < numberOfIterations; ++i)
+    {
+        double time = 0.0;
+        Vector state = getInitialState(gridSize);
+        double stepSize = 1.0e-6;
+        StepSizeController<double> controller;
+        BDFStepper<double, Vector> stepper;
+        while (time < finalTime)
+        {
+            if (time + stepSize > finalTime)
+            {
+                stepSize = finalTime - time;
+            }
+            stepper.step(time, state, stepSize, model, preconditioner, errorNorm, controller,
+                         1.0e-12, finalTime);
+        }
+        doNotOptimize(state[0]);
+    }
+}
+
+void benchmarkRKF45(const long numberOfIterations, const int gridSize)
+{
+    const DiffusionReaction model(gridSize);
+    const WeightedRootMeanSquareErrorNorm<double, Vector> errorNorm(1.0e-6, 1.0e-6);
+    for (long i = 0; i < numberOfIterations; ++i)
+    {
+        double time = 0.0;
+        Vector state = getInitialState(gridSize);
+        double stepSize = 1.0e-6;
+        StepSizeController<double> controller;
+        RKF45Stepper<double, Vector> stepper;
+        integrateAdaptive(stepper, time, state, stepSize, finalTime, model, errorNorm,
+                          controller, 1.0e-12, finalTime);
+        doNotOptimize(state[0]);
+    }
+}
+
+//! Register benchmarks for all grid sizes.
+bool registerDiffusionReactionBenchmarks()
+{
+    const int gridSizes[] = {64, 320};
+    for (const int gridSize : gridSizes)
+    {
+        std::ostringstream suffix;
+        suffix << "/n:" << gridSize << "x" << gridSize;
+
+        registerBenchmark("diffusionReaction/bdf" + suffix.str(),
+                          [gridSize](const long numberOfIterations)
+        {
+            benchmarkBDF(numberOfIterations, gridSize);
+        });
+        registerBenchmark("diffusionReaction/bdfPreconditioned" + suffix.str(),
+                          [gridSize](const long numberOfIterations)
+        {
+            benchmarkPreconditionedBDF(numberOfIterations, gridSize);
+        });
+        if (gridSize == gridSizes[0])
+        {
+            registerBenchmark("diffusionReaction/rkf45" + suffix.str(),
+                              [gridSize](const long numberOfIterations)
+            {
+                benchmarkRKF45(numberOfIterations, gridSize);
+            });
+        }
+    }
+    return true;
+}
+
+const bool isDiffusionReactionBenchmarkRegistered = registerDiffusionReactionBenchmarks();
+
+} // namespace
+} // namespace benchmarks
+} // namespace integrate
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2014-2025 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+// Benchmarks the throughput of integrating an ensemble of Kepler orbits with the batched
+// EnsembleRungeKuttaStepper, compared to stepping each trajectory with the scalar stepper. One
+// iteration executes a single Runge-Kutta 4 step for all trajectories in the ensemble. Build with
+// e.g. -march=native to let the compiler use the widest available SIMD instructions, and with
+// -fno-math-errno, so that the calls to std::sqrt in the dynamics can be vectorized.
+
+#include <array>
+#include <cmath>
+#include <vector>
+
+#include "integrate/ensemble.hpp"
+#include "integrate/rk4.hpp"
+
+#include "benchmark.hpp"
+
+namespace integrate
+{
+namespace benchmarks
+{
+namespace
+{
+
+typedef std::array<double, 6> KeplerState;
+
+const int numberOfTrajectories = 256;
+
+//! Kepler dynamics for single trajectory (gravitational parameter of 1), written in-place.
+struct Kepler
+{
+    void operator()(const double, const KeplerState& state, KeplerState& stateDerivative) const
+    {
+        const double radius = std::sqrt(state[0] * state[0]
+                                        + state[1] * state[1]
+                                        + state[2] * state[2]);
+        const double factor = -1.0 / (radius * radius * radius);
+        stateDerivative[0] = state[3];
+        stateDerivative[1] = state[4];
+        stateDerivative[2] = state[5];
+        stateDerivative[3] = factor * state[0];
+        stateDerivative[4] = factor * state[1];
+        stateDerivative[5] = factor * state[2];
+    }
+};
+
+//! Kepler dynamics for all lanes of an ensemble (gravitational parameter of 1).
+struct EnsembleKepler
+{
+    void operator()(const std::vector<double>&,
+                    const EnsembleState<double>& states,
+                    EnsembleState<double>& stateDerivatives) const
+    {
+        const double* const x = states.getElement(0);
+        const double* const y = states.getElement(1);
+        const double* const z = states.getElement(2);
+        for (int element = 0; element < 3; ++element)
+        {
+            const double* const velocity = states.getElement(element + 3);
+            double* const positionDerivative = stateDerivatives.getElement(element);
+            for (int lane = 0; lane < states.getNumberOfLanes(); ++lane)
+            {
+                positionDerivative[lane] = velocity[lane];
+            }
+        }
+
+        double* const vxDerivative = stateDerivatives.getElement(3);
+        double* const vyDerivative = stateDerivatives.getElement(4);
+        double* const vzDerivative = stateDerivatives.getElement(5);
+        for (int lane = 0; lane < states.getNumberOfLanes(); ++lane)
+        {
+            const double radius = std::sqrt(x[lane] * x[lane] + y[lane] * y[lane]
+                                            + z[lane] * z[lane]);
+            const double factor = -1.0 / (radius * radius * radius);
+            vxDerivative[lane] = factor * x[lane];
+            vyDerivative[lane] = factor * y[lane];
+            vzDerivative[lane] = factor * z[lane];
+        }
+    }
+};
+
+//! Get initial state of given trajectory (near-circular orbit with varying radius).
+KeplerState getInitialState(const int trajectory)
+{
+    const double radius = 1.0 + 0.001 * trajectory;
+    const KeplerState state = {{radius, 0.0, 0.0, 0.0, 1.0 / std::sqrt(radius), 0.01}};
+    return state;
+}
+
+void benchmarkScalar(const long numberOfIterations)
+{
+    std::vector<double> times(numberOfTrajectories, 0.0);
+    std::vector<KeplerState> states(numberOfTrajectories);
+    for (int trajectory = 0; trajectory < numberOfTrajectories; ++trajectory)
+    {
+        states[trajectory] = getInitialState(trajectory);
+    }
+
+    RK4Stepper<double, KeplerState> stepper;
+    for (long i = 0; i < numberOfIterations; ++i)
+    {
+        for (int trajectory = 0; trajectory < numberOfTrajectories; ++trajectory)
+        {
+            stepper.step(times[trajectory], states[trajectory], 1.0e-6, Kepler());
+        }
+    }
+    doNotOptimize(states[0]);
+}
+
+void benchmarkBatched(const long numberOfIterations)
+{
+    std::vector<double> times(numberOfTrajectories, 0.0);
+    EnsembleState<double> states(numberOfTrajectories, 6);
+    for (int trajectory = 0; trajectory < numberOfTrajectories; ++trajectory)
+    {
+        states.setLane(trajectory, getInitialState(trajectory));
+    }
+
+    EnsembleRungeKuttaStepper<double, RK4Tableau<double> > stepper;
+    for (long i = 0; i < numberOfIterations; ++i)
+    {
+        stepper.step(times, states, 1.0e-6, EnsembleKepler());
+    }
+    doNotOptimize(states(0, 0));
+}
+
+INTEGRATE_BENCHMARK("ensemble/rk4/scalar", benchmarkScalar);
+INTEGRATE_BENCHMARK("ensemble/rk4/batched", benchmarkBatched);
+
+} // namespace
+} // namespace benchmarks
+} // namespace integrate
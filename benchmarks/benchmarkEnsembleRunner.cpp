@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2014-2025 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+// Benchmarks the scaling of the EnsembleRunner with the number of threads, from a single thread
+// up to all hardware threads. One iteration integrates an ensemble of Kepler/J2 orbits with
+// varying eccentricity over a single orbital period, using DOPRI5Stepper with adaptive step size.
+// Since the number of steps per orbit grows with the eccentricity, the amount of work per
+// trajectory is uneven, which is the case that work stealing is designed for.
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "integrate/dopri5.hpp"
+#include "integrate/ensembleRunner.hpp"
+#include "integrate/integrateAdaptive.hpp"
+
+#include "benchmark.hpp"
+
+namespace integrate
+{
+namespace benchmarks
+{
+namespace
+{
+
+typedef std::array<double, 6> OrbitState;
+typedef DOPRI5Stepper<double, OrbitState> OrbitStepper;
+
+const int numberOfTrajectories = 256;
+
+//! Kepler/J2 dynamics (gravitational parameter and equatorial radius of 1), written in-place.
+struct KeplerJ2
+{
+    void operator()(const double, const OrbitState& state, OrbitState& stateDerivative) const
+    {
+        const double j2 = 1.08263e-3;
+        const double radiusSquared = state[0] * state[0] + state[1] * state[1]
+                                     + state[2] * state[2];
+        const double radius = std::sqrt(radiusSquared);
+        const double factor = -1.0 / (radiusSquared * radius);
+        const double j2Factor = 1.5 * j2 / radiusSquared;
+        const double zSquaredRatio = 5.0 * state[2] * state[2] / radiusSquared;
+
+        stateDerivative[0] = state[3];
+        stateDerivative[1] = state[4];
+        stateDerivative[2] = state[5];
+        stateDerivative[3] = factor * state[0] * (1.0 + j2Factor * (1.0 - zSquaredRatio));
+        stateDerivative[4] = factor * state[1] * (1.0 + j2Factor * (1.0 - zSquaredRatio));
+        stateDerivative[5] = factor * state[2] * (1.0 + j2Factor * (3.0 - zSquaredRatio));
+    }
+};
+
+//! Integrate single trajectory over one orbital period.
+double integrateTrajectory(OrbitStepper& stepper, const int trajectory)
+{
+    // Start at periapsis of orbit with semi-major axis of 2 and inclination of 0.5 rad.
+    const double eccentricity = 0.7 * trajectory / numberOfTrajectories;
+    const double semiMajorAxis = 2.0;
+    const double periapsisRadius = semiMajorAxis * (1.0 - eccentricity);
+    const double periapsisSpeed = std::sqrt((1.0 + eccentricity) / periapsisRadius);
+    const double inclination = 0.5;
+
+    double time = 0.0;
+    OrbitState state = {{periapsisRadius, 0.0, 0.0,
+                         0.0, periapsisSpeed * std::cos(inclination),
+                         periapsisSpeed * std::sin(inclination)}};
+    double stepSize = 1.0e-3;
+    const double period = 2.0 * 3.14159265358979323846 * std::sqrt(semiMajorAxis
+                                                                    * semiMajorAxis
+                                                                    * semiMajorAxis);
+    integrateAdaptive(stepper, time, state, stepSize, period, KeplerJ2(), 1.0e-10, 1.0e-12, 1.0);
+    return state[0];
+}
+
+//! Benchmark ensemble runner with given number of threads.
+void benchmarkEnsembleRunner(const long numberOfIterations, const int numberOfThreads)
+{
+    EnsembleRunner runner(numberOfThreads);
+    std::vector<double> finalPositions(numberOfTrajectories);
+    for (long i = 0; i < numberOfIterations; ++i)
+    {
+        runner.run<OrbitStepper>(numberOfTrajectories,
+                                 [&finalPositions](OrbitStepper& stepper, const int trajectory)
+        {
+            finalPositions[trajectory] = integrateTrajectory(stepper, trajectory);
+        });
+    }
+    doNotOptimize(finalPositions[0]);
+}
+
+//! Register scaling benchmarks for 1, 2, 4, ... threads up to all hardware threads.
+bool registerEnsembleRunnerBenchmarks()
+{
+    const int numberOfHardwareThreads
+        = std::max(1, static_cast<int>(std::thread::hardware_concurrency()));
+    for (int numberOfThreads = 1; ; numberOfThreads *= 2)
+    {
+        if (numberOfThreads > numberOfHardwareThreads)
+        {
+            numberOfThreads = numberOfHardwareThreads;
+        }
+
+        std::ostringstream name;
+        name << "ensembleRunner/dopri5/keplerJ2/threads:" << numberOfThreads;
+        registerBenchmark(name.str(), [numberOfThreads](const long numberOfIterations)
+        {
+            benchmarkEnsembleRunner(numberOfIterations, numberOfThreads);
+        });
+
+        if (numberOfThreads == numberOfHardwareThreads)
+        {
+            break;
+        }
+    }
+    return true;
+}
+
+const bool isEnsembleRunnerBenchmarkRegistered = registerEnsembleRunnerBenchmarks();
+
+} // namespace
+} // namespace benchmarks
+} // namespace integrate
@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2014-2025 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+// Benchmarks random access to trajectory files written by IndexedTrajectoryWriter, at several
+// numbers of records (6 state elements and state derivatives per record, i.e., 104 bytes). One
+// iteration computes the state at a pseudo-random time with IndexedTrajectory, i.e., a binary
+// search in the time index and the records of one index entry, followed by cubic Hermite
+// interpolation. The lookup latency should grow with the logarithm of the number of records only.
+// The files are written on first use and removed at exit.
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "integrate/indexedTrajectory.hpp"
+
+#include "benchmark.hpp"
+
+namespace integrate
+{
+namespace benchmarks
+{
+namespace
+{
+
+//! Trajectory file with given number of records, which is removed on destruction.
+class TrajectoryFile
+{
+public:
+
+    explicit TrajectoryFile(const std::size_t numberOfRecords)
+    {
+        std::ostringstream name;
+        name << "benchmarkIndexedTrajectory" << numberOfRecords << ".bin";
+        fileName = name.str();
+
+        // Three uncoupled harmonic oscillators, sampled with a step size of 0.01.
+        {
+            IndexedTrajectoryWriter<double> writer(fileName, 6, true);
+            double state[6];
+            double stateDerivative[6];
+            for (std::size_t i = 0; i < numberOfRecords; ++i)
+            {
+                const double time = 0.01 * i;
+                for (int j = 0; j < 3; ++j)
+                {
+                    const double frequency = 1.0 + 0.5 * j;
+                    state[2 * j] = std::sin(frequency * time);
+                    state[2 * j + 1] = frequency * std::cos(frequency * time);
+                    stateDerivative[2 * j] = state[2 * j + 1];
+                    stateDerivative[2 * j + 1] = -frequency * frequency * state[2 * j];
+                }
+                writer.write(time, state, stateDerivative);
+            }
+        }
+        trajectory.reset(new IndexedTrajectory<double>(fileName));
+    }
+
+    ~TrajectoryFile()
+    {
+        trajectory.reset();
+        std::remove(fileName.c_str());
+    }
+
+    const IndexedTrajectory<double>& getTrajectory() const { return *trajectory; }
+
+private:
+
+    std::string fileName;
+    std::unique_ptr<IndexedTrajectory<double> > trajectory;
+};
+
+//! Get trajectory with given number of records, and write its file on first use.
+const IndexedTrajectory<double>& getTrajectory(const std::size_t numberOfRecords)
+{
+    static std::map<std::size_t, std::unique_ptr<TrajectoryFile> > files;
+    std::unique_ptr<TrajectoryFile>& file = files[numberOfRecords];
+    if (!file)
+    {
+        file.reset(new TrajectoryFile(numberOfRecords));
+    }
+    return file->getTrajectory();
+}
+
+void benchmarkLookup(const long numberOfIterations, const std::size_t numberOfRecords)
+{
+    const IndexedTrajectory<double>& trajectory = getTrajectory(numberOfRecords);
+    const double startTime = trajectory.getStartTime();
+    const double duration = trajectory.getEndTime() - startTime;
+
+    // Linear congruential generator, so that successive lookups hit unrelated records.
+    std::uint64_t random = 12345;
+    double state[6];
+    for (long i = 0; i < numberOfIterations; ++i)
+    {
+        random = random * 6364136223846793005ULL + 1442695040888963407ULL;
+        const double fraction = static_cast<double>(random >> 11) * (1.0 / 9007199254740992.0);
+        trajectory.interpolate(startTime + fraction * duration, state);
+        doNotOptimize(state[0]);
+    }
+}
+
+//! Register benchmarks for all numbers of records.
+bool registerIndexedTrajectoryBenchmarks()
+{
+    const std::size_t sizes[] = {1000, 100000, 1000000};
+    for (const std::size_t size : sizes)
+    {
+        std::ostringstream name;
+        name << "indexedTrajectory/lookup/records:" << size;
+        registerBenchmark(name.str(), [size](const long numberOfIterations)
+        {
+            benchmarkLookup(numberOfIterations, size);
+        });
+    }
+    return true;
+}
+
+const bool isIndexedTrajectoryBenchmarkRegistered = registerIndexedTrajectoryBenchmarks();
+
+} // namespace
+} // namespace benchmarks
+} // namespace integrate
@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2014-2025 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+// Benchmarks the state arithmetic for large states, as found in method-of-lines discretizations
+// of partial differential equations, at several state sizes. Each benchmark is run for a
+// contiguous state (std::vector), for which reductions operate on the raw storage, and for a state
+// that only provides element access by index, for which all kernels use element-wise access.
+// One iteration either computes the maximum norm of a state, or executes a single RKF78 step with
+// adaptive step size for the 1D heat equation (discretized with central differences).
+
+#include <cmath>
+#include <cstddef>
+#include <sstream>
+#include <vector>
+
+#include "integrate/rkf78.hpp"
+#include "integrate/stateNorm.hpp"
+
+#include "benchmark.hpp"
+
+namespace integrate
+{
+namespace benchmarks
+{
+namespace
+{
+
+//! State that provides element access by index, but does not expose contiguous storage.
+class IndexableState
+{
+public:
+
+    explicit IndexableState(const std::size_t size = 0)
+        : vector(size)
+    { }
+
+    std::size_t size() const { return vector.size(); }
+
+    double operator[](const std::size_t i) const { return vector[i]; }
+
+    double& operator[](const std::size_t i) { return vector[i]; }
+
+private:
+
+    std::vector<double> vector;
+};
+
+//! Heat equation discretized with central differences (unit diffusivity and grid spacing).
+struct HeatEquation
+{
+    template <typename State>
+    void operator()(const double, const State& state, State& stateDerivative) const
+    {
+        const std::size_t size = state.size();
+        stateDerivative[0] = state[1] - 2.0 * state[0];
+        for (std::size_t i = 1; i + 1 < size; ++i)
+        {
+            stateDerivative[i] = state[i - 1] - 2.0 * state[i] + state[i + 1];
+        }
+        stateDerivative[size - 1] = state[size - 2] - 2.0 * state[size - 1];
+    }
+};
+
+//! Get initial state for heat equation, i.e., sine profile.
+template <typename State>
+State getInitialState(const std::size_t size)
+{
+    State state(size);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        state[i] = std::sin(3.14159265358979323846 * (i + 1) / (size + 1));
+    }
+    return state;
+}
+
+template <typename State>
+void benchmarkMaximumNorm(const long numberOfIterations, const std::size_t size)
+{
+    const State state = getInitialState<State>(size);
+    for (long i = 0; i < numberOfIterations; ++i)
+    {
+        const double norm = computeMaximumNorm<double>(state);
+        doNotOptimize(norm);
+    }
+}
+
+template <typename State>
+void benchmarkRKF78Step(const long numberOfIterations, const std::size_t size)
+{
+    double time = 0.0;
+    State state = getInitialState<State>(size);
+    RKF78Stepper<double, State> stepper;
+    for (long i = 0; i < numberOfIterations; ++i)
+    {
+        // Reset the step size, so that each iteration executes the same amount of work.
+        double stepSize = 0.1;
+        stepper.step(time, state, stepSize, HeatEquation(), 1.0, 1.0e-6, 0.1);
+    }
+    doNotOptimize(state[0]);
+}
+
+//! Register benchmarks for all state sizes.
+bool registerLargeStateBenchmarks()
+{
+    const std::size_t sizes[] = {1000, 100000, 1000000};
+    for (const std::size_t size : sizes)
+    {
+        std::ostringstream suffix;
+        suffix << "/n:" << size;
+
+        registerBenchmark("largeState/maximumNorm/contiguous" + suffix.str(),
+                          [size](const long numberOfIterations)
+        {
+            benchmarkMaximumNorm<std::vector<double> >(numberOfIterations, size);
+        });
+        registerBenchmark("largeState/maximumNorm/indexable" + suffix.str(),
+                          [size](const long numberOfIterations)
+        {
+            benchmarkMaximumNorm<IndexableState>(numberOfIterations, size);
+        });
+        registerBenchmark("largeState/rkf78Step/contiguous" + suffix.str(),
+                          [size](const long numberOfIterations)
+        {
+            benchmarkRKF78Step<std::vector<double> >(numberOfIterations, size);
+        });
+        registerBenchmark("largeState/rkf78Step/indexable" + suffix.str(),
+                          [size](const long numberOfIterations)
+        {
+            benchmarkRKF78Step<IndexableState>(numberOfIterations, size);
+        });
+    }
+    return true;
+}
+
+const bool isLargeStateBenchmarkRegistered = registerLargeStateBenchmarks();
+
+} // namespace
+} // namespace benchmarks
+} // namespace integrate
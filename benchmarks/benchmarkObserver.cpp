@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2014-2025 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+// Benchmarks the output of every accepted step of a long integration. One iteration integrates
+// three uncoupled harmonic oscillators (6 state elements) with DOPRI5 over 1000 time units at a
+// tight tolerance, i.e., about 10^4 steps, and collects the trajectory:
+//
+//  - map: in a std::map<double, std::vector<double> >, as the caller's loop in the tests does,
+//    which allocates a node and a state per step;
+//  - streamingSink: with StreamingTrajectorySink, which hands the samples through a ring buffer to
+//    a writer thread that writes a columnar binary file, so that the integration thread does not
+//    allocate or perform I/O;
+//  - none: without output, as reference for the cost of the integration.
+
+#include <cstdio>
+#include <map>
+#include <vector>
+
+#include "integrate/dopri5.hpp"
+#include "integrate/integrateAdaptive.hpp"
+#include "integrate/trajectoryWriter.hpp"
+
+#include "benchmark.hpp"
+
+namespace integrate
+{
+namespace benchmarks
+{
+namespace
+{
+
+typedef std::vector<double> Vector;
+
+//! Final time of integration.
+const double finalTime = 1000.0;
+
+//! Name of trajectory file written by benchmark.
+const char* const trajectoryFileName = "benchmarkObserver.bin";
+
+//! Three uncoupled harmonic oscillators with different angular frequencies.
+struct Oscillators
+{
+    void operator()(const double, const Vector& state, Vector& stateDerivative) const
+    {
+        for (int i = 0; i < 3; ++i)
+        {
+            const double frequency = 1.0 + 0.5 * i;
+            stateDerivative[2 * i] = state[2 * i + 1];
+            stateDerivative[2 * i + 1] = -frequency * frequency * state[2 * i];
+        }
+    }
+};
+
+//! Get initial state of oscillators.
+Vector getInitialState()
+{
+    return Vector({1.0, 0.0, 0.0, 1.0, 0.5, 0.5});
+}
+
+template <typename Observer>
+void integrateOscillators(const Observer& observe)
+{
+    double time = 0.0;
+    Vector state = getInitialState();
+    double stepSize = 0.01;
+    DOPRI5Stepper<double, Vector> stepper;
+    integrateObserved(stepper, time, state, stepSize, finalTime, Oscillators(), 1.0e-12,
+                      1.0e-12, 1.0, observe);
+    doNotOptimize(state[0]);
+}
+
+void benchmarkNone(const long numberOfIterations)
+{
+    for (long i = 0; i < numberOfIterations; ++i)
+    {
+        integrateOscillators([](const double, const Vector&) { });
+    }
+}
+
+void benchmarkMap(const long numberOfIterations)
+{
+    for (long i = 0; i < numberOfIterations; ++i)
+    {
+        std::map<double, Vector> trajectory;
+        integrateOscillators([&trajectory](const double time, const Vector& state)
+        {
+            trajectory[time] = state;
+        });
+        doNotOptimize(trajectory.size());
+    }
+}
+
+void benchmarkStreamingSink(const long numberOfIterations)
+{
+    for (long i = 0; i < numberOfIterations; ++i)
+    {
+        StreamingTrajectorySink<double, Vector> sink(trajectoryFileName, 6);
+        integrateOscillators(sink);
+        sink.close();
+        doNotOptimize(sink.getNumberOfStalls());
+    }
+    std::remove(trajectoryFileName);
+}
+
+const bool isNoneRegistered = registerBenchmark("observer/none", &benchmarkNone);
+const bool isMapRegistered = registerBenchmark("observer/map", &benchmarkMap);
+const bool isStreamingSinkRegistered
+    = registerBenchmark("observer/streamingSink", &benchmarkStreamingSink);
+
+} // namespace
+} // namespace benchmarks
+} // namespace integrate
@@ -0,0 +1,102 @@
+/*
+ * Copyright (c) 2014-2025 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+// Benchmarks the overhead of calling the state derivative through the type-erased
+// StateDerivativeFunction wrapper, compared to passing a functor or lambda that the compiler can
+// inline into the stage evaluations. A scalar state is used, so that the cost of a step is
+// dominated by the state derivative calls and not by state arithmetic.
+
+#include "integrate/euler.hpp"
+#include "integrate/rk4.hpp"
+#include "integrate/stateDerivative.hpp"
+
+#include "benchmark.hpp"
+
+namespace integrate
+{
+namespace benchmarks
+{
+namespace
+{
+
+//! Burden & Faires dynamics for scalar state, i.e., ydot = y - t^2 + 1.
+struct ScalarBurdenFaires
+{
+    double operator()(const double time, const double state) const
+    {
+        return state - time * time + 1.0;
+    }
+};
+
+template <typename StateDerivative>
+void benchmarkEuler(const long numberOfIterations, const StateDerivative& computeStateDerivative)
+{
+    double time = 0.0;
+    double state = 0.5;
+    const double stepSize = 1.0e-9;
+    for (long i = 0; i < numberOfIterations; ++i)
+    {
+        stepEuler<double, double>(time, state, stepSize, computeStateDerivative);
+    }
+    doNotOptimize(state);
+}
+
+template <typename StateDerivative>
+void benchmarkRK4(const long numberOfIterations, const StateDerivative& computeStateDerivative)
+{
+    double time = 0.0;
+    double state = 0.5;
+    const double stepSize = 1.0e-9;
+    for (long i = 0; i < numberOfIterations; ++i)
+    {
+        stepRK4<double, double>(time, state, stepSize, computeStateDerivative);
+    }
+    doNotOptimize(state);
+}
+
+const StateDerivativeFunction<double, double> typeErasedBurdenFaires = ScalarBurdenFaires();
+
+INTEGRATE_BENCHMARK("stateDerivative/euler/functor", [](const long numberOfIterations)
+{
+    benchmarkEuler(numberOfIterations, ScalarBurdenFaires());
+});
+
+INTEGRATE_BENCHMARK("stateDerivative/euler/lambda", [](const long numberOfIterations)
+{
+    benchmarkEuler(numberOfIterations, [](const double time, const double state)
+    {
+        return state - time * time + 1.0;
+    });
+});
+
+INTEGRATE_BENCHMARK("stateDerivative/euler/StateDerivativeFunction",
+                    [](const long numberOfIterations)
+{
+    benchmarkEuler(numberOfIterations, typeErasedBurdenFaires);
+});
+
+INTEGRATE_BENCHMARK("stateDerivative/rk4/functor", [](const long numberOfIterations)
+{
+    benchmarkRK4(numberOfIterations, ScalarBurdenFaires());
+});
+
+INTEGRATE_BENCHMARK("stateDerivative/rk4/lambda", [](const long numberOfIterations)
+{
+    benchmarkRK4(numberOfIterations, [](const double time, const double state)
+    {
+        return state - time * time + 1.0;
+    });
+});
+
+INTEGRATE_BENCHMARK("stateDerivative/rk4/StateDerivativeFunction",
+                    [](const long numberOfIterations)
+{
+    benchmarkRK4(numberOfIterations, typeErasedBurdenFaires);
+});
+
+} // namespace
+} // namespace benchmarks
+} // namespace integrate
@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2014-2025 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+// Benchmarks the state types for a small system, i.e., a Kepler orbit with eccentricity 0.5
+// (6 state elements), integrated with the DOPRI5 and RKF78 steppers with adaptive step size. Each
+// benchmark is run for
+//
+//  - testState: a state that wraps std::vector, as the State of the tests, which is indexable but
+//    does not expose contiguous storage;
+//  - fixedState: FixedState<double, 6>, whose elements are stored in the state itself and whose
+//    size is a compile-time constant;
+//  - dynamicState: DynamicState<double>, whose elements are stored in an aligned heap buffer.
+//
+// One iteration integrates a single orbital period, starting at periapsis.
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include "integrate/dopri5.hpp"
+#include "integrate/integrateAdaptive.hpp"
+#include "integrate/rkf78.hpp"
+#include "integrate/state.hpp"
+
+#include "benchmark.hpp"
+
+namespace integrate
+{
+namespace benchmarks
+{
+namespace
+{
+
+//! State that wraps std::vector, as the State of the tests.
+class TestState
+{
+public:
+
+    TestState(const std::vector<double>& vector)
+        : vector(vector)
+    { }
+
+    std::size_t size() const { return vector.size(); }
+
+    double operator[](const std::size_t i) const { return vector[i]; }
+
+    double& operator[](const std::size_t i) { return vector[i]; }
+
+    friend TestState operator+(const TestState& state, const TestState& otherState)
+    {
+        std::vector<double> sum(state.size());
+        for (std::size_t i = 0; i < sum.size(); ++i)
+        {
+            sum[i] = state[i] + otherState[i];
+        }
+        return TestState(sum);
+    }
+
+    friend TestState operator*(const double multiplier, const TestState& state)
+    {
+        std::vector<double> product(state.size());
+        for (std::size_t i = 0; i < product.size(); ++i)
+        {
+            product[i] = multiplier * state[i];
+        }
+        return TestState(product);
+    }
+
+private:
+
+    std::vector<double> vector;
+};
+
+typedef FixedState<double, 6> FixedState6;
+typedef DynamicState<double> DynamicStateX;
+
+//! Orbital period of orbit with semi-major axis 1 (gravitational parameter 1).
+const double orbitalPeriod = 2.0 * 3.14159265358979323846;
+
+//! Kepler problem with gravitational parameter 1, with state (x, y, z, x', y', z').
+struct Kepler
+{
+    template <typename State>
+    void operator()(const double, const State& state, State& stateDerivative) const
+    {
+        const double radiusSquared
+            = state[0] * state[0] + state[1] * state[1] + state[2] * state[2];
+        const double factor = -1.0 / (radiusSquared * std::sqrt(radiusSquared));
+        stateDerivative[0] = state[3];
+        stateDerivative[1] = state[4];
+        stateDerivative[2] = state[5];
+        stateDerivative[3] = factor * state[0];
+        stateDerivative[4] = factor * state[1];
+        stateDerivative[5] = factor * state[2];
+    }
+};
+
+//! Set state to periapsis of inclined orbit with semi-major axis 1 and eccentricity 0.5.
+template <typename State>
+void setInitialState(State& state)
+{
+    const double speed = std::sqrt(3.0);
+    state[0] = 0.5;
+    state[1] = 0.0;
+    state[2] = 0.0;
+    state[3] = 0.0;
+    state[4] = speed * std::cos(0.5);
+    state[5] = speed * std::sin(0.5);
+}
+
+template <template <typename, typename> class Stepper, typename State>
+void benchmarkOrbit(const long numberOfIterations, const State& zeroState)
+{
+    Stepper<double, State> stepper;
+    State state = zeroState;
+    for (long i = 0; i < numberOfIterations; ++i)
+    {
+        double time = 0.0;
+        double stepSize = 0.01;
+        setInitialState(state);
+        integrateAdaptive(stepper, time, state, stepSize, orbitalPeriod, Kepler(), 1.0e-10,
+                          1.0e-12, 1.0);
+        doNotOptimize(state[0]);
+    }
+}
+
+template <template <typename, typename> class Stepper>
+void benchmarkTestState(const long numberOfIterations)
+{
+    benchmarkOrbit<Stepper>(numberOfIterations, TestState(std::vector<double>(6, 0.0)));
+}
+
+template <template <typename, typename> class Stepper>
+void benchmarkFixedState(const long numberOfIterations)
+{
+    benchmarkOrbit<Stepper>(numberOfIterations, FixedState6());
+}
+
+template <template <typename, typename> class Stepper>
+void benchmarkDynamicState(const long numberOfIterations)
+{
+    benchmarkOrbit<Stepper>(numberOfIterations, DynamicStateX(6));
+}
+
+//! DOPRI5 stepper with default statistics.
+template <typename Real, typename State>
+using DOPRI5 = DOPRI5Stepper<Real, State>;
+
+//! RKF78 stepper with default statistics.
+template <typename Real, typename State>
+using RKF78 = RKF78Stepper<Real, State>;
+
+const bool isDOPRI5TestStateRegistered
+    = registerBenchmark("stateTypes/dopri5/testState", &benchmarkTestState<DOPRI5>);
+const bool isDOPRI5FixedStateRegistered
+    = registerBenchmark("stateTypes/dopri5/fixedState", &benchmarkFixedState<DOPRI5>);
+const bool isDOPRI5DynamicStateRegistered
+    = registerBenchmark("stateTypes/dopri5/dynamicState", &benchmarkDynamicState<DOPRI5>);
+const bool isRKF78TestStateRegistered
+    = registerBenchmark("stateTypes/rkf78/testState", &benchmarkTestState<RKF78>);
+const bool isRKF78FixedStateRegistered
+    = registerBenchmark("stateTypes/rkf78/fixedState", &benchmarkFixedState<RKF78>);
+const bool isRKF78DynamicStateRegistered
+    = registerBenchmark("stateTypes/rkf78/dynamicState", &benchmarkDynamicState<RKF78>);
+
+} // namespace
+} // namespace benchmarks
+} // namespace integrate
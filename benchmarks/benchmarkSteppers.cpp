@@ -0,0 +1,261 @@
+/*
+ * Copyright (c) 2014-2025 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+// Benchmarks a single integration step of every stepper, for three dynamical models:
+//
+//  - oscillator: harmonic oscillator with a small fixed-size state (std::array) and a cheap state
+//    derivative, so that the cost of a step is dominated by the integrator overhead;
+//  - nBody: gravitational 8-body problem with a fixed-size state and an expensive state derivative
+//    (all pairwise interactions), so that the cost is dominated by the state derivative;
+//  - heat: 1D heat equation (periodic, discretized with central differences) with a large dynamic
+//    state (std::vector), so that the cost is dominated by the state arithmetic.
+//
+// Each model is passed to the stepper as an inlined functor, as a std::function that writes the
+// state derivative in-place, and as a StateDerivativeFunction that returns the state derivative.
+// One iteration executes a single step with fixed step size ("fixed"), or, for the embedded
+// schemes, a single step with adaptive step size ("adaptive") for which the step size is reset
+// before each step, so that all iterations execute the same amount of work. The benchmark names
+// are "steppers/<stepper>/<fixed|adaptive>/<model>/<callable>".
+
+#include <array>
+#include <cmath>
+#include <functional>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "integrate/dopri5.hpp"
+#include "integrate/euler.hpp"
+#include "integrate/rk4.hpp"
+#include "integrate/rkf45.hpp"
+#include "integrate/rkf78.hpp"
+#include "integrate/stateDerivative.hpp"
+
+#include "benchmark.hpp"
+
+namespace integrate
+{
+namespace benchmarks
+{
+namespace
+{
+
+typedef std::array<double, 2> OscillatorState;
+
+const int numberOfBodies = 8;
+typedef std::array<double, 6 * numberOfBodies> NBodyState;
+
+typedef std::vector<double> HeatState;
+const int numberOfHeatGridPoints = 10000;
+
+//! Harmonic oscillator with unit angular frequency.
+struct Oscillator
+{
+    typedef OscillatorState State;
+
+    void operator()(const double,
+                    const OscillatorState& state,
+                    OscillatorState& stateDerivative) const
+    {
+        stateDerivative[0] = state[1];
+        stateDerivative[1] = -state[0];
+    }
+
+    static OscillatorState getInitialState() { return OscillatorState{{1.0, 0.0}}; }
+};
+
+//! Gravitational N-body problem (unit gravitational constant and masses, softened).
+struct NBody
+{
+    typedef NBodyState State;
+
+    void operator()(const double, const NBodyState& state, NBodyState& stateDerivative) const
+    {
+        for (int i = 0; i < numberOfBodies; ++i)
+        {
+            stateDerivative[6 * i] = state[6 * i + 3];
+            stateDerivative[6 * i + 1] = state[6 * i + 4];
+            stateDerivative[6 * i + 2] = state[6 * i + 5];
+            stateDerivative[6 * i + 3] = 0.0;
+            stateDerivative[6 * i + 4] = 0.0;
+            stateDerivative[6 * i + 5] = 0.0;
+        }
+
+        for (int i = 0; i < numberOfBodies; ++i)
+        {
+            for (int j = i + 1; j < numberOfBodies; ++j)
+            {
+                const double dx = state[6 * j] - state[6 * i];
+                const double dy = state[6 * j + 1] - state[6 * i + 1];
+                const double dz = state[6 * j + 2] - state[6 * i + 2];
+                const double distanceSquared = dx * dx + dy * dy + dz * dz + 1.0e-3;
+                const double factor = 1.0 / (distanceSquared * std::sqrt(distanceSquared));
+                stateDerivative[6 * i + 3] += factor * dx;
+                stateDerivative[6 * i + 4] += factor * dy;
+                stateDerivative[6 * i + 5] += factor * dz;
+                stateDerivative[6 * j + 3] -= factor * dx;
+                stateDerivative[6 * j + 4] -= factor * dy;
+                stateDerivative[6 * j + 5] -= factor * dz;
+            }
+        }
+    }
+
+    //! Get initial state, i.e., bodies on a circle with circular velocities.
+    static NBodyState getInitialState()
+    {
+        NBodyState state = { };
+        for (int i = 0; i < numberOfBodies; ++i)
+        {
+            const double angle = 2.0 * 3.14159265358979323846 * i / numberOfBodies;
+            state[6 * i] = std::cos(angle);
+            state[6 * i + 1] = std::sin(angle);
+            state[6 * i + 2] = 0.01 * i;
+            state[6 * i + 3] = -std::sin(angle);
+            state[6 * i + 4] = std::cos(angle);
+        }
+        return state;
+    }
+};
+
+//! Periodic 1D heat equation discretized with central differences (unit diffusivity and spacing).
+struct Heat
+{
+    typedef HeatState State;
+
+    void operator()(const double, const HeatState& state, HeatState& stateDerivative) const
+    {
+        const int size = static_cast<int>(state.size());
+        stateDerivative[0] = state[size - 1] - 2.0 * state[0] + state[1];
+        for (int i = 1; i < size - 1; ++i)
+        {
+            stateDerivative[i] = state[i - 1] - 2.0 * state[i] + state[i + 1];
+        }
+        stateDerivative[size - 1] = state[size - 2] - 2.0 * state[size - 1] + state[0];
+    }
+
+    //! Get initial state, i.e., sine profile with unit mean (so that the state does not decay).
+    static HeatState getInitialState()
+    {
+        HeatState state(numberOfHeatGridPoints);
+        for (int i = 0; i < numberOfHeatGridPoints; ++i)
+        {
+            state[i] = 1.0 + std::sin(2.0 * 3.14159265358979323846 * i / numberOfHeatGridPoints);
+        }
+        return state;
+    }
+};
+
+//! Benchmark single step with fixed step size.
+template <typename Stepper, typename Model, typename StateDerivative>
+void benchmarkStep(const long numberOfIterations,
+                   const StateDerivative& computeStateDerivative,
+                   std::false_type)
+{
+    Stepper stepper;
+    double time = 0.0;
+    typename Model::State state = Model::getInitialState();
+    for (long i = 0; i < numberOfIterations; ++i)
+    {
+        stepper.step(time, state, 1.0e-3, computeStateDerivative);
+    }
+    doNotOptimize(state[0]);
+}
+
+//! Benchmark single step with adaptive step size, resetting the step size before each step.
+template <typename Stepper, typename Model, typename StateDerivative>
+void benchmarkStep(const long numberOfIterations,
+                   const StateDerivative& computeStateDerivative,
+                   std::true_type)
+{
+    Stepper stepper;
+    double time = 0.0;
+    typename Model::State state = Model::getInitialState();
+    for (long i = 0; i < numberOfIterations; ++i)
+    {
+        double stepSize = 1.0e-3;
+        stepper.step(time, state, stepSize, computeStateDerivative, 1.0e-6, 1.0e-12, 1.0);
+    }
+    doNotOptimize(state[0]);
+}
+
+//! Register benchmarks of given stepper for given model, for all types of callables.
+template <template <typename, typename> class Stepper, typename Model, bool IsAdaptive>
+void registerModelBenchmarks(const std::string& stepperName, const std::string& modelName)
+{
+    typedef typename Model::State State;
+    typedef Stepper<double, State> ModelStepper;
+    typedef std::integral_constant<bool, IsAdaptive> IsAdaptiveType;
+
+    const std::string prefix = "steppers/" + stepperName + "/"
+                               + (IsAdaptive ? "adaptive/" : "fixed/") + modelName + "/";
+    const std::function<void(const double, const State&, State&)> stdFunction = Model();
+    const StateDerivativeFunction<double, State> stateDerivativeFunction
+        = [](const double time, const State& state)
+    {
+        State stateDerivative = state;
+        Model()(time, state, stateDerivative);
+        return stateDerivative;
+    };
+
+    registerBenchmark(prefix + "inlined", [](const long numberOfIterations)
+    {
+        benchmarkStep<ModelStepper, Model>(numberOfIterations, Model(), IsAdaptiveType());
+    });
+    registerBenchmark(prefix + "stdFunction", [stdFunction](const long numberOfIterations)
+    {
+        benchmarkStep<ModelStepper, Model>(numberOfIterations, stdFunction, IsAdaptiveType());
+    });
+    registerBenchmark(prefix + "StateDerivativeFunction",
+                      [stateDerivativeFunction](const long numberOfIterations)
+    {
+        benchmarkStep<ModelStepper, Model>(numberOfIterations, stateDerivativeFunction,
+                                           IsAdaptiveType());
+    });
+}
+
+//! Register benchmarks of given stepper for all models.
+template <template <typename, typename> class Stepper, bool IsAdaptive>
+void registerStepperBenchmarks(const std::string& stepperName)
+{
+    registerModelBenchmarks<Stepper, Oscillator, IsAdaptive>(stepperName, "oscillator");
+    registerModelBenchmarks<Stepper, NBody, IsAdaptive>(stepperName, "nBody");
+    registerModelBenchmarks<Stepper, Heat, IsAdaptive>(stepperName, "heat");
+}
+
+// The stepper aliases have a defaulted statistics parameter, so they are wrapped in aliases with
+// exactly two parameters to be passed as template template arguments.
+template <typename Real, typename State>
+using EulerBenchmarkStepper = EulerStepper<Real, State>;
+template <typename Real, typename State>
+using RK4BenchmarkStepper = RK4Stepper<Real, State>;
+template <typename Real, typename State>
+using RKF45BenchmarkStepper = RKF45Stepper<Real, State>;
+template <typename Real, typename State>
+using RKF78BenchmarkStepper = RKF78Stepper<Real, State>;
+template <typename Real, typename State>
+using DOPRI5BenchmarkStepper = DOPRI5Stepper<Real, State>;
+
+//! Register benchmarks of all steppers.
+bool registerSteppersBenchmarks()
+{
+    registerStepperBenchmarks<EulerBenchmarkStepper, false>("euler");
+    registerStepperBenchmarks<RK4BenchmarkStepper, false>("rk4");
+    registerStepperBenchmarks<RKF45BenchmarkStepper, false>("rkf45");
+    registerStepperBenchmarks<RKF78BenchmarkStepper, false>("rkf78");
+    registerStepperBenchmarks<DOPRI5BenchmarkStepper, false>("dopri5");
+
+    // Adaptive step size control is only available for the embedded schemes.
+    registerStepperBenchmarks<RKF45BenchmarkStepper, true>("rkf45");
+    registerStepperBenchmarks<RKF78BenchmarkStepper, true>("rkf78");
+    registerStepperBenchmarks<DOPRI5BenchmarkStepper, true>("dopri5");
+    return true;
+}
+
+const bool isSteppersBenchmarkRegistered = registerSteppersBenchmarks();
+
+} // namespace
+} // namespace benchmarks
+} // namespace integrate
@@ -0,0 +1,121 @@
+/*
+ * Copyright (c) 2014-2025 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+// Benchmarks the cost of long-horizon orbit propagation with the symplectic integrators against
+// RKF78. One iteration propagates a Kepler orbit (unit gravitational parameter and semi-major
+// axis, eccentricity 0.5) over one revolution, continuing from the end of the previous
+// revolution, so that the cost per revolution over a long horizon is measured. The symplectic
+// integrators take 128 fixed steps per revolution; RKF78 takes adaptive steps with a tolerance of
+// 1e-10. The energy error of these settings over a long horizon is generated by the
+// integrate_energy_error application. The benchmark names are "symplectic/<stepper>/kepler".
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <string>
+
+#include "integrate/forestRuth.hpp"
+#include "integrate/rkf78.hpp"
+#include "integrate/velocityVerlet.hpp"
+#include "integrate/yoshida.hpp"
+
+#include "benchmark.hpp"
+
+namespace integrate
+{
+namespace benchmarks
+{
+namespace
+{
+
+typedef std::array<double, 2> KeplerVector;
+typedef std::array<double, 4> KeplerState;
+
+const double keplerPeriod = 2.0 * 3.14159265358979323846;
+const double keplerEccentricity = 0.5;
+const int numberOfStepsPerRevolution = 128;
+
+//! Compute acceleration of Kepler orbit.
+void computeKeplerAcceleration(const double,
+                               const KeplerVector& position,
+                               KeplerVector& acceleration)
+{
+    const double radiusSquared = position[0] * position[0] + position[1] * position[1];
+    const double factor = -1.0 / (radiusSquared * std::sqrt(radiusSquared));
+    acceleration[0] = factor * position[0];
+    acceleration[1] = factor * position[1];
+}
+
+//! Compute state derivative of Kepler orbit.
+void computeKeplerStateDerivative(const double,
+                                  const KeplerState& state,
+                                  KeplerState& stateDerivative)
+{
+    const double radiusSquared = state[0] * state[0] + state[1] * state[1];
+    const double factor = -1.0 / (radiusSquared * std::sqrt(radiusSquared));
+    stateDerivative[0] = state[2];
+    stateDerivative[1] = state[3];
+    stateDerivative[2] = factor * state[0];
+    stateDerivative[3] = factor * state[1];
+}
+
+//! Benchmark revolutions of Kepler orbit with given symplectic stepper.
+template <typename Stepper>
+void benchmarkSymplecticRevolutions(const long numberOfIterations)
+{
+    Stepper stepper;
+    double time = 0.0;
+    KeplerVector position = {{1.0 - keplerEccentricity, 0.0}};
+    KeplerVector velocity
+        = {{0.0, std::sqrt((1.0 + keplerEccentricity) / (1.0 - keplerEccentricity))}};
+    const double stepSize = keplerPeriod / numberOfStepsPerRevolution;
+    for (long i = 0; i < numberOfIterations * numberOfStepsPerRevolution; ++i)
+    {
+        stepper.step(time, position, velocity, stepSize, &computeKeplerAcceleration);
+    }
+    doNotOptimize(position[0]);
+}
+
+//! Benchmark revolutions of Kepler orbit with RKF78 with adaptive step size.
+void benchmarkRKF78Revolutions(const long numberOfIterations)
+{
+    RKF78Stepper<double, KeplerState> stepper;
+    double time = 0.0;
+    KeplerState state = {{1.0 - keplerEccentricity, 0.0,
+                          0.0, std::sqrt((1.0 + keplerEccentricity) / (1.0 - keplerEccentricity))}};
+    double stepSize = 1.0e-3 * keplerPeriod;
+    const double finalTime = numberOfIterations * keplerPeriod;
+    while (time < finalTime)
+    {
+        double currentStepSize = std::min(stepSize, finalTime - time);
+        stepper.step(time, state, currentStepSize, &computeKeplerStateDerivative, 1.0e-10,
+                     1.0e-12 * keplerPeriod, keplerPeriod);
+        stepSize = currentStepSize;
+    }
+    doNotOptimize(state[0]);
+}
+
+typedef VelocityVerletStepper<double, KeplerVector> KeplerVelocityVerletStepper;
+typedef ForestRuthStepper<double, KeplerVector> KeplerForestRuthStepper;
+typedef Yoshida4Stepper<double, KeplerVector> KeplerYoshida4Stepper;
+typedef Yoshida6Stepper<double, KeplerVector> KeplerYoshida6Stepper;
+typedef Yoshida8Stepper<double, KeplerVector> KeplerYoshida8Stepper;
+
+INTEGRATE_BENCHMARK("symplectic/velocityVerlet/kepler",
+                    &benchmarkSymplecticRevolutions<KeplerVelocityVerletStepper>);
+INTEGRATE_BENCHMARK("symplectic/forestRuth/kepler",
+                    &benchmarkSymplecticRevolutions<KeplerForestRuthStepper>);
+INTEGRATE_BENCHMARK("symplectic/yoshida4/kepler",
+                    &benchmarkSymplecticRevolutions<KeplerYoshida4Stepper>);
+INTEGRATE_BENCHMARK("symplectic/yoshida6/kepler",
+                    &benchmarkSymplecticRevolutions<KeplerYoshida6Stepper>);
+INTEGRATE_BENCHMARK("symplectic/yoshida8/kepler",
+                    &benchmarkSymplecticRevolutions<KeplerYoshida8Stepper>);
+INTEGRATE_BENCHMARK("symplectic/rkf78/kepler", &benchmarkRKF78Revolutions);
+
+} // namespace
+} // namespace benchmarks
+} // namespace integrate
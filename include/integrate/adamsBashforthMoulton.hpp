@@ -0,0 +1,638 @@
+/*
+ * Copyright (c) 2014-2025 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "integrate/linearCombination.hpp"
+#include "integrate/rkf78.hpp"
+#include "integrate/stateDerivative.hpp"
+#include "integrate/statistics.hpp"
+#include "integrate/stepSizeControl.hpp"
+
+namespace integrate
+{
+namespace detail
+{
+
+//! Compute Adams integration weights for given interpolation nodes.
+/*!
+ * Computes the weights w_j = int_0^1 L_j(s) ds of the Lagrange basis polynomials L_j for the
+ * given nodes s_j, which are expressed in units of the step size relative to the start of the
+ * step, so that int_t^(t+h) p(t') dt' = h sum_j w_j p(t + s_j h) for every polynomial p of degree
+ * less than the number of nodes.
+ */
+template <typename Real>
+inline void computeAdamsWeights(const Real* const nodes,
+                                const int numberOfNodes,
+                                Real* const polynomial,
+                                Real* const weights)
+{
+    for (int j = 0; j < numberOfNodes; ++j)
+    {
+        // Expand L_j(s) = prod_(i != j) (s - s_i) / (s_j - s_i) in monomials.
+        polynomial[0] = 1.0;
+        int degree = 0;
+        for (int i = 0; i < numberOfNodes; ++i)
+        {
+            if (i == j)
+            {
+                continue;
+            }
+
+            const Real scale = 1.0 / (nodes[j] - nodes[i]);
+            polynomial[degree + 1] = 0.0;
+            for (int l = degree + 1; l > 0; --l)
+            {
+                polynomial[l] = (polynomial[l - 1] - nodes[i] * polynomial[l]) * scale;
+            }
+            polynomial[0] = -nodes[i] * polynomial[0] * scale;
+            ++degree;
+        }
+
+        Real weight = 0.0;
+        for (int l = 0; l <= degree; ++l)
+        {
+            weight += polynomial[l] / (l + 1);
+        }
+        weights[j] = weight;
+    }
+}
+
+} // namespace detail
+
+//! Variable-step, variable-order Adams-Bashforth-Moulton stepper.
+/*!
+ * Stepper that executes integration steps using the Adams-Bashforth-Moulton predictor-corrector
+ * scheme in PECE mode (Hairer et al., 1993, Section III.5). For order k, the Adams-Bashforth
+ * predictor of order k extrapolates the state derivatives at the last k accepted steps, the state
+ * derivative is evaluated at the predicted state, and the Adams-Moulton corrector of order k + 1
+ * interpolates the predicted state derivative and the last k state derivatives. The state
+ * derivative at the corrected state is then evaluated for the history, so that an accepted step
+ * costs two state derivative evaluations, independent of the order, compared to thirteen for
+ * RKF78. The scheme is therefore well-suited for smooth trajectories with expensive dynamical
+ * models.
+ *
+ * The integration weights are computed for the actual times in the history on every step (in
+ * Lagrange form), so that the step size can change on every step. The difference between the
+ * corrected and predicted states estimates the local truncation error of the predictor, which
+ * controls the step size as for the embedded Runge-Kutta schemes. The errors of orders k - 1 and
+ * k + 1 are estimated in the same way, without additional evaluations, and the order that allows
+ * the largest next step is selected, between 1 and the maximum order.
+ *
+ * The state derivatives of the accepted steps are kept in a ring buffer. If a step does not start
+ * from the time and state at which the previous step ended, e.g., at the first step or after an
+ * impulsive change of the state, the history is discarded and the stepper starts up again with
+ * adaptive RKF78 steps (see RKF78Stepper) until the history contains enough state derivatives for
+ * the starting order. The state derivative evaluations and accepted steps of the starting steps
+ * are recorded in the statistics of this stepper, but their rejected attempts are not.
+ *
+ * @tparam  Real        Type for floating-point number
+ * @tparam  State       Type for state and state derivative
+ * @tparam  Statistics  Statistics policy, e.g., NullStatistics or IntegrationStatistics
+ */
+template <typename Real, typename State, typename Statistics = NullStatistics>
+class AdamsBashforthMoultonStepper
+{
+public:
+
+    //! Construct stepper.
+    /*!
+     * Constructs stepper.
+     *
+     * @throws std::invalid_argument  If maximum order is smaller than 1
+     *
+     * @param[in]  maximumOrder  Maximum order of the Adams-Bashforth predictor
+     */
+    explicit AdamsBashforthMoultonStepper(const int maximumOrder = 12)
+        : maximumOrder(maximumOrder),
+          order(0),
+          historySize(0),
+          newestIndex(0),
+          historyCapacity(maximumOrder + 1)
+    {
+        if (maximumOrder < 1)
+        {
+            throw std::invalid_argument("Maximum order must be at least 1!");
+        }
+    }
+
+    //! Execute single integration step with adaptive step size.
+    /*!
+     * Executes single numerical integration step with adaptive step size and order control. If
+     * the maximum norm of the error estimate exceeds the tolerance times the step size, the step
+     * is rejected and repeated with a smaller step size, until it is accepted. The step size is
+     * scaled by the elementary controller, as for the adaptive step function of
+     * ExplicitRungeKuttaStepper that takes a tolerance.
+     *
+     * @throws std::runtime_error  If a rejected step has to be repeated with a step size that is
+     *                             smaller than the minimum step size
+     *
+     * @tparam         StateDerivative         Type of callable to compute state derivative, e.g.,
+     *                                         function pointer, functor, lambda or
+     *                                         StateDerivativeFunction
+     * @param[in,out]  time                    Independent variable, which is provided as input and
+     *                                         is updated with output at end of integration step
+     * @param[in,out]  state                   State, which is provided as input and is updated
+     *                                         with output at end of integration step
+     * @param[in,out]  stepSize                Step size to take for integration step, which is
+     *                                         updated with step size for next integration step
+     * @param[in]      computeStateDerivative  Function to compute state derivative for current
+     *                                         time and state
+     * @param[in]      tolerance               Local truncation error tolerance
+     * @param[in]      minimumStepSize         Minimum allowable step size for integration step
+     * @param[in]      maximumStepSize         Maximum allowable step size for integration step
+     */
+    template <typename StateDerivative>
+    void step(Real& time,
+              State& state,
+              Real& stepSize,
+              const StateDerivative& computeStateDerivative,
+              const Real tolerance,
+              const Real minimumStepSize,
+              const Real maximumStepSize)
+    {
+        StepSizeController<Real> elementaryController(1.0, 0.0, 0.0, 0.84, 0.1, 4.0);
+        stepAdaptive(time, state, stepSize, computeStateDerivative,
+                     detail::ErrorPerUnitStepNorm<Real>(tolerance), elementaryController, 0,
+                     minimumStepSize, maximumStepSize);
+    }
+
+    //! Execute single integration step with adaptive step size, error norm and controller.
+    /*!
+     * Executes single numerical integration step with adaptive step size and order control, based
+     * on the scaled error of the error estimate, as computed by the given error norm, e.g.,
+     * WeightedRootMeanSquareErrorNorm. See the corresponding adaptive step function of
+     * ExplicitRungeKuttaStepper for details. The starting steps use the same error norm and
+     * controller.
+     *
+     * @throws std::runtime_error  If a rejected step has to be repeated with a step size that is
+     *                             smaller than the minimum step size
+     *
+     * @tparam         StateDerivative         Type of callable to compute state derivative, e.g.,
+     *                                         function pointer, functor, lambda or
+     *                                         StateDerivativeFunction
+     * @tparam         ErrorNorm               Type of callable to compute scaled error, e.g.,
+     *                                         WeightedRootMeanSquareErrorNorm
+     * @param[in,out]  time                    Independent variable, which is provided as input and
+     *                                         is updated with output at end of integration step
+     * @param[in,out]  state                   State, which is provided as input and is updated
+     *                                         with output at end of integration step
+     * @param[in,out]  stepSize                Step size to take for integration step, which is
+     *                                         updated with step size for next integration step
+     * @param[in]      computeStateDerivative  Function to compute state derivative for current
+     *                                         time and state
+     * @param[in]      computeError            Function to compute scaled error of error estimate
+     * @param[in,out]  controller              Step size controller, which is updated with scaled
+     *                                         error of accepted step
+     * @param[in]      minimumStepSize         Minimum allowable step size for integration step
+     * @param[in]      maximumStepSize         Maximum allowable step size for integration step
+     */
+    template <typename StateDerivative, typename ErrorNorm>
+    void step(Real& time,
+              State& state,
+              Real& stepSize,
+              const StateDerivative& computeStateDerivative,
+              const ErrorNorm& computeError,
+              StepSizeController<Real>& controller,
+              const Real minimumStepSize,
+              const Real maximumStepSize)
+    {
+        stepAdaptive(time, state, stepSize, computeStateDerivative, computeError, controller, 1,
+                     minimumStepSize, maximumStepSize);
+    }
+
+    //! Reset stepper.
+    /*!
+     * Discards the history of state derivatives, so that the next step starts up again, e.g.,
+     * because the dynamical model has changed between steps.
+     */
+    void reset()
+    {
+        historySize = 0;
+        order = 0;
+    }
+
+    //! Write history and statistics to checkpoint.
+    /*!
+     * Writes the order, the history of times and state derivatives, and the statistics to the
+     * given checkpoint (see Checkpoint). The state at the end of the last accepted step is not
+     * written, since it is the state of the integration.
+     *
+     * @tparam      Checkpoint  Type of checkpoint, e.g., Checkpoint
+     * @param[out]  checkpoint  Checkpoint to which stepper is written
+     */
+    template <typename Checkpoint>
+    void writeCheckpoint(Checkpoint& checkpoint) const
+    {
+        checkpoint.write(order);
+        checkpoint.write(historySize);
+        for (int age = historySize - 1; age >= 0; --age)
+        {
+            checkpoint.write(times[getHistoryIndex(age)]);
+            checkpoint.writeState(stateDerivatives[getHistoryIndex(age)]);
+        }
+        statistics.writeCheckpoint(checkpoint);
+    }
+
+    //! Read history and statistics from checkpoint.
+    /*!
+     * Reads the data written by writeCheckpoint() from the given checkpoint. The history
+     * continues from the given state, which is the state of the integration.
+     *
+     * @throws std::runtime_error  If checkpoint does not contain data of stepper, or if its
+     *                             history does not fit the maximum order
+     *
+     * @tparam         Checkpoint  Type of checkpoint, e.g., Checkpoint
+     * @param[in,out]  checkpoint  Checkpoint from which stepper is read
+     * @param[in]      state       State of the integration
+     */
+    template <typename Checkpoint>
+    void readCheckpoint(Checkpoint& checkpoint, const State& state)
+    {
+        checkpoint.read(order);
+        checkpoint.read(historySize);
+        if (historySize < 0 || historySize > historyCapacity || order < 0 || order > maximumOrder)
+        {
+            historySize = 0;
+            order = 0;
+            throw std::runtime_error("Checkpoint does not match stepper!");
+        }
+        allocate(state);
+        newestIndex = historySize > 0 ? historySize - 1 : 0;
+        for (int age = historySize - 1; age >= 0; --age)
+        {
+            checkpoint.read(times[getHistoryIndex(age)]);
+            checkpoint.readState(stateDerivatives[getHistoryIndex(age)]);
+        }
+        workspace[lastStateIndex] = state;
+        statistics.readCheckpoint(checkpoint);
+    }
+
+    //! Get order of the Adams-Bashforth predictor for next step (0 if stepper starts up).
+    int getOrder() const { return order; }
+
+    //! Get statistics collected by stepper.
+    const Statistics& getStatistics() const { return statistics; }
+
+    //! Get statistics collected by stepper, e.g., to reset them.
+    Statistics& getStatistics() { return statistics; }
+
+protected:
+private:
+
+    //! Order of the Adams-Bashforth predictor at which the starting steps end.
+    static const int startingOrder = 4;
+
+    //! Index of state at end of last accepted step in workspace.
+    static const int lastStateIndex = 0;
+
+    //! Index of predicted state in workspace.
+    static const int predictedStateIndex = 1;
+
+    //! Index of state derivative at predicted state in workspace.
+    static const int predictedStateDerivativeIndex = 2;
+
+    //! Index of corrected state in workspace, which is computed before a step is accepted.
+    static const int nextStateIndex = 3;
+
+    //! Index of error estimate in workspace.
+    static const int errorEstimateIndex = 4;
+
+    //! Execute single integration step with adaptive step size and order control.
+    /*!
+     * Executes single integration step. The step size controller uses exponent 1 / (j + offset)
+     * for the error estimate of order j, i.e., offset 0 for errors per unit step and offset 1 for
+     * errors per step.
+     */
+    template <typename StateDerivative, typename ErrorNorm>
+    void stepAdaptive(Real& time,
+                      State& state,
+                      Real& stepSize,
+                      const StateDerivative& computeStateDerivative,
+                      const ErrorNorm& computeError,
+                      StepSizeController<Real>& controller,
+                      const int errorEstimateOrderOffset,
+                      const Real minimumStepSize,
+                      const Real maximumStepSize)
+    {
+        statistics.startStep();
+        const detail::RecordedStateDerivative<Real, State, StateDerivative, Statistics>
+            recordedStateDerivative(computeStateDerivative, statistics);
+
+        if (!isHistoryValid(time, state))
+        {
+            startUp(time, state, recordedStateDerivative);
+        }
+
+        if (historySize < startingOrder && historySize < maximumOrder)
+        {
+            const Real startTime = time;
+            try
+            {
+                starter.step(time, state, stepSize, recordedStateDerivative, computeError,
+                             controller, minimumStepSize, maximumStepSize);
+            }
+            catch (...)
+            {
+                statistics.stopStep();
+                throw;
+            }
+            statistics.recordAcceptedStep(time - startTime);
+            addToHistory(time, state, recordedStateDerivative);
+            order = std::min(historySize, maximumOrder);
+            statistics.stopStep();
+            return;
+        }
+
+        State& predictedState = workspace[predictedStateIndex];
+        State& predictedStateDerivative = workspace[predictedStateDerivativeIndex];
+        State& nextState = workspace[nextStateIndex];
+        const State& errorEstimate = workspace[errorEstimateIndex];
+        while (true)
+        {
+            // Predict (P), evaluate (E) and correct (C); the error estimate is the difference
+            // between the corrected and predicted states.
+            computeWeights(stepSize, order);
+            computeAdamsCombination(predictedState, state, stepSize, order, false);
+            recordedStateDerivative(time + stepSize, predictedState, predictedStateDerivative);
+            computeAdamsCombination(nextState, state, stepSize, order, true);
+            computeAdamsErrorEstimate(stepSize, order);
+            const Real error = computeError(errorEstimate, state, nextState, stepSize);
+            const bool isAccepted = error <= 1.0;
+
+            // Select order for next attempt or step that allows the largest step size.
+            int nextOrder = order;
+            Real nextError = error;
+            if (order > 1)
+            {
+                computeWeights(stepSize, order - 1);
+                computeAdamsErrorEstimate(stepSize, order - 1);
+                const Real lowerOrderError
+                    = computeError(errorEstimate, state, nextState, stepSize);
+                if (isHigherStepSizeFactor(lowerOrderError, order - 1, error, order,
+                                           errorEstimateOrderOffset))
+                {
+                    nextOrder = order - 1;
+                    nextError = lowerOrderError;
+                }
+            }
+            if (isAccepted && nextOrder == order && order < maximumOrder && historySize > order)
+            {
+                computeWeights(stepSize, order + 1);
+                computeAdamsErrorEstimate(stepSize, order + 1);
+                const Real higherOrderError
+                    = computeError(errorEstimate, state, nextState, stepSize);
+                if (isHigherStepSizeFactor(higherOrderError, order + 1, error, order,
+                                           errorEstimateOrderOffset))
+                {
+                    nextOrder = order + 1;
+                    nextError = higherOrderError;
+                }
+            }
+
+            const Real stepSizeFactor = controller.computeStepSizeFactor(
+                nextError, nextOrder + errorEstimateOrderOffset, isAccepted);
+            order = nextOrder;
+
+            if (isAccepted)
+            {
+                statistics.recordAcceptedStep(stepSize);
+                time += stepSize;
+                using std::swap;
+                swap(state, nextState);
+                addToHistory(time, state, recordedStateDerivative);
+
+                stepSize = stepSizeFactor * stepSize;
+                if (stepSize > maximumStepSize)
+                {
+                    stepSize = maximumStepSize;
+                }
+                else if (stepSize < minimumStepSize)
+                {
+                    stepSize = minimumStepSize;
+                }
+                statistics.stopStep();
+                return;
+            }
+
+            statistics.recordRejectedStep(stepSize);
+            stepSize = stepSizeFactor * stepSize;
+            if (stepSize > maximumStepSize)
+            {
+                stepSize = maximumStepSize;
+            }
+            else if (stepSize < minimumStepSize)
+            {
+                statistics.stopStep();
+                throw std::runtime_error("Minimum step size exceeded!");
+            }
+        }
+    }
+
+    //! Check if history continues from given time and state.
+    bool isHistoryValid(const Real time, const State& state) const
+    {
+        return historySize > 0
+               && time == times[newestIndex]
+               && detail::isEqualState(
+                   state, workspace[lastStateIndex],
+                   std::integral_constant<bool, StateTraits<State>::isIndexable>());
+    }
+
+    //! Discard history and start new history at given time and state.
+    template <typename RecordedStateDerivative>
+    void startUp(const Real time,
+                 const State& state,
+                 const RecordedStateDerivative& recordedStateDerivative)
+    {
+        allocate(state);
+        historySize = 0;
+        order = 0;
+        addToHistory(time, state, recordedStateDerivative);
+    }
+
+    //! Allocate history and workspace for states of given size, unless they are allocated.
+    /*!
+     * Allocates the history and workspace again if the number of elements of the state has
+     * changed, since state derivatives may be written in-place.
+     */
+    void allocate(const State& state)
+    {
+        if (stateDerivatives.empty()
+            || !detail::hasSameSize(stateDerivatives[0], state,
+                                    typename detail::StateTag<State>::type()))
+        {
+            stateDerivatives.assign(historyCapacity, state);
+            times.assign(historyCapacity, 0.0);
+            workspace.assign(5, state);
+            nodes.resize(maximumOrder + 2);
+            polynomial.resize(maximumOrder + 2);
+            predictorWeights.resize(maximumOrder + 2);
+            correctorWeights.resize(maximumOrder + 2);
+            coefficients.resize(maximumOrder + 2);
+            terms.resize(maximumOrder + 2);
+        }
+    }
+
+    //! Evaluate state derivative at given time and state, and add it to history.
+    template <typename RecordedStateDerivative>
+    void addToHistory(const Real time,
+                      const State& state,
+                      const RecordedStateDerivative& recordedStateDerivative)
+    {
+        newestIndex = (newestIndex + 1) % historyCapacity;
+        recordedStateDerivative(time, state, stateDerivatives[newestIndex]);
+        times[newestIndex] = time;
+        workspace[lastStateIndex] = state;
+        if (historySize < historyCapacity)
+        {
+            ++historySize;
+        }
+    }
+
+    //! Get index in ring buffer of history entry with given age (0 for newest entry).
+    int getHistoryIndex(const int age) const
+    {
+        return (newestIndex - age + historyCapacity) % historyCapacity;
+    }
+
+    //! Compute Adams-Bashforth weights of given order, and Adams-Moulton weights of order + 1.
+    /*!
+     * Computes Adams-Bashforth weights for the newest order entries in the history, and
+     * Adams-Moulton weights for the predicted state derivative at the end of the step (first
+     * weight) and the newest order entries in the history.
+     */
+    void computeWeights(const Real stepSize, const int adamsOrder)
+    {
+        const Real currentTime = times[newestIndex];
+        nodes[0] = 1.0;
+        for (int age = 0; age < adamsOrder; ++age)
+        {
+            nodes[age + 1] = (times[getHistoryIndex(age)] - currentTime) / stepSize;
+        }
+        detail::computeAdamsWeights(&nodes[1], adamsOrder, polynomial.data(),
+                                    predictorWeights.data());
+        detail::computeAdamsWeights(nodes.data(), adamsOrder + 1, polynomial.data(),
+                                    correctorWeights.data());
+    }
+
+    //! Compute predicted state (Adams-Bashforth) or corrected state (Adams-Moulton).
+    /*!
+     * Computes predicted or corrected state with the weights of given order, which must have been
+     * computed with computeWeights().
+     */
+    void computeAdamsCombination(State& result,
+                                 const State& state,
+                                 const Real stepSize,
+                                 const int adamsOrder,
+                                 const bool isCorrector)
+    {
+        int numberOfTerms = 0;
+        if (isCorrector)
+        {
+            coefficients[numberOfTerms] = correctorWeights[0];
+            terms[numberOfTerms] = &workspace[predictedStateDerivativeIndex];
+            ++numberOfTerms;
+        }
+        for (int age = 0; age < adamsOrder; ++age)
+        {
+            coefficients[numberOfTerms]
+                = isCorrector ? correctorWeights[age + 1] : predictorWeights[age];
+            terms[numberOfTerms] = &stateDerivatives[getHistoryIndex(age)];
+            ++numberOfTerms;
+        }
+        detail::computeLinearCombination<Real, State>(
+            result, &state, stepSize, coefficients.data(), terms.data(),
+            static_cast<std::size_t>(numberOfTerms), typename detail::StateTag<State>::type());
+    }
+
+    //! Compute error estimate of given order, i.e., corrector of order + 1 minus predictor.
+    /*!
+     * Computes error estimate with the weights of given order, which must have been computed with
+     * computeWeights().
+     */
+    void computeAdamsErrorEstimate(const Real stepSize, const int adamsOrder)
+    {
+        coefficients[0] = correctorWeights[0];
+        terms[0] = &workspace[predictedStateDerivativeIndex];
+        for (int age = 0; age < adamsOrder; ++age)
+        {
+            coefficients[age + 1] = correctorWeights[age + 1] - predictorWeights[age];
+            terms[age + 1] = &stateDerivatives[getHistoryIndex(age)];
+        }
+        detail::computeLinearCombination<Real, State>(
+            workspace[errorEstimateIndex], nullptr, stepSize, coefficients.data(), terms.data(),
+            static_cast<std::size_t>(adamsOrder + 1), typename detail::StateTag<State>::type());
+    }
+
+    //! Check if error of candidate order allows a larger step size than error of current order.
+    static bool isHigherStepSizeFactor(const Real candidateError,
+                                       const int candidateOrder,
+                                       const Real error,
+                                       const int currentOrder,
+                                       const int errorEstimateOrderOffset)
+    {
+        return std::pow(candidateError, -1.0 / (candidateOrder + errorEstimateOrderOffset))
+               > std::pow(error, -1.0 / (currentOrder + errorEstimateOrderOffset));
+    }
+
+    //! Maximum order of the Adams-Bashforth predictor.
+    int maximumOrder;
+
+    //! Order of the Adams-Bashforth predictor for next step.
+    int order;
+
+    //! Number of state derivatives in history.
+    int historySize;
+
+    //! Index of newest state derivative in ring buffer.
+    int newestIndex;
+
+    //! Capacity of ring buffer.
+    int historyCapacity;
+
+    //! Ring buffer of state derivatives of accepted steps.
+    std::vector<State> stateDerivatives;
+
+    //! Ring buffer of times of accepted steps.
+    std::vector<Real> times;
+
+    //! Storage for last, predicted and corrected states, and for predicted state derivative.
+    std::vector<State> workspace;
+
+    //! Interpolation nodes, in units of the step size relative to the start of the step.
+    std::vector<Real> nodes;
+
+    //! Storage for coefficients of Lagrange basis polynomial.
+    std::vector<Real> polynomial;
+
+    //! Adams-Bashforth weights.
+    std::vector<Real> predictorWeights;
+
+    //! Adams-Moulton weights.
+    std::vector<Real> correctorWeights;
+
+    //! Coefficients of linear combination of state derivatives.
+    std::vector<Real> coefficients;
+
+    //! State derivatives of linear combination.
+    std::vector<const State*> terms;
+
+    //! Stepper for starting steps.
+    RKF78Stepper<Real, State> starter;
+
+    //! Statistics collected by stepper.
+    Statistics statistics;
+};
+
+} // namespace integrate
@@ -0,0 +1,935 @@
+/*
+ * Copyright (c) 2014-2025 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "integrate/gmres.hpp"
+#include "integrate/linearCombination.hpp"
+#include "integrate/stateDerivative.hpp"
+#include "integrate/stateNorm.hpp"
+#include "integrate/statistics.hpp"
+#include "integrate/stepSizeControl.hpp"
+
+namespace integrate
+{
+namespace detail
+{
+
+//! Preconditioner that leaves states unchanged, i.e., unpreconditioned Newton-Krylov iterations.
+struct IdentityPreconditioner
+{
+    //! Copy given state to result.
+    template <typename Real, typename State>
+    void operator()(const Real, const State&, const Real, const State& vector, State& result) const
+    {
+        result = vector;
+    }
+};
+
+} // namespace detail
+
+//! Variable-step, variable-order BDF stepper with matrix-free Newton-Krylov iterations.
+/*!
+ * Stepper that executes integration steps using the backward differentiation formulas (BDF) of
+ * orders 1 to 5 (Hairer & Wanner, 1996, Section III.1), for stiff systems that are too large for
+ * dense Jacobians, e.g., method-of-lines discretizations of partial differential equations. For
+ * order k, the implicit equation
+ *
+ *      y_{n+1} = psi + gamma f(t_{n+1}, y_{n+1})
+ *
+ * where psi and gamma = h / alpha_0 follow from the derivative of the interpolation polynomial
+ * through y_{n+1} and the last k accepted states, is solved with an inexact Newton method, starting
+ * from the extrapolation of the last k + 1 accepted states. The linear system of each Newton
+ * iteration, (I - gamma J) delta = r, is solved with restarted GMRES (see detail::GMRESSolver), in
+ * which the products with the Jacobian J are approximated with forward differences
+ *
+ *      J v ~ (f(t, y + sigma v) - f(t, y)) / sigma,   sigma = sqrt(epsilon) (1 + |y|) / |v|
+ *
+ * so that the Jacobian is never formed, at the cost of one state derivative evaluation per GMRES
+ * iteration (Brown & Hindmarsh, 1986). The memory of the stepper therefore grows linearly with
+ * the size of the state: it keeps the last maximumOrder + 1 accepted states, the Krylov basis of
+ * krylovDimension + 1 states and a fixed number of work states.
+ *
+ * The convergence of GMRES depends on the conditioning of I - gamma J, so an optional
+ * preconditioner can be given, i.e.,
+ * void applyPreconditioner(const Real time, const State& state, const Real gamma,
+ *                          const State& vector, State& result),
+ * which writes an approximation of (I - gamma J)^{-1} vector to result, e.g., the inverse of the
+ * diagonal of I - gamma J. The Newton iterations are stopped once the estimated error of the
+ * iterate, measured with the error norm of the step, is below 0.1, and the step is repeated with a
+ * quarter of the step size if they diverge or do not converge within four iterations.
+ *
+ * The difference between the converged and predicted states, divided by k + 1, estimates the
+ * local truncation error, which controls the step size as for the embedded Runge-Kutta schemes.
+ * After k + 1 steps at order k, the errors of orders k - 1 and k + 1 are estimated from divided
+ * differences of the accepted states, and the order that allows the largest next step is
+ * selected, with a bias towards the current order (Shampine & Reichelt, 1997). Since the variable
+ * step formulas of higher order are only stable for moderate changes of the step size, the step
+ * size is at most doubled per step.
+ *
+ * If a step does not start from the time and state at which the previous step ended, e.g., at
+ * the first step or after an impulsive change of the state, the history is discarded and the
+ * stepper starts up again at order 1, with the explicit Euler step as predictor.
+ *
+ * The state must be indexable or contiguous (see StateTraits).
+ *
+ * @tparam  Real        Type for floating-point number
+ * @tparam  State       Type for state and state derivative
+ * @tparam  Statistics  Statistics policy, e.g., NullStatistics or IntegrationStatistics
+ */
+template <typename Real, typename State, typename Statistics = NullStatistics>
+class BDFStepper
+{
+public:
+
+    static_assert(StateTraits<State>::isIndexable || StateTraits<State>::isContiguous,
+                  "BDF steppers require indexable or contiguous states (see StateTraits)");
+
+    //! Construct stepper.
+    /*!
+     * Constructs stepper.
+     *
+     * @throws std::invalid_argument  If maximum order is not between 1 and 5, or if Krylov
+     *                                subspace dimension is smaller than 1
+     *
+     * @param[in]  maximumOrder     Maximum order of the backward differentiation formulas
+     * @param[in]  krylovDimension  Dimension of Krylov subspace after which GMRES is restarted
+     */
+    explicit BDFStepper(const int maximumOrder = 5, const int krylovDimension = 20)
+        : maximumOrder(maximumOrder),
+          order(0),
+          numberOfStepsAtOrder(0),
+          historySize(0),
+          newestIndex(0),
+          historyCapacity(maximumOrder + 1),
+          krylovDimension(krylovDimension),
+          previousConvergenceRate(1.0),
+          numberOfNewtonIterations(0),
+          numberOfLinearIterations(0),
+          linearSolver(krylovDimension)
+    {
+        if (maximumOrder < 1 || maximumOrder > 5)
+        {
+            throw std::invalid_argument("Maximum order must be between 1 and 5!");
+        }
+    }
+
+    //! Execute single integration step with adaptive step size and order control.
+    /*!
+     * Executes single numerical integration step with adaptive step size and order control,
+     * without preconditioner. If the maximum norm of the error estimate exceeds the tolerance
+     * times the step size, the step is rejected and repeated with a smaller step size, until it
+     * is accepted. The step size is scaled by the elementary controller, as for the adaptive step
+     * function of ExplicitRungeKuttaStepper that takes a tolerance.
+     *
+     * @throws std::runtime_error  If a rejected step has to be repeated with a step size that is
+     *                             smaller than the minimum step size
+     *
+     * @tparam         StateDerivative         Type of callable to compute state derivative, e.g.,
+     *                                         function pointer, functor, lambda or
+     *                                         StateDerivativeFunction
+     * @param[in,out]  time                    Independent variable, which is provided as input and
+     *                                         is updated with output at end of integration step
+     * @param[in,out]  state                   State, which is provided as input and is updated
+     *                                         with output at end of integration step
+     * @param[in,out]  stepSize                Step size to take for integration step, which is
+     *                                         updated with step size for next integration step
+     * @param[in]      computeStateDerivative  Function to compute state derivative for current
+     *                                         time and state
+     * @param[in]      tolerance               Local truncation error tolerance
+     * @param[in]      minimumStepSize         Minimum allowable step size for integration step
+     * @param[in]      maximumStepSize         Maximum allowable step size for integration step
+     */
+    template <typename StateDerivative>
+    void step(Real& time,
+              State& state,
+              Real& stepSize,
+              const StateDerivative& computeStateDerivative,
+              const Real tolerance,
+              const Real minimumStepSize,
+              const Real maximumStepSize)
+    {
+        step(time, state, stepSize, computeStateDerivative, detail::IdentityPreconditioner(),
+             tolerance, minimumStepSize, maximumStepSize);
+    }
+
+    //! Execute single integration step with adaptive step size and order control, and given
+    //! preconditioner.
+    /*!
+     * Executes single numerical integration step with adaptive step size and order control,
+     * using the given preconditioner for the linear systems of the Newton iterations. See the
+     * overload without preconditioner for details.
+     *
+     * @throws std::runtime_error  If a rejected step has to be repeated with a step size that is
+     *                             smaller than the minimum step size
+     *
+     * @tparam         StateDerivative         Type of callable to compute state derivative, e.g.,
+     *                                         function pointer, functor, lambda or
+     *                                         StateDerivativeFunction
+     * @tparam         Preconditioner          Type of callable to apply preconditioner
+     * @param[in,out]  time                    Independent variable, which is provided as input and
+     *                                         is updated with output at end of integration step
+     * @param[in,out]  state                   State, which is provided as input and is updated
+     *                                         with output at end of integration step
+     * @param[in,out]  stepSize                Step size to take for integration step, which is
+     *                                         updated with step size for next integration step
+     * @param[in]      computeStateDerivative  Function to compute state derivative for current
+     *                                         time and state
+     * @param[in]      applyPreconditioner     Function to apply approximate inverse of
+     *                                         I - gamma J to state
+     * @param[in]      tolerance               Local truncation error tolerance
+     * @param[in]      minimumStepSize         Minimum allowable step size for integration step
+     * @param[in]      maximumStepSize         Maximum allowable step size for integration step
+     */
+    template <typename StateDerivative, typename Preconditioner>
+    void step(Real& time,
+              State& state,
+              Real& stepSize,
+              const StateDerivative& computeStateDerivative,
+              const Preconditioner& applyPreconditioner,
+              const Real tolerance,
+              const Real minimumStepSize,
+              const Real maximumStepSize)
+    {
+        StepSizeController<Real> elementaryController(1.0, 0.0, 0.0, 0.84, 0.1, 4.0);
+        stepAdaptive(time, state, stepSize, computeStateDerivative, applyPreconditioner,
+                     detail::ErrorPerUnitStepNorm<Real>(tolerance), elementaryController, 0,
+                     minimumStepSize, maximumStepSize);
+    }
+
+    //! Execute single integration step with adaptive step size and order control, error norm and
+    //! controller.
+    /*!
+     * Executes single numerical integration step with adaptive step size and order control,
+     * based on the scaled error of the error estimate, as computed by the given error norm, e.g.,
+     * WeightedRootMeanSquareErrorNorm, and without preconditioner. The same error norm measures
+     * the convergence of the Newton iterations. See the corresponding adaptive step function of
+     * ExplicitRungeKuttaStepper for details.
+     *
+     * @throws std::runtime_error  If a rejected step has to be repeated with a step size that is
+     *                             smaller than the minimum step size
+     *
+     * @tparam         StateDerivative         Type of callable to compute state derivative, e.g.,
+     *                                         function pointer, functor, lambda or
+     *                                         StateDerivativeFunction
+     * @tparam         ErrorNorm               Type of callable to compute scaled error, e.g.,
+     *                                         WeightedRootMeanSquareErrorNorm
+     * @param[in,out]  time                    Independent variable, which is provided as input and
+     *                                         is updated with output at end of integration step
+     * @param[in,out]  state                   State, which is provided as input and is updated
+     *                                         with output at end of integration step
+     * @param[in,out]  stepSize                Step size to take for integration step, which is
+     *                                         updated with step size for next integration step
+     * @param[in]      computeStateDerivative  Function to compute state derivative for current
+     *                                         time and state
+     * @param[in]      computeError            Function to compute scaled error of error estimate
+     * @param[in,out]  controller              Step size controller, which is updated with scaled
+     *                                         error of accepted step
+     * @param[in]      minimumStepSize         Minimum allowable step size for integration step
+     * @param[in]      maximumStepSize         Maximum allowable step size for integration step
+     */
+    template <typename StateDerivative, typename ErrorNorm>
+    void step(Real& time,
+              State& state,
+              Real& stepSize,
+              const StateDerivative& computeStateDerivative,
+              const ErrorNorm& computeError,
+              StepSizeController<Real>& controller,
+              const Real minimumStepSize,
+              const Real maximumStepSize)
+    {
+        step(time, state, stepSize, computeStateDerivative, detail::IdentityPreconditioner(),
+             computeError, controller, minimumStepSize, maximumStepSize);
+    }
+
+    //! Execute single integration step with adaptive step size and order control, given
+    //! preconditioner, error norm and controller.
+    /*!
+     * Executes single numerical integration step with adaptive step size and order control,
+     * using the given preconditioner, error norm and controller.
+     *
+     * @throws std::runtime_error  If a rejected step has to be repeated with a step size that is
+     *                             smaller than the minimum step size
+     *
+     * @tparam         StateDerivative         Type of callable to compute state derivative, e.g.,
+     *                                         function pointer, functor, lambda or
+     *                                         StateDerivativeFunction
+     * @tparam         Preconditioner          Type of callable to apply preconditioner
+     * @tparam         ErrorNorm               Type of callable to compute scaled error, e.g.,
+     *                                         WeightedRootMeanSquareErrorNorm
+     * @param[in,out]  time                    Independent variable, which is provided as input and
+     *                                         is updated with output at end of integration step
+     * @param[in,out]  state                   State, which is provided as input and is updated
+     *                                         with output at end of integration step
+     * @param[in,out]  stepSize                Step size to take for integration step, which is
+     *                                         updated with step size for next integration step
+     * @param[in]      computeStateDerivative  Function to compute state derivative for current
+     *                                         time and state
+     * @param[in]      applyPreconditioner     Function to apply approximate inverse of
+     *                                         I - gamma J to state
+     * @param[in]      computeError            Function to compute scaled error of error estimate
+     * @param[in,out]  controller              Step size controller, which is updated with scaled
+     *                                         error of accepted step
+     * @param[in]      minimumStepSize         Minimum allowable step size for integration step
+     * @param[in]      maximumStepSize         Maximum allowable step size for integration step
+     */
+    template <typename StateDerivative, typename Preconditioner, typename ErrorNorm>
+    void step(Real& time,
+              State& state,
+              Real& stepSize,
+              const StateDerivative& computeStateDerivative,
+              const Preconditioner& applyPreconditioner,
+              const ErrorNorm& computeError,
+              StepSizeController<Real>& controller,
+              const Real minimumStepSize,
+              const Real maximumStepSize)
+    {
+        stepAdaptive(time, state, stepSize, computeStateDerivative, applyPreconditioner,
+                     computeError, controller, 1, minimumStepSize, maximumStepSize);
+    }
+
+    //! Reset stepper.
+    /*!
+     * Discards the history, so that the stepper starts up again at the next step, e.g., because
+     * the dynamical model has changed between steps.
+     */
+    void reset()
+    {
+        historySize = 0;
+        order = 0;
+    }
+
+    //! Write history, order control and statistics to checkpoint.
+    /*!
+     * Writes the order, the number of steps at the current order, the convergence rate of the
+     * last Newton iterations, the history of times and states, the state derivative at the start
+     * of the history, the Newton and GMRES iteration counts and the statistics to the given
+     * checkpoint (see Checkpoint).
+     *
+     * @tparam      Checkpoint  Type of checkpoint, e.g., Checkpoint
+     * @param[out]  checkpoint  Checkpoint to which stepper is written
+     */
+    template <typename Checkpoint>
+    void writeCheckpoint(Checkpoint& checkpoint) const
+    {
+        checkpoint.write(order);
+        checkpoint.write(numberOfStepsAtOrder);
+        checkpoint.write(previousConvergenceRate);
+        checkpoint.write(historySize);
+        for (int age = historySize - 1; age >= 0; --age)
+        {
+            checkpoint.write(times[getHistoryIndex(age)]);
+            checkpoint.writeState(states[getHistoryIndex(age)]);
+        }
+        if (historySize > 0)
+        {
+            checkpoint.writeState(workspace[initialStateDerivativeIndex]);
+        }
+        checkpoint.write(numberOfNewtonIterations);
+        checkpoint.write(numberOfLinearIterations);
+        statistics.writeCheckpoint(checkpoint);
+    }
+
+    //! Read history, order control and statistics from checkpoint.
+    /*!
+     * Reads the data written by writeCheckpoint() from the given checkpoint.
+     *
+     * @throws std::runtime_error  If checkpoint does not contain data of stepper, or if its
+     *                             history does not fit the maximum order
+     *
+     * @tparam         Checkpoint  Type of checkpoint, e.g., Checkpoint
+     * @param[in,out]  checkpoint  Checkpoint from which stepper is read
+     * @param[in]      state       State with the number of elements of the integration
+     */
+    template <typename Checkpoint>
+    void readCheckpoint(Checkpoint& checkpoint, const State& state)
+    {
+        checkpoint.read(order);
+        checkpoint.read(numberOfStepsAtOrder);
+        checkpoint.read(previousConvergenceRate);
+        checkpoint.read(historySize);
+        if (historySize < 0 || historySize > historyCapacity || order < 0 || order > maximumOrder)
+        {
+            historySize = 0;
+            order = 0;
+            throw std::runtime_error("Checkpoint does not match stepper!");
+        }
+        allocate(state);
+        newestIndex = historySize > 0 ? historySize - 1 : 0;
+        for (int age = historySize - 1; age >= 0; --age)
+        {
+            checkpoint.read(times[getHistoryIndex(age)]);
+            checkpoint.readState(states[getHistoryIndex(age)]);
+        }
+        if (historySize > 0)
+        {
+            checkpoint.readState(workspace[initialStateDerivativeIndex]);
+        }
+        checkpoint.read(numberOfNewtonIterations);
+        checkpoint.read(numberOfLinearIterations);
+        statistics.readCheckpoint(checkpoint);
+    }
+
+    //! Get order of the backward differentiation formula for next step (0 if stepper starts up).
+    int getOrder() const { return order; }
+
+    //! Get number of Newton iterations.
+    long getNumberOfNewtonIterations() const { return numberOfNewtonIterations; }
+
+    //! Get number of GMRES iterations, i.e., of Jacobian-vector products.
+    long getNumberOfLinearIterations() const { return numberOfLinearIterations; }
+
+    //! Get statistics collected by stepper.
+    const Statistics& getStatistics() const { return statistics; }
+
+    //! Get statistics collected by stepper, e.g., to reset them.
+    Statistics& getStatistics() { return statistics; }
+
+protected:
+private:
+
+    //! Index of predicted state in workspace.
+    static const int predictedStateIndex = 0;
+
+    //! Index of Newton iterate in workspace.
+    static const int iterateIndex = 1;
+
+    //! Index of state derivative at Newton iterate in workspace.
+    static const int iterateDerivativeIndex = 2;
+
+    //! Index of constant part psi of the implicit equation in workspace.
+    static const int baseStateIndex = 3;
+
+    //! Index of Newton residual in workspace, which is also used for the error estimate.
+    static const int residualIndex = 4;
+
+    //! Index of Newton correction in workspace.
+    static const int correctionIndex = 5;
+
+    //! Index of perturbed state of Jacobian-vector products in workspace.
+    static const int perturbedStateIndex = 6;
+
+    //! Index of state derivative at perturbed state in workspace.
+    static const int perturbedStateDerivativeIndex = 7;
+
+    //! Index of state derivative at start of history in workspace, for the first predictor.
+    static const int initialStateDerivativeIndex = 8;
+
+    //! Number of states in workspace.
+    static const int workspaceSize = 9;
+
+    //! Maximum number of Newton iterations per attempt.
+    static const int maximumNumberOfNewtonIterations = 4;
+
+    //! Scaled error of Newton iterate below which the iterations are stopped.
+    static constexpr Real newtonTolerance = 0.1;
+
+    //! Convergence rate of Newton iterations above which the iterations diverge.
+    static constexpr Real maximumConvergenceRate = 0.9;
+
+    //! Factor by which GMRES reduces the residual of each Newton iteration.
+    static constexpr Real linearTolerance = 0.05;
+
+    //! Factor by which the step size is reduced if the Newton iterations fail.
+    static constexpr Real newtonFailureStepSizeFactor = 0.25;
+
+    //! Maximum factor by which the step size is increased per step.
+    static constexpr Real maximumStepSizeIncrease = 2.0;
+
+    //! Execute single integration step with adaptive step size and order control.
+    /*!
+     * Executes single integration step. The step size controller uses exponent 1 / (j + offset)
+     * for the error estimate of order j, i.e., offset 0 for errors per unit step and offset 1 for
+     * errors per step.
+     */
+    template <typename StateDerivative, typename Preconditioner, typename ErrorNorm>
+    void stepAdaptive(Real& time,
+                      State& state,
+                      Real& stepSize,
+                      const StateDerivative& computeStateDerivative,
+                      const Preconditioner& applyPreconditioner,
+                      const ErrorNorm& computeError,
+                      StepSizeController<Real>& controller,
+                      const int errorEstimateOrderOffset,
+                      const Real minimumStepSize,
+                      const Real maximumStepSize)
+    {
+        statistics.startStep();
+        const detail::RecordedStateDerivative<Real, State, StateDerivative, Statistics>
+            recordedStateDerivative(computeStateDerivative, statistics);
+
+        if (!isHistoryValid(time, state))
+        {
+            startUp(time, state, recordedStateDerivative);
+        }
+
+        State& predictedState = workspace[predictedStateIndex];
+        State& iterate = workspace[iterateIndex];
+        State& errorEstimate = workspace[residualIndex];
+        while (true)
+        {
+            predict(time, stepSize);
+            bool isConverged = solveImplicitEquation(time + stepSize, state, stepSize,
+                                                     recordedStateDerivative,
+                                                     applyPreconditioner, computeError);
+            if (!isConverged)
+            {
+                statistics.recordRejectedStep(stepSize);
+                previousConvergenceRate = 1.0;
+                stepSize = newtonFailureStepSizeFactor * stepSize;
+                if (stepSize < minimumStepSize)
+                {
+                    statistics.stopStep();
+                    throw std::runtime_error("Minimum step size exceeded!");
+                }
+                continue;
+            }
+
+            const Real one = 1.0;
+            computeWeightedSum(errorEstimate, one / (order + 1), 1.0, iterate,
+                               -1.0, predictedState);
+            const Real error = computeError(errorEstimate, state, iterate, stepSize);
+            const bool isAccepted = error <= 1.0;
+
+            // Select order for next attempt or step that allows the largest step size, based on
+            // the divided differences through the iterate and the accepted states.
+            int nextOrder = order;
+            Real nextError = error;
+            Real nextBiasedFactor = computeBiasedStepSizeFactor(
+                error, currentOrderBias, order + errorEstimateOrderOffset);
+            if (order > 1)
+            {
+                computeDividedDifference(time + stepSize, stepSize, order, errorEstimate);
+                const Real lowerOrderError
+                    = computeError(errorEstimate, state, iterate, stepSize) / order;
+                const Real biasedFactor = computeBiasedStepSizeFactor(
+                    lowerOrderError, lowerOrderBias, order - 1 + errorEstimateOrderOffset);
+                if (biasedFactor > nextBiasedFactor)
+                {
+                    nextOrder = order - 1;
+                    nextError = lowerOrderError;
+                    nextBiasedFactor = biasedFactor;
+                }
+            }
+            if (isAccepted
+                && order < maximumOrder
+                && numberOfStepsAtOrder >= order + 1
+                && historySize >= order + 2)
+            {
+                computeDividedDifference(time + stepSize, stepSize, order + 2, errorEstimate);
+                const Real higherOrderError
+                    = computeError(errorEstimate, state, iterate, stepSize) / (order + 2);
+                const Real biasedFactor = computeBiasedStepSizeFactor(
+                    higherOrderError, higherOrderBias, order + 1 + errorEstimateOrderOffset);
+                if (biasedFactor > nextBiasedFactor)
+                {
+                    nextOrder = order + 1;
+                    nextError = higherOrderError;
+                }
+            }
+
+            Real stepSizeFactor = controller.computeStepSizeFactor(
+                nextError, nextOrder + errorEstimateOrderOffset, isAccepted);
+            if (stepSizeFactor > maximumStepSizeIncrease)
+            {
+                stepSizeFactor = maximumStepSizeIncrease;
+            }
+            if (nextOrder != order)
+            {
+                order = nextOrder;
+                numberOfStepsAtOrder = 0;
+            }
+
+            if (isAccepted)
+            {
+                statistics.recordAcceptedStep(stepSize);
+                time += stepSize;
+                using std::swap;
+                swap(state, iterate);
+                addToHistory(time, state);
+                ++numberOfStepsAtOrder;
+
+                stepSize = stepSizeFactor * stepSize;
+                if (stepSize > maximumStepSize)
+                {
+                    stepSize = maximumStepSize;
+                }
+                else if (stepSize < minimumStepSize)
+                {
+                    stepSize = minimumStepSize;
+                }
+                statistics.stopStep();
+                return;
+            }
+
+            statistics.recordRejectedStep(stepSize);
+            stepSize = stepSizeFactor * stepSize;
+            if (stepSize > maximumStepSize)
+            {
+                stepSize = maximumStepSize;
+            }
+            else if (stepSize < minimumStepSize)
+            {
+                statistics.stopStep();
+                throw std::runtime_error("Minimum step size exceeded!");
+            }
+        }
+    }
+
+    //! Solve implicit equation of step with inexact Newton iterations, starting from predictor.
+    /*!
+     * Solves implicit equation of the backward differentiation formula of the current order for
+     * the state at the given time, and returns false if the Newton iterations diverge or do not
+     * converge. The convergence rate is estimated from the ratio of successive corrections, and
+     * for the first iteration from the convergence rate of the previous step (Hairer & Wanner,
+     * 1996, Section IV.8).
+     */
+    template <typename RecordedStateDerivative, typename Preconditioner, typename ErrorNorm>
+    bool solveImplicitEquation(const Real nextTime,
+                               const State& state,
+                               const Real stepSize,
+                               const RecordedStateDerivative& recordedStateDerivative,
+                               const Preconditioner& applyPreconditioner,
+                               const ErrorNorm& computeError)
+    {
+        const Real gamma = computeCorrectorBase(nextTime, stepSize);
+        const State& baseState = workspace[baseStateIndex];
+        State& iterate = workspace[iterateIndex];
+        State& iterateDerivative = workspace[iterateDerivativeIndex];
+        State& residual = workspace[residualIndex];
+        State& correction = workspace[correctionIndex];
+        State& perturbedState = workspace[perturbedStateIndex];
+        State& perturbedStateDerivative = workspace[perturbedStateDerivativeIndex];
+        iterate = workspace[predictedStateIndex];
+
+        Real iterateNorm = 0.0;
+        const Real one = 1.0;
+        const auto applyIterationMatrix = [&](const State& vector, State& result)
+        {
+            // Product of I - gamma J with vector, with forward-difference Jacobian-vector product.
+            const Real vectorNorm = std::sqrt(computeDotProduct<Real>(vector, vector));
+            if (vectorNorm == 0.0)
+            {
+                result = vector;
+                return;
+            }
+            const Real increment = std::sqrt(std::numeric_limits<Real>::epsilon())
+                                   * (1.0 + iterateNorm) / vectorNorm;
+            computeLinearCombination(perturbedState, iterate, increment, 1.0, vector);
+            recordedStateDerivative(nextTime, perturbedState, perturbedStateDerivative);
+            computeLinearCombination(result, vector, -gamma / increment,
+                                     1.0, perturbedStateDerivative, -1.0, iterateDerivative);
+        };
+        const auto applyIterationPreconditioner = [&](const State& vector, State& result)
+        {
+            applyPreconditioner(nextTime, iterate, gamma, vector, result);
+        };
+
+        Real convergenceRate = std::pow(
+            std::max(previousConvergenceRate, std::numeric_limits<Real>::epsilon()), 0.8);
+        Real previousCorrectionNorm = 0.0;
+        for (int iteration = 0; iteration < maximumNumberOfNewtonIterations; ++iteration)
+        {
+            ++numberOfNewtonIterations;
+            recordedStateDerivative(nextTime, iterate, iterateDerivative);
+            computeLinearCombination(residual, baseState, one, -1.0, iterate,
+                                     gamma, iterateDerivative);
+            iterateNorm = std::sqrt(computeDotProduct<Real>(iterate, iterate));
+            numberOfLinearIterations += linearSolver.solve(
+                applyIterationMatrix, applyIterationPreconditioner, residual, correction,
+                linearTolerance, 2 * krylovDimension);
+            computeLinearCombination(iterate, iterate, one, 1.0, correction);
+
+            const Real correctionNorm = computeError(correction, state, iterate, stepSize);
+            if (correctionNorm == 0.0)
+            {
+                return true;
+            }
+            if (iteration > 0)
+            {
+                const Real ratio = correctionNorm / previousCorrectionNorm;
+                if (ratio >= maximumConvergenceRate)
+                {
+                    return false;
+                }
+                convergenceRate = ratio / (1.0 - ratio);
+            }
+            if (convergenceRate * correctionNorm <= newtonTolerance)
+            {
+                previousConvergenceRate = convergenceRate;
+                return true;
+            }
+            previousCorrectionNorm = correctionNorm;
+        }
+        return false;
+    }
+
+    //! Check if history continues from given time and state.
+    bool isHistoryValid(const Real time, const State& state) const
+    {
+        return historySize > 0
+               && time == times[newestIndex]
+               && detail::isEqualState(
+                   state, states[newestIndex],
+                   std::integral_constant<bool, StateTraits<State>::isIndexable>());
+    }
+
+    //! Discard history and start new history at given time and state.
+    template <typename RecordedStateDerivative>
+    void startUp(const Real time,
+                 const State& state,
+                 const RecordedStateDerivative& recordedStateDerivative)
+    {
+        allocate(state);
+        historySize = 0;
+        order = 1;
+        numberOfStepsAtOrder = 0;
+        previousConvergenceRate = 1.0;
+        addToHistory(time, state);
+        recordedStateDerivative(time, state, workspace[initialStateDerivativeIndex]);
+    }
+
+    //! Allocate history and workspace for states of given size, unless they are allocated.
+    /*!
+     * Allocates the history and workspace again if the number of elements of the state has
+     * changed, since state derivatives may be written in-place.
+     */
+    void allocate(const State& state)
+    {
+        if (states.empty()
+            || !detail::hasSameSize(states[0], state, typename detail::StateTag<State>::type()))
+        {
+            states.assign(historyCapacity, state);
+            times.assign(historyCapacity, 0.0);
+            workspace.assign(workspaceSize, state);
+            nodes.resize(maximumOrder + 3);
+            coefficients.resize(maximumOrder + 3);
+            terms.resize(maximumOrder + 3);
+        }
+    }
+
+    //! Add given time and state to history.
+    void addToHistory(const Real time, const State& state)
+    {
+        newestIndex = (newestIndex + 1) % historyCapacity;
+        states[newestIndex] = state;
+        times[newestIndex] = time;
+        if (historySize < historyCapacity)
+        {
+            ++historySize;
+        }
+    }
+
+    //! Get index in ring buffer of history entry with given age (0 for newest entry).
+    int getHistoryIndex(const int age) const
+    {
+        return (newestIndex - age + historyCapacity) % historyCapacity;
+    }
+
+    //! Set interpolation nodes, in units of the step size relative to the newest accepted time.
+    /*!
+     * Sets node 0 to the end of the step (i.e., 1), and node j to the accepted time with age
+     * j - 1, for j = 1, ..., numberOfNodes - 1.
+     */
+    void setNodes(const Real nextTime, const Real stepSize, const int numberOfNodes)
+    {
+        const Real time = times[newestIndex];
+        nodes[0] = (nextTime - time) / stepSize;
+        for (int j = 1; j < numberOfNodes; ++j)
+        {
+            nodes[j] = (times[getHistoryIndex(j - 1)] - time) / stepSize;
+        }
+    }
+
+    //! Compute predicted state by extrapolation of the last order + 1 accepted states.
+    /*!
+     * Computes predicted state at the end of the step by Lagrange extrapolation. At the first
+     * step, the history contains a single state, and the explicit Euler step is used instead.
+     */
+    void predict(const Real time, const Real stepSize)
+    {
+        State& predictedState = workspace[predictedStateIndex];
+        if (historySize == 1)
+        {
+            computeLinearCombination(predictedState, states[newestIndex], stepSize,
+                                     1.0, workspace[initialStateDerivativeIndex]);
+            return;
+        }
+
+        const int numberOfPoints = order + 1;
+        setNodes(time + stepSize, stepSize, numberOfPoints + 1);
+        for (int j = 1; j <= numberOfPoints; ++j)
+        {
+            Real weight = 1.0;
+            for (int l = 1; l <= numberOfPoints; ++l)
+            {
+                if (l != j)
+                {
+                    weight *= (nodes[0] - nodes[l]) / (nodes[j] - nodes[l]);
+                }
+            }
+            coefficients[j - 1] = weight;
+            terms[j - 1] = &states[getHistoryIndex(j - 1)];
+        }
+        detail::computeLinearCombination<Real, State>(
+            predictedState, nullptr, 1.0, coefficients.data(), terms.data(),
+            static_cast<std::size_t>(numberOfPoints), typename detail::StateTag<State>::type());
+    }
+
+    //! Compute constant part psi of implicit equation, and return gamma.
+    /*!
+     * Computes coefficients alpha_j of the backward differentiation formula of the current order,
+     * i.e., the derivatives at the end of the step of the Lagrange basis polynomials through the
+     * end of the step (j = 0) and the last order accepted states (j = 1, ..., order), in units of
+     * the step size. The formula sum_j alpha_j y_j = h f(t_{n+1}, y_{n+1}) is then written as
+     * y_{n+1} = psi + gamma f(t_{n+1}, y_{n+1}).
+     */
+    Real computeCorrectorBase(const Real nextTime, const Real stepSize)
+    {
+        setNodes(nextTime, stepSize, order + 1);
+        Real leadingCoefficient = 0.0;
+        for (int l = 1; l <= order; ++l)
+        {
+            leadingCoefficient += 1.0 / (nodes[0] - nodes[l]);
+        }
+
+        for (int j = 1; j <= order; ++j)
+        {
+            Real numerator = 1.0;
+            Real denominator = nodes[j] - nodes[0];
+            for (int l = 1; l <= order; ++l)
+            {
+                if (l != j)
+                {
+                    numerator *= nodes[0] - nodes[l];
+                    denominator *= nodes[j] - nodes[l];
+                }
+            }
+            coefficients[j - 1] = -numerator / denominator / leadingCoefficient;
+            terms[j - 1] = &states[getHistoryIndex(j - 1)];
+        }
+        detail::computeLinearCombination<Real, State>(
+            workspace[baseStateIndex], nullptr, 1.0, coefficients.data(), terms.data(),
+            static_cast<std::size_t>(order), typename detail::StateTag<State>::type());
+        return stepSize / leadingCoefficient;
+    }
+
+    //! Compute scaled divided difference of given degree through iterate and accepted states.
+    /*!
+     * Computes h^m m! [y_{n+1}, y_n, ..., y_{n+1-m}], which approximates h^m times the m-th
+     * derivative of the solution, i.e., the m-th backward difference for constant step sizes.
+     */
+    void computeDividedDifference(const Real nextTime,
+                                  const Real stepSize,
+                                  const int degree,
+                                  State& result)
+    {
+        setNodes(nextTime, stepSize, degree + 1);
+        Real factorial = 1.0;
+        for (int m = 2; m <= degree; ++m)
+        {
+            factorial *= m;
+        }
+
+        for (int i = 0; i <= degree; ++i)
+        {
+            Real denominator = 1.0;
+            for (int l = 0; l <= degree; ++l)
+            {
+                if (l != i)
+                {
+                    denominator *= nodes[i] - nodes[l];
+                }
+            }
+            coefficients[i] = factorial / denominator;
+            terms[i] = i == 0 ? &workspace[iterateIndex] : &states[getHistoryIndex(i - 1)];
+        }
+        detail::computeLinearCombination<Real, State>(
+            result, nullptr, 1.0, coefficients.data(), terms.data(),
+            static_cast<std::size_t>(degree + 1), typename detail::StateTag<State>::type());
+    }
+
+    //! Compute step size factor for scaled error of given order, reduced by given bias.
+    static Real computeBiasedStepSizeFactor(const Real error,
+                                            const Real bias,
+                                            const int errorEstimateOrder)
+    {
+        return std::pow(bias * error, -1.0 / errorEstimateOrder);
+    }
+
+    //! Bias against the order below the current order.
+    static constexpr Real lowerOrderBias = 1.3;
+
+    //! Bias against the current order.
+    static constexpr Real currentOrderBias = 1.2;
+
+    //! Bias against the order above the current order.
+    static constexpr Real higherOrderBias = 1.4;
+
+    //! Maximum order of the backward differentiation formulas.
+    int maximumOrder;
+
+    //! Order of the backward differentiation formula for next step.
+    int order;
+
+    //! Number of accepted steps since the order was changed.
+    int numberOfStepsAtOrder;
+
+    //! Number of states in history.
+    int historySize;
+
+    //! Index of newest state in ring buffer.
+    int newestIndex;
+
+    //! Capacity of ring buffer.
+    int historyCapacity;
+
+    //! Dimension of Krylov subspace after which GMRES is restarted.
+    int krylovDimension;
+
+    //! Convergence rate of the Newton iterations of the last converged attempt.
+    Real previousConvergenceRate;
+
+    //! Number of Newton iterations.
+    long numberOfNewtonIterations;
+
+    //! Number of GMRES iterations.
+    long numberOfLinearIterations;
+
+    //! Ring buffer of states of accepted steps.
+    std::vector<State> states;
+
+    //! Ring buffer of times of accepted steps.
+    std::vector<Real> times;
+
+    //! Storage for predicted state, Newton iterations and error estimates.
+    std::vector<State> workspace;
+
+    //! Interpolation nodes, in units of the step size relative to the newest accepted time.
+    std::vector<Real> nodes;
+
+    //! Coefficients of linear combination of states.
+    std::vector<Real> coefficients;
+
+    //! States of linear combination.
+    std::vector<const State*> terms;
+
+    //! GMRES solver for linear systems of Newton iterations.
+    detail::GMRESSolver<Real, State> linearSolver;
+
+    //! Statistics collected by stepper.
+    Statistics statistics;
+};
+
+} // namespace integrate
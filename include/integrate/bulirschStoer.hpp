@@ -0,0 +1,695 @@
+/*
+ * Copyright (c) 2014-2025 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "integrate/linearCombination.hpp"
+#include "integrate/stateDerivative.hpp"
+#include "integrate/statistics.hpp"
+#include "integrate/stepSizeControl.hpp"
+
+namespace integrate
+{
+namespace detail
+{
+
+//! Pool of persistent worker threads that execute the same task in parallel.
+/*!
+ * Pool that keeps its worker threads alive between tasks, so that a task can be executed in
+ * parallel on every integration step without the cost of creating threads. The calling thread
+ * participates as worker 0, so that a pool of n workers creates n - 1 threads. If a task throws an
+ * exception on any worker, the first exception is rethrown by run() after all workers have
+ * finished.
+ */
+class WorkerPool
+{
+public:
+
+    //! Construct pool with given number of workers, including the calling thread.
+    explicit WorkerPool(const int numberOfWorkers)
+        : numberOfWorkers(numberOfWorkers),
+          generation(0),
+          numberOfBusyWorkers(0),
+          isStopping(false),
+          task(nullptr)
+    {
+        for (int worker = 1; worker < numberOfWorkers; ++worker)
+        {
+            threads.push_back(std::thread(&WorkerPool::runWorker, this, worker));
+        }
+    }
+
+    //! Stop and join worker threads.
+    ~WorkerPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            isStopping = true;
+        }
+        taskCondition.notify_all();
+        for (std::size_t i = 0; i < threads.size(); ++i)
+        {
+            threads[i].join();
+        }
+    }
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    //! Get number of workers, including the calling thread.
+    int getNumberOfWorkers() const { return numberOfWorkers; }
+
+    //! Execute given task on all workers, i.e., task(worker) for worker in [0, numberOfWorkers).
+    void run(const std::function<void(const int)>& task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            this->task = &task;
+            exception = nullptr;
+            numberOfBusyWorkers = numberOfWorkers - 1;
+            ++generation;
+        }
+        taskCondition.notify_all();
+
+        executeTask(0);
+
+        std::exception_ptr taskException;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            doneCondition.wait(lock, [this]() { return numberOfBusyWorkers == 0; });
+            this->task = nullptr;
+            std::swap(taskException, exception);
+        }
+        if (taskException)
+        {
+            std::rethrow_exception(taskException);
+        }
+    }
+
+protected:
+private:
+
+    //! Wait for tasks and execute them on given worker, until the pool is stopped.
+    void runWorker(const int worker)
+    {
+        unsigned long lastGeneration = 0;
+        while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                taskCondition.wait(lock, [this, lastGeneration]()
+                {
+                    return isStopping || generation != lastGeneration;
+                });
+                if (isStopping)
+                {
+                    return;
+                }
+                lastGeneration = generation;
+            }
+
+            executeTask(worker);
+
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--numberOfBusyWorkers == 0)
+            {
+                doneCondition.notify_one();
+            }
+        }
+    }
+
+    //! Execute current task on given worker and keep first exception.
+    void executeTask(const int worker)
+    {
+        try
+        {
+            (*task)(worker);
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!exception)
+            {
+                exception = std::current_exception();
+            }
+        }
+    }
+
+    //! Number of workers, including the calling thread.
+    int numberOfWorkers;
+
+    //! Counter that is incremented for each task, so that workers can detect new tasks.
+    unsigned long generation;
+
+    //! Number of worker threads that have not finished current task.
+    int numberOfBusyWorkers;
+
+    //! Flag that indicates if worker threads must stop.
+    bool isStopping;
+
+    //! Current task.
+    const std::function<void(const int)>* task;
+
+    //! First exception thrown by current task.
+    std::exception_ptr exception;
+
+    //! Mutex that protects the members above.
+    std::mutex mutex;
+
+    //! Condition that signals a new task or stop to the worker threads.
+    std::condition_variable taskCondition;
+
+    //! Condition that signals that all worker threads have finished current task.
+    std::condition_variable doneCondition;
+
+    //! Worker threads.
+    std::vector<std::thread> threads;
+};
+
+} // namespace detail
+
+//! Gragg-Bulirsch-Stoer extrapolation stepper with order and step size control.
+/*!
+ * Stepper that executes integration steps using Gragg-Bulirsch-Stoer extrapolation (Hairer et
+ * al., 1993, Section II.9). For column j of the extrapolation table, the step is divided into
+ * n_j = 2j substeps of the modified midpoint rule, and the results of columns 1 to k are
+ * extrapolated to zero substep size (Aitken-Neville, in powers of the squared substep size), which
+ * yields a solution of order 2k. The difference between the last two extrapolated solutions of
+ * the last column estimates the local truncation error, which controls the step size as for the
+ * embedded Runge-Kutta schemes. Since the order increases by two for every additional column, the
+ * stepper takes much larger steps than RKF78 at high accuracy, e.g., for tolerances of 1e-13.
+ *
+ * The number of columns k is selected on every step from the work per unit step, as for ODEX
+ * (Hairer et al., 1993, Section II.9): the state derivative at the start of the step is evaluated
+ * once and is shared by all columns, so that column j costs 2j - 1 further evaluations. If the
+ * error of column k exceeds the tolerance, column k + 1 is computed before the step is rejected,
+ * and column k + 1 is selected for the next step if it is accepted. The number of columns is kept
+ * between 3 and the maximum number of columns minus one.
+ *
+ * The columns are independent of each other, so that they can be computed in parallel. If the
+ * stepper is constructed with more than one thread, columns 1 to k are distributed over a pool of
+ * persistent worker threads, which reduces the time per step for expensive dynamical models. The
+ * state derivative must then be safe to call concurrently. The columns are computed in the same
+ * way for any number of threads, so that the result does not depend on the number of threads.
+ * Each column records its evaluations in its own statistics, which are added to the statistics of
+ * the stepper after the columns have been computed; in parallel mode, the time spent inside the
+ * state derivative function is therefore summed over the threads.
+ *
+ * @tparam  Real        Type for floating-point number
+ * @tparam  State       Type for state and state derivative
+ * @tparam  Statistics  Statistics policy, e.g., NullStatistics or IntegrationStatistics
+ */
+template <typename Real, typename State, typename Statistics = NullStatistics>
+class BulirschStoerStepper
+{
+public:
+
+    //! Construct stepper.
+    /*!
+     * Constructs stepper.
+     *
+     * @throws std::invalid_argument  If maximum number of columns is smaller than 4
+     *
+     * @param[in]  maximumNumberOfColumns  Maximum number of columns of the extrapolation table
+     * @param[in]  numberOfThreads         Number of threads that compute the columns, including
+     *                                     the calling thread; if zero, the number of concurrent
+     *                                     threads supported by the hardware is used
+     */
+    explicit BulirschStoerStepper(const int maximumNumberOfColumns = 8,
+                                  const int numberOfThreads = 1)
+        : maximumNumberOfColumns(maximumNumberOfColumns),
+          numberOfThreads(numberOfThreads > 0
+                          ? numberOfThreads
+                          : static_cast<int>(std::thread::hardware_concurrency()))
+    {
+        if (maximumNumberOfColumns < 4)
+        {
+            throw std::invalid_argument("Maximum number of columns must be at least 4!");
+        }
+
+        this->numberOfThreads
+            = std::max(1, std::min(this->numberOfThreads, maximumNumberOfColumns));
+        reset();
+        if (this->numberOfThreads > 1)
+        {
+            pool.reset(new detail::WorkerPool(this->numberOfThreads));
+            workerLoads.resize(this->numberOfThreads);
+        }
+    }
+
+    //! Execute single integration step with adaptive step size.
+    /*!
+     * Executes single numerical integration step with adaptive step size and order control. If
+     * the maximum norm of the error estimate exceeds the tolerance times the step size, the step
+     * is rejected and repeated with a smaller step size, until it is accepted. The step size is
+     * scaled by the elementary controller, as for the adaptive step function of
+     * ExplicitRungeKuttaStepper that takes a tolerance.
+     *
+     * @throws std::runtime_error  If a rejected step has to be repeated with a step size that is
+     *                             smaller than the minimum step size
+     *
+     * @tparam         StateDerivative         Type of callable to compute state derivative, e.g.,
+     *                                         function pointer, functor, lambda or
+     *                                         StateDerivativeFunction
+     * @param[in,out]  time                    Independent variable, which is provided as input and
+     *                                         is updated with output at end of integration step
+     * @param[in,out]  state                   State, which is provided as input and is updated
+     *                                         with output at end of integration step
+     * @param[in,out]  stepSize                Step size to take for integration step, which is
+     *                                         updated with step size for next integration step
+     * @param[in]      computeStateDerivative  Function to compute state derivative for current
+     *                                         time and state
+     * @param[in]      tolerance               Local truncation error tolerance
+     * @param[in]      minimumStepSize         Minimum allowable step size for integration step
+     * @param[in]      maximumStepSize         Maximum allowable step size for integration step
+     */
+    template <typename StateDerivative>
+    void step(Real& time,
+              State& state,
+              Real& stepSize,
+              const StateDerivative& computeStateDerivative,
+              const Real tolerance,
+              const Real minimumStepSize,
+              const Real maximumStepSize)
+    {
+        StepSizeController<Real> elementaryController(1.0, 0.0, 0.0, 0.84, 0.1, 4.0);
+        stepAdaptive(time, state, stepSize, computeStateDerivative,
+                     detail::ErrorPerUnitStepNorm<Real>(tolerance), elementaryController, 0,
+                     minimumStepSize, maximumStepSize);
+    }
+
+    //! Execute single integration step with adaptive step size, error norm and controller.
+    /*!
+     * Executes single numerical integration step with adaptive step size and order control, based
+     * on the scaled error of the error estimate, as computed by the given error norm, e.g.,
+     * WeightedRootMeanSquareErrorNorm. See the corresponding adaptive step function of
+     * ExplicitRungeKuttaStepper for details.
+     *
+     * @throws std::runtime_error  If a rejected step has to be repeated with a step size that is
+     *                             smaller than the minimum step size
+     *
+     * @tparam         StateDerivative         Type of callable to compute state derivative, e.g.,
+     *                                         function pointer, functor, lambda or
+     *                                         StateDerivativeFunction
+     * @tparam         ErrorNorm               Type of callable to compute scaled error, e.g.,
+     *                                         WeightedRootMeanSquareErrorNorm
+     * @param[in,out]  time                    Independent variable, which is provided as input and
+     *                                         is updated with output at end of integration step
+     * @param[in,out]  state                   State, which is provided as input and is updated
+     *                                         with output at end of integration step
+     * @param[in,out]  stepSize                Step size to take for integration step, which is
+     *                                         updated with step size for next integration step
+     * @param[in]      computeStateDerivative  Function to compute state derivative for current
+     *                                         time and state
+     * @param[in]      computeError            Function to compute scaled error of error estimate
+     * @param[in,out]  controller              Step size controller, which is updated with scaled
+     *                                         error of accepted step
+     * @param[in]      minimumStepSize         Minimum allowable step size for integration step
+     * @param[in]      maximumStepSize         Maximum allowable step size for integration step
+     */
+    template <typename StateDerivative, typename ErrorNorm>
+    void step(Real& time,
+              State& state,
+              Real& stepSize,
+              const StateDerivative& computeStateDerivative,
+              const ErrorNorm& computeError,
+              StepSizeController<Real>& controller,
+              const Real minimumStepSize,
+              const Real maximumStepSize)
+    {
+        stepAdaptive(time, state, stepSize, computeStateDerivative, computeError, controller, 1,
+                     minimumStepSize, maximumStepSize);
+    }
+
+    //! Reset stepper.
+    /*!
+     * Resets the number of columns to its initial value, i.e., half the maximum number of
+     * columns, but at least 3.
+     */
+    void reset()
+    {
+        numberOfColumns = std::max(3, maximumNumberOfColumns / 2);
+    }
+
+    //! Get number of columns of the extrapolation table for next step.
+    int getNumberOfColumns() const { return numberOfColumns; }
+
+    //! Get number of threads that compute the columns, including the calling thread.
+    int getNumberOfThreads() const { return numberOfThreads; }
+
+    //! Get statistics collected by stepper.
+    const Statistics& getStatistics() const { return statistics; }
+
+    //! Get statistics collected by stepper, e.g., to reset them.
+    Statistics& getStatistics() { return statistics; }
+
+protected:
+private:
+
+    //! Index of state derivative at start of step in workspace.
+    static const int initialStateDerivativeIndex = 0;
+
+    //! Index of error estimate in workspace.
+    static const int errorEstimateIndex = 1;
+
+    //! Number of states in column workspace per column.
+    static const int columnWorkspaceSize = 3;
+
+    //! Execute single integration step with adaptive step size and order control.
+    /*!
+     * Executes single integration step. The step size controller uses exponent 1 / (2j - 2 +
+     * offset) for the error estimate of column j, i.e., offset 0 for errors per unit step and
+     * offset 1 for errors per step.
+     */
+    template <typename StateDerivative, typename ErrorNorm>
+    void stepAdaptive(Real& time,
+                      State& state,
+                      Real& stepSize,
+                      const StateDerivative& computeStateDerivative,
+                      const ErrorNorm& computeError,
+                      StepSizeController<Real>& controller,
+                      const int errorEstimateOrderOffset,
+                      const Real minimumStepSize,
+                      const Real maximumStepSize)
+    {
+        statistics.startStep();
+
+        // The workspace is set up again if the number of elements of the state has changed, since
+        // state derivatives may be written in-place.
+        if (workspace.empty()
+            || !detail::hasSameSize(workspace[0], state, typename detail::StateTag<State>::type()))
+        {
+            workspace.assign(2, state);
+            columnWorkspace.assign(columnWorkspaceSize * maximumNumberOfColumns, state);
+            previousRow.assign(maximumNumberOfColumns, state);
+            currentRow.assign(maximumNumberOfColumns, state);
+            errors.resize(maximumNumberOfColumns + 1);
+            columnStatistics.resize(maximumNumberOfColumns + 1);
+            columnWorkers.resize(maximumNumberOfColumns + 1);
+        }
+
+        // The state derivative at the start of the step is shared by all columns and attempts.
+        const detail::RecordedStateDerivative<Real, State, StateDerivative, Statistics>
+            recordedStateDerivative(computeStateDerivative, statistics);
+        recordedStateDerivative(time, state, workspace[initialStateDerivativeIndex]);
+
+        while (true)
+        {
+            const int column = numberOfColumns;
+            int lastColumn = column;
+            try
+            {
+                computeColumns(1, column, time, state, stepSize, computeStateDerivative);
+            }
+            catch (...)
+            {
+                statistics.stopStep();
+                throw;
+            }
+            for (int j = 1; j <= column; ++j)
+            {
+                extrapolateColumn(j, state, stepSize, computeError);
+            }
+
+            bool isAccepted = errors[column] <= 1.0;
+            if (!isAccepted)
+            {
+                lastColumn = column + 1;
+                try
+                {
+                    computeColumns(lastColumn, lastColumn, time, state, stepSize,
+                                   computeStateDerivative);
+                }
+                catch (...)
+                {
+                    statistics.stopStep();
+                    throw;
+                }
+                extrapolateColumn(lastColumn, state, stepSize, computeError);
+                isAccepted = errors[lastColumn] <= 1.0;
+            }
+
+            // Select number of columns for next attempt or step with the lowest work per unit
+            // step, i.e., the number of evaluations divided by the attainable step size.
+            const int selectedColumn = isAccepted ? lastColumn : column;
+            int nextColumn = std::min(selectedColumn, maximumNumberOfColumns - 1);
+            bool isIncreased = false;
+            if (selectedColumn > 3
+                && computeWorkPerUnitStep(selectedColumn - 1, errorEstimateOrderOffset)
+                   < 0.8 * computeWorkPerUnitStep(selectedColumn, errorEstimateOrderOffset))
+            {
+                nextColumn = selectedColumn - 1;
+            }
+            else if (isAccepted
+                     && lastColumn == column
+                     && column < maximumNumberOfColumns - 1
+                     && computeWorkPerUnitStep(column, errorEstimateOrderOffset)
+                        < 0.9 * computeWorkPerUnitStep(column - 1, errorEstimateOrderOffset))
+            {
+                nextColumn = column + 1;
+                isIncreased = true;
+            }
+
+            const int factorColumn = isIncreased ? column : nextColumn;
+            Real stepSizeFactor = controller.computeStepSizeFactor(
+                errors[factorColumn], getErrorEstimateOrder(factorColumn, errorEstimateOrderOffset),
+                isAccepted);
+            if (isIncreased)
+            {
+                stepSizeFactor *= static_cast<Real>(computeWork(column + 1)) / computeWork(column);
+            }
+            numberOfColumns = nextColumn;
+
+            if (isAccepted)
+            {
+                statistics.recordAcceptedStep(stepSize);
+                time += stepSize;
+                using std::swap;
+                swap(state, currentRow[lastColumn - 1]);
+
+                stepSize = stepSizeFactor * stepSize;
+                if (stepSize > maximumStepSize)
+                {
+                    stepSize = maximumStepSize;
+                }
+                else if (stepSize < minimumStepSize)
+                {
+                    stepSize = minimumStepSize;
+                }
+                statistics.stopStep();
+                return;
+            }
+
+            statistics.recordRejectedStep(stepSize);
+            stepSize = stepSizeFactor * stepSize;
+            if (stepSize > maximumStepSize)
+            {
+                stepSize = maximumStepSize;
+            }
+            else if (stepSize < minimumStepSize)
+            {
+                statistics.stopStep();
+                throw std::runtime_error("Minimum step size exceeded!");
+            }
+        }
+    }
+
+    //! Compute given range of columns, in parallel if the stepper has more than one thread.
+    /*!
+     * Computes the modified midpoint solutions of the given columns. In parallel mode, the columns
+     * are assigned to the workers in order of decreasing cost, each to the worker with the lowest
+     * load. The evaluations of each column are added to the statistics of the stepper afterwards.
+     */
+    template <typename StateDerivative>
+    void computeColumns(const int firstColumn,
+                        const int lastColumn,
+                        const Real time,
+                        const State& state,
+                        const Real stepSize,
+                        const StateDerivative& computeStateDerivative)
+    {
+        if (!pool || firstColumn == lastColumn)
+        {
+            for (int column = firstColumn; column <= lastColumn; ++column)
+            {
+                computeColumn(column, time, state, stepSize, computeStateDerivative);
+            }
+        }
+        else
+        {
+            std::fill(workerLoads.begin(), workerLoads.end(), 0);
+            for (int column = lastColumn; column >= firstColumn; --column)
+            {
+                const int worker = static_cast<int>(
+                    std::min_element(workerLoads.begin(), workerLoads.end())
+                    - workerLoads.begin());
+                columnWorkers[column] = worker;
+                workerLoads[worker] += 2 * column - 1;
+            }
+
+            pool->run([&](const int worker)
+            {
+                for (int column = firstColumn; column <= lastColumn; ++column)
+                {
+                    if (columnWorkers[column] == worker)
+                    {
+                        computeColumn(column, time, state, stepSize, computeStateDerivative);
+                    }
+                }
+            });
+        }
+
+        for (int column = firstColumn; column <= lastColumn; ++column)
+        {
+            statistics += columnStatistics[column];
+            columnStatistics[column] = Statistics();
+        }
+    }
+
+    //! Compute modified midpoint solution of given column, with 2 * column substeps.
+    /*!
+     * Computes the modified midpoint solution without smoothing step, i.e., z_0 = y,
+     * z_1 = y + h f(t, y) and z_(m+1) = z_(m-1) + 2 h f(t + m h, z_m). The solutions at even and
+     * odd substeps are kept in separate states, so that the result is the solution at even
+     * substeps.
+     */
+    template <typename StateDerivative>
+    void computeColumn(const int column,
+                       const Real time,
+                       const State& state,
+                       const Real stepSize,
+                       const StateDerivative& computeStateDerivative)
+    {
+        const detail::RecordedStateDerivative<Real, State, StateDerivative, Statistics>
+            recordedStateDerivative(computeStateDerivative, columnStatistics[column]);
+
+        const int numberOfSubsteps = 2 * column;
+        const Real substepSize = stepSize / numberOfSubsteps;
+        State& evenState = columnWorkspace[columnWorkspaceSize * (column - 1)];
+        State& oddState = columnWorkspace[columnWorkspaceSize * (column - 1) + 1];
+        State& stateDerivative = columnWorkspace[columnWorkspaceSize * (column - 1) + 2];
+
+        evenState = state;
+        computeLinearCombination(oddState, state, substepSize,
+                                 1.0, workspace[initialStateDerivativeIndex]);
+        for (int substep = 1; substep < numberOfSubsteps; ++substep)
+        {
+            const Real substepTime = time + substep * stepSize / numberOfSubsteps;
+            State& currentState = substep % 2 == 1 ? oddState : evenState;
+            State& nextState = substep % 2 == 1 ? evenState : oddState;
+            recordedStateDerivative(substepTime, currentState, stateDerivative);
+            computeLinearCombination(nextState, nextState, 2 * substepSize,
+                                     1.0, stateDerivative);
+        }
+    }
+
+    //! Extrapolate solution of given column and compute its scaled error (from column 2).
+    /*!
+     * Computes row T_(column, 1..column) of the extrapolation table from the modified midpoint
+     * solution of the column and the row of the previous column, i.e., T_(j, l + 1) = T_(j, l) +
+     * (T_(j, l) - T_(j - 1, l)) / ((n_j / n_(j - l))^2 - 1). The error estimate is
+     * T_(j, j) - T_(j, j - 1).
+     */
+    template <typename ErrorNorm>
+    void extrapolateColumn(const int column,
+                           const State& state,
+                           const Real stepSize,
+                           const ErrorNorm& computeError)
+    {
+        using std::swap;
+        swap(previousRow, currentRow);
+        swap(currentRow[0], columnWorkspace[columnWorkspaceSize * (column - 1)]);
+        for (int l = 1; l < column; ++l)
+        {
+            const Real ratio = static_cast<Real>(column) / (column - l);
+            const Real scale = 1.0 / (ratio * ratio - 1.0);
+            computeLinearCombination(currentRow[l], currentRow[l - 1], scale,
+                                     1.0, currentRow[l - 1], -1.0, previousRow[l - 1]);
+        }
+
+        if (column > 1)
+        {
+            State& errorEstimate = workspace[errorEstimateIndex];
+            const Real scale = -1.0;
+            computeLinearCombination(errorEstimate, currentRow[column - 1], scale,
+                                     1.0, currentRow[column - 2]);
+            errors[column] = computeError(errorEstimate, state, currentRow[column - 1], stepSize);
+        }
+    }
+
+    //! Get order of error estimate of given column, including offset of error norm.
+    static int getErrorEstimateOrder(const int column, const int errorEstimateOrderOffset)
+    {
+        return 2 * column - 2 + errorEstimateOrderOffset;
+    }
+
+    //! Compute number of state derivative evaluations of columns 1 to given column.
+    static int computeWork(const int column)
+    {
+        return 1 + column * column;
+    }
+
+    //! Compute work per unit step of given column, up to a common factor.
+    Real computeWorkPerUnitStep(const int column, const int errorEstimateOrderOffset) const
+    {
+        return computeWork(column)
+               * std::pow(errors[column],
+                          1.0 / getErrorEstimateOrder(column, errorEstimateOrderOffset));
+    }
+
+    //! Maximum number of columns of extrapolation table.
+    int maximumNumberOfColumns;
+
+    //! Number of threads that compute the columns, including the calling thread.
+    int numberOfThreads;
+
+    //! Number of columns of extrapolation table for next step.
+    int numberOfColumns;
+
+    //! Storage for state derivative at start of step and error estimate.
+    std::vector<State> workspace;
+
+    //! Storage for modified midpoint solutions and state derivative of each column.
+    std::vector<State> columnWorkspace;
+
+    //! Row of extrapolation table of previous column.
+    std::vector<State> previousRow;
+
+    //! Row of extrapolation table of current column.
+    std::vector<State> currentRow;
+
+    //! Scaled errors of columns (from column 2).
+    std::vector<Real> errors;
+
+    //! Statistics collected by each column during current attempt.
+    std::vector<Statistics> columnStatistics;
+
+    //! Worker to which each column is assigned in parallel mode.
+    std::vector<int> columnWorkers;
+
+    //! Number of state derivative evaluations assigned to each worker in parallel mode.
+    std::vector<int> workerLoads;
+
+    //! Pool of worker threads (only in parallel mode).
+    std::unique_ptr<detail::WorkerPool> pool;
+
+    //! Statistics collected by stepper.
+    Statistics statistics;
+};
+
+} // namespace integrate
@@ -0,0 +1,400 @@
+/*
+ * Copyright (c) 2014-2025 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "integrate/linearCombination.hpp"
+
+namespace integrate
+{
+
+//! Checkpoint of integration, from which the integration is resumed bit-identically.
+/*!
+ * Compact binary snapshot of everything that determines the continuation of an integration: the
+ * time, state and step size, and the internal state of the stepper, step size controller and
+ * statistics, e.g., the state derivative that an FSAL stepper reuses in its next step, the
+ * history of a multistep stepper and the scaled errors of the previous steps of the controller.
+ * Configuration, e.g., tolerances, gains or the maximum order, is not stored, since it is given
+ * on construction; a checkpoint is restored into components that are constructed with the same
+ * configuration as the components it was taken from.
+ *
+ * Components write their state with writeCheckpoint() and read it back, in the same order, with
+ * readCheckpoint(); saveCheckpoint() and restoreCheckpoint() do so for a complete integration.
+ * Values are appended to an in-memory buffer, whose storage is kept by clear(), so that taking a
+ * snapshot does not allocate after the first one, and costs about as much as copying the stepper
+ * histories. Writing the snapshot to a file is a separate step (save()), which replaces the file
+ * atomically, so that an interruption while saving leaves the previous checkpoint intact.
+ *
+ * A checkpoint file consists of a header, i.e., magic "ICHKPNT" (8 bytes, including terminating
+ * zero), format version (uint32), number of bytes per value (uint32) and number of bytes of data
+ * (uint64), followed by the data, in native byte order.
+ *
+ * @tparam  Real  Type for floating-point number
+ */
+template <typename Real>
+class Checkpoint
+{
+public:
+
+    //! Version of file format.
+    static const std::uint32_t formatVersion = 1;
+
+    //! Construct empty checkpoint.
+    Checkpoint()
+        : readPosition(0)
+    { }
+
+    //! Discard data, but keep storage for next snapshot.
+    void clear()
+    {
+        data.clear();
+        readPosition = 0;
+    }
+
+    //! Get number of bytes of data.
+    std::size_t getSize() const { return data.size(); }
+
+    //! Check if all data was read.
+    bool isRead() const { return readPosition == data.size(); }
+
+    //! Restart reading at first value.
+    void rewind() { readPosition = 0; }
+
+    //! Append value of arithmetic type, e.g., time, counter or flag.
+    template <typename Value>
+    void write(const Value value)
+    {
+        static_assert(std::is_arithmetic<Value>::value, "Checkpoint values must be arithmetic");
+        append(&value, sizeof(value));
+    }
+
+    //! Read value of arithmetic type.
+    /*!
+     * Reads next value.
+     *
+     * @throws std::runtime_error  If checkpoint does not contain more data
+     *
+     * @param[out]  value  Value that is read
+     */
+    template <typename Value>
+    void read(Value& value)
+    {
+        static_assert(std::is_arithmetic<Value>::value, "Checkpoint values must be arithmetic");
+        extract(&value, sizeof(value));
+    }
+
+    //! Append number of elements and elements of state.
+    template <typename State>
+    void writeState(const State& state)
+    {
+        static_assert(StateTraits<State>::isIndexable, "Checkpoint requires indexable state");
+        const std::uint64_t size = static_cast<std::uint64_t>(state.size());
+        append(&size, sizeof(size));
+        const std::size_t start = data.size();
+        data.resize(start + size * sizeof(Real));
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            const Real element = state[i];
+            std::memcpy(&data[start + i * sizeof(Real)], &element, sizeof(Real));
+        }
+    }
+
+    //! Read elements of state.
+    /*!
+     * Reads next state into given state, which must have the number of elements of the state that
+     * was written, e.g., because it is a copy of the initial state.
+     *
+     * @throws std::runtime_error  If number of elements differs from that of given state, or if
+     *                             checkpoint does not contain more data
+     *
+     * @param[in,out]  state  State, whose elements are read
+     */
+    template <typename State>
+    void readState(State& state)
+    {
+        static_assert(StateTraits<State>::isIndexable, "Checkpoint requires indexable state");
+        std::uint64_t size = 0;
+        extract(&size, sizeof(size));
+        if (size != static_cast<std::uint64_t>(state.size()))
+        {
+            throw std::runtime_error("Checkpoint state size differs from state size!");
+        }
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            Real element;
+            extract(&element, sizeof(Real));
+            state[i] = element;
+        }
+    }
+
+    //! Write checkpoint to file.
+    /*!
+     * Writes checkpoint to a temporary file, which then replaces the file with given name, so
+     * that an existing checkpoint file is only replaced by a complete one.
+     *
+     * @throws std::runtime_error  If file cannot be written
+     *
+     * @param[in]  fileName  Name of checkpoint file
+     */
+    void save(const std::string& fileName) const
+    {
+        const std::string temporaryFileName = fileName + ".tmp";
+        std::FILE* const file = std::fopen(temporaryFileName.c_str(), "wb");
+        if (file == 0)
+        {
+            throw std::runtime_error("Checkpoint file could not be opened!");
+        }
+        char header[24] = "ICHKPNT";
+        const std::uint32_t version = formatVersion;
+        const std::uint32_t bytesPerValue = sizeof(Real);
+        const std::uint64_t size = data.size();
+        std::memcpy(header + 8, &version, sizeof(version));
+        std::memcpy(header + 12, &bytesPerValue, sizeof(bytesPerValue));
+        std::memcpy(header + 16, &size, sizeof(size));
+        const bool isWritten = std::fwrite(header, 1, sizeof(header), file) == sizeof(header)
+                               && std::fwrite(data.data(), 1, data.size(), file) == data.size();
+        if (std::fclose(file) != 0 || !isWritten)
+        {
+            std::remove(temporaryFileName.c_str());
+            throw std::runtime_error("Checkpoint file could not be written!");
+        }
+
+        // Renaming does not replace an existing file on all platforms.
+        if (std::rename(temporaryFileName.c_str(), fileName.c_str()) != 0
+            && (std::remove(fileName.c_str()) != 0
+                || std::rename(temporaryFileName.c_str(), fileName.c_str()) != 0))
+        {
+            throw std::runtime_error("Checkpoint file could not be written!");
+        }
+    }
+
+    //! Read checkpoint from file.
+    /*!
+     * Replaces data with that of checkpoint file with given name, and restarts reading.
+     *
+     * @throws std::runtime_error  If file cannot be read, or is not a checkpoint file of the
+     *                             current format version with values of type Real
+     *
+     * @param[in]  fileName  Name of checkpoint file
+     */
+    void load(const std::string& fileName)
+    {
+        std::FILE* const file = std::fopen(fileName.c_str(), "rb");
+        if (file == 0)
+        {
+            throw std::runtime_error("Checkpoint file could not be opened!");
+        }
+        char header[24];
+        std::uint32_t version = 0;
+        std::uint32_t bytesPerValue = 0;
+        std::uint64_t size = 0;
+        bool isValid = std::fread(header, 1, sizeof(header), file) == sizeof(header);
+        if (isValid)
+        {
+            std::memcpy(&version, header + 8, sizeof(version));
+            std::memcpy(&bytesPerValue, header + 12, sizeof(bytesPerValue));
+            std::memcpy(&size, header + 16, sizeof(size));
+            isValid = std::strncmp(header, "ICHKPNT", 8) == 0
+                      && version == formatVersion
+                      && bytesPerValue == sizeof(Real);
+        }
+        if (isValid)
+        {
+            data.resize(static_cast<std::size_t>(size));
+            char extraByte;
+            isValid = std::fread(data.data(), 1, data.size(), file) == data.size()
+                      && std::fread(&extraByte, 1, 1, file) == 0;
+        }
+        std::fclose(file);
+        readPosition = 0;
+        if (!isValid)
+        {
+            data.clear();
+            throw std::runtime_error("Checkpoint file could not be read!");
+        }
+    }
+
+protected:
+private:
+
+    //! Append bytes to data.
+    void append(const void* const value, const std::size_t size)
+    {
+        const std::size_t start = data.size();
+        data.resize(start + size);
+        std::memcpy(&data[start], value, size);
+    }
+
+    //! Extract next bytes from data.
+    void extract(void* const value, const std::size_t size)
+    {
+        if (data.size() - readPosition < size)
+        {
+            throw std::runtime_error("Checkpoint does not contain more data!");
+        }
+        std::memcpy(value, &data[readPosition], size);
+        readPosition += size;
+    }
+
+    //! Data of checkpoint.
+    std::vector<char> data;
+
+    //! Position of next value to read.
+    std::size_t readPosition;
+};
+
+//! Take checkpoint of integration with adaptive step size.
+/*!
+ * Replaces data of checkpoint with the time, state and step size of the integration, and the
+ * internal state of the stepper, including its statistics.
+ *
+ * @tparam      Real        Type for floating-point number
+ * @tparam      State       Type for state (indexable)
+ * @tparam      Stepper     Type of stepper that provides writeCheckpoint(), e.g., DOPRI5Stepper,
+ *                          AdamsBashforthMoultonStepper or BDFStepper
+ * @param[out]  checkpoint  Checkpoint to which integration is written
+ * @param[in]   time        Current time
+ * @param[in]   state       Current state
+ * @param[in]   stepSize    Step size for next integration step
+ * @param[in]   stepper     Stepper used to execute integration steps
+ */
+template <typename Real, typename State, typename Stepper>
+void saveCheckpoint(Checkpoint<Real>& checkpoint,
+                    const Real time,
+                    const State& state,
+                    const Real stepSize,
+                    const Stepper& stepper)
+{
+    checkpoint.clear();
+    checkpoint.write(time);
+    checkpoint.writeState(state);
+    checkpoint.write(stepSize);
+    stepper.writeCheckpoint(checkpoint);
+}
+
+//! Take checkpoint of integration with adaptive step size and step size controller.
+/*!
+ * Replaces data of checkpoint with the time, state and step size of the integration, and the
+ * internal state of the stepper, including its statistics, and of the step size controller.
+ *
+ * @tparam      Real        Type for floating-point number
+ * @tparam      State       Type for state (indexable)
+ * @tparam      Stepper     Type of stepper that provides writeCheckpoint(), e.g., DOPRI5Stepper,
+ *                          AdamsBashforthMoultonStepper or BDFStepper
+ * @tparam      Controller  Type of step size controller, e.g., StepSizeController
+ * @param[out]  checkpoint  Checkpoint to which integration is written
+ * @param[in]   time        Current time
+ * @param[in]   state       Current state
+ * @param[in]   stepSize    Step size for next integration step
+ * @param[in]   stepper     Stepper used to execute integration steps
+ * @param[in]   controller  Step size controller
+ */
+template <typename Real, typename State, typename Stepper, typename Controller>
+void saveCheckpoint(Checkpoint<Real>& checkpoint,
+                    const Real time,
+                    const State& state,
+                    const Real stepSize,
+                    const Stepper& stepper,
+                    const Controller& controller)
+{
+    saveCheckpoint(checkpoint, time, state, stepSize, stepper);
+    controller.writeCheckpoint(checkpoint);
+}
+
+//! Restore integration with adaptive step size from checkpoint.
+/*!
+ * Restores time, state and step size of the integration, and the internal state of the stepper,
+ * including its statistics, from a checkpoint taken with saveCheckpoint(), so that the
+ * integration continues bit-identically to the integration from which the checkpoint was taken.
+ *
+ * @throws std::runtime_error  If checkpoint does not match integration, e.g., because it was
+ *                             taken with another type of stepper or with a different state size
+ *
+ * @tparam         Real        Type for floating-point number
+ * @tparam         State       Type for state (indexable)
+ * @tparam         Stepper     Type of stepper that provides readCheckpoint(), e.g.,
+ *                             DOPRI5Stepper, AdamsBashforthMoultonStepper or BDFStepper
+ * @param[in,out]  checkpoint  Checkpoint from which integration is read
+ * @param[out]     time        Current time
+ * @param[in,out]  state       State with the number of elements of the integration, which is
+ *                             updated with current state
+ * @param[out]     stepSize    Step size for next integration step
+ * @param[in,out]  stepper     Stepper used to execute integration steps, which is constructed
+ *                             with the same configuration as the stepper of the checkpoint
+ */
+template <typename Real, typename State, typename Stepper>
+void restoreCheckpoint(Checkpoint<Real>& checkpoint,
+                       Real& time,
+                       State& state,
+                       Real& stepSize,
+                       Stepper& stepper)
+{
+    checkpoint.rewind();
+    checkpoint.read(time);
+    checkpoint.readState(state);
+    checkpoint.read(stepSize);
+    stepper.readCheckpoint(checkpoint, state);
+    if (!checkpoint.isRead())
+    {
+        throw std::runtime_error("Checkpoint does not match integration!");
+    }
+}
+
+//! Restore integration with adaptive step size and step size controller from checkpoint.
+/*!
+ * Restores time, state and step size of the integration, and the internal state of the stepper,
+ * including its statistics, and of the step size controller from a checkpoint taken with
+ * saveCheckpoint(), so that the integration continues bit-identically to the integration from
+ * which the checkpoint was taken.
+ *
+ * @throws std::runtime_error  If checkpoint does not match integration, e.g., because it was
+ *                             taken with another type of stepper or with a different state size
+ *
+ * @tparam         Real        Type for floating-point number
+ * @tparam         State       Type for state (indexable)
+ * @tparam         Stepper     Type of stepper that provides readCheckpoint(), e.g.,
+ *                             DOPRI5Stepper, AdamsBashforthMoultonStepper or BDFStepper
+ * @tparam         Controller  Type of step size controller, e.g., StepSizeController
+ * @param[in,out]  checkpoint  Checkpoint from which integration is read
+ * @param[out]     time        Current time
+ * @param[in,out]  state       State with the number of elements of the integration, which is
+ *                             updated with current state
+ * @param[out]     stepSize    Step size for next integration step
+ * @param[in,out]  stepper     Stepper used to execute integration steps, which is constructed
+ *                             with the same configuration as the stepper of the checkpoint
+ * @param[in,out]  controller  Step size controller, which is constructed with the same
+ *                             configuration as the controller of the checkpoint
+ */
+template <typename Real, typename State, typename Stepper, typename Controller>
+void restoreCheckpoint(Checkpoint<Real>& checkpoint,
+                       Real& time,
+                       State& state,
+                       Real& stepSize,
+                       Stepper& stepper,
+                       Controller& controller)
+{
+    checkpoint.rewind();
+    checkpoint.read(time);
+    checkpoint.readState(state);
+    checkpoint.read(stepSize);
+    stepper.readCheckpoint(checkpoint, state);
+    controller.readCheckpoint(checkpoint);
+    if (!checkpoint.isRead())
+    {
+        throw std::runtime_error("Checkpoint does not match integration!");
+    }
+}
+
+} // namespace integrate
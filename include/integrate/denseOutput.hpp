@@ -0,0 +1,251 @@
+/*
+ * Copyright (c) 2014-2025 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include "integrate/integrateAdaptive.hpp"
+#include "integrate/linearCombination.hpp"
+
+namespace integrate
+{
+
+//! Compute cubic Hermite interpolation between states at start and end of integration step.
+/*!
+ * Computes the cubic Hermite polynomial that matches the states and state derivatives at the
+ * start and end of an integration step, at given fraction of the step, i.e., at time
+ * startTime + stepFraction * stepSize. The interpolation is third-order accurate, is continuous
+ * with continuous derivative across steps, and costs a single linear combination of four states,
+ * so that it can be used as continuous extension of any stepper that provides the state
+ * derivatives at both ends of its steps.
+ *
+ * @tparam       Real             Type for floating-point number
+ * @tparam       State            Type for state and state derivative
+ * @param[out]   result           Interpolated state (must not alias input states)
+ * @param[in]    stepFraction     Fraction of step at which state is interpolated, i.e., between 0
+ *                                and 1 (extrapolated otherwise)
+ * @param[in]    stepSize         Step size of integration step
+ * @param[in]    startState       State at start of step
+ * @param[in]    startDerivative  State derivative at start of step
+ * @param[in]    endState         State at end of step
+ * @param[in]    endDerivative    State derivative at end of step
+ */
+template <typename Real, typename State>
+void computeHermiteInterpolation(State& result,
+                                 const Real stepFraction,
+                                 const Real stepSize,
+                                 const State& startState,
+                                 const State& startDerivative,
+                                 const State& endState,
+                                 const State& endDerivative)
+{
+    const Real theta = stepFraction;
+    const Real thetaSquared = theta * theta;
+    const Real thetaCubed = thetaSquared * theta;
+    const Real coefficients[4] = {
+        2.0 * thetaCubed - 3.0 * thetaSquared + 1.0,
+        -2.0 * thetaCubed + 3.0 * thetaSquared,
+        stepSize * (thetaCubed - 2.0 * thetaSquared + theta),
+        stepSize * (thetaCubed - thetaSquared)
+    };
+    const State* const terms[4] = {&startState, &endState, &startDerivative, &endDerivative};
+    computeWeightedSum(result, Real(1), coefficients, terms);
+}
+
+namespace detail
+{
+
+//! Integrate to last output time using given function to execute adaptive integration steps.
+template <typename Real, typename State, typename Stepper, typename Observer, typename AdaptiveStep>
+int integrateDenseOutput(const Stepper& stepper,
+                         Real& time,
+                         const State& state,
+                         Real& stepSize,
+                         const std::vector<Real>& outputTimes,
+                         const Real minimumStepSize,
+                         const Observer& observe,
+                         const AdaptiveStep& executeStep)
+{
+    if (outputTimes.empty())
+    {
+        return 0;
+    }
+    if (outputTimes.front() < time || !std::is_sorted(outputTimes.begin(), outputTimes.end()))
+    {
+        throw std::runtime_error(
+            "Output times must be sorted and must not lie before current time!");
+    }
+
+    std::size_t outputIndex = 0;
+    State outputState = state;
+    const int numberOfSteps = integrateAdaptive(
+        time, stepSize, outputTimes.back(), minimumStepSize,
+        [&](Real& currentStepSize, const Real currentMinimumStepSize)
+    {
+        // Output times at the start of the step are reported before the step is executed, so
+        // that the interpolant is only evaluated within the step.
+        while (outputIndex < outputTimes.size() && outputTimes[outputIndex] == time)
+        {
+            observe(time, state);
+            ++outputIndex;
+        }
+        executeStep(currentStepSize, currentMinimumStepSize);
+        while (outputIndex < outputTimes.size() && outputTimes[outputIndex] < time)
+        {
+            stepper.interpolate(outputTimes[outputIndex], outputState);
+            observe(outputTimes[outputIndex], outputState);
+            ++outputIndex;
+        }
+    });
+
+    // Remaining output times are equal to the final time.
+    for (; outputIndex < outputTimes.size(); ++outputIndex)
+    {
+        observe(outputTimes[outputIndex], state);
+    }
+    return numberOfSteps;
+}
+
+} // namespace detail
+
+//! Integrate to last output time using adaptive step size and report state at output times.
+/*!
+ * Integrates from current time to the last of the given output times by executing adaptive
+ * integration steps with given stepper, and reports the state at each output time to the given
+ * observer. The steps are not shortened to hit the output times; instead, the state at output
+ * times within a step is computed with the continuous extension of the stepper (see
+ * ExplicitRungeKuttaStepper::interpolate), so that the number of steps is determined by the
+ * tolerance only, and dense output grids cost a polynomial evaluation per output time. Only the
+ * last step is shortened, so that the integration ends exactly at the last output time.
+ *
+ * @throws std::runtime_error  If output times are not sorted or lie before current time, if the
+ *                             stepper does not provide dense output, or if the stepper throws
+ *                             because the minimum step size is exceeded
+ *
+ * @tparam         Real                    Type for floating-point number
+ * @tparam         State                   Type for state and state derivative
+ * @tparam         Stepper                 Type of stepper that provides adaptive step function and
+ *                                         dense output, e.g., DOPRI5Stepper
+ * @tparam         StateDerivative         Type of callable to compute state derivative, e.g.,
+ *                                         function pointer, functor, lambda or
+ *                                         StateDerivativeFunction
+ * @tparam         Observer                Type of callable that receives output, i.e.,
+ *                                         void observe(const Real time, const State& state)
+ * @param[in,out]  stepper                 Stepper used to execute integration steps
+ * @param[in,out]  time                    Independent variable, which is provided as input and is
+ *                                         equal to the last output time at end of integration
+ * @param[in,out]  state                   State, which is provided as input and is updated with
+ *                                         output at end of integration
+ * @param[in,out]  stepSize                Step size to take for first integration step, which is
+ *                                         updated with step size for next integration step
+ * @param[in]      outputTimes             Sorted times at which state is reported
+ * @param[in]      computeStateDerivative  Function to compute state derivative for current time
+ *                                         and state
+ * @param[in]      tolerance               Local truncation error tolerance
+ * @param[in]      minimumStepSize         Minimum allowable step size for integration steps
+ * @param[in]      maximumStepSize         Maximum allowable step size for integration steps
+ * @param[in]      observe                 Function that receives time and state at output times
+ * @return                                 Number of accepted integration steps
+ */
+template <typename Real,
+          typename State,
+          typename Stepper,
+          typename StateDerivative,
+          typename Observer>
+int integrateDenseOutput(Stepper& stepper,
+                         Real& time,
+                         State& state,
+                         Real& stepSize,
+                         const std::vector<Real>& outputTimes,
+                         const StateDerivative& computeStateDerivative,
+                         const Real tolerance,
+                         const Real minimumStepSize,
+                         const Real maximumStepSize,
+                         const Observer& observe)
+{
+    return detail::integrateDenseOutput(
+        stepper, time, state, stepSize, outputTimes, minimumStepSize, observe,
+        [&](Real& currentStepSize, const Real currentMinimumStepSize)
+    {
+        stepper.step(time, state, currentStepSize, computeStateDerivative, tolerance,
+                     currentMinimumStepSize, maximumStepSize);
+    });
+}
+
+//! Integrate to last output time using error norm and controller, and report state at outputs.
+/*!
+ * Integrates from current time to the last of the given output times by executing adaptive
+ * integration steps with given stepper, error norm, e.g., WeightedRootMeanSquareErrorNorm, and
+ * step size controller, and reports the state at each output time to the given observer. See the
+ * overload that takes a scalar tolerance for details on how the output is computed.
+ *
+ * @throws std::runtime_error  If output times are not sorted or lie before current time, if the
+ *                             stepper does not provide dense output, or if the stepper throws
+ *                             because the minimum step size is exceeded
+ *
+ * @tparam         Real                    Type for floating-point number
+ * @tparam         State                   Type for state and state derivative
+ * @tparam         Stepper                 Type of stepper that provides adaptive step function and
+ *                                         dense output, e.g., DOPRI5Stepper
+ * @tparam         StateDerivative         Type of callable to compute state derivative, e.g.,
+ *                                         function pointer, functor, lambda or
+ *                                         StateDerivativeFunction
+ * @tparam         ErrorNorm               Type of callable to compute scaled error, e.g.,
+ *                                         WeightedRootMeanSquareErrorNorm
+ * @tparam         Controller              Type of step size controller, e.g., StepSizeController
+ * @tparam         Observer                Type of callable that receives output, i.e.,
+ *                                         void observe(const Real time, const State& state)
+ * @param[in,out]  stepper                 Stepper used to execute integration steps
+ * @param[in,out]  time                    Independent variable, which is provided as input and is
+ *                                         equal to the last output time at end of integration
+ * @param[in,out]  state                   State, which is provided as input and is updated with
+ *                                         output at end of integration
+ * @param[in,out]  stepSize                Step size to take for first integration step, which is
+ *                                         updated with step size for next integration step
+ * @param[in]      outputTimes             Sorted times at which state is reported
+ * @param[in]      computeStateDerivative  Function to compute state derivative for current time
+ *                                         and state
+ * @param[in]      computeError            Function to compute scaled error of error estimate
+ * @param[in,out]  controller              Step size controller, which is updated with scaled
+ *                                         errors of accepted steps
+ * @param[in]      minimumStepSize         Minimum allowable step size for integration steps
+ * @param[in]      maximumStepSize         Maximum allowable step size for integration steps
+ * @param[in]      observe                 Function that receives time and state at output times
+ * @return                                 Number of accepted integration steps
+ */
+template <typename Real,
+          typename State,
+          typename Stepper,
+          typename StateDerivative,
+          typename ErrorNorm,
+          typename Controller,
+          typename Observer>
+int integrateDenseOutput(Stepper& stepper,
+                         Real& time,
+                         State& state,
+                         Real& stepSize,
+                         const std::vector<Real>& outputTimes,
+                         const StateDerivative& computeStateDerivative,
+                         const ErrorNorm& computeError,
+                         Controller& controller,
+                         const Real minimumStepSize,
+                         const Real maximumStepSize,
+                         const Observer& observe)
+{
+    return detail::integrateDenseOutput(
+        stepper, time, state, stepSize, outputTimes, minimumStepSize, observe,
+        [&](Real& currentStepSize, const Real currentMinimumStepSize)
+    {
+        stepper.step(time, state, currentStepSize, computeStateDerivative, computeError,
+                     controller, currentMinimumStepSize, maximumStepSize);
+    });
+}
+
+} // namespace integrate
@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2014-2025 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "integrate/explicitRungeKutta.hpp"
+#include "integrate/statistics.hpp"
+#include "integrate/stateDerivative.hpp"
+#include "integrate/threadLocalStepper.hpp"
+
+namespace integrate
+{
+
+//! Butcher tableau for Dormand-Prince 5(4) scheme.
+/*!
+ * Butcher tableau for the Dormand-Prince 5(4) scheme, which propagates the 5th-order solution
+ * (Dormand & Prince, 1980; Hairer et al., 1993). The last stage is evaluated with the propagated
+ * solution at the end of the step (First-Same-As-Last), so that an accepted step costs six state
+ * derivative evaluations when it is reused by DOPRI5Stepper. The tableau defines the 4th-order
+ * continuous extension of Dormand & Prince, which DOPRI5Stepper uses for dense output.
+ *
+ * @tparam  Real  Type for floating-point number
+ */
+template <typename Real>
+struct DOPRI5Tableau
+{
+    //! Number of stages.
+    static const int numberOfStages = 7;
+
+    //! Order of propagated solution.
+    static const int order = 5;
+
+    //! Flag that indicates if tableau contains embedded solution.
+    static const bool isEmbedded = true;
+
+    //! Order of embedded solution.
+    static const int embeddedOrder = 4;
+
+    //! Flag that indicates if last stage is evaluated at end of step with propagated solution.
+    static const bool isFirstSameAsLast = true;
+
+    //! Nodes.
+    static constexpr Real c[7] = {0.0, 1.0 / 5.0, 3.0 / 10.0, 4.0 / 5.0, 8.0 / 9.0, 1.0, 1.0};
+
+    //! Runge-Kutta matrix (strictly lower-triangular; omitted coefficients are zero).
+    static constexpr Real a[7][7] = {
+        {},
+        {1.0 / 5.0},
+        {3.0 / 40.0, 9.0 / 40.0},
+        {44.0 / 45.0, -56.0 / 15.0, 32.0 / 9.0},
+        {19372.0 / 6561.0, -25360.0 / 2187.0, 64448.0 / 6561.0, -212.0 / 729.0},
+        {9017.0 / 3168.0, -355.0 / 33.0, 46732.0 / 5247.0, 49.0 / 176.0, -5103.0 / 18656.0},
+        {35.0 / 384.0, 0.0, 500.0 / 1113.0, 125.0 / 192.0, -2187.0 / 6784.0, 11.0 / 84.0}
+    };
+
+    //! Weights of propagated solution.
+    static constexpr Real b[7] = {
+        35.0 / 384.0, 0.0, 500.0 / 1113.0, 125.0 / 192.0, -2187.0 / 6784.0, 11.0 / 84.0, 0.0
+    };
+
+    //! Weights of embedded solution.
+    static constexpr Real bHat[7] = {
+        5179.0 / 57600.0, 0.0, 7571.0 / 16695.0, 393.0 / 640.0, -92097.0 / 339200.0,
+        187.0 / 2100.0, 1.0 / 40.0
+    };
+
+    //! Coefficients of polynomial weights of 4th-order continuous extension, i.e., coefficients
+    //! of theta, theta^2, theta^3 and theta^4 (Hairer et al., 1993, Section II.6). The weights
+    //! are b_i theta^2 (3 - 2 theta) + d_i theta^2 (1 - theta)^2, with additional terms for the
+    //! first and last stage, so that the interpolant matches the state derivatives at both ends.
+    static constexpr Real bTheta[7][4] = {
+        {1.0,
+         3.0 * 35.0 / 384.0 - 2.0 - 12715105075.0 / 11282082432.0,
+         -2.0 * 35.0 / 384.0 + 1.0 + 2.0 * 12715105075.0 / 11282082432.0,
+         -12715105075.0 / 11282082432.0},
+        {},
+        {0.0,
+         3.0 * 500.0 / 1113.0 + 87487479700.0 / 32700410799.0,
+         -2.0 * 500.0 / 1113.0 - 2.0 * 87487479700.0 / 32700410799.0,
+         87487479700.0 / 32700410799.0},
+        {0.0,
+         3.0 * 125.0 / 192.0 - 10690763975.0 / 1880347072.0,
+         -2.0 * 125.0 / 192.0 + 2.0 * 10690763975.0 / 1880347072.0,
+         -10690763975.0 / 1880347072.0},
+        {0.0,
+         -3.0 * 2187.0 / 6784.0 + 701980252875.0 / 199316789632.0,
+         2.0 * 2187.0 / 6784.0 - 2.0 * 701980252875.0 / 199316789632.0,
+         701980252875.0 / 199316789632.0},
+        {0.0,
+         3.0 * 11.0 / 84.0 - 1453857185.0 / 822651844.0,
+         -2.0 * 11.0 / 84.0 + 2.0 * 1453857185.0 / 822651844.0,
+         -1453857185.0 / 822651844.0},
+        {0.0,
+         -1.0 + 69997945.0 / 29380423.0,
+         1.0 - 2.0 * 69997945.0 / 29380423.0,
+         69997945.0 / 29380423.0}
+    };
+};
+
+template <typename Real> constexpr Real DOPRI5Tableau<Real>::c[7];
+template <typename Real> constexpr Real DOPRI5Tableau<Real>::a[7][7];
+template <typename Real> constexpr Real DOPRI5Tableau<Real>::b[7];
+template <typename Real> constexpr Real DOPRI5Tableau<Real>::bHat[7];
+template <typename Real> constexpr Real DOPRI5Tableau<Real>::bTheta[7][4];
+
+//! Dormand-Prince 5(4) stepper.
+/*!
+ * Stepper that executes integration steps using Dormand-Prince 5(4) scheme. The stepper keeps the
+ * last stage state derivative of each accepted step and reuses it as the first stage of the next
+ * step. See ExplicitRungeKuttaStepper for details.
+ *
+ * @tparam  Real        Type for floating-point number
+ * @tparam  State       Type for state and state derivative
+ * @tparam  Statistics  Statistics policy, e.g., NullStatistics or IntegrationStatistics
+ */
+template <typename Real, typename State, typename Statistics = NullStatistics>
+using DOPRI5Stepper = ExplicitRungeKuttaStepper<Real, State, DOPRI5Tableau<Real>, Statistics>;
+
+//! Execute single integration step using Dormand-Prince 5(4) scheme.
+/*!
+ * Executes single numerical integration step using Dormand-Prince 5(4) scheme. The stepper that
+ * holds the storage for the stages is kept per thread and reused across calls, so that memory is
+ * only allocated on the first call of each thread. Since the stepper is reset on each call, the
+ * First-Same-As-Last stage is not reused; use DOPRI5Stepper instead to reuse it across steps.
+ *
+ * @tparam         Real                    Type for floating-point number
+ * @tparam         State                   Type for state and state derivative
+ * @tparam         StateDerivative         Type of callable to compute state derivative, e.g.,
+ *                                         function pointer, functor, lambda or
+ *                                         StateDerivativeFunction
+ * @param[in,out]  time                    Independent variable, which is provided as input and is
+ *                                         updated with output at end of integration step
+ * @param[in,out]  state                   State, which is provided as input and is updated with
+ *                                         output at end of integration step
+ * @param[in,out]  stepSize                Step size to take for integration step
+ * @param[in]      computeStateDerivative  Function to compute state derivative for current time
+ *                                         and state
+ * @param[in]      tolerance               Local truncation error tolerance
+ * @param[in]      minimumStepSize         Minimum allowable step size for integration step
+ * @param[in]      maximumStepSize         Maximum allowable step size for integration step
+ */
+template <typename Real, typename State, typename StateDerivative>
+const void stepDOPRI5(
+    Real& time,
+    State& state,
+    Real& stepSize,
+    const StateDerivative& computeStateDerivative,
+    const Real tolerance,
+    const Real minimumStepSize,
+    const Real maximumStepSize)
+{
+    detail::ThreadLocalStepper<DOPRI5Stepper<Real, State> > threadLocalStepper;
+    DOPRI5Stepper<Real, State>& stepper = threadLocalStepper.get();
+    stepper.step(time,
+                 state,
+                 stepSize,
+                 computeStateDerivative,
+                 tolerance,
+                 minimumStepSize,
+                 maximumStepSize);
+};
+
+//! Execute single integration step using Dormand-Prince 5(4) scheme and collect statistics.
+/*!
+ * Executes single numerical integration step using Dormand-Prince 5(4) scheme, and adds the state
+ * derivative evaluations, accepted step and rejected step attempts of the integration step to the
+ * given statistics.
+ *
+ * @tparam         Real                    Type for floating-point number
+ * @tparam         State                   Type for state and state derivative
+ * @tparam         StateDerivative         Type of callable to compute state derivative, e.g.,
+ *                                         function pointer, functor, lambda or
+ *                                         StateDerivativeFunction
+ * @param[in,out]  time                    Independent variable, which is provided as input and is
+ *                                         updated with output at end of integration step
+ * @param[in,out]  state                   State, which is provided as input and is updated with
+ *                                         output at end of integration step
+ * @param[in,out]  stepSize                Step size to take for integration step
+ * @param[in]      computeStateDerivative  Function to compute state derivative for current time
+ *                                         and state
+ * @param[in]      tolerance               Local truncation error tolerance
+ * @param[in]      minimumStepSize         Minimum allowable step size for integration step
+ * @param[in]      maximumStepSize         Maximum allowable step size for integration step
+ * @param[in,out]  statistics              Statistics, which are updated with statistics of
+ *                                         integration step
+ */
+template <typename Real, typename State, typename StateDerivative>
+const void stepDOPRI5(
+    Real& time,
+    State& state,
+    Real& stepSize,
+    const StateDerivative& computeStateDerivative,
+    const Real tolerance,
+    const Real minimumStepSize,
+    const Real maximumStepSize,
+    IntegrationStatistics<Real>& statistics)
+{
+    typedef DOPRI5Stepper<Real, State, IntegrationStatistics<Real> > Stepper;
+    detail::ThreadLocalStepper<Stepper> threadLocalStepper;
+    Stepper& stepper = threadLocalStepper.get();
+    try
+    {
+        stepper.step(time,
+                     state,
+                     stepSize,
+                     computeStateDerivative,
+                     tolerance,
+                     minimumStepSize,
+                     maximumStepSize);
+    }
+    catch (...)
+    {
+        statistics += stepper.getStatistics();
+        throw;
+    }
+    statistics += stepper.getStatistics();
+};
+
+} // namespace integrate
@@ -0,0 +1,720 @@
+/*
+ * Copyright (c) 2014-2025 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#include "integrate/explicitRungeKutta.hpp"
+
+namespace integrate
+{
+
+//! Ensemble of states in structure-of-arrays layout.
+/*!
+ * Stores the states of an ensemble of independent trajectories of the same dynamical system in
+ * structure-of-arrays layout, i.e., the values of a given state element for all trajectories
+ * (lanes) are stored contiguously. Loops over the lanes of an element thus access contiguous
+ * memory without dependencies between iterations, which allows the compiler to vectorize them
+ * with the widest SIMD instructions that are enabled for the target (e.g., -mavx2 or -mavx512f),
+ * so that the throughput scales with the vector width instead of with the number of trajectories.
+ *
+ * @tparam  Real  Type for floating-point number
+ */
+template <typename Real>
+class EnsembleState
+{
+public:
+
+    //! Construct ensemble of states.
+    /*!
+     * Constructs ensemble of states with all elements set to zero.
+     *
+     * @param[in]  numberOfLanes    Number of trajectories in ensemble
+     * @param[in]  stateDimension   Number of elements of each state
+     */
+    EnsembleState(const int numberOfLanes = 0, const int stateDimension = 0)
+        : numberOfLanes(numberOfLanes),
+          stateDimension(stateDimension),
+          values(static_cast<std::size_t>(numberOfLanes) * stateDimension, 0.0)
+    { }
+
+    //! Get number of trajectories in ensemble.
+    int getNumberOfLanes() const { return numberOfLanes; }
+
+    //! Get number of elements of each state.
+    int getStateDimension() const { return stateDimension; }
+
+    //! Get pointer to contiguous values of given element for all lanes.
+    Real* getElement(const int element)
+    {
+        return values.data() + static_cast<std::size_t>(element) * numberOfLanes;
+    }
+
+    //! Get pointer to contiguous values of given element for all lanes.
+    const Real* getElement(const int element) const
+    {
+        return values.data() + static_cast<std::size_t>(element) * numberOfLanes;
+    }
+
+    //! Get value of given element of given lane.
+    Real& operator( )( const int lane, const int element )
+    {
+        return getElement(element)[lane];
+    }
+
+    //! Get value of given element of given lane.
+    const Real& operator( )( const int lane, const int element ) const
+    {
+        return getElement(element)[lane];
+    }
+
+    //! Set state of given lane.
+    /*!
+     * Sets state of given lane from an indexable state, e.g., std::vector or std::array.
+     *
+     * @tparam     State  Type for state, which provides operator[]
+     * @param[in]  lane   Index of lane
+     * @param[in]  state  State of lane
+     */
+    template <typename State>
+    void setLane(const int lane, const State& state)
+    {
+        for (int element = 0; element < stateDimension; ++element)
+        {
+            getElement(element)[lane] = state[element];
+        }
+    }
+
+    //! Get state of given lane.
+    /*!
+     * Copies state of given lane to an indexable state, e.g., std::vector or std::array, that
+     * provides storage for at least getStateDimension() elements.
+     *
+     * @tparam      State  Type for state, which provides operator[]
+     * @param[in]   lane   Index of lane
+     * @param[out]  state  State of lane
+     */
+    template <typename State>
+    void getLane(const int lane, State& state) const
+    {
+        for (int element = 0; element < stateDimension; ++element)
+        {
+            state[element] = getElement(element)[lane];
+        }
+    }
+
+protected:
+private:
+
+    //! Number of trajectories in ensemble.
+    int numberOfLanes;
+
+    //! Number of elements of each state.
+    int stateDimension;
+
+    //! Values of all elements of all lanes, stored element by element.
+    std::vector<Real> values;
+};
+
+namespace detail
+{
+
+//! Accumulate weighted stage state derivatives for single lane, skipping zero coefficients.
+template <typename Real,
+          typename Coefficients,
+          int Term,
+          bool IsEnd = (Term >= Coefficients::numberOfTerms)>
+struct AccumulateLaneTerms
+{
+    static inline void apply(Real& sum,
+                             const Real* const* const stateDerivativeElements,
+                             const int lane)
+    {
+        addTerm(sum, stateDerivativeElements, lane,
+                std::integral_constant<bool, Coefficients::get(Term) != Real(0)>());
+        AccumulateLaneTerms<Real, Coefficients, Term + 1>::apply(
+            sum, stateDerivativeElements, lane);
+    }
+
+private:
+
+    static inline void addTerm(Real& sum,
+                               const Real* const* const stateDerivativeElements,
+                               const int lane,
+                               std::true_type)
+    {
+        sum += Coefficients::get(Term) * stateDerivativeElements[Term][lane];
+    }
+
+    static inline void addTerm(Real&, const Real* const* const, const int, std::false_type)
+    { }
+};
+
+//! Accumulate weighted stage state derivatives for single lane (recursion end).
+template <typename Real, typename Coefficients, int Term>
+struct AccumulateLaneTerms<Real, Coefficients, Term, true>
+{
+    static inline void apply(Real&, const Real* const* const, const int)
+    { }
+};
+
+//! Compute combination of stage state derivatives for all lanes of an ensemble.
+/*!
+ * Computes result = base + stepSize * sum_j coefficient_j * stateDerivative_j per lane (or
+ * without the base if HasBase is false), where the step size can differ per lane. Each element of
+ * each lane is computed in a single pass, skipping terms with zero coefficients at compile-time,
+ * so the result may be the same object as the base. The loops over the lanes are the innermost
+ * loops, so that they can be vectorized.
+ */
+template <typename Real, typename Coefficients, bool HasBase>
+inline void computeEnsembleCombination(EnsembleState<Real>& result,
+                                       const EnsembleState<Real>& base,
+                                       const Real* const stepSizes,
+                                       const EnsembleState<Real>* const stateDerivatives)
+{
+    const int numberOfLanes = base.getNumberOfLanes();
+    const Real* stateDerivativeElements[Coefficients::numberOfTerms > 0
+                                        ? Coefficients::numberOfTerms : 1];
+    for (int element = 0; element < base.getStateDimension(); ++element)
+    {
+        for (int term = 0; term < Coefficients::numberOfTerms; ++term)
+        {
+            stateDerivativeElements[term] = stateDerivatives[term].getElement(element);
+        }
+
+        Real* const resultElement = result.getElement(element);
+        const Real* const baseElement = base.getElement(element);
+        for (int lane = 0; lane < numberOfLanes; ++lane)
+        {
+            Real sum = 0.0;
+            AccumulateLaneTerms<Real, Coefficients, 0>::apply(sum, stateDerivativeElements, lane);
+            resultElement[lane] = HasBase ? baseElement[lane] + stepSizes[lane] * sum
+                                          : stepSizes[lane] * sum;
+        }
+    }
+}
+
+} // namespace detail
+
+//! Ensemble explicit Runge-Kutta stepper.
+/*!
+ * Stepper that executes integration steps for all trajectories in an ensemble simultaneously,
+ * using an explicit Runge-Kutta scheme that is defined by a Butcher tableau, e.g., RK4Tableau,
+ * RKF78Tableau or DOPRI5Tableau (see ExplicitRungeKuttaStepper). Each trajectory (lane) has its
+ * own time and, for adaptive steps, its own step size and accept/reject decision.
+ *
+ * The state derivative is evaluated for all lanes at once, using a callable of the form:
+ *
+ *  void computeStateDerivative(const std::vector<Real>& times,
+ *                              const EnsembleState<Real>& states,
+ *                              EnsembleState<Real>& stateDerivatives)
+ *
+ * The callable should loop over the lanes in its innermost loops, so that the evaluation is
+ * vectorized as well.
+ *
+ * The stepper stores numberOfStages + 1 ensembles of states as workspace, and each stage streams
+ * through all of them. Large ensembles are therefore best integrated in batches of a few hundred
+ * lanes, so that the workspace of a batch remains in cache.
+ *
+ * @tparam  Real     Type for floating-point number
+ * @tparam  Tableau  Butcher tableau that defines Runge-Kutta scheme
+ */
+template <typename Real, typename Tableau>
+class EnsembleRungeKuttaStepper
+{
+public:
+
+    //! Construct stepper.
+    EnsembleRungeKuttaStepper()
+        : isFirstStageStateDerivativeValid(false)
+    { }
+
+    //! Execute single integration step with fixed step size for all lanes.
+    /*!
+     * Executes single numerical integration step with given step size for all lanes.
+     *
+     * @tparam         StateDerivative         Type of callable to compute state derivative of
+     *                                         ensemble
+     * @param[in,out]  times                   Independent variable per lane, which is provided as
+     *                                         input and is updated with output at end of step
+     * @param[in,out]  states                  States, which are provided as input and are updated
+     *                                         with output at end of integration step
+     * @param[in]      stepSize                Step size to take for integration step
+     * @param[in]      computeStateDerivative  Function to compute state derivative for current
+     *                                         times and states
+     */
+    template <typename StateDerivative>
+    void step(std::vector<Real>& times,
+              EnsembleState<Real>& states,
+              const Real stepSize,
+              const StateDerivative& computeStateDerivative)
+    {
+        laneStepSizes.assign(states.getNumberOfLanes(), stepSize);
+        computeFirstStage(times, states, computeStateDerivative);
+        computeStage(times, states, computeStateDerivative, std::integral_constant<int, 1>());
+        detail::computeEnsembleCombination<
+            Real, detail::SolutionCoefficients<Real, Tableau>, true>(
+                states, states, laneStepSizes.data(), workspace.data());
+        for (int lane = 0; lane < states.getNumberOfLanes(); ++lane)
+        {
+            times[lane] += stepSize;
+        }
+        isAccepted.assign(states.getNumberOfLanes(), 1);
+        keepLastStageStateDerivative(times, states,
+                                     std::integral_constant<bool, isFirstSameAsLast>());
+    }
+
+    //! Execute single attempt of integration step with adaptive step size for all lanes.
+    /*!
+     * Executes single attempt of numerical integration step with adaptive step size control for
+     * all lanes, based on the error estimate of the embedded solution per lane. Lanes for which
+     * the error estimate is within the tolerance are advanced; all other lanes are left unchanged.
+     * For all lanes, the step size is updated with the step size for the next attempt, as for
+     * ExplicitRungeKuttaStepper. Lanes with a step size of zero are inactive: they are always
+     * accepted and keep their time, state and step size.
+     *
+     * @throws std::runtime_error  If a rejected lane has to be repeated with a step size that is
+     *                             smaller than the minimum step size, in which case the times,
+     *                             states and step sizes of all lanes are left unchanged
+     *
+     * @tparam         StateDerivative         Type of callable to compute state derivative of
+     *                                         ensemble
+     * @param[in,out]  times                   Independent variable per lane, which is provided as
+     *                                         input and is updated for accepted lanes
+     * @param[in,out]  states                  States, which are provided as input and are updated
+     *                                         for accepted lanes
+     * @param[in,out]  stepSizes               Step size per lane to take for integration step,
+     *                                         which is updated with step size for next attempt
+     * @param[in]      computeStateDerivative  Function to compute state derivative for current
+     *                                         times and states
+     * @param[in]      tolerance               Local truncation error tolerance
+     * @param[in]      minimumStepSize         Minimum allowable step size for integration step
+     * @param[in]      maximumStepSize         Maximum allowable step size for integration step
+     * @return                                 Number of lanes that are accepted
+     */
+    template <typename StateDerivative>
+    int step(std::vector<Real>& times,
+             EnsembleState<Real>& states,
+             std::vector<Real>& stepSizes,
+             const StateDerivative& computeStateDerivative,
+             const Real tolerance,
+             const Real minimumStepSize,
+             const Real maximumStepSize)
+    {
+        laneMinimumStepSizes.assign(states.getNumberOfLanes(), minimumStepSize);
+        return step(times, states, stepSizes, computeStateDerivative, tolerance,
+                    laneMinimumStepSizes, maximumStepSize);
+    }
+
+    //! Execute single attempt of integration step with adaptive step size for all lanes.
+    /*!
+     * Executes single attempt of numerical integration step with adaptive step size control for
+     * all lanes, as for the overload that takes a single minimum step size, but with a minimum
+     * step size per lane, e.g., so that the minimum step size of a lane can be lowered for its
+     * last step to the final time without weakening the check for the other lanes.
+     *
+     * @throws std::runtime_error  If a rejected lane has to be repeated with a step size that is
+     *                             smaller than its minimum step size, in which case the times,
+     *                             states and step sizes of all lanes are left unchanged
+     *
+     * @tparam         StateDerivative         Type of callable to compute state derivative of
+     *                                         ensemble
+     * @param[in,out]  times                   Independent variable per lane, which is provided as
+     *                                         input and is updated for accepted lanes
+     * @param[in,out]  states                  States, which are provided as input and are updated
+     *                                         for accepted lanes
+     * @param[in,out]  stepSizes               Step size per lane to take for integration step,
+     *                                         which is updated with step size for next attempt
+     * @param[in]      computeStateDerivative  Function to compute state derivative for current
+     *                                         times and states
+     * @param[in]      tolerance               Local truncation error tolerance
+     * @param[in]      minimumStepSizes        Minimum allowable step size per lane for integration
+     *                                         step
+     * @param[in]      maximumStepSize         Maximum allowable step size for integration step
+     * @return                                 Number of lanes that are accepted
+     */
+    template <typename StateDerivative>
+    int step(std::vector<Real>& times,
+             EnsembleState<Real>& states,
+             std::vector<Real>& stepSizes,
+             const StateDerivative& computeStateDerivative,
+             const Real tolerance,
+             const std::vector<Real>& minimumStepSizes,
+             const Real maximumStepSize)
+    {
+        static_assert(Tableau::isEmbedded,
+                      "Adaptive step size control requires tableau with embedded solution");
+
+        const int numberOfLanes = states.getNumberOfLanes();
+        laneStepSizes = stepSizes;
+        computeFirstStage(times, states, computeStateDerivative);
+        computeStage(times, states, computeStateDerivative, std::integral_constant<int, 1>());
+
+        // Reuse stage state as storage for the error estimate.
+        EnsembleState<Real>& errorEstimate = workspace[Tableau::numberOfStages];
+        detail::computeEnsembleCombination<
+            Real, detail::ErrorEstimateCoefficients<Real, Tableau>, false>(
+                errorEstimate, states, stepSizes.data(), workspace.data());
+
+        errorEstimateMaximum.assign(numberOfLanes, 0.0);
+        for (int element = 0; element < states.getStateDimension(); ++element)
+        {
+            const Real* const errorEstimateElement = errorEstimate.getElement(element);
+            for (int lane = 0; lane < numberOfLanes; ++lane)
+            {
+                errorEstimateMaximum[lane] = std::max(errorEstimateMaximum[lane],
+                                                      std::fabs(errorEstimateElement[lane]));
+            }
+        }
+
+        // Compute the propagated solution for all lanes in the stage state, so that the lanes
+        // are updated below in a single pass over the accepted lanes.
+        EnsembleState<Real>& propagatedStates = errorEstimate;
+        detail::computeEnsembleCombination<
+            Real, detail::SolutionCoefficients<Real, Tableau>, true>(
+                propagatedStates, states, stepSizes.data(), workspace.data());
+
+        // Decide on acceptance and next step size of all lanes first, so that no lane is updated
+        // if the minimum step size is exceeded for any lane.
+        int numberOfAcceptedLanes = 0;
+        isAccepted.assign(numberOfLanes, 0);
+        nextStepSizes.assign(numberOfLanes, 0.0);
+        for (int lane = 0; lane < numberOfLanes; ++lane)
+        {
+            const Real stepSize = laneStepSizes[lane];
+            if (stepSize == Real(0))
+            {
+                isAccepted[lane] = 1;
+                ++numberOfAcceptedLanes;
+                continue;
+            }
+
+            Real stepSizeFactor
+                = 0.84 * std::pow((tolerance * stepSize / errorEstimateMaximum[lane]),
+                                  1.0 / Tableau::order);
+            if (!(stepSizeFactor > 0.1))
+            {
+                stepSizeFactor = 0.1;
+            }
+            else if (stepSizeFactor > 4.0)
+            {
+                stepSizeFactor = 4.0;
+            }
+
+            Real nextStepSize = std::min(stepSizeFactor * stepSize, maximumStepSize);
+            if (errorEstimateMaximum[lane] < tolerance * stepSize)
+            {
+                isAccepted[lane] = 1;
+                ++numberOfAcceptedLanes;
+                nextStepSize = std::max(nextStepSize, minimumStepSizes[lane]);
+            }
+            else if (nextStepSize < minimumStepSizes[lane])
+            {
+                isAccepted.assign(numberOfLanes, 0);
+                throw std::runtime_error("Minimum step size exceeded!");
+            }
+            nextStepSizes[lane] = nextStepSize;
+        }
+
+        for (int lane = 0; lane < numberOfLanes; ++lane)
+        {
+            if (laneStepSizes[lane] != Real(0))
+            {
+                if (isAccepted[lane] != 0)
+                {
+                    times[lane] += laneStepSizes[lane];
+                }
+                stepSizes[lane] = nextStepSizes[lane];
+            }
+        }
+
+        for (int element = 0; element < states.getStateDimension(); ++element)
+        {
+            Real* const stateElement = states.getElement(element);
+            const Real* const propagatedStateElement = propagatedStates.getElement(element);
+            for (int lane = 0; lane < numberOfLanes; ++lane)
+            {
+                stateElement[lane] = isAccepted[lane] != 0 && laneStepSizes[lane] != Real(0)
+                                     ? propagatedStateElement[lane] : stateElement[lane];
+            }
+        }
+
+        keepLastStageStateDerivative(times, states,
+                                     std::integral_constant<bool, isFirstSameAsLast>());
+        return numberOfAcceptedLanes;
+    }
+
+    //! Get accept/reject mask of last step (non-zero for lanes that are accepted).
+    const std::vector<unsigned char>& getAcceptedLanes() const { return isAccepted; }
+
+    //! Reset stepper.
+    /*!
+     * Discards the state derivatives that are kept for reuse in the next step.
+     */
+    void reset()
+    {
+        isFirstStageStateDerivativeValid = false;
+    }
+
+protected:
+private:
+
+    //! Flag that indicates if tableau has First-Same-As-Last property.
+    static const bool isFirstSameAsLast = detail::IsFirstSameAsLast<Tableau>::value;
+
+    //! Compute first stage state derivative, unless it was kept from previous step.
+    template <typename StateDerivative>
+    void computeFirstStage(const std::vector<Real>& times,
+                           const EnsembleState<Real>& states,
+                           const StateDerivative& computeStateDerivative)
+    {
+        if (workspace.empty()
+            || workspace[0].getNumberOfLanes() != states.getNumberOfLanes()
+            || workspace[0].getStateDimension() != states.getStateDimension())
+        {
+            workspace.assign(Tableau::numberOfStages + 1, states);
+            isFirstStageStateDerivativeValid = false;
+        }
+
+        if (!(isFirstStageStateDerivativeValid
+              && times == firstStageTimes
+              && isEqualEnsembleState(states, firstStageStates)))
+        {
+            computeStateDerivative(times, states, workspace[0]);
+        }
+        isFirstStageStateDerivativeValid = false;
+    }
+
+    //! Compute stage states and stage state derivatives of given stage and subsequent stages.
+    template <typename StateDerivative, int Stage>
+    void computeStage(const std::vector<Real>& times,
+                      const EnsembleState<Real>& states,
+                      const StateDerivative& computeStateDerivative,
+                      std::integral_constant<int, Stage>)
+    {
+        EnsembleState<Real>& stageStates = workspace[Tableau::numberOfStages];
+        detail::computeEnsembleCombination<
+            Real, detail::StageCoefficients<Real, Tableau, Stage>, true>(
+                stageStates, states, laneStepSizes.data(), workspace.data());
+
+        stageTimes.resize(times.size());
+        for (std::size_t lane = 0; lane < times.size(); ++lane)
+        {
+            stageTimes[lane] = times[lane] + Tableau::c[Stage] * laneStepSizes[lane];
+        }
+
+        computeStateDerivative(stageTimes, stageStates, workspace[Stage]);
+        computeStage(times, states, computeStateDerivative,
+                     std::integral_constant<int, Stage + 1>());
+    }
+
+    //! Compute stage states and stage state derivatives (recursion end).
+    template <typename StateDerivative>
+    void computeStage(const std::vector<Real>&,
+                      const EnsembleState<Real>&,
+                      const StateDerivative&,
+                      std::integral_constant<int, Tableau::numberOfStages>)
+    { }
+
+    //! Keep last stage state derivatives of accepted lanes for reuse as first stage of next step.
+    /*!
+     * For rejected lanes, the time and state are unchanged, so their first stage state
+     * derivatives remain valid.
+     */
+    void keepLastStageStateDerivative(const std::vector<Real>& times,
+                                      const EnsembleState<Real>& states,
+                                      std::true_type)
+    {
+        const int numberOfLanes = states.getNumberOfLanes();
+        for (int element = 0; element < states.getStateDimension(); ++element)
+        {
+            Real* const firstStageElement = workspace[0].getElement(element);
+            const Real* const lastStageElement
+                = workspace[Tableau::numberOfStages - 1].getElement(element);
+            for (int lane = 0; lane < numberOfLanes; ++lane)
+            {
+                firstStageElement[lane] = isAccepted[lane] != 0 && laneStepSizes[lane] != Real(0)
+                                          ? lastStageElement[lane] : firstStageElement[lane];
+            }
+        }
+        firstStageTimes = times;
+        firstStageStates = states;
+        isFirstStageStateDerivativeValid = true;
+    }
+
+    //! Keep last stage state derivatives (not applicable if tableau is not FSAL).
+    void keepLastStageStateDerivative(const std::vector<Real>&,
+                                      const EnsembleState<Real>&,
+                                      std::false_type)
+    { }
+
+    //! Check if ensembles of states are equal.
+    static bool isEqualEnsembleState(const EnsembleState<Real>& states,
+                                     const EnsembleState<Real>& otherStates)
+    {
+        if (states.getNumberOfLanes() != otherStates.getNumberOfLanes()
+            || states.getStateDimension() != otherStates.getStateDimension())
+        {
+            return false;
+        }
+
+        const std::size_t size = static_cast<std::size_t>(states.getNumberOfLanes())
+                                 * states.getStateDimension();
+        return size == 0 || std::equal(states.getElement(0),
+                                       states.getElement(0) + size,
+                                       otherStates.getElement(0));
+    }
+
+    //! Storage for stage state derivatives and stage states of all lanes.
+    std::vector<EnsembleState<Real> > workspace;
+
+    //! Step sizes per lane of current step.
+    std::vector<Real> laneStepSizes;
+
+    //! Minimum step sizes per lane of current step, if a single minimum step size is given.
+    std::vector<Real> laneMinimumStepSizes;
+
+    //! Times per lane at which current stage is evaluated.
+    std::vector<Real> stageTimes;
+
+    //! Maximum absolute error estimate per lane.
+    std::vector<Real> errorEstimateMaximum;
+
+    //! Step sizes per lane for next attempt, which are only applied if no lane fails.
+    std::vector<Real> nextStepSizes;
+
+    //! Accept/reject mask of last step.
+    std::vector<unsigned char> isAccepted;
+
+    //! Flag that indicates if first stage state derivatives of next step are available.
+    bool isFirstStageStateDerivativeValid;
+
+    //! Times at which first stage state derivatives of next step were evaluated.
+    std::vector<Real> firstStageTimes;
+
+    //! States at which first stage state derivatives of next step were evaluated.
+    EnsembleState<Real> firstStageStates;
+};
+
+//! Integrate all lanes of an ensemble to final time using adaptive step size.
+/*!
+ * Integrates all lanes of an ensemble from their current times to given final time, by executing
+ * adaptive step attempts with given stepper until all lanes have reached the final time. Each
+ * lane takes its own steps; lanes that have reached the final time are inactive for the
+ * remaining attempts. As for integrateAdaptive(), the last step of each lane is shortened so that
+ * it lands exactly on the final time.
+ *
+ * @throws std::runtime_error  If a rejected lane has to be repeated with a step size that is
+ *                             smaller than the minimum step size, or if the step size of a lane
+ *                             that has not reached the final time does not advance its time,
+ *                             e.g., because it is not positive
+ *
+ * @tparam         Real                    Type for floating-point number
+ * @tparam         Tableau                 Butcher tableau that defines Runge-Kutta scheme
+ * @tparam         StateDerivative         Type of callable to compute state derivative of ensemble
+ * @param[in,out]  stepper                 Stepper used to execute integration steps
+ * @param[in,out]  times                   Independent variable per lane, which is provided as
+ *                                         input and is equal to the final time at end of
+ *                                         integration
+ * @param[in,out]  states                  States, which are provided as input and are updated
+ *                                         with output at end of integration
+ * @param[in,out]  stepSizes               Step size per lane to take for first integration step,
+ *                                         which is updated with step size for next step
+ * @param[in]      finalTime               Time to integrate to
+ * @param[in]      computeStateDerivative  Function to compute state derivative for current times
+ *                                         and states
+ * @param[in]      tolerance               Local truncation error tolerance
+ * @param[in]      minimumStepSize         Minimum allowable step size for integration steps
+ * @param[in]      maximumStepSize         Maximum allowable step size for integration steps
+ * @return                                 Number of step attempts for ensemble
+ */
+template <typename Real, typename Tableau, typename StateDerivative>
+int integrateEnsemble(EnsembleRungeKuttaStepper<Real, Tableau>& stepper,
+                      std::vector<Real>& times,
+                      EnsembleState<Real>& states,
+                      std::vector<Real>& stepSizes,
+                      const Real finalTime,
+                      const StateDerivative& computeStateDerivative,
+                      const Real tolerance,
+                      const Real minimumStepSize,
+                      const Real maximumStepSize)
+{
+    const int numberOfLanes = states.getNumberOfLanes();
+    std::vector<Real> currentStepSizes(numberOfLanes);
+    std::vector<Real> currentMinimumStepSizes(numberOfLanes);
+    std::vector<unsigned char> isLastStep(numberOfLanes);
+
+    int numberOfAttempts = 0;
+    while (true)
+    {
+        // Shorten last step of each lane to final time and deactivate lanes that are done. The
+        // minimum step size is only lowered for lanes whose remaining time is shorter.
+        bool isDone = true;
+        for (int lane = 0; lane < numberOfLanes; ++lane)
+        {
+            const Real remainingTime = finalTime - times[lane];
+            isLastStep[lane] = !(stepSizes[lane] < remainingTime);
+            currentStepSizes[lane] = remainingTime > Real(0)
+                                     ? std::min(stepSizes[lane], remainingTime) : Real(0);
+            currentMinimumStepSizes[lane] = std::min(minimumStepSize, remainingTime);
+            if (remainingTime > Real(0))
+            {
+                if (!(times[lane] + currentStepSizes[lane] > times[lane]))
+                {
+                    throw std::runtime_error("Step size does not advance time!");
+                }
+                isDone = false;
+            }
+        }
+
+        if (isDone)
+        {
+            break;
+        }
+
+        stepper.step(times,
+                     states,
+                     currentStepSizes,
+                     computeStateDerivative,
+                     tolerance,
+                     currentMinimumStepSizes,
+                     maximumStepSize);
+        ++numberOfAttempts;
+
+        for (int lane = 0; lane < numberOfLanes; ++lane)
+        {
+            if (currentStepSizes[lane] == Real(0))
+            {
+                continue;
+            }
+
+            // Remove round-off error in time, so that integration ends exactly at final time.
+            const Real timeTolerance = 4.0 * std::numeric_limits<Real>::epsilon()
+                                       * std::max(std::fabs(times[lane]), std::fabs(finalTime));
+            if (std::fabs(finalTime - times[lane]) <= timeTolerance)
+            {
+                times[lane] = finalTime;
+            }
+
+            if (!(isLastStep[lane] != 0
+                  && times[lane] == finalTime
+                  && currentStepSizes[lane] < stepSizes[lane]))
+            {
+                stepSizes[lane] = currentStepSizes[lane];
+            }
+        }
+    }
+
+    return numberOfAttempts;
+}
+
+} // namespace integrate
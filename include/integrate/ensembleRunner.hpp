@@ -0,0 +1,244 @@
+/*
+ * Copyright (c) 2014-2025 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace integrate
+{
+namespace detail
+{
+
+//! Range of task indices owned by a worker thread, from which other workers can steal.
+struct TaskRange
+{
+    //! Construct empty task range.
+    TaskRange()
+        : begin(0),
+          end(0)
+    { }
+
+    //! Mutex that protects the range.
+    std::mutex mutex;
+
+    //! First task index in range.
+    int begin;
+
+    //! End of range (one past last task index).
+    int end;
+};
+
+//! Pin calling thread to given core (only supported on Linux; ignored otherwise).
+inline void pinThreadToCore(const int core)
+{
+#if defined(__linux__)
+    cpu_set_t cpuSet;
+    CPU_ZERO(&cpuSet);
+    CPU_SET(core, &cpuSet);
+    pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &cpuSet);
+#else
+    static_cast<void>(core);
+#endif
+}
+
+} // namespace detail
+
+//! Ensemble runner.
+/*!
+ * Runner that executes a large number of independent tasks, e.g., the integration of the
+ * trajectories of a Monte Carlo ensemble, or of SIMD batches of trajectories (see
+ * EnsembleRungeKuttaStepper), in parallel on a number of worker threads.
+ *
+ * Adaptive trajectories take very different numbers of steps, so a static partition of the tasks
+ * over the threads leaves threads idle. Instead, the tasks are distributed using work stealing:
+ * each worker starts with a contiguous range of tasks and executes them in order; a worker that
+ * runs out of tasks steals the back half of the remaining range of another worker.
+ *
+ * Each worker has its own stepper, so that the stepper workspaces are not shared between threads.
+ * Since each task only depends on its own inputs, and the stepper is reset before each task, the
+ * result of each task is independent of the number of threads and of the order in which the
+ * tasks are executed.
+ */
+class EnsembleRunner
+{
+public:
+
+    //! Construct ensemble runner.
+    /*!
+     * Constructs ensemble runner.
+     *
+     * @param[in]  numberOfThreads  Number of worker threads; if zero, the number of concurrent
+     *                              threads supported by the hardware is used
+     * @param[in]  isPinned         Flag that indicates if worker i is pinned to core i, modulo
+     *                              the number of cores (only supported on Linux)
+     */
+    EnsembleRunner(const int numberOfThreads = 0, const bool isPinned = false)
+        : numberOfThreads(numberOfThreads > 0
+                          ? numberOfThreads
+                          : static_cast<int>(std::thread::hardware_concurrency())),
+          isPinned(isPinned)
+    {
+        if (this->numberOfThreads < 1)
+        {
+            this->numberOfThreads = 1;
+        }
+    }
+
+    //! Get number of worker threads.
+    int getNumberOfThreads() const { return numberOfThreads; }
+
+    //! Run tasks.
+    /*!
+     * Executes given task for all task indices in [0, numberOfTasks), distributed over the worker
+     * threads using work stealing. Each worker constructs its own stepper, which is passed to the
+     * task and is reset before each task. If a task throws an exception, the remaining tasks are
+     * skipped and the first exception is rethrown after all workers have finished.
+     *
+     * @tparam     Stepper        Type of stepper, which is default-constructible and provides
+     *                            reset(), e.g., DOPRI5Stepper or EnsembleRungeKuttaStepper
+     * @tparam     Task           Type of callable that executes a task, i.e.,
+     *                            void task(Stepper& stepper, const int taskIndex)
+     * @param[in]  numberOfTasks  Number of tasks
+     * @param[in]  task           Function that executes task with given index
+     */
+    template <typename Stepper, typename Task>
+    void run(const int numberOfTasks, const Task& task)
+    {
+        std::vector<detail::TaskRange> taskRanges(numberOfThreads);
+        for (int thread = 0; thread < numberOfThreads; ++thread)
+        {
+            taskRanges[thread].begin
+                = static_cast<int>(static_cast<long>(numberOfTasks) * thread / numberOfThreads);
+            taskRanges[thread].end
+                = static_cast<int>(static_cast<long>(numberOfTasks) * (thread + 1)
+                                   / numberOfThreads);
+        }
+
+        std::mutex exceptionMutex;
+        std::exception_ptr exception;
+        bool isAborted = false;
+
+        auto worker = [&](const int thread)
+        {
+            if (isPinned)
+            {
+                const int numberOfCores = static_cast<int>(std::thread::hardware_concurrency());
+                detail::pinThreadToCore(numberOfCores > 0 ? thread % numberOfCores : thread);
+            }
+
+            Stepper stepper;
+            int taskIndex = 0;
+            while (getTask(taskRanges, thread, taskIndex))
+            {
+                {
+                    std::lock_guard<std::mutex> lock(exceptionMutex);
+                    if (isAborted)
+                    {
+                        return;
+                    }
+                }
+
+                try
+                {
+                    stepper.reset();
+                    task(stepper, taskIndex);
+                }
+                catch (...)
+                {
+                    std::lock_guard<std::mutex> lock(exceptionMutex);
+                    if (!isAborted)
+                    {
+                        exception = std::current_exception();
+                        isAborted = true;
+                    }
+                    return;
+                }
+            }
+        };
+
+        // All workers run on new threads, so that the calling thread is never pinned.
+        std::vector<std::thread> threads;
+        for (int thread = 0; thread < numberOfThreads; ++thread)
+        {
+            threads.push_back(std::thread(worker, thread));
+        }
+        for (std::size_t i = 0; i < threads.size(); ++i)
+        {
+            threads[i].join();
+        }
+
+        if (exception)
+        {
+            std::rethrow_exception(exception);
+        }
+    }
+
+protected:
+private:
+
+    //! Get next task for given worker, stealing from other workers if its own range is empty.
+    static bool getTask(std::vector<detail::TaskRange>& taskRanges,
+                        const int thread,
+                        int& taskIndex)
+    {
+        {
+            detail::TaskRange& ownRange = taskRanges[thread];
+            std::lock_guard<std::mutex> lock(ownRange.mutex);
+            if (ownRange.begin < ownRange.end)
+            {
+                taskIndex = ownRange.begin++;
+                return true;
+            }
+        }
+
+        const int numberOfRanges = static_cast<int>(taskRanges.size());
+        for (int offset = 1; offset < numberOfRanges; ++offset)
+        {
+            detail::TaskRange& victimRange = taskRanges[(thread + offset) % numberOfRanges];
+            int stolenBegin = 0;
+            int stolenEnd = 0;
+            {
+                std::lock_guard<std::mutex> lock(victimRange.mutex);
+                const int numberOfRemainingTasks = victimRange.end - victimRange.begin;
+                if (numberOfRemainingTasks <= 0)
+                {
+                    continue;
+                }
+
+                stolenEnd = victimRange.end;
+                stolenBegin = victimRange.end - (numberOfRemainingTasks + 1) / 2;
+                victimRange.end = stolenBegin;
+            }
+
+            detail::TaskRange& ownRange = taskRanges[thread];
+            std::lock_guard<std::mutex> lock(ownRange.mutex);
+            taskIndex = stolenBegin;
+            ownRange.begin = stolenBegin + 1;
+            ownRange.end = stolenEnd;
+            return true;
+        }
+
+        return false;
+    }
+
+    //! Number of worker threads.
+    int numberOfThreads;
+
+    //! Flag that indicates if worker threads are pinned to cores.
+    bool isPinned;
+};
+
+} // namespace integrate
@@ -6,17 +6,70 @@
 
 #pragma once
 
-#include <functional>
+#include "integrate/explicitRungeKutta.hpp"
+#include "integrate/stateDerivative.hpp"
+#include "integrate/threadLocalStepper.hpp"
 
 namespace integrate
 {
 
+//! Butcher tableau for Euler scheme.
+/*!
+ * Butcher tableau for the explicit (forward) Euler scheme.
+ *
+ * @tparam  Real  Type for floating-point number
+ */
+template <typename Real>
+struct EulerTableau
+{
+    //! Number of stages.
+    static const int numberOfStages = 1;
+
+    //! Order of propagated solution.
+    static const int order = 1;
+
+    //! Flag that indicates if tableau contains embedded solution.
+    static const bool isEmbedded = false;
+
+    //! Nodes.
+    static constexpr Real c[1] = {0.0};
+
+    //! Runge-Kutta matrix (strictly lower-triangular; omitted coefficients are zero).
+    static constexpr Real a[1][1] = {
+        {}
+    };
+
+    //! Weights of propagated solution.
+    static constexpr Real b[1] = {1.0};
+};
+
+template <typename Real> constexpr Real EulerTableau<Real>::c[1];
+template <typename Real> constexpr Real EulerTableau<Real>::a[1][1];
+template <typename Real> constexpr Real EulerTableau<Real>::b[1];
+
+//! Euler stepper.
+/*!
+ * Stepper that executes integration steps using Euler scheme. See
+ * ExplicitRungeKuttaStepper for details.
+ *
+ * @tparam  Real        Type for floating-point number
+ * @tparam  State       Type for state and state derivative
+ * @tparam  Statistics  Statistics policy, e.g., NullStatistics or IntegrationStatistics
+ */
+template <typename Real, typename State, typename Statistics = NullStatistics>
+using EulerStepper = ExplicitRungeKuttaStepper<Real, State, EulerTableau<Real>, Statistics>;
+
 //! Execute single integration step using Euler scheme.
 /*!
- * Executes single numerical integration step using Euler scheme.
+ * Executes single numerical integration step using Euler scheme. The stepper that holds the
+ * storage for the state derivative is kept per thread and reused across calls, so that memory is
+ * only allocated on the first call of each thread.
  *
  * @tparam         Real                    Type for floating-point number
  * @tparam         State                   Type for state and state derivative
+ * @tparam         StateDerivative         Type of callable to compute state derivative, e.g.,
+ *                                         function pointer, functor, lambda or
+ *                                         StateDerivativeFunction
  * @param[in,out]  time                    Independent variable, which is provided as input and is
  *                                         updated with output at end of integration step
  * @param[in,out]  state                   State, which is provided as input and is updated with
@@ -25,16 +78,16 @@ namespace integrate
  * @param[in]      computeStateDerivative  Function to compute state derivative for current time
  *                                         and state
  */
-template <typename Real, typename State>
+template <typename Real, typename State, typename StateDerivative>
 const void stepEuler(
     Real& time,
     State& state,
     const Real stepSize,
-    const std::function<const State(const Real time,
-                                     const State& state)>& computeStateDerivative)
+    const StateDerivative& computeStateDerivative)
 {
-    state += stepSize * computeStateDerivative(time, state);
-    time += stepSize;
+    detail::ThreadLocalStepper<EulerStepper<Real, State> > threadLocalStepper;
+    EulerStepper<Real, State>& stepper = threadLocalStepper.get();
+    stepper.step(time, state, stepSize, computeStateDerivative);
 };
 
 } // namespace integrate
@@ -0,0 +1,468 @@
+/*
+ * Copyright (c) 2014-2025 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "integrate/integrateAdaptive.hpp"
+
+namespace integrate
+{
+
+//! Function that computes scalar event value for given time and state, e.g., altitude above a
+//! reference altitude, whose roots define the times at which the event occurs.
+template <typename Real, typename State>
+using EventFunction = std::function<Real(const Real time, const State& state)>;
+
+//! Direction of sign changes of event function that trigger event.
+enum class EventDirection
+{
+    //! Event is triggered if event function changes sign from positive to negative.
+    decreasing = -1,
+
+    //! Event is triggered if event function changes sign in either direction.
+    any = 0,
+
+    //! Event is triggered if event function changes sign from negative to positive.
+    increasing = 1
+};
+
+//! Locator of events within accepted integration steps.
+/*!
+ * Locator that keeps a set of scalar event functions, checks for sign changes of the event
+ * functions after each accepted integration step, and locates the roots within the step with the
+ * Illinois variant of the regula falsi method (Dowell & Jarratt, 1971) on the dense output of the
+ * stepper (see ExplicitRungeKuttaStepper::interpolate), so that no state derivatives are evaluated
+ * to locate events. Each event function is evaluated once per accepted step, and a few times per
+ * located event, so that the cost scales with the number of event functions, rather than with the
+ * number of steps needed to resolve the events.
+ *
+ * Events are reported in order of time. If an event is terminal, the time and state are set to
+ * the time and state of the event, and later events within the step are not reported. Since the
+ * root is located from the side at which the event function has changed sign, the event is not
+ * triggered again if the integration is continued from the terminal event.
+ *
+ * @tparam  Real   Type for floating-point number
+ * @tparam  State  Type for state
+ */
+template <typename Real, typename State>
+class EventLocator
+{
+public:
+
+    //! Construct event locator.
+    /*!
+     * Constructs event locator without events.
+     *
+     * @param[in]  timeTolerance  Tolerance on time of located events (located to round-off if 0)
+     */
+    explicit EventLocator(const Real timeTolerance = 0.0)
+        : timeTolerance(timeTolerance),
+          startTime(0.0),
+          terminalEventIndex(-1)
+    { }
+
+    //! Add event.
+    /*!
+     * Adds event that is defined by the roots of the given event function. The event function is
+     * evaluated with interpolated states, so it must depend continuously on time and state.
+     *
+     * @param[in]  computeEventValue  Function that computes value of event function
+     * @param[in]  direction          Direction of sign changes that trigger event
+     * @param[in]  isTerminal         Flag that indicates if integration is stopped at event
+     * @return                        Index of event, which is passed to event observer
+     */
+    int addEvent(const EventFunction<Real, State>& computeEventValue,
+                 const EventDirection direction = EventDirection::any,
+                 const bool isTerminal = false)
+    {
+        events.push_back(Event(computeEventValue, direction, isTerminal));
+        startValues.push_back(0.0);
+        return static_cast<int>(events.size()) - 1;
+    }
+
+    //! Get number of events.
+    int getNumberOfEvents() const { return static_cast<int>(events.size()); }
+
+    //! Get index of terminal event at which integration was stopped (-1 if not stopped).
+    int getTerminalEventIndex() const { return terminalEventIndex; }
+
+    //! Initialize event locator at start of integration.
+    /*!
+     * Evaluates the event functions at given time and state. Events with roots at this time are
+     * not triggered.
+     *
+     * @param[in]  time   Time at start of integration
+     * @param[in]  state  State at start of integration
+     */
+    void initialize(const Real time, const State& state)
+    {
+        terminalEventIndex = -1;
+        evaluateStartValues(time, state);
+    }
+
+    //! Locate and report events within last accepted integration step.
+    /*!
+     * Evaluates the event functions at the end of the last accepted step of the given stepper,
+     * locates the roots of event functions that have changed sign in the direction of their event
+     * since the start of the step, and reports them to the given observer in order of time. If one
+     * of the events is terminal, the time and state are set to the time and state of the earliest
+     * terminal event.
+     *
+     * @tparam         Stepper   Type of stepper that provides dense output, e.g., DOPRI5Stepper
+     * @tparam         Observer  Type of callable that receives events, i.e.,
+     *                           void observe(const int eventIndex, const Real time,
+     *                                        const State& state)
+     * @param[in]      stepper   Stepper that executed last accepted step
+     * @param[in,out]  time      Time at end of step, which is set to time of terminal event
+     * @param[in,out]  state     State at end of step, which is set to state of terminal event
+     * @param[in]      observe   Function that receives index, time and state of events
+     * @return                   Flag that indicates if terminal event occurred
+     */
+    template <typename Stepper, typename Observer>
+    bool locateEvents(const Stepper& stepper, Real& time, State& state, const Observer& observe)
+    {
+        if (workspace.empty())
+        {
+            workspace.assign(1, state);
+        }
+        State& eventState = workspace[0];
+
+        // Locate roots of all event functions that are triggered within the step.
+        triggeredEvents.clear();
+        for (std::size_t i = 0; i < events.size(); ++i)
+        {
+            const Real endValue = events[i].computeEventValue(time, state);
+            if (isTriggered(events[i].direction, startValues[i], endValue))
+            {
+                const Real eventTime = locateRoot(stepper, events[i], startValues[i], endValue,
+                                                  time, eventState);
+                triggeredEvents.push_back(std::make_pair(eventTime, static_cast<int>(i)));
+            }
+            startValues[i] = endValue;
+        }
+        startTime = time;
+        std::sort(triggeredEvents.begin(), triggeredEvents.end());
+
+        for (std::size_t j = 0; j < triggeredEvents.size(); ++j)
+        {
+            const Real eventTime = triggeredEvents[j].first;
+            const int eventIndex = triggeredEvents[j].second;
+            if (eventTime < time)
+            {
+                stepper.interpolate(eventTime, eventState);
+            }
+            else
+            {
+                eventState = state;
+            }
+            observe(eventIndex, eventTime, eventState);
+
+            if (events[eventIndex].isTerminal)
+            {
+                terminalEventIndex = eventIndex;
+                if (eventTime < time)
+                {
+                    time = eventTime;
+                    state = eventState;
+                    evaluateStartValues(time, state);
+                }
+                return true;
+            }
+        }
+        return false;
+    }
+
+protected:
+private:
+
+    //! Event defined by event function, direction and terminal flag.
+    struct Event
+    {
+        Event(const EventFunction<Real, State>& computeEventValue,
+              const EventDirection direction,
+              const bool isTerminal)
+            : computeEventValue(computeEventValue),
+              direction(direction),
+              isTerminal(isTerminal)
+        { }
+
+        //! Function that computes value of event function.
+        EventFunction<Real, State> computeEventValue;
+
+        //! Direction of sign changes that trigger event.
+        EventDirection direction;
+
+        //! Flag that indicates if integration is stopped at event.
+        bool isTerminal;
+    };
+
+    //! Evaluate event functions at start of next step.
+    void evaluateStartValues(const Real time, const State& state)
+    {
+        startTime = time;
+        for (std::size_t i = 0; i < events.size(); ++i)
+        {
+            startValues[i] = events[i].computeEventValue(time, state);
+        }
+    }
+
+    //! Check if event is triggered by change of event function from start to end of step.
+    static bool isTriggered(const EventDirection direction,
+                            const Real startValue,
+                            const Real endValue)
+    {
+        const bool isIncreasing = startValue < 0.0 && endValue >= 0.0;
+        const bool isDecreasing = startValue > 0.0 && endValue <= 0.0;
+        return (direction != EventDirection::decreasing && isIncreasing)
+            || (direction != EventDirection::increasing && isDecreasing);
+    }
+
+    //! Locate root of event function within last accepted step, from the side of end of step.
+    template <typename Stepper>
+    Real locateRoot(const Stepper& stepper,
+                    const Event& event,
+                    const Real startValue,
+                    const Real endValue,
+                    const Real endTime,
+                    State& eventState) const
+    {
+        // The bracket is kept such that the event function has the sign of the start of the step
+        // at the lower end, and the sign of the end of the step (or is zero) at the upper end.
+        Real lower = startTime;
+        Real upper = endTime;
+        Real lowerValue = startValue;
+        Real upperValue = endValue;
+        if (upperValue == 0.0)
+        {
+            return upper;
+        }
+
+        const int maximumIterations = 100;
+        int side = 0;
+        for (int iteration = 0; iteration < maximumIterations; ++iteration)
+        {
+            const Real tolerance = std::max(
+                timeTolerance,
+                4.0 * std::numeric_limits<Real>::epsilon()
+                    * std::max(std::fabs(lower), std::fabs(upper)));
+            if (upper - lower <= tolerance)
+            {
+                break;
+            }
+
+            Real time = (lower * upperValue - upper * lowerValue) / (upperValue - lowerValue);
+            if (!(time > lower && time < upper))
+            {
+                time = 0.5 * (lower + upper);
+            }
+            stepper.interpolate(time, eventState);
+            const Real value = event.computeEventValue(time, eventState);
+
+            // Illinois modification: the function value at the end that is retained twice in a
+            // row is halved, so that both ends of the bracket converge.
+            if ((value < 0.0) == (lowerValue < 0.0) && value != 0.0)
+            {
+                lower = time;
+                lowerValue = value;
+                if (side == -1)
+                {
+                    upperValue *= 0.5;
+                }
+                side = -1;
+            }
+            else
+            {
+                upper = time;
+                upperValue = value;
+                if (value == 0.0)
+                {
+                    break;
+                }
+                if (side == 1)
+                {
+                    lowerValue *= 0.5;
+                }
+                side = 1;
+            }
+        }
+        return upper;
+    }
+
+    //! Tolerance on time of located events.
+    Real timeTolerance;
+
+    //! Events.
+    std::vector<Event> events;
+
+    //! Values of event functions at start of current step.
+    std::vector<Real> startValues;
+
+    //! Time at start of current step.
+    Real startTime;
+
+    //! Times and indices of events triggered within current step.
+    std::vector<std::pair<Real, int> > triggeredEvents;
+
+    //! Storage for interpolated state.
+    std::vector<State> workspace;
+
+    //! Index of terminal event at which integration was stopped (-1 if not stopped).
+    int terminalEventIndex;
+};
+
+//! Integrate to final time using adaptive step size, and locate events.
+/*!
+ * Integrates from current time to given final time by executing adaptive integration steps with
+ * given stepper, and locates the events of the given event locator after each accepted step (see
+ * EventLocator). The integration stops at the first terminal event, at which the time and state
+ * are set to the time and state of the event; the index of the event is available from
+ * EventLocator::getTerminalEventIndex(). The steps are not shortened to resolve events, and no
+ * state derivatives are evaluated to locate them.
+ *
+ * @throws std::runtime_error  If final time lies before current time, if the stepper does not
+ *                             provide dense output, if the step size does not advance the time,
+ *                             or if the stepper throws because the minimum step size is exceeded
+ *
+ * @tparam         Real                    Type for floating-point number
+ * @tparam         State                   Type for state and state derivative
+ * @tparam         Stepper                 Type of stepper that provides adaptive step function and
+ *                                         dense output, e.g., DOPRI5Stepper
+ * @tparam         StateDerivative         Type of callable to compute state derivative, e.g.,
+ *                                         function pointer, functor, lambda or
+ *                                         StateDerivativeFunction
+ * @tparam         Observer                Type of callable that receives events, i.e.,
+ *                                         void observe(const int eventIndex, const Real time,
+ *                                                      const State& state)
+ * @param[in,out]  stepper                 Stepper used to execute integration steps
+ * @param[in,out]  time                    Independent variable, which is provided as input and is
+ *                                         equal to the final time or the time of the terminal
+ *                                         event at end of integration
+ * @param[in,out]  state                   State, which is provided as input and is updated with
+ *                                         output at end of integration
+ * @param[in,out]  stepSize                Step size to take for first integration step, which is
+ *                                         updated with step size for next integration step
+ * @param[in]      finalTime               Time to integrate to
+ * @param[in]      computeStateDerivative  Function to compute state derivative for current time
+ *                                         and state
+ * @param[in]      tolerance               Local truncation error tolerance
+ * @param[in]      minimumStepSize         Minimum allowable step size for integration steps
+ * @param[in]      maximumStepSize         Maximum allowable step size for integration steps
+ * @param[in,out]  eventLocator            Event locator that defines events
+ * @param[in]      observe                 Function that receives index, time and state of events
+ * @return                                 Number of accepted integration steps
+ */
+template <typename Real,
+          typename State,
+          typename Stepper,
+          typename StateDerivative,
+          typename Observer>
+int integrateEvents(Stepper& stepper,
+                    Real& time,
+                    State& state,
+                    Real& stepSize,
+                    const Real finalTime,
+                    const StateDerivative& computeStateDerivative,
+                    const Real tolerance,
+                    const Real minimumStepSize,
+                    const Real maximumStepSize,
+                    EventLocator<Real, State>& eventLocator,
+                    const Observer& observe)
+{
+    eventLocator.initialize(time, state);
+    return detail::integrateAdaptiveUntil(
+        time, stepSize, finalTime, minimumStepSize,
+        [&](Real& currentStepSize, const Real currentMinimumStepSize)
+    {
+        stepper.step(time, state, currentStepSize, computeStateDerivative, tolerance,
+                     currentMinimumStepSize, maximumStepSize);
+        return eventLocator.locateEvents(stepper, time, state, observe);
+    });
+}
+
+//! Integrate to final time using error norm and step size controller, and locate events.
+/*!
+ * Integrates from current time to given final time by executing adaptive integration steps with
+ * given stepper, error norm, e.g., WeightedRootMeanSquareErrorNorm, and step size controller, and
+ * locates the events of the given event locator after each accepted step. See the overload that
+ * takes a scalar tolerance for details.
+ *
+ * @throws std::runtime_error  If final time lies before current time, if the stepper does not
+ *                             provide dense output, if the step size does not advance the time,
+ *                             or if the stepper throws because the minimum step size is exceeded
+ *
+ * @tparam         Real                    Type for floating-point number
+ * @tparam         State                   Type for state and state derivative
+ * @tparam         Stepper                 Type of stepper that provides adaptive step function and
+ *                                         dense output, e.g., DOPRI5Stepper
+ * @tparam         StateDerivative         Type of callable to compute state derivative, e.g.,
+ *                                         function pointer, functor, lambda or
+ *                                         StateDerivativeFunction
+ * @tparam         ErrorNorm               Type of callable to compute scaled error, e.g.,
+ *                                         WeightedRootMeanSquareErrorNorm
+ * @tparam         Controller              Type of step size controller, e.g., StepSizeController
+ * @tparam         Observer                Type of callable that receives events, i.e.,
+ *                                         void observe(const int eventIndex, const Real time,
+ *                                                      const State& state)
+ * @param[in,out]  stepper                 Stepper used to execute integration steps
+ * @param[in,out]  time                    Independent variable, which is provided as input and is
+ *                                         equal to the final time or the time of the terminal
+ *                                         event at end of integration
+ * @param[in,out]  state                   State, which is provided as input and is updated with
+ *                                         output at end of integration
+ * @param[in,out]  stepSize                Step size to take for first integration step, which is
+ *                                         updated with step size for next integration step
+ * @param[in]      finalTime               Time to integrate to
+ * @param[in]      computeStateDerivative  Function to compute state derivative for current time
+ *                                         and state
+ * @param[in]      computeError            Function to compute scaled error of error estimate
+ * @param[in,out]  controller              Step size controller, which is updated with scaled
+ *                                         errors of accepted steps
+ * @param[in]      minimumStepSize         Minimum allowable step size for integration steps
+ * @param[in]      maximumStepSize         Maximum allowable step size for integration steps
+ * @param[in,out]  eventLocator            Event locator that defines events
+ * @param[in]      observe                 Function that receives index, time and state of events
+ * @return                                 Number of accepted integration steps
+ */
+template <typename Real,
+          typename State,
+          typename Stepper,
+          typename StateDerivative,
+          typename ErrorNorm,
+          typename Controller,
+          typename Observer>
+int integrateEvents(Stepper& stepper,
+                    Real& time,
+                    State& state,
+                    Real& stepSize,
+                    const Real finalTime,
+                    const StateDerivative& computeStateDerivative,
+                    const ErrorNorm& computeError,
+                    Controller& controller,
+                    const Real minimumStepSize,
+                    const Real maximumStepSize,
+                    EventLocator<Real, State>& eventLocator,
+                    const Observer& observe)
+{
+    eventLocator.initialize(time, state);
+    return detail::integrateAdaptiveUntil(
+        time, stepSize, finalTime, minimumStepSize,
+        [&](Real& currentStepSize, const Real currentMinimumStepSize)
+    {
+        stepper.step(time, state, currentStepSize, computeStateDerivative, computeError,
+                     controller, currentMinimumStepSize, maximumStepSize);
+        return eventLocator.locateEvents(stepper, time, state, observe);
+    });
+}
+
+} // namespace integrate
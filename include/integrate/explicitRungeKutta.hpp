@@ -0,0 +1,863 @@
+/*
+ * Copyright (c) 2014-2025 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "integrate/denseOutput.hpp"
+#include "integrate/linearCombination.hpp"
+#include "integrate/stateDerivative.hpp"
+#include "integrate/stateNorm.hpp"
+#include "integrate/statistics.hpp"
+#include "integrate/stepSizeControl.hpp"
+
+namespace integrate
+{
+namespace detail
+{
+
+//! Coefficients to compute stage state of given stage from stage state derivatives.
+template <typename Real, typename Tableau, int Stage>
+struct StageCoefficients
+{
+    //! Number of stage state derivatives that are combined.
+    static const int numberOfTerms = Stage;
+
+    //! Get coefficient of given stage state derivative.
+    static constexpr Real get(const int term) { return Tableau::a[Stage][term]; }
+};
+
+//! Coefficients to compute propagated solution from stage state derivatives.
+template <typename Real, typename Tableau>
+struct SolutionCoefficients
+{
+    //! Number of stage state derivatives that are combined.
+    static const int numberOfTerms = Tableau::numberOfStages;
+
+    //! Get coefficient of given stage state derivative.
+    static constexpr Real get(const int term) { return Tableau::b[term]; }
+};
+
+//! Coefficients to compute error estimate from stage state derivatives.
+template <typename Real, typename Tableau>
+struct ErrorEstimateCoefficients
+{
+    //! Number of stage state derivatives that are combined.
+    static const int numberOfTerms = Tableau::numberOfStages;
+
+    //! Get coefficient of given stage state derivative.
+    static constexpr Real get(const int term) { return Tableau::b[term] - Tableau::bHat[term]; }
+};
+
+//! Find index of first non-zero coefficient, starting at given term.
+template <typename Real, typename Coefficients>
+constexpr int findFirstNonZeroTerm(const int term)
+{
+    return term >= Coefficients::numberOfTerms
+        ? Coefficients::numberOfTerms
+        : (Coefficients::get(term) != Real(0)
+            ? term : findFirstNonZeroTerm<Real, Coefficients>(term + 1));
+}
+
+//! Accumulate weighted stage state derivatives for single element, skipping zero coefficients.
+template <typename Real,
+          typename State,
+          typename Coefficients,
+          int Term,
+          bool IsEnd = (Term >= Coefficients::numberOfTerms)>
+struct AccumulateTerms
+{
+    static inline void apply(Real& sum,
+                             const State* const stateDerivatives,
+                             const std::size_t element)
+    {
+        addTerm(sum, stateDerivatives, element,
+                std::integral_constant<bool, Coefficients::get(Term) != Real(0)>());
+        AccumulateTerms<Real, State, Coefficients, Term + 1>::apply(
+            sum, stateDerivatives, element);
+    }
+
+private:
+
+    static inline void addTerm(Real& sum,
+                               const State* const stateDerivatives,
+                               const std::size_t element,
+                               std::true_type)
+    {
+        sum += Coefficients::get(Term) * stateDerivatives[Term][element];
+    }
+
+    static inline void addTerm(Real&, const State* const, const std::size_t, std::false_type)
+    { }
+};
+
+//! Accumulate weighted stage state derivatives for single element (recursion end).
+template <typename Real, typename State, typename Coefficients, int Term>
+struct AccumulateTerms<Real, State, Coefficients, Term, true>
+{
+    static inline void apply(Real&, const State* const, const std::size_t)
+    { }
+};
+
+//! Compute combination of stage state derivatives for indexable states.
+template <typename Real, typename State, typename Coefficients, bool HasBase>
+inline void computeTableauCombination(State& result,
+                                      const State& base,
+                                      const Real scale,
+                                      const State* const stateDerivatives,
+                                      IndexableStateTag)
+{
+    static const int firstTerm = findFirstNonZeroTerm<Real, Coefficients>(0);
+
+    const State& reference = HasBase ? base : stateDerivatives[firstTerm];
+    const std::size_t size = static_cast<std::size_t>(reference.size());
+    if (static_cast<std::size_t>(result.size()) != size)
+    {
+        result = reference;
+    }
+
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        Real sum = Coefficients::get(firstTerm) * stateDerivatives[firstTerm][i];
+        AccumulateTerms<Real, State, Coefficients, firstTerm + 1>::apply(sum, stateDerivatives, i);
+        result[i] = HasBase ? base[i] + scale * sum : scale * sum;
+    }
+}
+
+//! Compute combination of stage state derivatives using only the State operators.
+template <typename Real, typename State, typename Coefficients, bool HasBase>
+inline void computeTableauCombination(State& result,
+                                      const State& base,
+                                      const Real scale,
+                                      const State* const stateDerivatives,
+                                      OperatorStateTag)
+{
+    static const int firstTerm = findFirstNonZeroTerm<Real, Coefficients>(0);
+
+    State sum = (scale * Coefficients::get(firstTerm)) * stateDerivatives[firstTerm];
+    for (int term = firstTerm + 1; term < Coefficients::numberOfTerms; ++term)
+    {
+        if (Coefficients::get(term) != Real(0))
+        {
+            sum = sum + (scale * Coefficients::get(term)) * stateDerivatives[term];
+        }
+    }
+    result = HasBase ? base + sum : sum;
+}
+
+//! Compute combination of stage state derivatives defined by Butcher tableau coefficients.
+/*!
+ * Computes base + scale * sum_j coefficients_j * stateDerivatives_j (or the sum without the base)
+ * in a single pass. Terms with zero coefficients are skipped at compile-time.
+ */
+template <typename Real, typename State, typename Coefficients, bool HasBase>
+inline void computeTableauCombination(State& result,
+                                      const State& base,
+                                      const Real scale,
+                                      const State* const stateDerivatives)
+{
+    static_assert(findFirstNonZeroTerm<Real, Coefficients>(0) < Coefficients::numberOfTerms,
+                  "Combination of stage state derivatives must contain at least one term");
+    computeTableauCombination<Real, State, Coefficients, HasBase>(
+        result, base, scale, stateDerivatives, typename StateTag<State>::type());
+}
+
+//! Flag that indicates if tableau has First-Same-As-Last property (false if not specified).
+template <typename Tableau, typename Enable = void>
+struct IsFirstSameAsLast : std::false_type
+{ };
+
+//! Flag that indicates if tableau has First-Same-As-Last property (as specified by tableau).
+template <typename Tableau>
+struct IsFirstSameAsLast<Tableau,
+                         typename MakeVoid<decltype(Tableau::isFirstSameAsLast)>::type>
+    : std::integral_constant<bool, Tableau::isFirstSameAsLast>
+{ };
+
+//! Flag that indicates if tableau defines continuous extension (false if not specified).
+template <typename Tableau, typename Enable = void>
+struct HasContinuousExtension : std::false_type
+{ };
+
+//! Flag that indicates if tableau defines continuous extension (true if bTheta is specified).
+template <typename Tableau>
+struct HasContinuousExtension<Tableau, typename MakeVoid<decltype(Tableau::bTheta)>::type>
+    : std::true_type
+{ };
+
+//! Order of embedded solution of tableau (order of propagated solution minus one if not specified).
+template <typename Tableau, typename Enable = void>
+struct EmbeddedOrder : std::integral_constant<int, Tableau::order - 1>
+{ };
+
+//! Order of embedded solution of tableau (as specified by tableau).
+template <typename Tableau>
+struct EmbeddedOrder<Tableau, typename MakeVoid<decltype(Tableau::embeddedOrder)>::type>
+    : std::integral_constant<int, Tableau::embeddedOrder>
+{ };
+
+//! Order of error estimate of tableau, i.e., lowest order of propagated and embedded solution + 1.
+template <typename Tableau>
+struct ErrorEstimateOrder
+    : std::integral_constant<int, (Tableau::order < EmbeddedOrder<Tableau>::value
+                                   ? Tableau::order
+                                   : EmbeddedOrder<Tableau>::value) + 1>
+{ };
+
+} // namespace detail
+
+//! Explicit Runge-Kutta stepper.
+/*!
+ * Stepper that executes integration steps using an explicit Runge-Kutta scheme that is defined by
+ * a Butcher tableau. The tableau is a class with the following static members:
+ *
+ *  - numberOfStages: number of stages s
+ *  - order: order of the propagated solution
+ *  - isEmbedded: flag that indicates if the tableau contains an embedded solution (bHat)
+ *  - embeddedOrder: order of the embedded solution (optional, defaults to order - 1)
+ *  - isFirstSameAsLast: flag that indicates if the last stage is evaluated at the end of the step
+ *    with the propagated solution (optional, defaults to false)
+ *  - c[s]: nodes
+ *  - a[s][s]: Runge-Kutta matrix (strictly lower-triangular)
+ *  - b[s]: weights of the propagated solution
+ *  - bHat[s]: weights of the embedded solution (only required for embedded tableaus)
+ *  - bTheta[s][m]: coefficients of the polynomial weights of the continuous extension, i.e.,
+ *    b_i(theta) = sum_j bTheta[i][j] theta^(j + 1) (optional)
+ *
+ * All coefficients are constexpr, so that the stage loops are unrolled and terms with zero
+ * coefficients are skipped at compile-time. The stepper owns the storage for the stage state
+ * derivatives and the stage state, which is allocated on the first step and reused for all
+ * subsequent steps.
+ *
+ * For First-Same-As-Last (FSAL) tableaus, the last stage state derivative of an accepted step is
+ * equal to the state derivative at the start of the next step. The stepper keeps it and reuses it
+ * as the first stage of the next step, provided that the next step starts from the time and state
+ * at which the previous step ended, which saves one state derivative evaluation per step.
+ *
+ * After each accepted adaptive step, the state at any time within the step is available as dense
+ * output (see interpolate()), at the cost of a linear combination of the stage state derivatives,
+ * so that output at given times does not require shortened steps. If the tableau defines a
+ * continuous extension (bTheta), it is used; otherwise, the state is computed with cubic Hermite
+ * interpolation, which requires the state derivative at the end of the step. For FSAL tableaus,
+ * this is the last stage state derivative, so that dense output is always available; for other
+ * tableaus, it is evaluated after each accepted step if dense output is enabled on construction,
+ * and reused as the first stage of the next step.
+ *
+ * The stepper fills in the given statistics policy with the state derivative evaluations and the
+ * accepted and rejected steps, e.g., IntegrationStatistics. The default policy, NullStatistics,
+ * is compiled out entirely.
+ *
+ * @tparam  Real        Type for floating-point number
+ * @tparam  State       Type for state and state derivative
+ * @tparam  Tableau     Butcher tableau that defines Runge-Kutta scheme
+ * @tparam  Statistics  Statistics policy, e.g., NullStatistics or IntegrationStatistics
+ */
+template <typename Real, typename State, typename Tableau, typename Statistics = NullStatistics>
+class ExplicitRungeKuttaStepper
+{
+public:
+
+    //! Construct stepper.
+    /*!
+     * Constructs stepper.
+     *
+     * @param[in]  isDenseOutputEnabled  Flag that indicates if the state derivative at the end of
+     *                                   each accepted adaptive step is evaluated, so that dense
+     *                                   output is available for tableaus that are not FSAL
+     */
+    explicit ExplicitRungeKuttaStepper(const bool isDenseOutputEnabled = false)
+        : isDenseOutputEnabled(isDenseOutputEnabled),
+          isFirstStageStateDerivativeValid(false),
+          firstStageTime(0.0),
+          isDenseOutputValid(false),
+          denseOutputStartTime(0.0),
+          denseOutputStepSize(0.0)
+    { }
+
+    //! Execute single integration step with fixed step size.
+    /*!
+     * Executes single numerical integration step with given step size. For embedded tableaus,
+     * the error estimate is not computed. Dense output is not available after steps with fixed
+     * step size.
+     *
+     * @tparam         StateDerivative         Type of callable to compute state derivative, e.g.,
+     *                                         function pointer, functor, lambda or
+     *                                         StateDerivativeFunction
+     * @param[in,out]  time                    Independent variable, which is provided as input and
+     *                                         is updated with output at end of integration step
+     * @param[in,out]  state                   State, which is provided as input and is updated
+     *                                         with output at end of integration step
+     * @param[in]      stepSize                Step size to take for integration step
+     * @param[in]      computeStateDerivative  Function to compute state derivative for current
+     *                                         time and state
+     */
+    template <typename StateDerivative>
+    void step(Real& time,
+              State& state,
+              const Real stepSize,
+              const StateDerivative& computeStateDerivative)
+    {
+        statistics.startStep();
+        computeStages(time, state, stepSize, computeStateDerivative);
+        acceptStep(time, state, stepSize);
+        isDenseOutputValid = false;
+        statistics.recordAcceptedStep(stepSize);
+        statistics.stopStep();
+    }
+
+    //! Execute single integration step with adaptive step size.
+    /*!
+     * Executes single numerical integration step with adaptive step size control, based on the
+     * error estimate of the embedded solution. If the maximum norm of the error estimate exceeds
+     * the tolerance times the step size, the step is rejected and repeated with a smaller step
+     * size, until it is accepted. The first stage state derivative is evaluated once and reused
+     * for all repeated attempts. The step size is scaled by the elementary controller, i.e., a
+     * factor 0.84 (tolerance / error)^(1/order) between 0.1 and 4.0, per attempt and is bounded by
+     * the maximum step size; the step size for the next step is also bounded by the minimum step
+     * size. See the overload that takes an error norm and a StepSizeController for mixed absolute
+     * and relative tolerances per element and PI step size control.
+     *
+     * @throws std::runtime_error  If a rejected step has to be repeated with a step size that is
+     *                             smaller than the minimum step size
+     *
+     * @tparam         StateDerivative         Type of callable to compute state derivative, e.g.,
+     *                                         function pointer, functor, lambda or
+     *                                         StateDerivativeFunction
+     * @param[in,out]  time                    Independent variable, which is provided as input and
+     *                                         is updated with output at end of integration step
+     * @param[in,out]  state                   State, which is provided as input and is updated
+     *                                         with output at end of integration step
+     * @param[in,out]  stepSize                Step size to take for integration step, which is
+     *                                         updated with step size for next integration step
+     * @param[in]      computeStateDerivative  Function to compute state derivative for current
+     *                                         time and state
+     * @param[in]      tolerance               Local truncation error tolerance
+     * @param[in]      minimumStepSize         Minimum allowable step size for integration step
+     * @param[in]      maximumStepSize         Maximum allowable step size for integration step
+     */
+    template <typename StateDerivative>
+    void step(Real& time,
+              State& state,
+              Real& stepSize,
+              const StateDerivative& computeStateDerivative,
+              const Real tolerance,
+              const Real minimumStepSize,
+              const Real maximumStepSize)
+    {
+        StepSizeController<Real> elementaryController(1.0, 0.0, 0.0, 0.84, 0.1, 4.0);
+        stepAdaptive(time, state, stepSize, computeStateDerivative,
+                     detail::ErrorPerUnitStepNorm<Real>(tolerance), elementaryController,
+                     Tableau::order, minimumStepSize, maximumStepSize);
+    }
+
+    //! Execute single integration step with adaptive step size, error norm and controller.
+    /*!
+     * Executes single numerical integration step with adaptive step size control, based on the
+     * scaled error of the error estimate of the embedded solution, as computed by the given error
+     * norm, e.g., WeightedRootMeanSquareErrorNorm. If the scaled error exceeds 1, the step is
+     * rejected and repeated with a smaller step size, until it is accepted. The factor by which
+     * the step size is scaled after each attempt is computed by the given controller, which keeps
+     * the scaled errors of previous steps (see StepSizeController). The step size is bounded by
+     * the maximum step size; the step size for the next step is also bounded by the minimum step
+     * size.
+     *
+     * @throws std::runtime_error  If a rejected step has to be repeated with a step size that is
+     *                             smaller than the minimum step size
+     *
+     * @tparam         StateDerivative         Type of callable to compute state derivative, e.g.,
+     *                                         function pointer, functor, lambda or
+     *                                         StateDerivativeFunction
+     * @tparam         ErrorNorm               Type of callable to compute scaled error, e.g.,
+     *                                         WeightedRootMeanSquareErrorNorm
+     * @param[in,out]  time                    Independent variable, which is provided as input and
+     *                                         is updated with output at end of integration step
+     * @param[in,out]  state                   State, which is provided as input and is updated
+     *                                         with output at end of integration step
+     * @param[in,out]  stepSize                Step size to take for integration step, which is
+     *                                         updated with step size for next integration step
+     * @param[in]      computeStateDerivative  Function to compute state derivative for current
+     *                                         time and state
+     * @param[in]      computeError            Function to compute scaled error of error estimate
+     * @param[in,out]  controller              Step size controller, which is updated with scaled
+     *                                         error of accepted step
+     * @param[in]      minimumStepSize         Minimum allowable step size for integration step
+     * @param[in]      maximumStepSize         Maximum allowable step size for integration step
+     */
+    template <typename StateDerivative, typename ErrorNorm>
+    void step(Real& time,
+              State& state,
+              Real& stepSize,
+              const StateDerivative& computeStateDerivative,
+              const ErrorNorm& computeError,
+              StepSizeController<Real>& controller,
+              const Real minimumStepSize,
+              const Real maximumStepSize)
+    {
+        stepAdaptive(time, state, stepSize, computeStateDerivative, computeError, controller,
+                     detail::ErrorEstimateOrder<Tableau>::value, minimumStepSize, maximumStepSize);
+    }
+
+    //! Compute state at given time within last accepted adaptive step.
+    /*!
+     * Computes the state at given time within the last accepted adaptive step from the states and
+     * stage state derivatives of the step, using the continuous extension of the tableau if it is
+     * defined, or cubic Hermite interpolation otherwise. No state derivatives are evaluated. The
+     * state at times outside the step is extrapolated, with decreasing accuracy.
+     *
+     * @throws std::runtime_error  If no adaptive step was accepted since the last step with fixed
+     *                             step size, or if dense output is not enabled for tableau that
+     *                             is not FSAL
+     *
+     * @param[in]   time    Time at which state is computed
+     * @param[out]  result  State at given time
+     */
+    void interpolate(const Real time, State& result) const
+    {
+        if (!isDenseOutputValid)
+        {
+            throw std::runtime_error("Dense output is not available!");
+        }
+        interpolate((time - denseOutputStartTime) / denseOutputStepSize, result,
+                    detail::HasContinuousExtension<Tableau>());
+    }
+
+    //! Get state derivative at end of last accepted adaptive step.
+    /*!
+     * Returns the state derivative at the end of the last accepted adaptive step, which is kept
+     * for dense output, so that it can be recorded without evaluating it again.
+     *
+     * @throws std::runtime_error  If dense output is not available (see interpolate())
+     *
+     * @return  State derivative at end of last accepted adaptive step
+     */
+    const State& getEndStateDerivative() const
+    {
+        if (!isDenseOutputValid)
+        {
+            throw std::runtime_error("Dense output is not available!");
+        }
+        return workspace[0];
+    }
+
+    //! Reset stepper.
+    /*!
+     * Discards the state derivative that is kept for reuse in the next step, e.g., because the
+     * dynamical model has changed between steps.
+     */
+    void reset()
+    {
+        isFirstStageStateDerivativeValid = false;
+    }
+
+    //! Write state derivative that is kept for next step, and statistics, to checkpoint.
+    /*!
+     * Writes the configuration of the stepper, i.e., the number of stages and if the state
+     * derivative at the end of a step is kept, the state derivative that is reused as first stage
+     * of the next step, if any, and the statistics to the given checkpoint (see Checkpoint). Dense
+     * output of the last step is not written, so that it is not available after the checkpoint is
+     * read.
+     *
+     * @tparam      Checkpoint  Type of checkpoint, e.g., Checkpoint
+     * @param[out]  checkpoint  Checkpoint to which stepper is written
+     */
+    template <typename Checkpoint>
+    void writeCheckpoint(Checkpoint& checkpoint) const
+    {
+        checkpoint.write(static_cast<std::int32_t>(Tableau::numberOfStages));
+        checkpoint.write(isEndStateDerivativeKept());
+        checkpoint.write(isFirstStageStateDerivativeValid);
+        if (isFirstStageStateDerivativeValid)
+        {
+            checkpoint.write(firstStageTime);
+            checkpoint.writeState(workspace[firstStageStateIndex]);
+            checkpoint.writeState(workspace[0]);
+        }
+        statistics.writeCheckpoint(checkpoint);
+    }
+
+    //! Read state derivative that is kept for next step, and statistics, from checkpoint.
+    /*!
+     * Reads the data written by writeCheckpoint() from the given checkpoint, which must have
+     * been written by a stepper with the same configuration, i.e., the same tableau and dense
+     * output flag (unless the tableau has the First-Same-As-Last property).
+     *
+     * @throws std::runtime_error  If checkpoint does not contain data of stepper, or if it was
+     *                             written by a stepper with another configuration
+     *
+     * @tparam         Checkpoint  Type of checkpoint, e.g., Checkpoint
+     * @param[in,out]  checkpoint  Checkpoint from which stepper is read
+     * @param[in]      state       State with the number of elements of the integration
+     */
+    template <typename Checkpoint>
+    void readCheckpoint(Checkpoint& checkpoint, const State& state)
+    {
+        isDenseOutputValid = false;
+        isFirstStageStateDerivativeValid = false;
+
+        // The kept state derivative is only stored in the workspace of steppers that keep the
+        // state derivative at the end of a step, so the configuration is checked first.
+        std::int32_t numberOfStages = 0;
+        bool isEndStateDerivativeKeptInCheckpoint = false;
+        checkpoint.read(numberOfStages);
+        checkpoint.read(isEndStateDerivativeKeptInCheckpoint);
+        if (numberOfStages != Tableau::numberOfStages
+            || isEndStateDerivativeKeptInCheckpoint != isEndStateDerivativeKept())
+        {
+            throw std::runtime_error("Checkpoint was written by stepper with other configuration!");
+        }
+
+        bool isKeptStateDerivativeValid = false;
+        checkpoint.read(isKeptStateDerivativeValid);
+        if (isKeptStateDerivativeValid)
+        {
+            if (workspace.empty()
+                || !detail::hasSameSize(workspace[0], state,
+                                        typename detail::StateTag<State>::type()))
+            {
+                workspace.assign(Tableau::numberOfStages + (isEndStateDerivativeKept() ? 3 : 2),
+                                 state);
+            }
+            checkpoint.read(firstStageTime);
+            checkpoint.readState(workspace[firstStageStateIndex]);
+            checkpoint.readState(workspace[0]);
+            isFirstStageStateDerivativeValid = true;
+        }
+        statistics.readCheckpoint(checkpoint);
+    }
+
+    //! Get statistics collected by stepper.
+    const Statistics& getStatistics() const { return statistics; }
+
+    //! Get statistics collected by stepper, e.g., to reset them.
+    Statistics& getStatistics() { return statistics; }
+
+protected:
+private:
+
+    //! Flag that indicates if tableau has First-Same-As-Last property.
+    static const bool isFirstSameAsLast = detail::IsFirstSameAsLast<Tableau>::value;
+
+    //! Index of propagated solution in workspace, which is computed before a step is accepted.
+    static const int nextStateIndex = Tableau::numberOfStages + 1;
+
+    //! Index of state in workspace at which the kept first stage state derivative was evaluated.
+    static const int firstStageStateIndex = Tableau::numberOfStages + 2;
+
+    //! Index of first stage state derivative of last accepted step in workspace, which is moved
+    //! when the state derivative at the end of the step is kept.
+    static const int startStateDerivativeIndex
+        = isFirstSameAsLast ? Tableau::numberOfStages - 1 : Tableau::numberOfStages;
+
+    //! Check if state derivative at end of step is kept, i.e., if workspace stores first stage
+    //! state derivative of next step at firstStageStateIndex.
+    bool isEndStateDerivativeKept() const
+    {
+        return isFirstSameAsLast || isDenseOutputEnabled;
+    }
+
+    //! Execute single integration step with adaptive step size control.
+    template <typename StateDerivative, typename ErrorNorm>
+    void stepAdaptive(Real& time,
+                      State& state,
+                      Real& stepSize,
+                      const StateDerivative& computeStateDerivative,
+                      const ErrorNorm& computeError,
+                      StepSizeController<Real>& controller,
+                      const int errorEstimateOrder,
+                      const Real minimumStepSize,
+                      const Real maximumStepSize)
+    {
+        static_assert(Tableau::isEmbedded,
+                      "Adaptive step size control requires tableau with embedded solution");
+
+        statistics.startStep();
+
+        // Rejected attempts overwrite the stages of the last accepted step, so its dense output
+        // is discarded, also if no attempt of this step is accepted.
+        isDenseOutputValid = false;
+
+        // The first stage does not depend on the step size, so it is evaluated once and reused
+        // for all attempts of this step.
+        computeFirstStage(time, state, computeStateDerivative);
+
+        while (true)
+        {
+            computeStage(time, state, stepSize, computeStateDerivative,
+                         std::integral_constant<int, 1>());
+
+            // Reuse stage state as storage for the error estimate. The propagated solution is
+            // computed before the step is accepted, since relative tolerances depend on it.
+            State& errorEstimate = workspace[Tableau::numberOfStages];
+            State& nextState = workspace[nextStateIndex];
+            detail::computeTableauCombination<
+                Real, State, detail::ErrorEstimateCoefficients<Real, Tableau>, false>(
+                    errorEstimate, state, stepSize, workspace.data());
+            detail::computeTableauCombination<
+                Real, State, detail::SolutionCoefficients<Real, Tableau>, true>(
+                    nextState, state, stepSize, workspace.data());
+
+            const Real error = computeError(errorEstimate, state, nextState, stepSize);
+            const bool isAccepted = error <= 1.0;
+            const Real stepSizeFactor
+                = controller.computeStepSizeFactor(error, errorEstimateOrder, isAccepted);
+
+            if (isAccepted)
+            {
+                statistics.recordAcceptedStep(stepSize);
+                denseOutputStartTime = time;
+                denseOutputStepSize = stepSize;
+                time += stepSize;
+
+                // The state at the start of the step is kept in place of the propagated solution
+                // for dense output.
+                using std::swap;
+                swap(state, nextState);
+                keepLastStageStateDerivative(time, state,
+                                             std::integral_constant<bool, isFirstSameAsLast>());
+                if (!isFirstSameAsLast && isDenseOutputEnabled)
+                {
+                    keepEndStateDerivative(time, state, computeStateDerivative);
+                }
+                isDenseOutputValid = isEndStateDerivativeKept();
+
+                stepSize = stepSizeFactor * stepSize;
+                if (stepSize > maximumStepSize)
+                {
+                    stepSize = maximumStepSize;
+                }
+                else if (stepSize < minimumStepSize)
+                {
+                    stepSize = minimumStepSize;
+                }
+                statistics.stopStep();
+                return;
+            }
+
+            statistics.recordRejectedStep(stepSize);
+            stepSize = stepSizeFactor * stepSize;
+            if (stepSize > maximumStepSize)
+            {
+                stepSize = maximumStepSize;
+            }
+            else if (stepSize < minimumStepSize)
+            {
+                statistics.stopStep();
+                throw std::runtime_error("Minimum step size exceeded!");
+            }
+        }
+    }
+
+    //! Compute all stage state derivatives for given time, state and step size.
+    template <typename StateDerivative>
+    void computeStages(const Real time,
+                       const State& state,
+                       const Real stepSize,
+                       const StateDerivative& computeStateDerivative)
+    {
+        computeFirstStage(time, state, computeStateDerivative);
+        computeStage(time, state, stepSize, computeStateDerivative,
+                     std::integral_constant<int, 1>());
+    }
+
+    //! Compute first stage state derivative, unless it was kept from previous step.
+    template <typename StateDerivative>
+    void computeFirstStage(const Real time,
+                           const State& state,
+                           const StateDerivative& computeStateDerivative)
+    {
+        // The workspace is set up again if the number of elements of the state has changed, since
+        // state derivatives may be written in-place.
+        if (workspace.empty()
+            || !detail::hasSameSize(workspace[0], state, typename detail::StateTag<State>::type()))
+        {
+            workspace.assign(Tableau::numberOfStages + (isEndStateDerivativeKept() ? 3 : 2), state);
+            isFirstStageStateDerivativeValid = false;
+        }
+
+        if (!(isFirstStageStateDerivativeValid
+              && time == firstStageTime
+              && detail::isEqualState(
+                  state, workspace[firstStageStateIndex],
+                  std::integral_constant<bool, StateTraits<State>::isIndexable>())))
+        {
+            evaluateStageStateDerivative(computeStateDerivative, time, state, workspace[0]);
+        }
+        isFirstStageStateDerivativeValid = false;
+    }
+
+    //! Compute stage state and stage state derivative of given stage and all subsequent stages.
+    template <typename StateDerivative, int Stage>
+    void computeStage(const Real time,
+                      const State& state,
+                      const Real stepSize,
+                      const StateDerivative& computeStateDerivative,
+                      std::integral_constant<int, Stage>)
+    {
+        State& stageState = workspace[Tableau::numberOfStages];
+        detail::computeTableauCombination<
+            Real, State, detail::StageCoefficients<Real, Tableau, Stage>, true>(
+                stageState, state, stepSize, workspace.data());
+        evaluateStageStateDerivative(computeStateDerivative,
+                                     time + Tableau::c[Stage] * stepSize,
+                                     stageState,
+                                     workspace[Stage]);
+        computeStage(time, state, stepSize, computeStateDerivative,
+                     std::integral_constant<int, Stage + 1>());
+    }
+
+    //! Compute stage state and stage state derivative (recursion end).
+    template <typename StateDerivative>
+    void computeStage(const Real,
+                      const State&,
+                      const Real,
+                      const StateDerivative&,
+                      std::integral_constant<int, Tableau::numberOfStages>)
+    { }
+
+    //! Evaluate stage state derivative and record evaluation in statistics.
+    template <typename StateDerivative>
+    void evaluateStageStateDerivative(const StateDerivative& computeStateDerivative,
+                                      const Real time,
+                                      const State& state,
+                                      State& stateDerivative)
+    {
+        statistics.startStateDerivativeEvaluation();
+        evaluateStateDerivative(computeStateDerivative, time, state, stateDerivative);
+        statistics.stopStateDerivativeEvaluation();
+    }
+
+    //! Update time and state with propagated solution of computed stages.
+    void acceptStep(Real& time, State& state, const Real stepSize)
+    {
+        time += stepSize;
+        detail::computeTableauCombination<
+            Real, State, detail::SolutionCoefficients<Real, Tableau>, true>(
+                state, state, stepSize, workspace.data());
+        keepLastStageStateDerivative(time, state,
+                                     std::integral_constant<bool, isFirstSameAsLast>());
+    }
+
+    //! Keep last stage state derivative for reuse as first stage of next step.
+    void keepLastStageStateDerivative(const Real time, const State& state, std::true_type)
+    {
+        using std::swap;
+        swap(workspace[0], workspace[Tableau::numberOfStages - 1]);
+        workspace[firstStageStateIndex] = state;
+        firstStageTime = time;
+        isFirstStageStateDerivativeValid = true;
+    }
+
+    //! Keep last stage state derivative (not applicable if tableau is not FSAL).
+    void keepLastStageStateDerivative(const Real, const State&, std::false_type)
+    { }
+
+    //! Evaluate and keep state derivative at end of step for dense output and reuse as first
+    //! stage of next step (for tableaus that are not FSAL).
+    template <typename StateDerivative>
+    void keepEndStateDerivative(const Real time,
+                                const State& state,
+                                const StateDerivative& computeStateDerivative)
+    {
+        // The stage state is not needed after the step is accepted, so it stores the first stage
+        // state derivative of the step.
+        using std::swap;
+        evaluateStageStateDerivative(computeStateDerivative, time, state,
+                                     workspace[startStateDerivativeIndex]);
+        swap(workspace[0], workspace[startStateDerivativeIndex]);
+        workspace[firstStageStateIndex] = state;
+        firstStageTime = time;
+        isFirstStageStateDerivativeValid = true;
+    }
+
+    //! Get stage state derivative of last accepted step.
+    const State& getStageStateDerivative(const int stage) const
+    {
+        if (stage == 0)
+        {
+            return workspace[startStateDerivativeIndex];
+        }
+        return isFirstSameAsLast && stage == Tableau::numberOfStages - 1
+            ? workspace[0] : workspace[stage];
+    }
+
+    //! Compute state at given fraction of last accepted step with continuous extension.
+    void interpolate(const Real stepFraction, State& result, std::true_type) const
+    {
+        static const int degree
+            = static_cast<int>(std::extent<decltype(Tableau::bTheta), 1>::value);
+
+        Real coefficients[Tableau::numberOfStages];
+        const State* terms[Tableau::numberOfStages];
+        std::size_t numberOfTerms = 0;
+        for (int stage = 0; stage < Tableau::numberOfStages; ++stage)
+        {
+            Real weight = 0.0;
+            Real power = stepFraction;
+            for (int j = 0; j < degree; ++j)
+            {
+                weight += Tableau::bTheta[stage][j] * power;
+                power *= stepFraction;
+            }
+            if (weight != 0.0)
+            {
+                coefficients[numberOfTerms] = weight;
+                terms[numberOfTerms] = &getStageStateDerivative(stage);
+                ++numberOfTerms;
+            }
+        }
+        if (numberOfTerms == 0)
+        {
+            result = workspace[nextStateIndex];
+            return;
+        }
+        detail::computeLinearCombination<Real, State>(
+            result, &workspace[nextStateIndex], denseOutputStepSize, coefficients, terms,
+            numberOfTerms, typename detail::StateTag<State>::type());
+    }
+
+    //! Compute state at given fraction of last accepted step with cubic Hermite interpolation.
+    void interpolate(const Real stepFraction, State& result, std::false_type) const
+    {
+        computeHermiteInterpolation(result, stepFraction, denseOutputStepSize,
+                                    workspace[nextStateIndex], getStageStateDerivative(0),
+                                    workspace[firstStageStateIndex], workspace[0]);
+    }
+
+    //! Flag that indicates if state derivative at end of accepted steps is evaluated for dense
+    //! output, for tableaus that are not FSAL.
+    bool isDenseOutputEnabled;
+
+    //! Storage for stage derivatives, stage state, propagated solution and FSAL state. After an
+    //! adaptive step is accepted, the propagated solution is replaced by the state at the start of
+    //! the step.
+    std::vector<State> workspace;
+
+    //! Flag that indicates if first stage state derivative of next step is available.
+    bool isFirstStageStateDerivativeValid;
+
+    //! Time at which first stage state derivative of next step was evaluated.
+    Real firstStageTime;
+
+    //! Flag that indicates if dense output of last accepted step is available.
+    bool isDenseOutputValid;
+
+    //! Time at start of last accepted step.
+    Real denseOutputStartTime;
+
+    //! Step size of last accepted step.
+    Real denseOutputStepSize;
+
+    //! Statistics collected by stepper.
+    Statistics statistics;
+};
+
+} // namespace integrate
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2014-2025 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "integrate/stateDerivative.hpp"
+#include "integrate/symplectic.hpp"
+#include "integrate/threadLocalStepper.hpp"
+
+namespace integrate
+{
+
+//! Coefficients for Forest-Ruth scheme.
+/*!
+ * Drift and kick coefficients for the 4th-order Forest-Ruth scheme (Forest & Ruth, 1990), with
+ * theta = 1 / (2 - 2^(1/3)):
+ *
+ *  - c = {theta / 2, (1 - theta) / 2, (1 - theta) / 2, theta / 2}
+ *  - d = {theta, 1 - 2 theta, theta}
+ *
+ * The scheme starts and ends with a drift, so that each step costs three acceleration
+ * evaluations.
+ *
+ * @tparam  Real  Type for floating-point number
+ */
+template <typename Real>
+struct ForestRuthCoefficients
+{
+    //! Number of kicks.
+    static const int numberOfStages = 3;
+
+    //! Order of scheme.
+    static const int order = 4;
+
+    //! Drift coefficients.
+    static constexpr Real c[4] = {
+        0.675603595979828817023843904485730413, -0.175603595979828817023843904485730413,
+        -0.175603595979828817023843904485730413, 0.675603595979828817023843904485730413
+    };
+
+    //! Kick coefficients.
+    static constexpr Real d[3] = {
+        1.35120719195965763404768780897146083, -1.70241438391931526809537561794292165,
+        1.35120719195965763404768780897146083
+    };
+};
+
+template <typename Real> constexpr Real ForestRuthCoefficients<Real>::c[4];
+template <typename Real> constexpr Real ForestRuthCoefficients<Real>::d[3];
+
+//! Forest-Ruth stepper.
+/*!
+ * Stepper that executes integration steps using Forest-Ruth scheme. See SymplecticStepper for
+ * details.
+ *
+ * @tparam  Real        Type for floating-point number
+ * @tparam  State       Type for position, velocity and acceleration
+ * @tparam  Statistics  Statistics policy, e.g., NullStatistics or IntegrationStatistics
+ */
+template <typename Real, typename State, typename Statistics = NullStatistics>
+using ForestRuthStepper = SymplecticStepper<Real, State, ForestRuthCoefficients<Real>, Statistics>;
+
+//! Execute single integration step using Forest-Ruth scheme.
+/*!
+ * Executes single numerical integration step using Forest-Ruth scheme. The stepper that holds the
+ * storage for the acceleration is kept per thread and reused across calls, so that memory is only
+ * allocated on the first call of each thread.
+ *
+ * @tparam         Real                 Type for floating-point number
+ * @tparam         State                Type for position, velocity and acceleration
+ * @tparam         Acceleration         Type of callable to compute acceleration, e.g., function
+ *                                      pointer, functor, lambda or StateDerivativeFunction
+ * @param[in,out]  time                 Independent variable, which is provided as input and is
+ *                                      updated with output at end of integration step
+ * @param[in,out]  position             Position, which is provided as input and is updated with
+ *                                      output at end of integration step
+ * @param[in,out]  velocity             Velocity, which is provided as input and is updated with
+ *                                      output at end of integration step
+ * @param[in]      stepSize             Step size to take for integration step
+ * @param[in]      computeAcceleration  Function to compute acceleration for current time and
+ *                                      position
+ */
+template <typename Real, typename State, typename Acceleration>
+const void stepForestRuth(
+    Real& time,
+    State& position,
+    State& velocity,
+    const Real stepSize,
+    const Acceleration& computeAcceleration)
+{
+    detail::ThreadLocalStepper<ForestRuthStepper<Real, State> > threadLocalStepper;
+    ForestRuthStepper<Real, State>& stepper = threadLocalStepper.get();
+    stepper.step(time, position, velocity, stepSize, computeAcceleration);
+};
+
+} // namespace integrate
@@ -0,0 +1,247 @@
+/*
+ * Copyright (c) 2014-2025 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include "integrate/linearCombination.hpp"
+#include "integrate/stateNorm.hpp"
+
+namespace integrate
+{
+namespace detail
+{
+
+//! Restarted GMRES solver for linear systems on states.
+/*!
+ * Solver for linear systems A x = b, where A is only available as a function that computes the
+ * product of A with a state, e.g., a finite-difference approximation of a Jacobian-vector
+ * product, using the restarted Generalized Minimal Residual method with right preconditioning
+ * (Saad, 2003, Section 9.3.2). The Krylov basis is orthogonalized with modified Gram-Schmidt, and
+ * the least-squares problem is solved with Givens rotations, so that the residual norm is known
+ * after each iteration without additional products. The solver owns the Krylov basis, which is
+ * allocated on the first solve, so that its memory grows linearly with the size of the state.
+ *
+ * @tparam  Real   Type for floating-point number
+ * @tparam  State  Type for state (indexable or contiguous)
+ */
+template <typename Real, typename State>
+class GMRESSolver
+{
+public:
+
+    //! Construct solver.
+    /*!
+     * Constructs solver.
+     *
+     * @throws std::invalid_argument  If Krylov subspace dimension is smaller than 1
+     *
+     * @param[in]  krylovDimension  Dimension of Krylov subspace after which GMRES is restarted
+     */
+    explicit GMRESSolver(const int krylovDimension)
+        : krylovDimension(krylovDimension),
+          hessenberg(static_cast<std::size_t>(krylovDimension + 1) * krylovDimension),
+          cosines(krylovDimension),
+          sines(krylovDimension),
+          residuals(krylovDimension + 1),
+          coefficients(krylovDimension),
+          terms(krylovDimension)
+    {
+        if (krylovDimension < 1)
+        {
+            throw std::invalid_argument("Krylov subspace dimension must be at least 1!");
+        }
+    }
+
+    //! Solve linear system with zero initial guess.
+    /*!
+     * Solves linear system A x = b, starting from x = 0, until the 2-norm of the residual is
+     * reduced by the given factor, or the maximum number of iterations (products with A) is
+     * reached. In the latter case, the last iterate is returned, e.g., for inexact Newton
+     * methods, which check convergence themselves.
+     *
+     * @tparam      LinearOperator       Type of callable that computes product of A with state,
+     *                                   i.e., void applyOperator(const State& x, State& result)
+     * @tparam      Preconditioner       Type of callable that applies inverse of preconditioner
+     *                                   to state, i.e.,
+     *                                   void applyPreconditioner(const State& x, State& result)
+     * @param[in]   applyOperator        Function that computes product of A with state
+     * @param[in]   applyPreconditioner  Function that applies inverse of preconditioner
+     * @param[in]   rightHandSide        Right-hand side b
+     * @param[out]  solution             Solution x
+     * @param[in]   relativeTolerance    Factor by which 2-norm of residual is reduced
+     * @param[in]   maximumIterations    Maximum number of iterations
+     * @return                           Number of iterations
+     */
+    template <typename LinearOperator, typename Preconditioner>
+    int solve(const LinearOperator& applyOperator,
+              const Preconditioner& applyPreconditioner,
+              const State& rightHandSide,
+              State& solution,
+              const Real relativeTolerance,
+              const int maximumIterations)
+    {
+        // The basis is set up again if the number of elements of the state has changed, since
+        // products are written in-place.
+        if (basis.empty()
+            || !detail::hasSameSize(basis[0], rightHandSide,
+                                    typename detail::StateTag<State>::type()))
+        {
+            basis.assign(krylovDimension + 1, rightHandSide);
+            workspace.assign(2, rightHandSide);
+        }
+        State& product = workspace[0];
+        State& preconditionedVector = workspace[1];
+
+        const Real zero = 0.0;
+        integrate::computeWeightedSum(solution, zero, 1.0, rightHandSide);
+        State& residual = basis[0];
+        residual = rightHandSide;
+        const Real targetResidualNorm
+            = relativeTolerance * computeTwoNorm(rightHandSide);
+
+        int numberOfIterations = 0;
+        while (true)
+        {
+            const Real residualNorm = computeTwoNorm(residual);
+            if (residualNorm <= targetResidualNorm
+                || residualNorm == 0.0
+                || numberOfIterations >= maximumIterations)
+            {
+                return numberOfIterations;
+            }
+
+            // Arnoldi process, starting from normalized residual.
+            integrate::computeWeightedSum(basis[0], 1.0 / residualNorm, 1.0, residual);
+            residuals[0] = residualNorm;
+            int dimension = 0;
+            bool isConverged = false;
+            while (dimension < krylovDimension && numberOfIterations < maximumIterations)
+            {
+                const int j = dimension;
+                applyPreconditioner(basis[j], preconditionedVector);
+                applyOperator(preconditionedVector, product);
+                ++numberOfIterations;
+
+                for (int i = 0; i <= j; ++i)
+                {
+                    const Real projection = integrate::computeDotProduct<Real>(product, basis[i]);
+                    getHessenberg(i, j) = projection;
+                    integrate::computeLinearCombination(product, product, -projection,
+                                                        1.0, basis[i]);
+                }
+                const Real productNorm = computeTwoNorm(product);
+                getHessenberg(j + 1, j) = productNorm;
+                if (productNorm > 0.0)
+                {
+                    integrate::computeWeightedSum(basis[j + 1], 1.0 / productNorm, 1.0, product);
+                }
+
+                // Apply previous rotations to new column, and compute rotation that eliminates
+                // subdiagonal element.
+                for (int i = 0; i < j; ++i)
+                {
+                    const Real upper = getHessenberg(i, j);
+                    const Real lower = getHessenberg(i + 1, j);
+                    getHessenberg(i, j) = cosines[i] * upper + sines[i] * lower;
+                    getHessenberg(i + 1, j) = -sines[i] * upper + cosines[i] * lower;
+                }
+                const Real diagonal = getHessenberg(j, j);
+                const Real radius = std::sqrt(diagonal * diagonal + productNorm * productNorm);
+                cosines[j] = radius > 0.0 ? diagonal / radius : 1.0;
+                sines[j] = radius > 0.0 ? productNorm / radius : 0.0;
+                getHessenberg(j, j) = radius;
+                getHessenberg(j + 1, j) = 0.0;
+                residuals[j + 1] = -sines[j] * residuals[j];
+                residuals[j] = cosines[j] * residuals[j];
+
+                ++dimension;
+                if (std::fabs(residuals[j + 1]) <= targetResidualNorm || productNorm == 0.0)
+                {
+                    isConverged = true;
+                    break;
+                }
+            }
+
+            // Solve upper-triangular least-squares system, and update solution with
+            // preconditioned combination of basis states.
+            for (int i = dimension - 1; i >= 0; --i)
+            {
+                Real sum = residuals[i];
+                for (int l = i + 1; l < dimension; ++l)
+                {
+                    sum -= getHessenberg(i, l) * coefficients[l];
+                }
+                coefficients[i] = getHessenberg(i, i) != 0.0 ? sum / getHessenberg(i, i) : 0.0;
+                terms[i] = &basis[i];
+            }
+            detail::computeLinearCombination<Real, State>(
+                product, nullptr, 1.0, coefficients.data(), terms.data(),
+                static_cast<std::size_t>(dimension), typename detail::StateTag<State>::type());
+            applyPreconditioner(product, preconditionedVector);
+            integrate::computeLinearCombination(solution, solution, 1.0, 1.0, preconditionedVector);
+
+            if (isConverged || numberOfIterations >= maximumIterations)
+            {
+                return numberOfIterations;
+            }
+
+            // Restart with true residual.
+            applyOperator(solution, product);
+            integrate::computeLinearCombination(residual, rightHandSide, -1.0, 1.0, product);
+        }
+    }
+
+protected:
+private:
+
+    //! Get element of Hessenberg matrix.
+    Real& getHessenberg(const int row, const int column)
+    {
+        return hessenberg[static_cast<std::size_t>(row) * krylovDimension + column];
+    }
+
+    //! Compute 2-norm of state.
+    static Real computeTwoNorm(const State& state)
+    {
+        return std::sqrt(integrate::computeDotProduct<Real>(state, state));
+    }
+
+    //! Dimension of Krylov subspace after which GMRES is restarted.
+    int krylovDimension;
+
+    //! Hessenberg matrix of Arnoldi process, in row-major order, reduced to upper-triangular
+    //! form by Givens rotations.
+    std::vector<Real> hessenberg;
+
+    //! Cosines of Givens rotations.
+    std::vector<Real> cosines;
+
+    //! Sines of Givens rotations.
+    std::vector<Real> sines;
+
+    //! Right-hand side of least-squares problem, i.e., rotated residual norms.
+    std::vector<Real> residuals;
+
+    //! Coefficients of basis states in update of solution.
+    std::vector<Real> coefficients;
+
+    //! Basis states in update of solution.
+    std::vector<const State*> terms;
+
+    //! Orthonormal basis of Krylov subspace.
+    std::vector<State> basis;
+
+    //! Storage for operator product and preconditioned state.
+    std::vector<State> workspace;
+};
+
+} // namespace detail
+} // namespace integrate
@@ -0,0 +1,796 @@
+/*
+ * Copyright (c) 2014-2025 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "integrate/integrateAdaptive.hpp"
+#include "integrate/linearCombination.hpp"
+#include "integrate/stateDerivative.hpp"
+
+namespace integrate
+{
+
+//! Writer of trajectories to binary files with fixed-width records and a time index.
+/*!
+ * Writer that appends records of a trajectory, i.e., a time, the elements of a state and,
+ * optionally, the elements of the state derivative, to a binary file that is read with
+ * IndexedTrajectory. All records have the same width, so that record i is found at a fixed
+ * offset, and the times of every k-th record are collected in a time index, which is appended to
+ * the file when it is closed. The stored state derivatives are the coefficients of the cubic
+ * Hermite interpolant between consecutive records. The writer only keeps the time index in
+ * memory, i.e., one value per k records. The file consists of:
+ *
+ *  - header (64 bytes): magic "ITRJIDX" (8 bytes, including terminating zero), format version
+ *    (uint32), number of bytes per value (uint32), number of state elements n (uint64), flags
+ *    (uint64, bit 0 set if state derivatives are stored), number of records N (uint64), number
+ *    of records per index entry k (uint64), byte offset of time index (uint64) and 8 reserved
+ *    bytes
+ *  - records: N records of 1 + n values (1 + 2n values with state derivatives), i.e., the time,
+ *    the state elements and the state derivative elements
+ *  - time index: times of records 0, k, 2k, ..., i.e., ceil(N / k) values
+ *
+ * All values are stored in native byte order. The number of records and the offset of the time
+ * index are zero until the file is closed, so that incomplete files are rejected by the reader.
+ *
+ * @tparam  Real  Type for floating-point number
+ */
+template <typename Real>
+class IndexedTrajectoryWriter
+{
+public:
+
+    //! Version of file format.
+    static const std::uint32_t formatVersion = 1;
+
+    //! Size of file header in bytes.
+    static const std::size_t headerSize = 64;
+
+    //! Flag that is set in header if state derivatives are stored.
+    static const std::uint64_t stateDerivativeFlag = 1;
+
+    //! Construct writer and write file header.
+    /*!
+     * Constructs writer, creates file with given name (or overwrites existing file) and writes
+     * file header.
+     *
+     * @throws std::invalid_argument  If number of state elements or records per index entry is
+     *                                smaller than 1
+     * @throws std::runtime_error     If file cannot be opened
+     *
+     * @param[in]  fileName                 Name of trajectory file
+     * @param[in]  numberOfElements         Number of state elements per record
+     * @param[in]  isStateDerivativeStored  Flag that indicates if state derivatives are stored
+     * @param[in]  recordsPerIndexEntry     Number of records per entry of time index
+     */
+    IndexedTrajectoryWriter(const std::string& fileName,
+                            const std::size_t numberOfElements,
+                            const bool isStateDerivativeStored = false,
+                            const std::size_t recordsPerIndexEntry = 64)
+        : numberOfElements(numberOfElements),
+          isStateDerivativeStored(isStateDerivativeStored),
+          recordsPerIndexEntry(recordsPerIndexEntry),
+          numberOfRecords(0),
+          isClosed(false)
+    {
+        if (numberOfElements < 1 || recordsPerIndexEntry < 1)
+        {
+            throw std::invalid_argument(
+                "Number of state elements and records per index entry must be at least 1!");
+        }
+        file.open(fileName.c_str(), std::ios::binary | std::ios::trunc);
+        if (!file)
+        {
+            throw std::runtime_error("Trajectory file could not be opened!");
+        }
+        record.resize(1 + numberOfElements * (isStateDerivativeStored ? 2 : 1));
+        writeHeader(0, 0);
+    }
+
+    //! Write time index and close file.
+    ~IndexedTrajectoryWriter()
+    {
+        try
+        {
+            close();
+        }
+        catch (...)
+        { }
+    }
+
+    IndexedTrajectoryWriter(const IndexedTrajectoryWriter&) = delete;
+    IndexedTrajectoryWriter& operator=(const IndexedTrajectoryWriter&) = delete;
+
+    //! Get number of state elements per record.
+    std::size_t getNumberOfElements() const { return numberOfElements; }
+
+    //! Get flag that indicates if state derivatives are stored.
+    bool hasStateDerivatives() const { return isStateDerivativeStored; }
+
+    //! Get number of records written.
+    std::size_t getNumberOfRecords() const { return numberOfRecords; }
+
+    //! Get time of last record written (zero if no records are written).
+    Real getLastTime() const { return numberOfRecords > 0 ? record[0] : Real(0); }
+
+    //! Append record.
+    /*!
+     * Appends record to file. The times of the records must increase strictly, so that the state
+     * at any time between the first and last record can be interpolated.
+     *
+     * @throws std::invalid_argument  If time does not lie after time of previous record, or if no
+     *                                state derivative is given although state derivatives are
+     *                                stored
+     * @throws std::runtime_error     If writer is closed, or if record cannot be written
+     *
+     * @param[in]  time             Time of record
+     * @param[in]  state            State elements of record (numberOfElements values)
+     * @param[in]  stateDerivative  State derivative elements of record (numberOfElements values),
+     *                              which are ignored if state derivatives are not stored
+     */
+    void write(const Real time, const Real* const state, const Real* const stateDerivative = 0)
+    {
+        if (isClosed)
+        {
+            throw std::runtime_error("Trajectory writer is closed!");
+        }
+        if (numberOfRecords > 0 && !(time > record[0]))
+        {
+            throw std::invalid_argument("Times of records must increase strictly!");
+        }
+        if (isStateDerivativeStored && stateDerivative == 0)
+        {
+            throw std::invalid_argument("State derivative must be given!");
+        }
+
+        record[0] = time;
+        std::copy(state, state + numberOfElements, &record[1]);
+        if (isStateDerivativeStored)
+        {
+            std::copy(stateDerivative, stateDerivative + numberOfElements,
+                      &record[1 + numberOfElements]);
+        }
+        if (numberOfRecords % recordsPerIndexEntry == 0)
+        {
+            timeIndex.push_back(time);
+        }
+        writeBytes(record.data(), record.size() * sizeof(Real));
+        ++numberOfRecords;
+    }
+
+    //! Close file.
+    /*!
+     * Appends the time index, completes the file header and closes the file. Subsequent calls
+     * have no effect.
+     *
+     * @throws std::runtime_error  If file cannot be written
+     */
+    void close()
+    {
+        if (isClosed)
+        {
+            return;
+        }
+        isClosed = true;
+        const std::uint64_t indexOffset
+            = headerSize + numberOfRecords * record.size() * sizeof(Real);
+        writeBytes(timeIndex.data(), timeIndex.size() * sizeof(Real));
+        file.seekp(0);
+        writeHeader(numberOfRecords, indexOffset);
+        file.close();
+        if (!file)
+        {
+            throw std::runtime_error("Trajectory file could not be written!");
+        }
+    }
+
+protected:
+private:
+
+    //! Write file header with given number of records and offset of time index.
+    void writeHeader(const std::uint64_t recordCount, const std::uint64_t indexOffset)
+    {
+        char header[headerSize] = "ITRJIDX";
+        const std::uint32_t version = formatVersion;
+        const std::uint32_t bytesPerValue = sizeof(Real);
+        const std::uint64_t fields[5] = {numberOfElements,
+                                         isStateDerivativeStored ? stateDerivativeFlag : 0,
+                                         recordCount,
+                                         recordsPerIndexEntry,
+                                         indexOffset};
+        std::memcpy(header + 8, &version, sizeof(version));
+        std::memcpy(header + 12, &bytesPerValue, sizeof(bytesPerValue));
+        std::memcpy(header + 16, fields, sizeof(fields));
+        writeBytes(header, headerSize);
+    }
+
+    //! Write bytes to file.
+    void writeBytes(const void* const data, const std::size_t size)
+    {
+        file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+        if (!file)
+        {
+            throw std::runtime_error("Trajectory file could not be written!");
+        }
+    }
+
+    //! Number of state elements per record.
+    std::size_t numberOfElements;
+
+    //! Flag that indicates if state derivatives are stored.
+    bool isStateDerivativeStored;
+
+    //! Number of records per entry of time index.
+    std::size_t recordsPerIndexEntry;
+
+    //! Number of records written.
+    std::size_t numberOfRecords;
+
+    //! Flag that indicates if file is closed.
+    bool isClosed;
+
+    //! Values of last record.
+    std::vector<Real> record;
+
+    //! Times of every recordsPerIndexEntry-th record.
+    std::vector<Real> timeIndex;
+
+    //! Trajectory file.
+    std::ofstream file;
+};
+
+namespace detail
+{
+
+//! Read-only memory mapping of file.
+class MappedFile
+{
+public:
+
+    //! Map file with given name.
+    explicit MappedFile(const std::string& fileName)
+        : data(0),
+          size(0)
+    {
+#if defined(_WIN32)
+        const HANDLE file = ::CreateFileA(fileName.c_str(), GENERIC_READ, FILE_SHARE_READ, 0,
+                                          OPEN_EXISTING, FILE_FLAG_RANDOM_ACCESS, 0);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            throw std::runtime_error("Trajectory file could not be opened!");
+        }
+        LARGE_INTEGER fileSize;
+        const HANDLE mapping = ::GetFileSizeEx(file, &fileSize) && fileSize.QuadPart > 0
+            ? ::CreateFileMappingA(file, 0, PAGE_READONLY, 0, 0, 0) : 0;
+        ::CloseHandle(file);
+        if (mapping == 0)
+        {
+            throw std::runtime_error("Trajectory file could not be mapped!");
+        }
+        const void* const address = ::MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        ::CloseHandle(mapping);
+        if (address == 0)
+        {
+            throw std::runtime_error("Trajectory file could not be mapped!");
+        }
+        data = static_cast<const char*>(address);
+        size = static_cast<std::size_t>(fileSize.QuadPart);
+#else
+        const int descriptor = ::open(fileName.c_str(), O_RDONLY);
+        if (descriptor < 0)
+        {
+            throw std::runtime_error("Trajectory file could not be opened!");
+        }
+        struct stat status;
+        void* address = MAP_FAILED;
+        if (::fstat(descriptor, &status) == 0 && status.st_size > 0)
+        {
+            address = ::mmap(0, static_cast<std::size_t>(status.st_size), PROT_READ, MAP_SHARED,
+                             descriptor, 0);
+        }
+        ::close(descriptor);
+        if (address == MAP_FAILED)
+        {
+            throw std::runtime_error("Trajectory file could not be mapped!");
+        }
+
+        // Lookups touch a few pages, so reading ahead only wastes page cache.
+        ::madvise(address, static_cast<std::size_t>(status.st_size), MADV_RANDOM);
+        data = static_cast<const char*>(address);
+        size = static_cast<std::size_t>(status.st_size);
+#endif
+    }
+
+    //! Unmap file.
+    ~MappedFile()
+    {
+#if defined(_WIN32)
+        ::UnmapViewOfFile(data);
+#else
+        ::munmap(const_cast<char*>(data), size);
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    //! Get pointer to first byte of file.
+    const char* getData() const { return data; }
+
+    //! Get size of file in bytes.
+    std::size_t getSize() const { return size; }
+
+protected:
+private:
+
+    //! Pointer to first byte of file.
+    const char* data;
+
+    //! Size of file in bytes.
+    std::size_t size;
+};
+
+} // namespace detail
+
+//! Trajectory that is read from memory-mapped file with fixed-width records and a time index.
+/*!
+ * Read-only view of a trajectory file that was written by IndexedTrajectoryWriter. The file is
+ * memory-mapped, so that opening it does not read the records, and records are accessed in place,
+ * without copies. The state at a given time is found by a binary search in the time index,
+ * followed by a binary search within the k records of one index entry, and interpolation
+ * between the two enclosing records: cubic Hermite interpolation if state derivatives are
+ * stored, and linear interpolation otherwise. A lookup thus touches the pages of the time index
+ * on its search path and the pages of a single block of records, so that its latency grows with
+ * the logarithm of the number of records, and only the accessed pages are loaded from disk.
+ *
+ * The reader is safe to use from multiple threads, since it does not modify any data.
+ *
+ * @tparam  Real  Type for floating-point number
+ */
+template <typename Real>
+class IndexedTrajectory
+{
+public:
+
+    //! Open trajectory file.
+    /*!
+     * Maps trajectory file and checks its header and size.
+     *
+     * @throws std::runtime_error  If file cannot be mapped, or is not a complete trajectory file
+     *                             of the current format version with values of type Real
+     *
+     * @param[in]  fileName  Name of trajectory file
+     */
+    explicit IndexedTrajectory(const std::string& fileName)
+        : file(fileName)
+    {
+        typedef IndexedTrajectoryWriter<Real> Writer;
+        const char* const data = file.getData();
+        std::uint32_t version = 0;
+        std::uint32_t bytesPerValue = 0;
+        std::uint64_t fields[5] = {0, 0, 0, 0, 0};
+        if (file.getSize() >= Writer::headerSize)
+        {
+            std::memcpy(&version, data + 8, sizeof(version));
+            std::memcpy(&bytesPerValue, data + 12, sizeof(bytesPerValue));
+            std::memcpy(fields, data + 16, sizeof(fields));
+        }
+        numberOfElements = static_cast<std::size_t>(fields[0]);
+        isStateDerivativeStored = (fields[1] & Writer::stateDerivativeFlag) != 0;
+        numberOfRecords = static_cast<std::size_t>(fields[2]);
+        recordsPerIndexEntry = static_cast<std::size_t>(fields[3]);
+        recordSize = 1 + numberOfElements * (isStateDerivativeStored ? 2 : 1);
+
+        const bool isHeaderValid = file.getSize() >= Writer::headerSize
+                                   && std::strncmp(data, "ITRJIDX", 8) == 0
+                                   && version == Writer::formatVersion
+                                   && bytesPerValue == sizeof(Real)
+                                   && numberOfElements > 0
+                                   && numberOfRecords > 0
+                                   && recordsPerIndexEntry > 0;
+        numberOfIndexEntries = isHeaderValid
+            ? (numberOfRecords + recordsPerIndexEntry - 1) / recordsPerIndexEntry : 0;
+        const std::uint64_t indexOffset
+            = Writer::headerSize + numberOfRecords * recordSize * sizeof(Real);
+        if (!isHeaderValid
+            || fields[4] != indexOffset
+            || file.getSize() != indexOffset + numberOfIndexEntries * sizeof(Real))
+        {
+            throw std::runtime_error("Trajectory file could not be read!");
+        }
+        records = reinterpret_cast<const Real*>(data + Writer::headerSize);
+        timeIndex = reinterpret_cast<const Real*>(data + indexOffset);
+    }
+
+    //! Get number of records.
+    std::size_t getNumberOfRecords() const { return numberOfRecords; }
+
+    //! Get number of state elements per record.
+    std::size_t getNumberOfElements() const { return numberOfElements; }
+
+    //! Get flag that indicates if state derivatives are stored.
+    bool hasStateDerivatives() const { return isStateDerivativeStored; }
+
+    //! Get time of first record.
+    Real getStartTime() const { return records[0]; }
+
+    //! Get time of last record.
+    Real getEndTime() const { return records[(numberOfRecords - 1) * recordSize]; }
+
+    //! Get time of given record.
+    Real getTime(const std::size_t recordIndex) const { return records[recordIndex * recordSize]; }
+
+    //! Get state elements of given record, in place in the mapped file.
+    const Real* getState(const std::size_t recordIndex) const
+    {
+        return &records[recordIndex * recordSize + 1];
+    }
+
+    //! Get state derivative elements of given record, in place in the mapped file, or null pointer
+    //! if state derivatives are not stored.
+    const Real* getStateDerivative(const std::size_t recordIndex) const
+    {
+        return isStateDerivativeStored
+            ? &records[recordIndex * recordSize + 1 + numberOfElements] : 0;
+    }
+
+    //! Find record at start of interval that contains given time.
+    /*!
+     * Finds record i, such that the given time lies between the times of records i and i + 1, or
+     * is equal to the time of record i if the trajectory consists of a single record.
+     *
+     * @throws std::out_of_range  If time lies outside of trajectory
+     *
+     * @param[in]  time  Time to find
+     * @return           Index of record at start of interval that contains time
+     */
+    std::size_t findRecord(const Real time) const
+    {
+        if (!(time >= getStartTime() && time <= getEndTime()))
+        {
+            throw std::out_of_range("Time lies outside of trajectory!");
+        }
+
+        // The first index entry is the start time, so the entry is found within the index.
+        const std::size_t entry = static_cast<std::size_t>(
+            std::upper_bound(timeIndex, timeIndex + numberOfIndexEntries, time) - timeIndex - 1);
+        std::size_t lower = entry * recordsPerIndexEntry;
+        std::size_t upper = std::min(lower + recordsPerIndexEntry, numberOfRecords);
+        while (upper - lower > 1)
+        {
+            const std::size_t middle = lower + (upper - lower) / 2;
+            if (getTime(middle) <= time)
+            {
+                lower = middle;
+            }
+            else
+            {
+                upper = middle;
+            }
+        }
+        return numberOfRecords > 1 ? std::min(lower, numberOfRecords - 2) : 0;
+    }
+
+    //! Compute state at given time.
+    /*!
+     * Computes state at given time by interpolation between the enclosing records, with cubic
+     * Hermite interpolation if state derivatives are stored, and linear interpolation otherwise.
+     *
+     * @throws std::out_of_range  If time lies outside of trajectory
+     *
+     * @param[in]   time    Time at which state is computed
+     * @param[out]  result  State elements at given time (numberOfElements values)
+     */
+    void interpolate(const Real time, Real* const result) const
+    {
+        const std::size_t recordIndex = findRecord(time);
+        const Real* const startState = getState(recordIndex);
+        if (numberOfRecords == 1)
+        {
+            std::copy(startState, startState + numberOfElements, result);
+            return;
+        }
+
+        const Real* const endState = getState(recordIndex + 1);
+        const Real startTime = getTime(recordIndex);
+        const Real stepSize = getTime(recordIndex + 1) - startTime;
+        const Real theta = (time - startTime) / stepSize;
+        if (!isStateDerivativeStored)
+        {
+            for (std::size_t i = 0; i < numberOfElements; ++i)
+            {
+                result[i] = (1.0 - theta) * startState[i] + theta * endState[i];
+            }
+            return;
+        }
+
+        // Same weights as computeHermiteInterpolation().
+        const Real* const startDerivative = getStateDerivative(recordIndex);
+        const Real* const endDerivative = getStateDerivative(recordIndex + 1);
+        const Real thetaSquared = theta * theta;
+        const Real thetaCubed = thetaSquared * theta;
+        const Real startWeight = 2.0 * thetaCubed - 3.0 * thetaSquared + 1.0;
+        const Real endWeight = -2.0 * thetaCubed + 3.0 * thetaSquared;
+        const Real startDerivativeWeight = stepSize * (thetaCubed - 2.0 * thetaSquared + theta);
+        const Real endDerivativeWeight = stepSize * (thetaCubed - thetaSquared);
+        for (std::size_t i = 0; i < numberOfElements; ++i)
+        {
+            result[i] = startWeight * startState[i] + endWeight * endState[i]
+                        + startDerivativeWeight * startDerivative[i]
+                        + endDerivativeWeight * endDerivative[i];
+        }
+    }
+
+protected:
+private:
+
+    //! Memory mapping of trajectory file.
+    detail::MappedFile file;
+
+    //! Number of state elements per record.
+    std::size_t numberOfElements;
+
+    //! Flag that indicates if state derivatives are stored.
+    bool isStateDerivativeStored;
+
+    //! Number of records.
+    std::size_t numberOfRecords;
+
+    //! Number of records per entry of time index.
+    std::size_t recordsPerIndexEntry;
+
+    //! Number of entries of time index.
+    std::size_t numberOfIndexEntries;
+
+    //! Number of values per record.
+    std::size_t recordSize;
+
+    //! First record in mapped file.
+    const Real* records;
+
+    //! First entry of time index in mapped file.
+    const Real* timeIndex;
+};
+
+namespace detail
+{
+
+//! Integrate to final time using given function to execute adaptive integration steps, and
+//! record each accepted step.
+template <typename Real,
+          typename State,
+          typename Stepper,
+          typename StateDerivative,
+          typename AdaptiveStep>
+int integrateRecorded(const Stepper& stepper,
+                      Real& time,
+                      const State& state,
+                      Real& stepSize,
+                      const Real finalTime,
+                      const StateDerivative& computeStateDerivative,
+                      const Real minimumStepSize,
+                      IndexedTrajectoryWriter<Real>& writer,
+                      const AdaptiveStep& executeStep)
+{
+    static_assert(StateTraits<State>::isIndexable, "Recording requires indexable state");
+
+    const std::size_t numberOfElements = writer.getNumberOfElements();
+    if (static_cast<std::size_t>(state.size()) != numberOfElements)
+    {
+        throw std::invalid_argument("State size differs from number of state elements!");
+    }
+
+    // The state derivative at the initial state is evaluated; the state derivatives at the end of
+    // accepted steps are kept by the stepper for dense output.
+    std::vector<Real> stateElements(numberOfElements);
+    std::vector<Real> stateDerivativeElements(numberOfElements);
+    bool isStepAccepted = false;
+
+    // The initial state is not recorded if the writer already holds a record at the initial time,
+    // i.e., if this integration continues a previous integration that was recorded to the writer.
+    bool isRecordSkipped = writer.getNumberOfRecords() > 0 && writer.getLastTime() == time;
+    const auto record = [&]()
+    {
+        if (isRecordSkipped)
+        {
+            isRecordSkipped = false;
+            return;
+        }
+        for (std::size_t i = 0; i < numberOfElements; ++i)
+        {
+            stateElements[i] = state[i];
+        }
+        if (writer.hasStateDerivatives())
+        {
+            if (isStepAccepted)
+            {
+                const State& stateDerivative = stepper.getEndStateDerivative();
+                for (std::size_t i = 0; i < numberOfElements; ++i)
+                {
+                    stateDerivativeElements[i] = stateDerivative[i];
+                }
+            }
+            else
+            {
+                State stateDerivative = state;
+                integrate::evaluateStateDerivative(
+                    computeStateDerivative, time, state, stateDerivative);
+                for (std::size_t i = 0; i < numberOfElements; ++i)
+                {
+                    stateDerivativeElements[i] = stateDerivative[i];
+                }
+            }
+        }
+        writer.write(time, stateElements.data(), stateDerivativeElements.data());
+    };
+
+    // The state is recorded before each step, i.e., after the time of the previous step has been
+    // corrected for round-off, and at the end of the integration.
+    const int numberOfSteps = integrateAdaptive(
+        time, stepSize, finalTime, minimumStepSize,
+        [&](Real& currentStepSize, const Real currentMinimumStepSize)
+    {
+        record();
+        executeStep(currentStepSize, currentMinimumStepSize);
+        isStepAccepted = true;
+    });
+    record();
+    return numberOfSteps;
+}
+
+} // namespace detail
+
+//! Integrate to final time using adaptive step size, and record each accepted step to file.
+/*!
+ * Integrates from current time to given final time by executing adaptive integration steps with
+ * given stepper, and appends the initial time and state, and the time and state after each
+ * accepted step, to the given trajectory writer. If the writer stores state derivatives, the state
+ * derivative at the end of each step is taken from the stepper, which keeps it for dense output,
+ * so that only the state derivative at the initial state is evaluated in addition to the steps.
+ * The writer is not closed, so that subsequent integrations can append to it: if the last record
+ * of the writer lies at the current time, e.g., because a previous integration to the current time
+ * was recorded, the initial state is not recorded again.
+ *
+ * @throws std::invalid_argument  If size of state differs from number of state elements of writer
+ * @throws std::runtime_error     If final time lies before current time, if the writer stores
+ *                                state derivatives and the stepper does not provide dense output,
+ *                                if the trajectory file cannot be written, or if the stepper
+ *                                throws because the minimum step size is exceeded
+ *
+ * @tparam         Real                    Type for floating-point number
+ * @tparam         State                   Type for state and state derivative (indexable)
+ * @tparam         Stepper                 Type of stepper that provides adaptive step function and
+ *                                         dense output, e.g., DOPRI5Stepper
+ * @tparam         StateDerivative         Type of callable to compute state derivative, e.g.,
+ *                                         function pointer, functor, lambda or
+ *                                         StateDerivativeFunction
+ * @param[in,out]  stepper                 Stepper used to execute integration steps
+ * @param[in,out]  time                    Independent variable, which is provided as input and is
+ *                                         equal to the final time at end of integration
+ * @param[in,out]  state                   State, which is provided as input and is updated with
+ *                                         output at end of integration
+ * @param[in,out]  stepSize                Step size to take for first integration step, which is
+ *                                         updated with step size for next integration step
+ * @param[in]      finalTime               Time to integrate to
+ * @param[in]      computeStateDerivative  Function to compute state derivative for current time
+ *                                         and state
+ * @param[in]      tolerance               Local truncation error tolerance
+ * @param[in]      minimumStepSize         Minimum allowable step size for integration steps
+ * @param[in]      maximumStepSize         Maximum allowable step size for integration steps
+ * @param[in,out]  writer                  Writer to which records are appended
+ * @return                                 Number of accepted integration steps
+ */
+template <typename Real, typename State, typename Stepper, typename StateDerivative>
+int integrateRecorded(Stepper& stepper,
+                      Real& time,
+                      State& state,
+                      Real& stepSize,
+                      const Real finalTime,
+                      const StateDerivative& computeStateDerivative,
+                      const Real tolerance,
+                      const Real minimumStepSize,
+                      const Real maximumStepSize,
+                      IndexedTrajectoryWriter<Real>& writer)
+{
+    return detail::integrateRecorded(
+        stepper, time, state, stepSize, finalTime, computeStateDerivative, minimumStepSize,
+        writer, [&](Real& currentStepSize, const Real currentMinimumStepSize)
+    {
+        stepper.step(time, state, currentStepSize, computeStateDerivative, tolerance,
+                     currentMinimumStepSize, maximumStepSize);
+    });
+}
+
+//! Integrate to final time using error norm and controller, and record each accepted step to
+//! file.
+/*!
+ * Integrates from current time to given final time by executing adaptive integration steps with
+ * given stepper, error norm, e.g., WeightedRootMeanSquareErrorNorm, and step size controller, and
+ * appends the initial time and state, and the time and state after each accepted step, to the
+ * given trajectory writer. See the overload that takes a scalar tolerance for details.
+ *
+ * @throws std::invalid_argument  If size of state differs from number of state elements of writer
+ * @throws std::runtime_error     If final time lies before current time, if the writer stores
+ *                                state derivatives and the stepper does not provide dense output,
+ *                                if the trajectory file cannot be written, or if the stepper
+ *                                throws because the minimum step size is exceeded
+ *
+ * @tparam         Real                    Type for floating-point number
+ * @tparam         State                   Type for state and state derivative (indexable)
+ * @tparam         Stepper                 Type of stepper that provides adaptive step function and
+ *                                         dense output, e.g., DOPRI5Stepper
+ * @tparam         StateDerivative         Type of callable to compute state derivative, e.g.,
+ *                                         function pointer, functor, lambda or
+ *                                         StateDerivativeFunction
+ * @tparam         ErrorNorm               Type of callable to compute scaled error, e.g.,
+ *                                         WeightedRootMeanSquareErrorNorm
+ * @tparam         Controller              Type of step size controller, e.g., StepSizeController
+ * @param[in,out]  stepper                 Stepper used to execute integration steps
+ * @param[in,out]  time                    Independent variable, which is provided as input and is
+ *                                         equal to the final time at end of integration
+ * @param[in,out]  state                   State, which is provided as input and is updated with
+ *                                         output at end of integration
+ * @param[in,out]  stepSize                Step size to take for first integration step, which is
+ *                                         updated with step size for next integration step
+ * @param[in]      finalTime               Time to integrate to
+ * @param[in]      computeStateDerivative  Function to compute state derivative for current time
+ *                                         and state
+ * @param[in]      computeError            Function to compute scaled error of error estimate
+ * @param[in,out]  controller              Step size controller, which is updated with scaled
+ *                                         errors of accepted steps
+ * @param[in]      minimumStepSize         Minimum allowable step size for integration steps
+ * @param[in]      maximumStepSize         Maximum allowable step size for integration steps
+ * @param[in,out]  writer                  Writer to which records are appended
+ * @return                                 Number of accepted integration steps
+ */
+template <typename Real,
+          typename State,
+          typename Stepper,
+          typename StateDerivative,
+          typename ErrorNorm,
+          typename Controller>
+int integrateRecorded(Stepper& stepper,
+                      Real& time,
+                      State& state,
+                      Real& stepSize,
+                      const Real finalTime,
+                      const StateDerivative& computeStateDerivative,
+                      const ErrorNorm& computeError,
+                      Controller& controller,
+                      const Real minimumStepSize,
+                      const Real maximumStepSize,
+                      IndexedTrajectoryWriter<Real>& writer)
+{
+    return detail::integrateRecorded(
+        stepper, time, state, stepSize, finalTime, computeStateDerivative, minimumStepSize,
+        writer, [&](Real& currentStepSize, const Real currentMinimumStepSize)
+    {
+        stepper.step(time, state, currentStepSize, computeStateDerivative, computeError,
+                     controller, currentMinimumStepSize, maximumStepSize);
+    });
+}
+
+} // namespace integrate
@@ -0,0 +1,469 @@
+/*
+ * Copyright (c) 2014-2025 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace integrate
+{
+
+namespace detail
+{
+
+//! Integrate to final time, or until given function to execute adaptive integration steps
+//! returns true, e.g., at a terminal event.
+template <typename Real, typename AdaptiveStep>
+int integrateAdaptiveUntil(Real& time,
+                           Real& stepSize,
+                           const Real finalTime,
+                           const Real minimumStepSize,
+                           const AdaptiveStep& executeStep)
+{
+    if (finalTime < time)
+    {
+        throw std::runtime_error("Final time lies before current time!");
+    }
+
+    int numberOfSteps = 0;
+    while (time < finalTime)
+    {
+        const Real remainingTime = finalTime - time;
+        const bool isLastStep = !(stepSize < remainingTime);
+
+        Real currentStepSize = isLastStep ? remainingTime : stepSize;
+        if (!(time + currentStepSize > time))
+        {
+            throw std::runtime_error("Step size does not advance time!");
+        }
+
+        const bool isStopped
+            = executeStep(currentStepSize, std::min(minimumStepSize, remainingTime));
+        ++numberOfSteps;
+
+        // Remove round-off error in time, so that integration ends exactly at the final time.
+        const Real timeTolerance = 4.0 * std::numeric_limits<Real>::epsilon()
+                                   * std::max(std::fabs(time), std::fabs(finalTime));
+        if (std::fabs(finalTime - time) <= timeTolerance)
+        {
+            time = finalTime;
+        }
+
+        if (!(isLastStep && time == finalTime && currentStepSize < stepSize))
+        {
+            stepSize = currentStepSize;
+        }
+
+        if (isStopped)
+        {
+            break;
+        }
+    }
+
+    return numberOfSteps;
+}
+
+//! Integrate to final time using given function to execute adaptive integration steps.
+template <typename Real, typename AdaptiveStep>
+int integrateAdaptive(Real& time,
+                      Real& stepSize,
+                      const Real finalTime,
+                      const Real minimumStepSize,
+                      const AdaptiveStep& executeStep)
+{
+    return integrateAdaptiveUntil(
+        time, stepSize, finalTime, minimumStepSize,
+        [&](Real& currentStepSize, const Real currentMinimumStepSize)
+    {
+        executeStep(currentStepSize, currentMinimumStepSize);
+        return false;
+    });
+}
+
+} // namespace detail
+
+//! Integrate to final time using adaptive step size.
+/*!
+ * Integrates from current time to given final time by executing adaptive integration steps with
+ * given stepper, e.g., RKF45Stepper, RKF78Stepper or DOPRI5Stepper. The steps are executed in a
+ * loop, so the stack depth does not depend on the number of steps. The last step is shortened so
+ * that the integration ends exactly at the final time.
+ *
+ * The step size is updated with the step size proposed by the stepper for the next step. If the
+ * last step was shortened to reach the final time, the step size is not reduced, so that
+ * repeated calls, e.g., to generate output at fixed intervals, do not shrink the step size.
+ *
+ * @throws std::runtime_error  If final time lies before current time, if the step size does not
+ *                             advance the time, e.g., because it is not positive, or if the
+ *                             stepper throws because the minimum step size is exceeded
+ *
+ * @tparam         Real                    Type for floating-point number
+ * @tparam         State                   Type for state and state derivative
+ * @tparam         Stepper                 Type of stepper that provides adaptive step function
+ * @tparam         StateDerivative         Type of callable to compute state derivative, e.g.,
+ *                                         function pointer, functor, lambda or
+ *                                         StateDerivativeFunction
+ * @param[in,out]  stepper                 Stepper used to execute integration steps
+ * @param[in,out]  time                    Independent variable, which is provided as input and is
+ *                                         equal to the final time at end of integration
+ * @param[in,out]  state                   State, which is provided as input and is updated with
+ *                                         output at end of integration
+ * @param[in,out]  stepSize                Step size to take for first integration step, which is
+ *                                         updated with step size for next integration step
+ * @param[in]      finalTime               Time to integrate to
+ * @param[in]      computeStateDerivative  Function to compute state derivative for current time
+ *                                         and state
+ * @param[in]      tolerance               Local truncation error tolerance
+ * @param[in]      minimumStepSize         Minimum allowable step size for integration steps
+ * @param[in]      maximumStepSize         Maximum allowable step size for integration steps
+ * @return                                 Number of accepted integration steps
+ */
+template <typename Real, typename State, typename Stepper, typename StateDerivative>
+int integrateAdaptive(Stepper& stepper,
+                      Real& time,
+                      State& state,
+                      Real& stepSize,
+                      const Real finalTime,
+                      const StateDerivative& computeStateDerivative,
+                      const Real tolerance,
+                      const Real minimumStepSize,
+                      const Real maximumStepSize)
+{
+    return detail::integrateAdaptive(
+        time, stepSize, finalTime, minimumStepSize,
+        [&](Real& currentStepSize, const Real currentMinimumStepSize)
+    {
+        stepper.step(time, state, currentStepSize, computeStateDerivative, tolerance,
+                     currentMinimumStepSize, maximumStepSize);
+    });
+}
+
+//! Integrate to final time using adaptive step size, error norm and step size controller.
+/*!
+ * Integrates from current time to given final time by executing adaptive integration steps with
+ * given stepper, e.g., RKF45Stepper, RKF78Stepper or DOPRI5Stepper, error norm, e.g.,
+ * WeightedRootMeanSquareErrorNorm, and step size controller. See the overload that takes a scalar
+ * tolerance for details on how the last step is shortened to end exactly at the final time.
+ *
+ * @throws std::runtime_error  If final time lies before current time, if the step size does not
+ *                             advance the time, e.g., because it is not positive, or if the
+ *                             stepper throws because the minimum step size is exceeded
+ *
+ * @tparam         Real                    Type for floating-point number
+ * @tparam         State                   Type for state and state derivative
+ * @tparam         Stepper                 Type of stepper that provides adaptive step function
+ * @tparam         StateDerivative         Type of callable to compute state derivative, e.g.,
+ *                                         function pointer, functor, lambda or
+ *                                         StateDerivativeFunction
+ * @tparam         ErrorNorm               Type of callable to compute scaled error, e.g.,
+ *                                         WeightedRootMeanSquareErrorNorm
+ * @tparam         Controller              Type of step size controller, e.g., StepSizeController
+ * @param[in,out]  stepper                 Stepper used to execute integration steps
+ * @param[in,out]  time                    Independent variable, which is provided as input and is
+ *                                         equal to the final time at end of integration
+ * @param[in,out]  state                   State, which is provided as input and is updated with
+ *                                         output at end of integration
+ * @param[in,out]  stepSize                Step size to take for first integration step, which is
+ *                                         updated with step size for next integration step
+ * @param[in]      finalTime               Time to integrate to
+ * @param[in]      computeStateDerivative  Function to compute state derivative for current time
+ *                                         and state
+ * @param[in]      computeError            Function to compute scaled error of error estimate
+ * @param[in,out]  controller              Step size controller, which is updated with scaled
+ *                                         errors of accepted steps
+ * @param[in]      minimumStepSize         Minimum allowable step size for integration steps
+ * @param[in]      maximumStepSize         Maximum allowable step size for integration steps
+ * @return                                 Number of accepted integration steps
+ */
+template <typename Real,
+          typename State,
+          typename Stepper,
+          typename StateDerivative,
+          typename ErrorNorm,
+          typename Controller>
+int integrateAdaptive(Stepper& stepper,
+                      Real& time,
+                      State& state,
+                      Real& stepSize,
+                      const Real finalTime,
+                      const StateDerivative& computeStateDerivative,
+                      const ErrorNorm& computeError,
+                      Controller& controller,
+                      const Real minimumStepSize,
+                      const Real maximumStepSize)
+{
+    return detail::integrateAdaptive(
+        time, stepSize, finalTime, minimumStepSize,
+        [&](Real& currentStepSize, const Real currentMinimumStepSize)
+    {
+        stepper.step(time, state, currentStepSize, computeStateDerivative, computeError,
+                     controller, currentMinimumStepSize, maximumStepSize);
+    });
+}
+
+//! Integrate to final time using adaptive step size and observe each accepted step.
+/*!
+ * Integrates from current time to given final time by executing adaptive integration steps with
+ * given stepper, like integrateAdaptive(), and passes the initial time and state, and the time and
+ * state after each accepted step, to the given observer, e.g., StreamingTrajectorySink, so that
+ * the trajectory does not have to be collected by the caller. Use integrateDenseOutput() to
+ * observe the state at given output times instead.
+ *
+ * @throws std::runtime_error  If final time lies before current time, if the step size does not
+ *                             advance the time, e.g., because it is not positive, or if the
+ *                             stepper throws because the minimum step size is exceeded
+ *
+ * @tparam         Real                    Type for floating-point number
+ * @tparam         State                   Type for state and state derivative
+ * @tparam         Stepper                 Type of stepper that provides adaptive step function
+ * @tparam         StateDerivative         Type of callable to compute state derivative, e.g.,
+ *                                         function pointer, functor, lambda or
+ *                                         StateDerivativeFunction
+ * @tparam         Observer                Type of callable that receives output, i.e.,
+ *                                         void observe(const Real time, const State& state)
+ * @param[in,out]  stepper                 Stepper used to execute integration steps
+ * @param[in,out]  time                    Independent variable, which is provided as input and is
+ *                                         equal to the final time at end of integration
+ * @param[in,out]  state                   State, which is provided as input and is updated with
+ *                                         output at end of integration
+ * @param[in,out]  stepSize                Step size to take for first integration step, which is
+ *                                         updated with step size for next integration step
+ * @param[in]      finalTime               Time to integrate to
+ * @param[in]      computeStateDerivative  Function to compute state derivative for current time
+ *                                         and state
+ * @param[in]      tolerance               Local truncation error tolerance
+ * @param[in]      minimumStepSize         Minimum allowable step size for integration steps
+ * @param[in]      maximumStepSize         Maximum allowable step size for integration steps
+ * @param[in]      observe                 Function that receives time and state of each step
+ * @return                                 Number of accepted integration steps
+ */
+template <typename Real,
+          typename State,
+          typename Stepper,
+          typename StateDerivative,
+          typename Observer>
+int integrateObserved(Stepper& stepper,
+                      Real& time,
+                      State& state,
+                      Real& stepSize,
+                      const Real finalTime,
+                      const StateDerivative& computeStateDerivative,
+                      const Real tolerance,
+                      const Real minimumStepSize,
+                      const Real maximumStepSize,
+                      const Observer& observe)
+{
+    // The state is observed before each step, i.e., after the time of the previous step has
+    // been corrected for round-off, and at the end of the integration.
+    const int numberOfSteps = detail::integrateAdaptive(
+        time, stepSize, finalTime, minimumStepSize,
+        [&](Real& currentStepSize, const Real currentMinimumStepSize)
+    {
+        observe(time, state);
+        stepper.step(time, state, currentStepSize, computeStateDerivative, tolerance,
+                     currentMinimumStepSize, maximumStepSize);
+    });
+    observe(time, state);
+    return numberOfSteps;
+}
+
+//! Integrate to final time using error norm and controller, and observe each accepted step.
+/*!
+ * Integrates from current time to given final time by executing adaptive integration steps with
+ * given stepper, error norm, e.g., WeightedRootMeanSquareErrorNorm, and step size controller, and
+ * passes the initial time and state, and the time and state after each accepted step, to the
+ * given observer. See the overload that takes a scalar tolerance for details.
+ *
+ * @throws std::runtime_error  If final time lies before current time, if the step size does not
+ *                             advance the time, e.g., because it is not positive, or if the
+ *                             stepper throws because the minimum step size is exceeded
+ *
+ * @tparam         Real                    Type for floating-point number
+ * @tparam         State                   Type for state and state derivative
+ * @tparam         Stepper                 Type of stepper that provides adaptive step function
+ * @tparam         StateDerivative         Type of callable to compute state derivative, e.g.,
+ *                                         function pointer, functor, lambda or
+ *                                         StateDerivativeFunction
+ * @tparam         ErrorNorm               Type of callable to compute scaled error, e.g.,
+ *                                         WeightedRootMeanSquareErrorNorm
+ * @tparam         Controller              Type of step size controller, e.g., StepSizeController
+ * @tparam         Observer                Type of callable that receives output, i.e.,
+ *                                         void observe(const Real time, const State& state)
+ * @param[in,out]  stepper                 Stepper used to execute integration steps
+ * @param[in,out]  time                    Independent variable, which is provided as input and is
+ *                                         equal to the final time at end of integration
+ * @param[in,out]  state                   State, which is provided as input and is updated with
+ *                                         output at end of integration
+ * @param[in,out]  stepSize                Step size to take for first integration step, which is
+ *                                         updated with step size for next integration step
+ * @param[in]      finalTime               Time to integrate to
+ * @param[in]      computeStateDerivative  Function to compute state derivative for current time
+ *                                         and state
+ * @param[in]      computeError            Function to compute scaled error of error estimate
+ * @param[in,out]  controller              Step size controller, which is updated with scaled
+ *                                         errors of accepted steps
+ * @param[in]      minimumStepSize         Minimum allowable step size for integration steps
+ * @param[in]      maximumStepSize         Maximum allowable step size for integration steps
+ * @param[in]      observe                 Function that receives time and state of each step
+ * @return                                 Number of accepted integration steps
+ */
+template <typename Real,
+          typename State,
+          typename Stepper,
+          typename StateDerivative,
+          typename ErrorNorm,
+          typename Controller,
+          typename Observer>
+int integrateObserved(Stepper& stepper,
+                      Real& time,
+                      State& state,
+                      Real& stepSize,
+                      const Real finalTime,
+                      const StateDerivative& computeStateDerivative,
+                      const ErrorNorm& computeError,
+                      Controller& controller,
+                      const Real minimumStepSize,
+                      const Real maximumStepSize,
+                      const Observer& observe)
+{
+    // The state is observed before each step, i.e., after the time of the previous step has
+    // been corrected for round-off, and at the end of the integration.
+    const int numberOfSteps = detail::integrateAdaptive(
+        time, stepSize, finalTime, minimumStepSize,
+        [&](Real& currentStepSize, const Real currentMinimumStepSize)
+    {
+        observe(time, state);
+        stepper.step(time, state, currentStepSize, computeStateDerivative, computeError,
+                     controller, currentMinimumStepSize, maximumStepSize);
+    });
+    observe(time, state);
+    return numberOfSteps;
+}
+
+//! Integrate second-order system to final time using adaptive step size.
+/*!
+ * Integrates position and velocity from current time to given final time by executing adaptive
+ * integration steps with given stepper for second-order systems, e.g., RKN43Stepper or
+ * RKN64Stepper. See the overload for first-order systems that takes a scalar tolerance for
+ * details on how the last step is shortened to end exactly at the final time.
+ *
+ * @throws std::runtime_error  If final time lies before current time, if the step size does not
+ *                             advance the time, e.g., because it is not positive, or if the
+ *                             stepper throws because the minimum step size is exceeded
+ *
+ * @tparam         Real                 Type for floating-point number
+ * @tparam         State                Type for position, velocity and acceleration
+ * @tparam         Stepper              Type of stepper that provides adaptive step function
+ * @tparam         Acceleration         Type of callable to compute acceleration, e.g., function
+ *                                      pointer, functor, lambda or StateDerivativeFunction
+ * @param[in,out]  stepper              Stepper used to execute integration steps
+ * @param[in,out]  time                 Independent variable, which is provided as input and is
+ *                                      equal to the final time at end of integration
+ * @param[in,out]  position             Position, which is provided as input and is updated with
+ *                                      output at end of integration
+ * @param[in,out]  velocity             Velocity, which is provided as input and is updated with
+ *                                      output at end of integration
+ * @param[in,out]  stepSize             Step size to take for first integration step, which is
+ *                                      updated with step size for next integration step
+ * @param[in]      finalTime            Time to integrate to
+ * @param[in]      computeAcceleration  Function to compute acceleration for current time and
+ *                                      position
+ * @param[in]      tolerance            Local truncation error tolerance
+ * @param[in]      minimumStepSize      Minimum allowable step size for integration steps
+ * @param[in]      maximumStepSize      Maximum allowable step size for integration steps
+ * @return                              Number of accepted integration steps
+ */
+template <typename Real, typename State, typename Stepper, typename Acceleration>
+int integrateAdaptive(Stepper& stepper,
+                      Real& time,
+                      State& position,
+                      State& velocity,
+                      Real& stepSize,
+                      const Real finalTime,
+                      const Acceleration& computeAcceleration,
+                      const Real tolerance,
+                      const Real minimumStepSize,
+                      const Real maximumStepSize)
+{
+    return detail::integrateAdaptive(
+        time, stepSize, finalTime, minimumStepSize,
+        [&](Real& currentStepSize, const Real currentMinimumStepSize)
+    {
+        stepper.step(time, position, velocity, currentStepSize, computeAcceleration, tolerance,
+                     currentMinimumStepSize, maximumStepSize);
+    });
+}
+
+//! Integrate second-order system to final time using adaptive step size, norm and controller.
+/*!
+ * Integrates position and velocity from current time to given final time by executing adaptive
+ * integration steps with given stepper for second-order systems, e.g., RKN43Stepper or
+ * RKN64Stepper, error norm, e.g., WeightedRootMeanSquareErrorNorm, and step size controller. See
+ * the overload for first-order systems that takes a scalar tolerance for details on how the last
+ * step is shortened to end exactly at the final time.
+ *
+ * @throws std::runtime_error  If final time lies before current time, if the step size does not
+ *                             advance the time, e.g., because it is not positive, or if the
+ *                             stepper throws because the minimum step size is exceeded
+ *
+ * @tparam         Real                 Type for floating-point number
+ * @tparam         State                Type for position, velocity and acceleration
+ * @tparam         Stepper              Type of stepper that provides adaptive step function
+ * @tparam         Acceleration         Type of callable to compute acceleration, e.g., function
+ *                                      pointer, functor, lambda or StateDerivativeFunction
+ * @tparam         ErrorNorm            Type of callable to compute scaled error, e.g.,
+ *                                      WeightedRootMeanSquareErrorNorm
+ * @tparam         Controller           Type of step size controller, e.g., StepSizeController
+ * @param[in,out]  stepper              Stepper used to execute integration steps
+ * @param[in,out]  time                 Independent variable, which is provided as input and is
+ *                                      equal to the final time at end of integration
+ * @param[in,out]  position             Position, which is provided as input and is updated with
+ *                                      output at end of integration
+ * @param[in,out]  velocity             Velocity, which is provided as input and is updated with
+ *                                      output at end of integration
+ * @param[in,out]  stepSize             Step size to take for first integration step, which is
+ *                                      updated with step size for next integration step
+ * @param[in]      finalTime            Time to integrate to
+ * @param[in]      computeAcceleration  Function to compute acceleration for current time and
+ *                                      position
+ * @param[in]      computeError         Function to compute scaled error of error estimate
+ * @param[in,out]  controller           Step size controller, which is updated with scaled errors
+ *                                      of accepted steps
+ * @param[in]      minimumStepSize      Minimum allowable step size for integration steps
+ * @param[in]      maximumStepSize      Maximum allowable step size for integration steps
+ * @return                              Number of accepted integration steps
+ */
+template <typename Real,
+          typename State,
+          typename Stepper,
+          typename Acceleration,
+          typename ErrorNorm,
+          typename Controller>
+int integrateAdaptive(Stepper& stepper,
+                      Real& time,
+                      State& position,
+                      State& velocity,
+                      Real& stepSize,
+                      const Real finalTime,
+                      const Acceleration& computeAcceleration,
+                      const ErrorNorm& computeError,
+                      Controller& controller,
+                      const Real minimumStepSize,
+                      const Real maximumStepSize)
+{
+    return detail::integrateAdaptive(
+        time, stepSize, finalTime, minimumStepSize,
+        [&](Real& currentStepSize, const Real currentMinimumStepSize)
+    {
+        stepper.step(time, position, velocity, currentStepSize, computeAcceleration,
+                     computeError, controller, currentMinimumStepSize, maximumStepSize);
+    });
+}
+
+} // namespace integrate
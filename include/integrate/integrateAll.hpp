@@ -6,7 +6,39 @@
 
 #pragma once
 
+#include "integrate/adamsBashforthMoulton.hpp"
+#include "integrate/bdf.hpp"
+#include "integrate/bulirschStoer.hpp"
+#include "integrate/checkpoint.hpp"
+#include "integrate/denseOutput.hpp"
+#include "integrate/dopri5.hpp"
+#include "integrate/ensemble.hpp"
+#include "integrate/ensembleRunner.hpp"
 #include "integrate/euler.hpp"
+#include "integrate/events.hpp"
+#include "integrate/explicitRungeKutta.hpp"
+#include "integrate/forestRuth.hpp"
+#include "integrate/gmres.hpp"
+#include "integrate/indexedTrajectory.hpp"
+#include "integrate/integrateAdaptive.hpp"
+#include "integrate/linearCombination.hpp"
+#include "integrate/luDecomposition.hpp"
+#include "integrate/ringBuffer.hpp"
 #include "integrate/rk4.hpp"
 #include "integrate/rkf45.hpp"
 #include "integrate/rkf78.hpp"
+#include "integrate/rkn43.hpp"
+#include "integrate/rkn64.hpp"
+#include "integrate/ros34pw2.hpp"
+#include "integrate/rosenbrock.hpp"
+#include "integrate/rungeKuttaNystrom.hpp"
+#include "integrate/stateDerivative.hpp"
+#include "integrate/state.hpp"
+#include "integrate/stateNorm.hpp"
+#include "integrate/statistics.hpp"
+#include "integrate/stepSizeControl.hpp"
+#include "integrate/symplectic.hpp"
+#include "integrate/threadLocalStepper.hpp"
+#include "integrate/trajectoryWriter.hpp"
+#include "integrate/velocityVerlet.hpp"
+#include "integrate/yoshida.hpp"
@@ -0,0 +1,379 @@
+/*
+ * Copyright (c) 2014-2025 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace integrate
+{
+namespace detail
+{
+
+//! Map any list of well-formed types to void (used for detection of State members).
+template <typename... Types>
+struct MakeVoid
+{
+    typedef void type;
+};
+
+//! Flag that indicates if elements of state can be accessed and modified by index (false).
+template <typename State, typename Enable = void>
+struct IsIndexable : std::false_type
+{ };
+
+//! Flag that indicates if elements of state can be accessed and modified by index (true).
+template <typename State>
+struct IsIndexable<State,
+                   typename MakeVoid<
+                       decltype(std::declval<const State&>().size()),
+                       decltype(std::declval<State&>()[0] = std::declval<State&>()[0])>::type>
+    : std::true_type
+{ };
+
+//! Flag that indicates if elements of state are stored contiguously (false).
+template <typename State, typename Enable = void>
+struct IsContiguous : std::false_type
+{ };
+
+//! Flag that indicates if elements of state are stored contiguously (true).
+template <typename State>
+struct IsContiguous<State,
+                    typename MakeVoid<
+                        decltype(std::declval<const State&>().size()),
+                        decltype(*std::declval<State&>().data()
+                                 = *std::declval<const State&>().data()),
+                        typename std::enable_if<std::is_pointer<
+                            decltype(std::declval<State&>().data())>::value>::type>::type>
+    : std::true_type
+{ };
+
+} // namespace detail
+
+//! State traits.
+/*!
+ * Traits that describe the capabilities of a State type, used by the integrators to select the
+ * most efficient implementation of state arithmetic. By default, the capabilities are detected
+ * automatically. Specialize this class template to override the detected capabilities for a
+ * given State type.
+ *
+ * A State is indexable if it provides a size() member function and a non-const operator[] that
+ * returns a reference to a mutable element. For indexable states, linear combinations are
+ * computed element-wise in a single pass without creating temporary states. All other states
+ * only need to provide the operators used in the original integrators, i.e., operator+,
+ * operator* (with a Real) and copy-assignment.
+ *
+ * A State is contiguous if it provides a size() member function and a data() member function that
+ * returns a pointer to size() contiguous elements, e.g., std::vector, std::array or Eigen vectors.
+ * For contiguous states, reductions such as norms are computed by kernels that operate on the raw
+ * storage and are vectorized by the compiler. Contiguous states are also indexable, so linear
+ * combinations use the element-wise kernels, which the compiler vectorizes for such states.
+ *
+ * @tparam  State   Type for state and state derivative
+ * @tparam  Enable  Dummy parameter that can be used to specialize traits for a family of types
+ */
+template <typename State, typename Enable = void>
+struct StateTraits
+{
+    //! Flag that indicates that elements of state can be accessed and modified by index.
+    static const bool isIndexable = detail::IsIndexable<State>::value;
+
+    //! Flag that indicates that elements of state are stored contiguously and exposed by data().
+    static const bool isContiguous = detail::IsContiguous<State>::value;
+};
+
+namespace detail
+{
+
+//! Tag for states that only provide the State operators.
+struct OperatorStateTag
+{ };
+
+//! Tag for indexable states (see StateTraits).
+struct IndexableStateTag : OperatorStateTag
+{ };
+
+//! Tag for contiguous states (see StateTraits).
+struct ContiguousStateTag : IndexableStateTag
+{ };
+
+//! Tag that selects most efficient implementation of state arithmetic for State.
+template <typename State>
+struct StateTag
+{
+    typedef typename std::conditional<
+        StateTraits<State>::isContiguous,
+        ContiguousStateTag,
+        typename std::conditional<StateTraits<State>::isIndexable,
+                                  IndexableStateTag,
+                                  OperatorStateTag>::type>::type type;
+};
+
+//! Check if states are equal using element-wise comparison.
+template <typename State>
+inline bool isEqualState(const State& state, const State& otherState, std::true_type)
+{
+    const std::size_t size = static_cast<std::size_t>(state.size());
+    if (static_cast<std::size_t>(otherState.size()) != size)
+    {
+        return false;
+    }
+
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        if (state[i] != otherState[i])
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+//! Check if arithmetic states, i.e., scalars, are equal.
+template <typename State>
+inline bool isEqualScalarState(const State& state, const State& otherState, std::true_type)
+{
+    return state == otherState;
+}
+
+//! Check if states are equal (states that are not scalars are never considered equal).
+template <typename State>
+inline bool isEqualScalarState(const State&, const State&, std::false_type)
+{
+    return false;
+}
+
+//! Check if states are equal (only scalar states can be compared if state is not indexable).
+template <typename State>
+inline bool isEqualState(const State& state, const State& otherState, std::false_type)
+{
+    return isEqualScalarState(state, otherState, std::is_arithmetic<State>());
+}
+
+//! Check if states have the same number of elements.
+template <typename State>
+inline bool hasSameSize(const State& state, const State& otherState, IndexableStateTag)
+{
+    return state.size() == otherState.size();
+}
+
+//! Check if states have the same number of elements (assumed, since they are only assigned).
+template <typename State>
+inline bool hasSameSize(const State&, const State&, OperatorStateTag)
+{
+    return true;
+}
+
+//! Compute linear combination of states using element-wise access.
+template <typename Real, typename State>
+inline void computeLinearCombination(State& result,
+                                     const State* const base,
+                                     const Real scale,
+                                     const Real* const coefficients,
+                                     const State* const* const terms,
+                                     const std::size_t numberOfTerms,
+                                     IndexableStateTag)
+{
+    const State& reference = base != nullptr ? *base : *terms[0];
+    const std::size_t size = static_cast<std::size_t>(reference.size());
+    if (static_cast<std::size_t>(result.size()) != size)
+    {
+        result = reference;
+    }
+
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        Real sum = coefficients[0] * (*terms[0])[i];
+        for (std::size_t j = 1; j < numberOfTerms; ++j)
+        {
+            sum += coefficients[j] * (*terms[j])[i];
+        }
+        result[i] = base != nullptr ? (*base)[i] + scale * sum : scale * sum;
+    }
+}
+
+//! Compute linear combination of states using only the State operators.
+template <typename Real, typename State>
+inline void computeLinearCombination(State& result,
+                                     const State* const base,
+                                     const Real scale,
+                                     const Real* const coefficients,
+                                     const State* const* const terms,
+                                     const std::size_t numberOfTerms,
+                                     OperatorStateTag)
+{
+    State sum = (scale * coefficients[0]) * (*terms[0]);
+    for (std::size_t j = 1; j < numberOfTerms; ++j)
+    {
+        sum = sum + (scale * coefficients[j]) * (*terms[j]);
+    }
+    result = base != nullptr ? *base + sum : sum;
+}
+
+//! Pack variadic list of coefficient-term pairs into arrays (recursion end).
+template <typename Real, typename State>
+inline void packTerms(Real* const, const State** const)
+{ }
+
+//! Pack variadic list of coefficient-term pairs into arrays.
+template <typename Real, typename State, typename Coefficient, typename... Rest>
+inline void packTerms(Real* const coefficients,
+                      const State** const terms,
+                      const Coefficient coefficient,
+                      const State& term,
+                      const Rest&... rest)
+{
+    coefficients[0] = static_cast<Real>(coefficient);
+    terms[0] = &term;
+    packTerms<Real, State>(coefficients + 1, terms + 1, rest...);
+}
+
+} // namespace detail
+
+//! Compute linear combination of states.
+/*!
+ * Computes linear combination of states in a single pass, i.e.,
+ *
+ * \f[
+ *      result = base + scale * \sum_{j} coefficients_{j} * terms_{j}
+ * \f]
+ *
+ * For indexable states (see StateTraits), each element of the result is computed directly from
+ * the corresponding elements of the base and terms, so no temporary states are created, and no
+ * memory is allocated if the result already has the correct size. The result may be the same
+ * object as the base or any of the terms. For all other states, the linear combination is
+ * computed using operator+ and operator*.
+ *
+ * @tparam         Real           Type for floating-point number
+ * @tparam         State          Type for state and state derivative
+ * @tparam         NumberOfTerms  Number of terms in linear combination
+ * @param[in,out]  result         State that linear combination is written to
+ * @param[in]      base           State that linear combination is added to
+ * @param[in]      scale          Scale factor for sum of weighted terms, e.g., step size
+ * @param[in]      coefficients   Weights of terms
+ * @param[in]      terms          Pointers to states that are combined
+ */
+template <typename Real, typename State, std::size_t NumberOfTerms>
+inline void computeLinearCombination(State& result,
+                                     const State& base,
+                                     const Real scale,
+                                     const Real (&coefficients)[NumberOfTerms],
+                                     const State* const (&terms)[NumberOfTerms])
+{
+    detail::computeLinearCombination<Real, State>(
+        result, &base, scale, coefficients, terms, NumberOfTerms,
+        typename detail::StateTag<State>::type());
+}
+
+//! Compute weighted sum of states.
+/*!
+ * Computes weighted sum of states in a single pass, i.e.,
+ *
+ * \f[
+ *      result = scale * \sum_{j} coefficients_{j} * terms_{j}
+ * \f]
+ *
+ * See computeLinearCombination() for details.
+ *
+ * @tparam         Real           Type for floating-point number
+ * @tparam         State          Type for state and state derivative
+ * @tparam         NumberOfTerms  Number of terms in weighted sum
+ * @param[in,out]  result         State that weighted sum is written to
+ * @param[in]      scale          Scale factor for sum of weighted terms, e.g., step size
+ * @param[in]      coefficients   Weights of terms
+ * @param[in]      terms          Pointers to states that are combined
+ */
+template <typename Real, typename State, std::size_t NumberOfTerms>
+inline void computeWeightedSum(State& result,
+                               const Real scale,
+                               const Real (&coefficients)[NumberOfTerms],
+                               const State* const (&terms)[NumberOfTerms])
+{
+    detail::computeLinearCombination<Real, State>(
+        result, nullptr, scale, coefficients, terms, NumberOfTerms,
+        typename detail::StateTag<State>::type());
+}
+
+//! Compute linear combination of states from list of coefficient-term pairs.
+/*!
+ * Computes linear combination of states in a single pass, i.e.,
+ *
+ * \f[
+ *      result = base + scale * (c_{1} * k_{1} + c_{2} * k_{2} + ...)
+ * \f]
+ *
+ * where the coefficients and terms are given as an alternating list, e.g.,
+ * computeLinearCombination(result, state, stepSize, 0.5, k1, 0.25, k2). See the array-based
+ * overload for details.
+ *
+ * @tparam         Real           Type for floating-point number
+ * @tparam         State          Type for state and state derivative
+ * @tparam         Coefficient    Type of first coefficient
+ * @tparam         Rest           Types of remaining coefficients and terms
+ * @param[in,out]  result         State that linear combination is written to
+ * @param[in]      base           State that linear combination is added to
+ * @param[in]      scale          Scale factor for sum of weighted terms, e.g., step size
+ * @param[in]      coefficient    Weight of first term
+ * @param[in]      term           First term
+ * @param[in]      rest           Alternating list of remaining coefficients and terms
+ */
+template <typename Real, typename State, typename Coefficient, typename... Rest>
+inline void computeLinearCombination(State& result,
+                                     const State& base,
+                                     const Real scale,
+                                     const Coefficient coefficient,
+                                     const State& term,
+                                     const Rest&... rest)
+{
+    static_assert(sizeof...(Rest) % 2 == 0, "Coefficients and terms must be given in pairs");
+    Real coefficients[sizeof...(Rest) / 2 + 1];
+    const State* terms[sizeof...(Rest) / 2 + 1];
+    detail::packTerms<Real, State>(coefficients, terms, coefficient, term, rest...);
+    detail::computeLinearCombination<Real, State>(
+        result, &base, scale, coefficients, terms, sizeof...(Rest) / 2 + 1,
+        typename detail::StateTag<State>::type());
+}
+
+//! Compute weighted sum of states from list of coefficient-term pairs.
+/*!
+ * Computes weighted sum of states in a single pass, i.e.,
+ *
+ * \f[
+ *      result = scale * (c_{1} * k_{1} + c_{2} * k_{2} + ...)
+ * \f]
+ *
+ * where the coefficients and terms are given as an alternating list. See
+ * computeLinearCombination() for details.
+ *
+ * @tparam         Real           Type for floating-point number
+ * @tparam         State          Type for state and state derivative
+ * @tparam         Coefficient    Type of first coefficient
+ * @tparam         Rest           Types of remaining coefficients and terms
+ * @param[in,out]  result         State that weighted sum is written to
+ * @param[in]      scale          Scale factor for sum of weighted terms, e.g., step size
+ * @param[in]      coefficient    Weight of first term
+ * @param[in]      term           First term
+ * @param[in]      rest           Alternating list of remaining coefficients and terms
+ */
+template <typename Real, typename State, typename Coefficient, typename... Rest>
+inline void computeWeightedSum(State& result,
+                               const Real scale,
+                               const Coefficient coefficient,
+                               const State& term,
+                               const Rest&... rest)
+{
+    static_assert(sizeof...(Rest) % 2 == 0, "Coefficients and terms must be given in pairs");
+    Real coefficients[sizeof...(Rest) / 2 + 1];
+    const State* terms[sizeof...(Rest) / 2 + 1];
+    detail::packTerms<Real, State>(coefficients, terms, coefficient, term, rest...);
+    detail::computeLinearCombination<Real, State>(
+        result, nullptr, scale, coefficients, terms, sizeof...(Rest) / 2 + 1,
+        typename detail::StateTag<State>::type());
+}
+
+} // namespace integrate
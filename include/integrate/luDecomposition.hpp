@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2014-2025 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include <cmath>
+#include <utility>
+
+namespace integrate
+{
+namespace detail
+{
+
+//! Compute LU decomposition of square matrix with partial pivoting, in-place.
+/*!
+ * Computes the LU decomposition P A = L U of the given square matrix A, which is stored in
+ * row-major order, using Gaussian elimination with partial (row) pivoting. The matrix is
+ * overwritten with the factors: the strictly lower-triangular part contains L (with unit
+ * diagonal, which is not stored) and the upper-triangular part contains U. Row i of the permuted
+ * matrix is row pivots[i] of A.
+ *
+ * @tparam         Real     Type for floating-point number
+ * @param[in,out]  matrix   Matrix, which is overwritten with LU factors
+ * @param[in]      size     Number of rows and columns of matrix
+ * @param[out]     pivots   Row permutation (size elements)
+ * @return                  Flag that indicates if matrix is non-singular, i.e., if all pivots
+ *                          are non-zero
+ */
+template <typename Real>
+inline bool computeLUDecomposition(Real* const matrix, const int size, int* const pivots)
+{
+    for (int i = 0; i < size; ++i)
+    {
+        pivots[i] = i;
+    }
+
+    for (int k = 0; k < size; ++k)
+    {
+        int pivotRow = k;
+        Real pivotMagnitude = std::fabs(matrix[k * size + k]);
+        for (int i = k + 1; i < size; ++i)
+        {
+            const Real magnitude = std::fabs(matrix[i * size + k]);
+            if (magnitude > pivotMagnitude)
+            {
+                pivotRow = i;
+                pivotMagnitude = magnitude;
+            }
+        }
+
+        if (pivotMagnitude == 0.0)
+        {
+            return false;
+        }
+
+        if (pivotRow != k)
+        {
+            std::swap(pivots[k], pivots[pivotRow]);
+            for (int j = 0; j < size; ++j)
+            {
+                std::swap(matrix[k * size + j], matrix[pivotRow * size + j]);
+            }
+        }
+
+        const Real inversePivot = 1.0 / matrix[k * size + k];
+        for (int i = k + 1; i < size; ++i)
+        {
+            Real* const row = matrix + i * size;
+            const Real multiplier = row[k] * inversePivot;
+            row[k] = multiplier;
+            if (multiplier == 0.0)
+            {
+                continue;
+            }
+
+            const Real* const pivotRowElements = matrix + k * size;
+            for (int j = k + 1; j < size; ++j)
+            {
+                row[j] -= multiplier * pivotRowElements[j];
+            }
+        }
+    }
+
+    return true;
+}
+
+//! Solve linear system using LU decomposition, in-place.
+/*!
+ * Solves the linear system A x = b, using the LU decomposition of A that is computed by
+ * computeLUDecomposition(). The right-hand side is overwritten with the solution. The
+ * permutation is applied using the given storage, so that no memory is allocated.
+ *
+ * @tparam         Real      Type for floating-point number
+ * @tparam         Vector    Type for right-hand side and solution, with element access through
+ *                           operator[], e.g., an indexable state
+ * @param[in]      lu        LU factors of matrix, in row-major order
+ * @param[in]      size      Number of rows and columns of matrix
+ * @param[in]      pivots    Row permutation of LU decomposition
+ * @param[in,out]  vector    Right-hand side b, which is overwritten with solution x
+ * @param[out]     storage   Storage for permuted right-hand side (size elements)
+ */
+template <typename Real, typename Vector>
+inline void solveLUSystem(const Real* const lu,
+                          const int size,
+                          const int* const pivots,
+                          Vector& vector,
+                          Real* const storage)
+{
+    // Forward substitution with unit lower-triangular factor, applied to permuted vector.
+    for (int i = 0; i < size; ++i)
+    {
+        Real sum = vector[pivots[i]];
+        const Real* const row = lu + i * size;
+        for (int j = 0; j < i; ++j)
+        {
+            sum -= row[j] * storage[j];
+        }
+        storage[i] = sum;
+    }
+
+    // Back substitution with upper-triangular factor.
+    for (int i = size - 1; i >= 0; --i)
+    {
+        Real sum = storage[i];
+        const Real* const row = lu + i * size;
+        for (int j = i + 1; j < size; ++j)
+        {
+            sum -= row[j] * storage[j];
+        }
+        storage[i] = sum / row[i];
+    }
+
+    for (int i = 0; i < size; ++i)
+    {
+        vector[i] = storage[i];
+    }
+}
+
+} // namespace detail
+} // namespace integrate
@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2014-2025 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+namespace integrate
+{
+
+//! Lock-free single-producer, single-consumer ring buffer of fixed-size samples.
+/*!
+ * Ring buffer that hands samples of a fixed number of floating-point values, e.g., the time and
+ * the elements of a state, from one producer thread, e.g., the integration thread, to one
+ * consumer thread, e.g., a writer thread, without locks or allocation. The storage for all
+ * samples is allocated on construction, so that the memory of the buffer is bounded, regardless
+ * of the number of samples that pass through it. The capacity is rounded up to a power of two, so
+ * that indices are wrapped with a mask.
+ *
+ * The producer and consumer only share the write and read counters, which are on separate cache
+ * lines. Each side keeps a cached copy of the counter of the other side, and only reloads it when
+ * the buffer appears full (producer) or empty (consumer), so that the counters are not exchanged
+ * between cores on every sample.
+ *
+ * @tparam  Real  Type for floating-point number
+ */
+template <typename Real>
+class SampleRingBuffer
+{
+public:
+
+    //! Construct ring buffer.
+    /*!
+     * Constructs ring buffer with storage for at least the given number of samples.
+     *
+     * @throws std::invalid_argument  If capacity or sample size is smaller than 1
+     *
+     * @param[in]  minimumCapacity  Minimum number of samples that can be stored
+     * @param[in]  sampleSize       Number of values per sample
+     */
+    SampleRingBuffer(const std::size_t minimumCapacity, const std::size_t sampleSize)
+        : capacity(1),
+          sampleSize(sampleSize),
+          writeCount(0),
+          cachedReadCount(0),
+          readCount(0),
+          cachedWriteCount(0)
+    {
+        if (minimumCapacity < 1 || sampleSize < 1)
+        {
+            throw std::invalid_argument("Ring buffer capacity and sample size must be at least 1!");
+        }
+        while (capacity < minimumCapacity)
+        {
+            capacity *= 2;
+        }
+        storage.resize(capacity * sampleSize);
+    }
+
+    SampleRingBuffer(const SampleRingBuffer&) = delete;
+    SampleRingBuffer& operator=(const SampleRingBuffer&) = delete;
+
+    //! Get number of samples that can be stored.
+    std::size_t getCapacity() const { return capacity; }
+
+    //! Get number of values per sample.
+    std::size_t getSampleSize() const { return sampleSize; }
+
+    //! Append sample, if buffer is not full (producer only).
+    /*!
+     * Copies the given sample into the buffer, unless the buffer is full.
+     *
+     * @param[in]  sample  Values of sample (sampleSize values)
+     * @return             Flag that indicates if sample was appended
+     */
+    bool tryPush(const Real* const sample)
+    {
+        const std::size_t count = writeCount.load(std::memory_order_relaxed);
+        if (count - cachedReadCount == capacity)
+        {
+            cachedReadCount = readCount.load(std::memory_order_acquire);
+            if (count - cachedReadCount == capacity)
+            {
+                return false;
+            }
+        }
+        std::copy(sample, sample + sampleSize, &storage[(count & (capacity - 1)) * sampleSize]);
+        writeCount.store(count + 1, std::memory_order_release);
+        return true;
+    }
+
+    //! Remove oldest sample, if buffer is not empty (consumer only).
+    /*!
+     * Copies the oldest sample in the buffer to the given storage and removes it, unless the
+     * buffer is empty.
+     *
+     * @param[out]  sample  Values of sample (sampleSize values)
+     * @return              Flag that indicates if sample was removed
+     */
+    bool tryPop(Real* const sample)
+    {
+        const std::size_t count = readCount.load(std::memory_order_relaxed);
+        if (count == cachedWriteCount)
+        {
+            cachedWriteCount = writeCount.load(std::memory_order_acquire);
+            if (count == cachedWriteCount)
+            {
+                return false;
+            }
+        }
+        const Real* const source = &storage[(count & (capacity - 1)) * sampleSize];
+        std::copy(source, source + sampleSize, sample);
+        readCount.store(count + 1, std::memory_order_release);
+        return true;
+    }
+
+protected:
+private:
+
+    //! Size of cache line, which separates counters of producer and consumer.
+    static const std::size_t cacheLineSize = 64;
+
+    //! Number of samples that can be stored (power of two).
+    std::size_t capacity;
+
+    //! Number of values per sample.
+    std::size_t sampleSize;
+
+    //! Storage for samples.
+    std::vector<Real> storage;
+
+    //! Padding that separates shared members from counters.
+    char padding[cacheLineSize];
+
+    //! Number of samples appended by producer.
+    std::atomic<std::size_t> writeCount;
+
+    //! Number of samples removed by consumer, as last loaded by producer.
+    std::size_t cachedReadCount;
+
+    //! Padding that separates counters of producer and consumer.
+    char producerPadding[cacheLineSize];
+
+    //! Number of samples removed by consumer.
+    std::atomic<std::size_t> readCount;
+
+    //! Number of samples appended by producer, as last loaded by consumer.
+    std::size_t cachedWriteCount;
+};
+
+} // namespace integrate
@@ -6,17 +6,73 @@
 
 #pragma once
 
-#include <functional>
+#include "integrate/explicitRungeKutta.hpp"
+#include "integrate/stateDerivative.hpp"
+#include "integrate/threadLocalStepper.hpp"
 
 namespace integrate
 {
 
+//! Butcher tableau for Runge-Kutta 4 scheme.
+/*!
+ * Butcher tableau for the classical Runge-Kutta 4 scheme.
+ *
+ * @tparam  Real  Type for floating-point number
+ */
+template <typename Real>
+struct RK4Tableau
+{
+    //! Number of stages.
+    static const int numberOfStages = 4;
+
+    //! Order of propagated solution.
+    static const int order = 4;
+
+    //! Flag that indicates if tableau contains embedded solution.
+    static const bool isEmbedded = false;
+
+    //! Nodes.
+    static constexpr Real c[4] = {0.0, 1.0 / 2.0, 1.0 / 2.0, 1.0};
+
+    //! Runge-Kutta matrix (strictly lower-triangular; omitted coefficients are zero).
+    static constexpr Real a[4][4] = {
+        {},
+        {1.0 / 2.0},
+        {0.0, 1.0 / 2.0},
+        {0.0, 0.0, 1.0}
+    };
+
+    //! Weights of propagated solution.
+    static constexpr Real b[4] = {1.0 / 6.0, 1.0 / 3.0, 1.0 / 3.0, 1.0 / 6.0};
+};
+
+template <typename Real> constexpr Real RK4Tableau<Real>::c[4];
+template <typename Real> constexpr Real RK4Tableau<Real>::a[4][4];
+template <typename Real> constexpr Real RK4Tableau<Real>::b[4];
+
+//! Runge-Kutta 4 stepper.
+/*!
+ * Stepper that executes integration steps using Runge-Kutta 4 scheme. See
+ * ExplicitRungeKuttaStepper for details.
+ *
+ * @tparam  Real        Type for floating-point number
+ * @tparam  State       Type for state and state derivative
+ * @tparam  Statistics  Statistics policy, e.g., NullStatistics or IntegrationStatistics
+ */
+template <typename Real, typename State, typename Statistics = NullStatistics>
+using RK4Stepper = ExplicitRungeKuttaStepper<Real, State, RK4Tableau<Real>, Statistics>;
+
 //! Execute single integration step using Runge-Kutta 4 scheme.
 /*!
- * Executes single numerical integration step using Runge-Kutta 4 scheme.
+ * Executes single numerical integration step using Runge-Kutta 4 scheme. The stepper that holds
+ * the storage for the stages is kept per thread and reused across calls, so that memory is only
+ * allocated on the first call of each thread.
  *
  * @tparam         Real                    Type for floating-point number
  * @tparam         State                   Type for state and state derivative
+ * @tparam         StateDerivative         Type of callable to compute state derivative, e.g.,
+ *                                         function pointer, functor, lambda or
+ *                                         StateDerivativeFunction
  * @param[in,out]  time                    Independent variable, which is provided as input and is
  *                                         updated with output at end of integration step
  * @param[in,out]  state                   State, which is provided as input and is updated with
@@ -25,20 +81,16 @@ namespace integrate
  * @param[in]      computeStateDerivative  Function to compute state derivative for current time
  *                                         and state
  */
-template <typename Real, typename State>
+template <typename Real, typename State, typename StateDerivative>
 const void stepRK4(
     Real& time,
     State& state,
     const Real stepSize,
-    const std::function<const State(const Real time,
-                                    const State& state) >& computeStateDerivative)
+    const StateDerivative& computeStateDerivative)
 {
-    const State k1 = stepSize * computeStateDerivative(time, state);
-    const State k2 = stepSize * computeStateDerivative(time + stepSize * 0.5, state + 0.5 * k1);
-    const State k3 = stepSize * computeStateDerivative(time + stepSize * 0.5, state + 0.5 * k2);
-    const State k4 = stepSize * computeStateDerivative(time + stepSize, state + k3);
-    state += (1.0 / 6.0) * (k1 + 2.0 * k2 + 2.0 * k3 + k4);
-    time += stepSize;
+    detail::ThreadLocalStepper<RK4Stepper<Real, State> > threadLocalStepper;
+    RK4Stepper<Real, State>& stepper = threadLocalStepper.get();
+    stepper.step(time, state, stepSize, computeStateDerivative);
 };
 
 } // namespace integrate
@@ -6,20 +6,88 @@
 
 #pragma once
 
-#include <algorithm>
-#include <cmath>
-#include <stdexcept>
-#include <functional>
+#include "integrate/explicitRungeKutta.hpp"
+#include "integrate/statistics.hpp"
+#include "integrate/stateDerivative.hpp"
+#include "integrate/threadLocalStepper.hpp"
 
 namespace integrate
 {
 
+//! Butcher tableau for Runge-Kutta-Fehlberg 4(5) scheme.
+/*!
+ * Butcher tableau for the Runge-Kutta-Fehlberg 4(5) scheme, which propagates the 4th-order
+ * solution (Fehlberg, 1969; Burden & Faires, 2001).
+ *
+ * @tparam  Real  Type for floating-point number
+ */
+template <typename Real>
+struct RKF45Tableau
+{
+    //! Number of stages.
+    static const int numberOfStages = 6;
+
+    //! Order of propagated solution.
+    static const int order = 4;
+
+    //! Flag that indicates if tableau contains embedded solution.
+    static const bool isEmbedded = true;
+
+    //! Order of embedded solution.
+    static const int embeddedOrder = 5;
+
+    //! Nodes.
+    static constexpr Real c[6] = {0.0, 1.0 / 4.0, 3.0 / 8.0, 12.0 / 13.0, 1.0, 1.0 / 2.0};
+
+    //! Runge-Kutta matrix (strictly lower-triangular; omitted coefficients are zero).
+    static constexpr Real a[6][6] = {
+        {},
+        {1.0 / 4.0},
+        {3.0 / 32.0, 9.0 / 32.0},
+        {1932.0 / 2197.0, -7200.0 / 2197.0, 7296.0 / 2197.0},
+        {439.0 / 216.0, -8.0, 3680.0 / 513.0, -845.0 / 4104.0},
+        {-8.0 / 27.0, 2.0, -3544.0 / 2565.0, 1859.0 / 4104.0, -11.0 / 40.0}
+    };
+
+    //! Weights of propagated solution.
+    static constexpr Real b[6] = {
+        25.0 / 216.0, 0.0, 1408.0 / 2565.0, 2197.0 / 4104.0, -1.0 / 5.0, 0.0
+    };
+
+    //! Weights of embedded solution.
+    static constexpr Real bHat[6] = {
+        16.0 / 135.0, 0.0, 6656.0 / 12825.0, 28561.0 / 56430.0, -9.0 / 50.0, 2.0 / 55.0
+    };
+};
+
+template <typename Real> constexpr Real RKF45Tableau<Real>::c[6];
+template <typename Real> constexpr Real RKF45Tableau<Real>::a[6][6];
+template <typename Real> constexpr Real RKF45Tableau<Real>::b[6];
+template <typename Real> constexpr Real RKF45Tableau<Real>::bHat[6];
+
+//! Runge-Kutta-Fehlberg 4(5) stepper.
+/*!
+ * Stepper that executes integration steps using Runge-Kutta-Fehlberg 4(5) scheme. See
+ * ExplicitRungeKuttaStepper for details.
+ *
+ * @tparam  Real        Type for floating-point number
+ * @tparam  State       Type for state and state derivative
+ * @tparam  Statistics  Statistics policy, e.g., NullStatistics or IntegrationStatistics
+ */
+template <typename Real, typename State, typename Statistics = NullStatistics>
+using RKF45Stepper = ExplicitRungeKuttaStepper<Real, State, RKF45Tableau<Real>, Statistics>;
+
 //! Execute single integration step using Runge-Kutta-Felhberg 4(5) scheme.
 /*!
- * Executes single numerical integration step using Runge-Kutta-Felhberg 4(5) scheme.
+ * Executes single numerical integration step using Runge-Kutta-Felhberg 4(5) scheme. The stepper
+ * that holds the storage for the stages is kept per thread and reused across calls, so that
+ * memory is only allocated on the first call of each thread.
  *
  * @tparam         Real                    Type for floating-point number
  * @tparam         State                   Type for state and state derivative
+ * @tparam         StateDerivative         Type of callable to compute state derivative, e.g.,
+ *                                         function pointer, functor, lambda or
+ *                                         StateDerivativeFunction
  * @param[in,out]  time                    Independent variable, which is provided as input and is
  *                                         updated with output at end of integration step
  * @param[in,out]  state                   State, which is provided as input and is updated with
@@ -31,98 +99,81 @@ namespace integrate
  * @param[in]      minimumStepSize         Minimum allowable step size for integration step
  * @param[in]      maximumStepSize         Maximum allowable step size for integration step
  */
-template <typename Real, typename State>
+template <typename Real, typename State, typename StateDerivative>
 const void stepRKF45(
     Real& time,
     State& state,
     Real& stepSize,
-    const std::function<const State(const Real time,
-                                     const State& state)>& computeStateDerivative,
+    const StateDerivative& computeStateDerivative,
     const Real tolerance,
     const Real minimumStepSize,
     const Real maximumStepSize)
 {
-    const State k1 = stepSize * computeStateDerivative(time, state);
-    const State k2 = stepSize * computeStateDerivative(time + 0.25 * stepSize,
-                                                       state + 0.25 * k1);
-    const State k3 = stepSize * computeStateDerivative(time + 0.375 * stepSize,
-                                                       state + 0.09375 * k1 + 0.28125 * k2);
-    const State k4 = stepSize * computeStateDerivative(time + (12.0 / 13.0) * stepSize,
-                                                       state + (1932.0 / 2197.0) * k1
-                                                             + (-7200.0 / 2197.0) * k2
-                                                             + (7296.0 / 2197.0) * k3);
-    const State k5 = stepSize * computeStateDerivative(time + stepSize,
-                                                       state + (439.0 / 216.0) * k1
-                                                             + (-8.0) * k2
-                                                             + (3680.0 / 513.0) * k3
-                                                             + (-845.0 / 4104.0) * k4);
-    const State k6 = stepSize * computeStateDerivative(time + 0.5 * stepSize,
-                                                       state + (-8.0 / 27.0) * k1
-                                                             + (2.0) * k2
-                                                             + (-3544.0 / 2565.0) * k3
-                                                             + (1859.0 / 4104.0) * k4
-                                                             + (-11.0 / 40.0) * k5);
-
-    const State errorEstimate = (1.0 / 360.0) * k1
-                                + (-128.0 / 4275.0) * k3
-                                + (-2197.0 / 75240.0) * k4
-                                + (1.0 / 50.0) * k5
-                                + (2.0 / 55.0) * k6;
-
-    Real errorEstimateMaximum = 0.0;
-    for (int i = 0; i < errorEstimate.size(); ++i)
-    {
-        const Real errorEstimateElementAbsolute = std::fabs(errorEstimate[i]);
-        if (errorEstimateMaximum < errorEstimateElementAbsolute)
-        {
-            errorEstimateMaximum = errorEstimateElementAbsolute;
-        }
-    }
-
-    const Real stepSizeFactor = 0.84 * std::pow((tolerance * stepSize
-                                                 / errorEstimateMaximum), 0.25);
+    detail::ThreadLocalStepper<RKF45Stepper<Real, State> > threadLocalStepper;
+    RKF45Stepper<Real, State>& stepper = threadLocalStepper.get();
+    stepper.step(time,
+                 state,
+                 stepSize,
+                 computeStateDerivative,
+                 tolerance,
+                 minimumStepSize,
+                 maximumStepSize);
+};
 
-    if (errorEstimateMaximum < tolerance * stepSize)
+//! Execute single integration step using Runge-Kutta-Felhberg 4(5) scheme and collect statistics.
+/*!
+ * Executes single numerical integration step using Runge-Kutta-Felhberg 4(5) scheme, and adds the
+ * state derivative evaluations, accepted step and rejected step attempts of the integration step
+ * to the given statistics.
+ *
+ * @tparam         Real                    Type for floating-point number
+ * @tparam         State                   Type for state and state derivative
+ * @tparam         StateDerivative         Type of callable to compute state derivative, e.g.,
+ *                                         function pointer, functor, lambda or
+ *                                         StateDerivativeFunction
+ * @param[in,out]  time                    Independent variable, which is provided as input and is
+ *                                         updated with output at end of integration step
+ * @param[in,out]  state                   State, which is provided as input and is updated with
+ *                                         output at end of integration step
+ * @param[in,out]  stepSize                Step size to take for integration step
+ * @param[in]      computeStateDerivative  Function to compute state derivative for current time
+ *                                         and state
+ * @param[in]      tolerance               Local truncation error tolerance
+ * @param[in]      minimumStepSize         Minimum allowable step size for integration step
+ * @param[in]      maximumStepSize         Maximum allowable step size for integration step
+ * @param[in,out]  statistics              Statistics, which are updated with statistics of
+ *                                         integration step
+ */
+template <typename Real, typename State, typename StateDerivative>
+const void stepRKF45(
+    Real& time,
+    State& state,
+    Real& stepSize,
+    const StateDerivative& computeStateDerivative,
+    const Real tolerance,
+    const Real minimumStepSize,
+    const Real maximumStepSize,
+    IntegrationStatistics<Real>& statistics)
+{
+    typedef RKF45Stepper<Real, State, IntegrationStatistics<Real> > Stepper;
+    detail::ThreadLocalStepper<Stepper> threadLocalStepper;
+    Stepper& stepper = threadLocalStepper.get();
+    try
     {
-        time = time + stepSize;
-        state = state + (25.0 / 216.0) * k1
-                      + (1408.0 / 2565.0) * k3
-                      + (2197.0 / 4104.0) * k4
-                      + (-1.0 / 5.0) * k5;
-        stepSize = stepSizeFactor * stepSize;
+        stepper.step(time,
+                     state,
+                     stepSize,
+                     computeStateDerivative,
+                     tolerance,
+                     minimumStepSize,
+                     maximumStepSize);
     }
-    else
+    catch (...)
     {
-        if (stepSizeFactor <= 0.1)
-        {
-            stepSize = 0.1 * stepSize;
-        }
-        else if (stepSizeFactor >= 4.0)
-        {
-            stepSize = 4.0 * stepSize;
-        }
-        else
-        {
-            stepSize = stepSizeFactor * stepSize;
-        }
-
-        if (stepSize > maximumStepSize)
-        {
-            stepSize = maximumStepSize;
-        }
-        else if (stepSize < minimumStepSize)
-        {
-            std::runtime_error("Minimum step size exceed!");
-        }
-
-        stepRKF45<Real, State>(time,
-                               state,
-                               stepSize,
-                               computeStateDerivative,
-                               minimumStepSize,
-                               maximumStepSize,
-                               tolerance);
+        statistics += stepper.getStatistics();
+        throw;
     }
+    statistics += stepper.getStatistics();
 };
 
 } // namespace integrate
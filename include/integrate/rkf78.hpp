@@ -6,20 +6,104 @@
 
 #pragma once
 
-#include <algorithm>
-#include <cmath>
-#include <stdexcept>
-#include <functional>
+#include "integrate/explicitRungeKutta.hpp"
+#include "integrate/statistics.hpp"
+#include "integrate/stateDerivative.hpp"
+#include "integrate/threadLocalStepper.hpp"
 
 namespace integrate
 {
 
+//! Butcher tableau for Runge-Kutta-Fehlberg 7(8) scheme.
+/*!
+ * Butcher tableau for the Runge-Kutta-Fehlberg 7(8) scheme, which propagates the 7th-order
+ * solution (Fehlberg, 1968).
+ *
+ * @tparam  Real  Type for floating-point number
+ */
+template <typename Real>
+struct RKF78Tableau
+{
+    //! Number of stages.
+    static const int numberOfStages = 13;
+
+    //! Order of propagated solution.
+    static const int order = 7;
+
+    //! Flag that indicates if tableau contains embedded solution.
+    static const bool isEmbedded = true;
+
+    //! Order of embedded solution.
+    static const int embeddedOrder = 8;
+
+    //! Nodes.
+    static constexpr Real c[13] = {
+        0.0, 2.0 / 27.0, 1.0 / 9.0, 1.0 / 6.0, 5.0 / 12.0, 1.0 / 2.0, 5.0 / 6.0, 1.0 / 6.0,
+        2.0 / 3.0, 1.0 / 3.0, 1.0, 0.0, 1.0
+    };
+
+    //! Runge-Kutta matrix (strictly lower-triangular; omitted coefficients are zero).
+    static constexpr Real a[13][13] = {
+        {},
+        {2.0 / 27.0},
+        {1.0 / 36.0, 1.0 / 12.0},
+        {1.0 / 24.0, 0.0, 1.0 / 8.0},
+        {5.0 / 12.0, 0.0, -25.0 / 16.0, 25.0 / 16.0},
+        {1.0 / 20.0, 0.0, 0.0, 1.0 / 4.0, 1.0 / 5.0},
+        {-25.0 / 108.0, 0.0, 0.0, 125.0 / 108.0, -65.0 / 27.0, 125.0 / 54.0},
+        {31.0 / 300.0, 0.0, 0.0, 0.0, 61.0 / 225.0, -2.0 / 9.0, 13.0 / 900.0},
+        {2.0, 0.0, 0.0, -53.0 / 6.0, 704.0 / 45.0, -107.0 / 9.0, 67.0 / 90.0, 3.0},
+        {-91.0 / 108.0, 0.0, 0.0, 23.0 / 108.0, -976.0 / 135.0, 311.0 / 54.0, -19.0 / 60.0,
+         17.0 / 6.0, -1.0 / 12.0},
+        {2383.0 / 4100.0, 0.0, 0.0, -341.0 / 164.0, 4496.0 / 1025.0, -301.0 / 82.0, 2133.0 / 4100.0,
+         45.0 / 82.0, 45.0 / 164.0, 18.0 / 41.0},
+        {3.0 / 205.0, 0.0, 0.0, 0.0, 0.0, -6.0 / 41.0, -3.0 / 205.0, -3.0 / 41.0, 3.0 / 41.0,
+         6.0 / 41.0, 0.0},
+        {-1777.0 / 4100.0, 0.0, 0.0, -341.0 / 164.0, 4496.0 / 1025.0, -289.0 / 82.0,
+         2193.0 / 4100.0, 51.0 / 82.0, 33.0 / 164.0, 12.0 / 41.0, 0.0, 1.0}
+    };
+
+    //! Weights of propagated solution.
+    static constexpr Real b[13] = {
+        41.0 / 840.0, 0.0, 0.0, 0.0, 0.0, 34.0 / 105.0, 9.0 / 35.0, 9.0 / 35.0, 9.0 / 280.0,
+        9.0 / 280.0, 41.0 / 840.0, 0.0, 0.0
+    };
+
+    //! Weights of embedded solution.
+    static constexpr Real bHat[13] = {
+        0.0, 0.0, 0.0, 0.0, 0.0, 34.0 / 105.0, 9.0 / 35.0, 9.0 / 35.0, 9.0 / 280.0, 9.0 / 280.0,
+        0.0, 41.0 / 840.0, 41.0 / 840.0
+    };
+};
+
+template <typename Real> constexpr Real RKF78Tableau<Real>::c[13];
+template <typename Real> constexpr Real RKF78Tableau<Real>::a[13][13];
+template <typename Real> constexpr Real RKF78Tableau<Real>::b[13];
+template <typename Real> constexpr Real RKF78Tableau<Real>::bHat[13];
+
+//! Runge-Kutta-Fehlberg 7(8) stepper.
+/*!
+ * Stepper that executes integration steps using Runge-Kutta-Fehlberg 7(8) scheme. See
+ * ExplicitRungeKuttaStepper for details.
+ *
+ * @tparam  Real        Type for floating-point number
+ * @tparam  State       Type for state and state derivative
+ * @tparam  Statistics  Statistics policy, e.g., NullStatistics or IntegrationStatistics
+ */
+template <typename Real, typename State, typename Statistics = NullStatistics>
+using RKF78Stepper = ExplicitRungeKuttaStepper<Real, State, RKF78Tableau<Real>, Statistics>;
+
 //! Execute single integration step using Runge-Kutta-Felhberg 7(8) scheme.
 /*!
- * Executes single numerical integration step using Runge-Kutta-Felhberg 7(8) scheme.
+ * Executes single numerical integration step using Runge-Kutta-Felhberg 7(8) scheme. The stepper
+ * that holds the storage for the stages is kept per thread and reused across calls, so that
+ * memory is only allocated on the first call of each thread.
  *
  * @tparam         Real                    Type for floating-point number
  * @tparam         State                   Type for state and state derivative
+ * @tparam         StateDerivative         Type of callable to compute state derivative, e.g.,
+ *                                         function pointer, functor, lambda or
+ *                                         StateDerivativeFunction
  * @param[in,out]  time                    Independent variable, which is provided as input and is
  *                                         updated with output at end of integration step
  * @param[in,out]  state                   State, which is provided as input and is updated with
@@ -31,146 +115,81 @@ namespace integrate
  * @param[in]      minimumStepSize         Minimum allowable step size for integration step
  * @param[in]      maximumStepSize         Maximum allowable step size for integration step
  */
-template <typename Real, typename State>
+template <typename Real, typename State, typename StateDerivative>
 const void stepRKF78(
     Real& time,
     State& state,
     Real& stepSize,
-    const std::function<const State(const Real time,
-                                     const State& state)>& computeStateDerivative,
+    const StateDerivative& computeStateDerivative,
     const Real tolerance,
     const Real minimumStepSize,
     const Real maximumStepSize)
 {
-    const State k1  = stepSize * computeStateDerivative(time, state);
-    const State k2  = stepSize * computeStateDerivative(time + (2.0 / 27.0) * stepSize,
-                                                        state + (2.0 / 27.0) * k1);
-    const State k3  = stepSize * computeStateDerivative(time + (1.0 / 9.0) * stepSize,
-                                                        state + (1.0 / 36.0) * k1
-                                                              + (1.0 / 12.0) * k2);
-    const State k4  = stepSize * computeStateDerivative(time + (1.0 / 6.0) * stepSize,
-                                                        state + (1.0 / 24.0) * k1
-                                                               + (0.125) * k3);
-    const State k5  = stepSize * computeStateDerivative(time + (5.0 / 12.0) * stepSize,
-                                                        state + (5.0 / 12.0) * k1
-                                                              + (-1.5625) * k3
-                                                              + (1.5625) * k4);
-    const State k6  = stepSize * computeStateDerivative(time + (0.5) * stepSize,
-                                                        state + (0.05) * k1
-                                                              + (0.25) * k4
-                                                              + (0.2) * k5);
-    const State k7  = stepSize * computeStateDerivative(time + (5.0 / 6.0) * stepSize,
-                                                        state + (-25.0 / 108.0) * k1
-                                                              + (125.0 / 108.0) * k4
-                                                              + (-65.0 / 27.0) * k5
-                                                              + (125.0 / 54.0) * k6);
-    const State k8  = stepSize * computeStateDerivative(time + (1.0 / 6.0) * stepSize,
-                                                        state + (31.0 / 300.0) * k1
-                                                              + (61.0 / 225.0) * k5
-                                                              + (-2.0 / 9.0) * k6
-                                                              + (13.0 / 900.0) * k7);
-    const State k9  = stepSize * computeStateDerivative(time + (2.0 / 3.0) * stepSize,
-                                                        state + (2.0) * k1
-                                                              + (-53.0 / 6.0) * k4
-                                                              + (704.0 / 45.0) * k5
-                                                              + (-107.0 / 9.0) * k6
-                                                              + (67.0 / 90.0) * k7
-                                                              + (3.0) * k8);
-    const State k10 = stepSize * computeStateDerivative(time + (1.0 / 3.0) * stepSize,
-                                                        state + (-91.0 / 108.0) * k1
-                                                              + (23.0 / 108.0) * k4
-                                                              + (-976.0 / 135.0) * k5
-                                                              + (311.0 / 54.0) * k6
-                                                              + (-19.0 / 60.0) * k7
-                                                              + (17.0 / 6.0) * k8
-                                                              + (-1.0 / 12.0) * k9);
-    const State k11 = stepSize * computeStateDerivative(time + stepSize,
-                                                        state + (2383.0 / 4100.0) * k1
-                                                              + (-341.0 / 164.0) * k4
-                                                              + (4496.0 / 1025.0) * k5
-                                                              + (-301.0 / 82.0) * k6
-                                                              + (2133.0 / 4100.0) * k7
-                                                              + (45.0 / 82.0) * k8
-                                                              + (45.0 / 164.0) * k9
-                                                              + (18.0 / 41.0) * k10);
-    const State k12 = stepSize * computeStateDerivative(time,
-                                                        state + (3.0 / 205.0) * k1
-                                                              + (-6.0 / 41.0) * k6
-                                                              + (-3.0 / 205.0) * k7
-                                                              + (-3.0 / 41.0) * k8
-                                                              + (3.0 / 41.0) * k9
-                                                              + (6.0 / 41.0) * k10);
-    const State k13 = stepSize * computeStateDerivative(time + stepSize,
-                                                        state + (-1777.0 / 4100.0) * k1
-                                                              + (-341.0 / 164.0) * k4
-                                                              + (4496.0 / 1025.0) * k5
-                                                              + (-289.0 / 82.0) * k6
-                                                              + (2193.0 / 4100.0) * k7
-                                                              + (51.0 / 82.0) * k8
-                                                              + (33.0 / 164.0) * k9
-                                                              + (12.0 / 41.0) * k10
-                                                              + k12);
-
-    const State errorEstimate = (41.0 / 840.0) * (k1 + k11 + (-1.0) * k12 + (-1.0) * k13);
-
-    Real errorEstimateMaximum = 0.0;
-    for (int i = 0; i < errorEstimate.size(); ++i)
-    {
-        const Real errorEstimateElementAbsolute = std::fabs(errorEstimate[i]);
-        if (errorEstimateMaximum < errorEstimateElementAbsolute)
-        {
-            errorEstimateMaximum = errorEstimateElementAbsolute;
-        }
-    }
-
-    const Real stepSizeFactor = 0.84 * std::pow((tolerance * stepSize
-                                                 / errorEstimateMaximum), 0.125);
+    detail::ThreadLocalStepper<RKF78Stepper<Real, State> > threadLocalStepper;
+    RKF78Stepper<Real, State>& stepper = threadLocalStepper.get();
+    stepper.step(time,
+                 state,
+                 stepSize,
+                 computeStateDerivative,
+                 tolerance,
+                 minimumStepSize,
+                 maximumStepSize);
+};
 
-    if (errorEstimateMaximum < tolerance * stepSize)
+//! Execute single integration step using Runge-Kutta-Felhberg 7(8) scheme and collect statistics.
+/*!
+ * Executes single numerical integration step using Runge-Kutta-Felhberg 7(8) scheme, and adds the
+ * state derivative evaluations, accepted step and rejected step attempts of the integration step
+ * to the given statistics.
+ *
+ * @tparam         Real                    Type for floating-point number
+ * @tparam         State                   Type for state and state derivative
+ * @tparam         StateDerivative         Type of callable to compute state derivative, e.g.,
+ *                                         function pointer, functor, lambda or
+ *                                         StateDerivativeFunction
+ * @param[in,out]  time                    Independent variable, which is provided as input and is
+ *                                         updated with output at end of integration step
+ * @param[in,out]  state                   State, which is provided as input and is updated with
+ *                                         output at end of integration step
+ * @param[in,out]  stepSize                Step size to take for integration step
+ * @param[in]      computeStateDerivative  Function to compute state derivative for current time
+ *                                         and state
+ * @param[in]      tolerance               Local truncation error tolerance
+ * @param[in]      minimumStepSize         Minimum allowable step size for integration step
+ * @param[in]      maximumStepSize         Maximum allowable step size for integration step
+ * @param[in,out]  statistics              Statistics, which are updated with statistics of
+ *                                         integration step
+ */
+template <typename Real, typename State, typename StateDerivative>
+const void stepRKF78(
+    Real& time,
+    State& state,
+    Real& stepSize,
+    const StateDerivative& computeStateDerivative,
+    const Real tolerance,
+    const Real minimumStepSize,
+    const Real maximumStepSize,
+    IntegrationStatistics<Real>& statistics)
+{
+    typedef RKF78Stepper<Real, State, IntegrationStatistics<Real> > Stepper;
+    detail::ThreadLocalStepper<Stepper> threadLocalStepper;
+    Stepper& stepper = threadLocalStepper.get();
+    try
     {
-        time = time + stepSize;
-        state = state + (41.0 / 840.0) * k1
-                      + (34.0 / 105.0) * k6
-                      + (9.0 / 35.0) * k7
-                      + (9.0 / 35.0) * k8
-                      + (9.0 / 280.0) * k9
-                      + (9.0 / 280.0) * k10
-                      + (41.0 / 840.0) * k11;
-
-        stepSize = stepSizeFactor * stepSize;
+        stepper.step(time,
+                     state,
+                     stepSize,
+                     computeStateDerivative,
+                     tolerance,
+                     minimumStepSize,
+                     maximumStepSize);
     }
-    else
+    catch (...)
     {
-        if (stepSizeFactor <= 0.1)
-        {
-            stepSize = 0.1 * stepSize;
-        }
-        else if (stepSizeFactor >= 4.0)
-        {
-            stepSize = 4.0 * stepSize;
-        }
-        else
-        {
-            stepSize = stepSizeFactor * stepSize;
-        }
-
-        if (stepSize > maximumStepSize)
-        {
-            stepSize = maximumStepSize;
-        }
-        else if (stepSize < minimumStepSize)
-        {
-            std::runtime_error("Minimum step size exceed!");
-        }
-
-        stepRKF78<Real, State>(time,
-                               state,
-                               stepSize,
-                               computeStateDerivative,
-                               minimumStepSize,
-                               maximumStepSize,
-                               tolerance);
+        statistics += stepper.getStatistics();
+        throw;
     }
+    statistics += stepper.getStatistics();
 };
 
 } // namespace integrate
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2014-2025 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "integrate/rungeKuttaNystrom.hpp"
+#include "integrate/statistics.hpp"
+#include "integrate/stateDerivative.hpp"
+#include "integrate/threadLocalStepper.hpp"
+
+namespace integrate
+{
+
+//! Tableau for Dormand-El-Mikkawy-Prince Runge-Kutta-Nystrom 4(3) scheme.
+/*!
+ * Tableau for the Runge-Kutta-Nystrom 4(3)4FM scheme, which propagates the 4th-order solution
+ * (Dormand et al., 1987). The last stage is evaluated with the propagated position at the end of
+ * the step (First-Same-As-Last), so that an accepted step costs three acceleration evaluations
+ * when it is reused by RKN43Stepper.
+ *
+ * @tparam  Real  Type for floating-point number
+ */
+template <typename Real>
+struct RKN43Tableau
+{
+    //! Number of stages.
+    static const int numberOfStages = 4;
+
+    //! Order of propagated solution.
+    static const int order = 4;
+
+    //! Flag that indicates if tableau contains embedded solution.
+    static const bool isEmbedded = true;
+
+    //! Order of embedded solution.
+    static const int embeddedOrder = 3;
+
+    //! Flag that indicates if last stage is evaluated at end of step with propagated position.
+    static const bool isFirstSameAsLast = true;
+
+    //! Nodes.
+    static constexpr Real c[4] = {0.0, 1.0 / 4.0, 7.0 / 10.0, 1.0};
+
+    //! Runge-Kutta-Nystrom matrix (strictly lower-triangular; omitted coefficients are zero).
+    static constexpr Real a[4][4] = {
+        {},
+        {1.0 / 32.0},
+        {7.0 / 1000.0, 119.0 / 500.0},
+        {1.0 / 14.0, 8.0 / 27.0, 25.0 / 189.0}
+    };
+
+    //! Weights of propagated position.
+    static constexpr Real b[4] = {1.0 / 14.0, 8.0 / 27.0, 25.0 / 189.0, 0.0};
+
+    //! Weights of propagated velocity.
+    static constexpr Real bPrime[4] = {1.0 / 14.0, 32.0 / 81.0, 250.0 / 567.0, 5.0 / 54.0};
+
+    //! Weights of embedded position.
+    static constexpr Real bHat[4] = {-7.0 / 150.0, 67.0 / 150.0, 3.0 / 20.0, -1.0 / 20.0};
+
+    //! Weights of embedded velocity.
+    static constexpr Real bHatPrime[4] = {13.0 / 21.0, -20.0 / 27.0, 275.0 / 189.0, -1.0 / 3.0};
+};
+
+template <typename Real> constexpr Real RKN43Tableau<Real>::c[4];
+template <typename Real> constexpr Real RKN43Tableau<Real>::a[4][4];
+template <typename Real> constexpr Real RKN43Tableau<Real>::b[4];
+template <typename Real> constexpr Real RKN43Tableau<Real>::bPrime[4];
+template <typename Real> constexpr Real RKN43Tableau<Real>::bHat[4];
+template <typename Real> constexpr Real RKN43Tableau<Real>::bHatPrime[4];
+
+//! Dormand-El-Mikkawy-Prince Runge-Kutta-Nystrom 4(3) stepper.
+/*!
+ * Stepper that executes integration steps using Runge-Kutta-Nystrom 4(3) scheme. The stepper
+ * keeps the last stage acceleration of each accepted step and reuses it as the first stage of the
+ * next step. See RungeKuttaNystromStepper for details.
+ *
+ * @tparam  Real        Type for floating-point number
+ * @tparam  State       Type for position, velocity and acceleration
+ * @tparam  Statistics  Statistics policy, e.g., NullStatistics or IntegrationStatistics
+ */
+template <typename Real, typename State, typename Statistics = NullStatistics>
+using RKN43Stepper = RungeKuttaNystromStepper<Real, State, RKN43Tableau<Real>, Statistics>;
+
+//! Execute single integration step using Runge-Kutta-Nystrom 4(3) scheme.
+/*!
+ * Executes single numerical integration step using Runge-Kutta-Nystrom 4(3) scheme. The stepper
+ * that holds the storage for the stages is kept per thread and reused across calls, so that memory
+ * is only allocated on the first call of each thread. Since the stepper is reset on each call, the
+ * First-Same-As-Last stage is not reused; use RKN43Stepper instead to reuse it across steps.
+ *
+ * @tparam         Real                 Type for floating-point number
+ * @tparam         State                Type for position, velocity and acceleration
+ * @tparam         Acceleration         Type of callable to compute acceleration, e.g., function
+ *                                      pointer, functor, lambda or StateDerivativeFunction
+ * @param[in,out]  time                 Independent variable, which is provided as input and is
+ *                                      updated with output at end of integration step
+ * @param[in,out]  position             Position, which is provided as input and is updated with
+ *                                      output at end of integration step
+ * @param[in,out]  velocity             Velocity, which is provided as input and is updated with
+ *                                      output at end of integration step
+ * @param[in,out]  stepSize             Step size to take for integration step
+ * @param[in]      computeAcceleration  Function to compute acceleration for current time and
+ *                                      position
+ * @param[in]      tolerance            Local truncation error tolerance
+ * @param[in]      minimumStepSize      Minimum allowable step size for integration step
+ * @param[in]      maximumStepSize      Maximum allowable step size for integration step
+ */
+template <typename Real, typename State, typename Acceleration>
+const void stepRKN43(
+    Real& time,
+    State& position,
+    State& velocity,
+    Real& stepSize,
+    const Acceleration& computeAcceleration,
+    const Real tolerance,
+    const Real minimumStepSize,
+    const Real maximumStepSize)
+{
+    detail::ThreadLocalStepper<RKN43Stepper<Real, State> > threadLocalStepper;
+    RKN43Stepper<Real, State>& stepper = threadLocalStepper.get();
+    stepper.step(time,
+                 position,
+                 velocity,
+                 stepSize,
+                 computeAcceleration,
+                 tolerance,
+                 minimumStepSize,
+                 maximumStepSize);
+};
+
+} // namespace integrate
@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2014-2025 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "integrate/rungeKuttaNystrom.hpp"
+#include "integrate/statistics.hpp"
+#include "integrate/stateDerivative.hpp"
+#include "integrate/threadLocalStepper.hpp"
+
+namespace integrate
+{
+
+//! Tableau for Dormand-El-Mikkawy-Prince Runge-Kutta-Nystrom 6(4) scheme.
+/*!
+ * Tableau for the Runge-Kutta-Nystrom 6(4)6FM scheme, which propagates the 6th-order solution
+ * (Dormand et al., 1987). The last stage is evaluated with the propagated position at the end of
+ * the step (First-Same-As-Last), so that an accepted step costs five acceleration evaluations
+ * when it is reused by RKN64Stepper, compared to twelve state derivative evaluations of RKF78 for
+ * the equivalent first-order system.
+ *
+ * @tparam  Real  Type for floating-point number
+ */
+template <typename Real>
+struct RKN64Tableau
+{
+    //! Number of stages.
+    static const int numberOfStages = 6;
+
+    //! Order of propagated solution.
+    static const int order = 6;
+
+    //! Flag that indicates if tableau contains embedded solution.
+    static const bool isEmbedded = true;
+
+    //! Order of embedded solution.
+    static const int embeddedOrder = 4;
+
+    //! Flag that indicates if last stage is evaluated at end of step with propagated position.
+    static const bool isFirstSameAsLast = true;
+
+    //! Nodes.
+    static constexpr Real c[6] = {0.0, 1.0 / 10.0, 3.0 / 10.0, 7.0 / 10.0, 17.0 / 25.0, 1.0};
+
+    //! Runge-Kutta-Nystrom matrix (strictly lower-triangular; omitted coefficients are zero).
+    static constexpr Real a[6][6] = {
+        {},
+        {1.0 / 200.0},
+        {-1.0 / 2200.0, 1.0 / 22.0},
+        {637.0 / 6600.0, -7.0 / 110.0, 7.0 / 33.0},
+        {225437.0 / 1968750.0, -30073.0 / 281250.0, 65569.0 / 281250.0, -9367.0 / 984375.0},
+        {151.0 / 2142.0, 5.0 / 116.0, 385.0 / 1368.0, 55.0 / 168.0, -6250.0 / 28101.0}
+    };
+
+    //! Weights of propagated position.
+    static constexpr Real b[6] = {
+        151.0 / 2142.0, 5.0 / 116.0, 385.0 / 1368.0, 55.0 / 168.0, -6250.0 / 28101.0, 0.0
+    };
+
+    //! Weights of propagated velocity.
+    static constexpr Real bPrime[6] = {
+        151.0 / 2142.0, 25.0 / 522.0, 275.0 / 684.0, 275.0 / 252.0, -78125.0 / 112404.0,
+        1.0 / 12.0
+    };
+
+    //! Weights of embedded position.
+    static constexpr Real bHat[6] = {
+        1349.0 / 157500.0, 7873.0 / 50000.0, 192199.0 / 900000.0, 521683.0 / 2100000.0,
+        -16.0 / 125.0, 0.0
+    };
+
+    //! Weights of embedded velocity.
+    static constexpr Real bHatPrime[6] = {
+        1349.0 / 157500.0, 7873.0 / 45000.0, 27457.0 / 90000.0, 521683.0 / 630000.0,
+        -2.0 / 5.0, 1.0 / 12.0
+    };
+};
+
+template <typename Real> constexpr Real RKN64Tableau<Real>::c[6];
+template <typename Real> constexpr Real RKN64Tableau<Real>::a[6][6];
+template <typename Real> constexpr Real RKN64Tableau<Real>::b[6];
+template <typename Real> constexpr Real RKN64Tableau<Real>::bPrime[6];
+template <typename Real> constexpr Real RKN64Tableau<Real>::bHat[6];
+template <typename Real> constexpr Real RKN64Tableau<Real>::bHatPrime[6];
+
+//! Dormand-El-Mikkawy-Prince Runge-Kutta-Nystrom 6(4) stepper.
+/*!
+ * Stepper that executes integration steps using Runge-Kutta-Nystrom 6(4) scheme. The stepper
+ * keeps the last stage acceleration of each accepted step and reuses it as the first stage of the
+ * next step. See RungeKuttaNystromStepper for details.
+ *
+ * @tparam  Real        Type for floating-point number
+ * @tparam  State       Type for position, velocity and acceleration
+ * @tparam  Statistics  Statistics policy, e.g., NullStatistics or IntegrationStatistics
+ */
+template <typename Real, typename State, typename Statistics = NullStatistics>
+using RKN64Stepper = RungeKuttaNystromStepper<Real, State, RKN64Tableau<Real>, Statistics>;
+
+//! Execute single integration step using Runge-Kutta-Nystrom 6(4) scheme.
+/*!
+ * Executes single numerical integration step using Runge-Kutta-Nystrom 6(4) scheme. The stepper
+ * that holds the storage for the stages is kept per thread and reused across calls, so that memory
+ * is only allocated on the first call of each thread. Since the stepper is reset on each call, the
+ * First-Same-As-Last stage is not reused; use RKN64Stepper instead to reuse it across steps.
+ *
+ * @tparam         Real                 Type for floating-point number
+ * @tparam         State                Type for position, velocity and acceleration
+ * @tparam         Acceleration         Type of callable to compute acceleration, e.g., function
+ *                                      pointer, functor, lambda or StateDerivativeFunction
+ * @param[in,out]  time                 Independent variable, which is provided as input and is
+ *                                      updated with output at end of integration step
+ * @param[in,out]  position             Position, which is provided as input and is updated with
+ *                                      output at end of integration step
+ * @param[in,out]  velocity             Velocity, which is provided as input and is updated with
+ *                                      output at end of integration step
+ * @param[in,out]  stepSize             Step size to take for integration step
+ * @param[in]      computeAcceleration  Function to compute acceleration for current time and
+ *                                      position
+ * @param[in]      tolerance            Local truncation error tolerance
+ * @param[in]      minimumStepSize      Minimum allowable step size for integration step
+ * @param[in]      maximumStepSize      Maximum allowable step size for integration step
+ */
+template <typename Real, typename State, typename Acceleration>
+const void stepRKN64(
+    Real& time,
+    State& position,
+    State& velocity,
+    Real& stepSize,
+    const Acceleration& computeAcceleration,
+    const Real tolerance,
+    const Real minimumStepSize,
+    const Real maximumStepSize)
+{
+    detail::ThreadLocalStepper<RKN64Stepper<Real, State> > threadLocalStepper;
+    RKN64Stepper<Real, State>& stepper = threadLocalStepper.get();
+    stepper.step(time,
+                 position,
+                 velocity,
+                 stepSize,
+                 computeAcceleration,
+                 tolerance,
+                 minimumStepSize,
+                 maximumStepSize);
+};
+
+} // namespace integrate
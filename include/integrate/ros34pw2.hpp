@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2014-2025 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "integrate/rosenbrock.hpp"
+#include "integrate/statistics.hpp"
+#include "integrate/stateDerivative.hpp"
+
+namespace integrate
+{
+
+//! Tableau for Rang-Angermann ROS34PW2 Rosenbrock-W scheme.
+/*!
+ * Tableau for the ROS34PW2 scheme (Rang & Angermann, 2005), a four-stage Rosenbrock-W scheme of
+ * order 3 with an embedded solution of order 2, which is stiffly accurate and L-stable. Since the
+ * order conditions are satisfied for any approximation of the Jacobian, the Jacobian can be kept
+ * across steps (see RosenbrockStepper).
+ *
+ * @tparam  Real  Type for floating-point number
+ */
+template <typename Real>
+struct ROS34PW2Tableau
+{
+    //! Number of stages.
+    static const int numberOfStages = 4;
+
+    //! Order of propagated solution.
+    static const int order = 3;
+
+    //! Order of embedded solution.
+    static const int embeddedOrder = 2;
+
+    //! Diagonal coefficient.
+    static constexpr Real gamma = 4.3586652150845900e-01;
+
+    //! Stage state coefficients (strictly lower-triangular; omitted coefficients are zero).
+    static constexpr Real a[4][4] = {
+        {},
+        {8.7173304301691801e-01},
+        {8.4457060015369423e-01, -1.1299064236484185e-01},
+        {0.0, 0.0, 1.0}
+    };
+
+    //! Coupling coefficients of the Jacobian (strictly lower-triangular).
+    static constexpr Real g[4][4] = {
+        {},
+        {-8.7173304301691801e-01},
+        {-9.0338057013044082e-01, 5.4180672388095326e-02},
+        {2.4212380706095346e-01, -1.2232505839045147e+00, 5.4526025533510214e-01}
+    };
+
+    //! Weights of propagated solution.
+    static constexpr Real b[4] = {
+        2.4212380706095346e-01, -1.2232505839045147e+00, 1.5452602553351020e+00,
+        4.3586652150845900e-01
+    };
+
+    //! Weights of embedded solution.
+    static constexpr Real bHat[4] = {
+        3.7810903145819369e-01, -9.6042292212423178e-02, 5.0000000000000000e-01,
+        2.1793326075422950e-01
+    };
+};
+
+template <typename Real> constexpr Real ROS34PW2Tableau<Real>::gamma;
+template <typename Real> constexpr Real ROS34PW2Tableau<Real>::a[4][4];
+template <typename Real> constexpr Real ROS34PW2Tableau<Real>::g[4][4];
+template <typename Real> constexpr Real ROS34PW2Tableau<Real>::b[4];
+template <typename Real> constexpr Real ROS34PW2Tableau<Real>::bHat[4];
+
+//! Rang-Angermann ROS34PW2 Rosenbrock-W stepper.
+/*!
+ * Stepper that executes integration steps using the ROS34PW2 scheme, and keeps the Jacobian and
+ * the LU decomposition of the iteration matrix across steps. See RosenbrockStepper for details.
+ *
+ * @tparam  Real        Type for floating-point number
+ * @tparam  State       Type for state and state derivative (indexable)
+ * @tparam  Statistics  Statistics policy, e.g., NullStatistics or IntegrationStatistics
+ */
+template <typename Real, typename State, typename Statistics = NullStatistics>
+using ROS34PW2Stepper = RosenbrockStepper<Real, State, ROS34PW2Tableau<Real>, Statistics>;
+
+//! Execute single integration step using ROS34PW2 scheme.
+/*!
+ * Executes single numerical integration step using ROS34PW2 scheme with finite-difference
+ * Jacobian. Since a new stepper is created for each call, the Jacobian is evaluated on every
+ * step; use ROS34PW2Stepper instead to keep the Jacobian and its LU decomposition across steps.
+ *
+ * @tparam         Real                    Type for floating-point number
+ * @tparam         State                   Type for state and state derivative (indexable)
+ * @tparam         StateDerivative         Type of callable to compute state derivative, e.g.,
+ *                                         function pointer, functor, lambda or
+ *                                         StateDerivativeFunction
+ * @param[in,out]  time                    Independent variable, which is provided as input and is
+ *                                         updated with output at end of integration step
+ * @param[in,out]  state                   State, which is provided as input and is updated with
+ *                                         output at end of integration step
+ * @param[in,out]  stepSize                Step size to take for integration step
+ * @param[in]      computeStateDerivative  Function to compute state derivative for current time
+ *                                         and state
+ * @param[in]      tolerance               Local truncation error tolerance
+ * @param[in]      minimumStepSize         Minimum allowable step size for integration step
+ * @param[in]      maximumStepSize         Maximum allowable step size for integration step
+ */
+template <typename Real, typename State, typename StateDerivative>
+const void stepROS34PW2(
+    Real& time,
+    State& state,
+    Real& stepSize,
+    const StateDerivative& computeStateDerivative,
+    const Real tolerance,
+    const Real minimumStepSize,
+    const Real maximumStepSize)
+{
+    ROS34PW2Stepper<Real, State> stepper;
+    stepper.step(time,
+                 state,
+                 stepSize,
+                 computeStateDerivative,
+                 tolerance,
+                 minimumStepSize,
+                 maximumStepSize);
+};
+
+} // namespace integrate
@@ -0,0 +1,704 @@
+/*
+ * Copyright (c) 2014-2025 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "integrate/linearCombination.hpp"
+#include "integrate/luDecomposition.hpp"
+#include "integrate/stateDerivative.hpp"
+#include "integrate/statistics.hpp"
+#include "integrate/stepSizeControl.hpp"
+
+namespace integrate
+{
+namespace detail
+{
+
+//! Tag that selects the finite-difference approximation of the Jacobian.
+struct FiniteDifferenceJacobian
+{ };
+
+} // namespace detail
+
+//! Rosenbrock-W stepper for stiff systems.
+/*!
+ * Stepper that executes integration steps using a linearly implicit Rosenbrock-W scheme (Hairer &
+ * Wanner, 1996, Section IV.7). Each stage solves a linear system with the iteration matrix
+ * W = I - h gamma J, where J is an approximation of the Jacobian of the state derivative with
+ * respect to the state:
+ *
+ *      W k_i = h f(t + alpha_i h, y + sum_j a_ij k_j) + h J sum_j g_ij k_j + h^2 gamma_i df/dt
+ *
+ * and the solution is y + sum_i b_i k_i. Since no Newton iterations are needed, the stepper is
+ * stable on stiff systems at the cost of one LU decomposition per iteration matrix and one
+ * forward-backward substitution per stage. The tableau is a class with the following static
+ * members:
+ *
+ *  - numberOfStages: number of stages s
+ *  - order: order of the propagated solution
+ *  - embeddedOrder: order of the embedded solution
+ *  - gamma: diagonal coefficient of the scheme
+ *  - a[s][s]: stage state coefficients (strictly lower-triangular)
+ *  - g[s][s]: coupling coefficients of the Jacobian (strictly lower-triangular)
+ *  - b[s]: weights of the propagated solution
+ *  - bHat[s]: weights of the embedded solution
+ *
+ * For a W-method, the order of the scheme does not depend on the accuracy of J, which is the
+ * Jacobian of the system augmented with the time, i.e., it includes the time derivative df/dt.
+ * The stepper therefore keeps the Jacobian and the time derivative across steps, until a step is
+ * rejected with a Jacobian that was not evaluated at the start of the step, the Jacobian has been
+ * used for the maximum number of accepted steps, or a step does not start from the time and
+ * state at which the previous step ended. The LU decomposition of the iteration matrix is kept
+ * until the Jacobian or the step size changes; to this end, the step size is not increased if the
+ * step size controller proposes an increase by a factor smaller than 1.2.
+ *
+ * The Jacobian is either computed by a user-provided callable, i.e.,
+ * void computeJacobian(const Real time, const State& state, std::vector<Real>& jacobian), which
+ * writes the partial derivative of element i of the state derivative with respect to element j of
+ * the state in element i * n + j (row-major order) of a jacobian of size n * n, or approximated
+ * with forward differences, with n additional state derivative evaluations. In both cases, the
+ * time derivative is approximated with a forward difference, with one additional evaluation.
+ *
+ * The state must be indexable (see StateTraits).
+ *
+ * @tparam  Real        Type for floating-point number
+ * @tparam  State       Type for state and state derivative
+ * @tparam  Tableau     Tableau that defines Rosenbrock-W scheme
+ * @tparam  Statistics  Statistics policy, e.g., NullStatistics or IntegrationStatistics
+ */
+template <typename Real, typename State, typename Tableau, typename Statistics = NullStatistics>
+class RosenbrockStepper
+{
+public:
+
+    static_assert(StateTraits<State>::isIndexable,
+                  "Rosenbrock steppers require indexable states (see StateTraits)");
+
+    //! Construct stepper.
+    /*!
+     * Constructs stepper.
+     *
+     * @throws std::invalid_argument  If maximum age of the Jacobian is smaller than 1
+     *
+     * @param[in]  maximumJacobianAge  Maximum number of accepted steps for which a Jacobian is used
+     */
+    explicit RosenbrockStepper(const int maximumJacobianAge = 20)
+        : maximumJacobianAge(maximumJacobianAge),
+          isJacobianValid(false),
+          jacobianAge(0),
+          decompositionStepSize(0.0),
+          lastTime(0.0),
+          isLastStateValid(false),
+          numberOfJacobianEvaluations(0),
+          numberOfDecompositions(0)
+    {
+        if (maximumJacobianAge < 1)
+        {
+            throw std::invalid_argument("Maximum age of Jacobian must be at least 1!");
+        }
+
+        for (int stage = 0; stage < numberOfStages; ++stage)
+        {
+            errorWeights[stage] = Tableau::b[stage] - Tableau::bHat[stage];
+        }
+    }
+
+    //! Execute single integration step with adaptive step size and finite-difference Jacobian.
+    /*!
+     * Executes single numerical integration step with adaptive step size control, based on the
+     * error estimate of the embedded solution. If the maximum norm of the error estimate exceeds
+     * the tolerance times the step size, the step is rejected and repeated with a smaller step
+     * size, until it is accepted. The step size is scaled by the elementary controller, as for
+     * the adaptive step function of ExplicitRungeKuttaStepper that takes a tolerance.
+     *
+     * @throws std::runtime_error  If a rejected step has to be repeated with a step size that is
+     *                             smaller than the minimum step size
+     *
+     * @tparam         StateDerivative         Type of callable to compute state derivative, e.g.,
+     *                                         function pointer, functor, lambda or
+     *                                         StateDerivativeFunction
+     * @param[in,out]  time                    Independent variable, which is provided as input and
+     *                                         is updated with output at end of integration step
+     * @param[in,out]  state                   State, which is provided as input and is updated
+     *                                         with output at end of integration step
+     * @param[in,out]  stepSize                Step size to take for integration step, which is
+     *                                         updated with step size for next integration step
+     * @param[in]      computeStateDerivative  Function to compute state derivative for current
+     *                                         time and state
+     * @param[in]      tolerance               Local truncation error tolerance
+     * @param[in]      minimumStepSize         Minimum allowable step size for integration step
+     * @param[in]      maximumStepSize         Maximum allowable step size for integration step
+     */
+    template <typename StateDerivative>
+    void step(Real& time,
+              State& state,
+              Real& stepSize,
+              const StateDerivative& computeStateDerivative,
+              const Real tolerance,
+              const Real minimumStepSize,
+              const Real maximumStepSize)
+    {
+        step(time, state, stepSize, computeStateDerivative, detail::FiniteDifferenceJacobian(),
+             tolerance, minimumStepSize, maximumStepSize);
+    }
+
+    //! Execute single integration step with adaptive step size and given Jacobian.
+    /*!
+     * Executes single numerical integration step with adaptive step size control, using the
+     * Jacobian that is computed by the given callable. See the overload that approximates the
+     * Jacobian for details.
+     *
+     * @throws std::runtime_error  If a rejected step has to be repeated with a step size that is
+     *                             smaller than the minimum step size
+     *
+     * @tparam         StateDerivative         Type of callable to compute state derivative, e.g.,
+     *                                         function pointer, functor, lambda or
+     *                                         StateDerivativeFunction
+     * @tparam         Jacobian                Type of callable to compute Jacobian
+     * @param[in,out]  time                    Independent variable, which is provided as input and
+     *                                         is updated with output at end of integration step
+     * @param[in,out]  state                   State, which is provided as input and is updated
+     *                                         with output at end of integration step
+     * @param[in,out]  stepSize                Step size to take for integration step, which is
+     *                                         updated with step size for next integration step
+     * @param[in]      computeStateDerivative  Function to compute state derivative for current
+     *                                         time and state
+     * @param[in]      computeJacobian         Function to compute Jacobian for current time and
+     *                                         state
+     * @param[in]      tolerance               Local truncation error tolerance
+     * @param[in]      minimumStepSize         Minimum allowable step size for integration step
+     * @param[in]      maximumStepSize         Maximum allowable step size for integration step
+     */
+    template <typename StateDerivative, typename Jacobian>
+    void step(Real& time,
+              State& state,
+              Real& stepSize,
+              const StateDerivative& computeStateDerivative,
+              const Jacobian& computeJacobian,
+              const Real tolerance,
+              const Real minimumStepSize,
+              const Real maximumStepSize)
+    {
+        StepSizeController<Real> elementaryController(1.0, 0.0, 0.0, 0.84, 0.1, 4.0);
+        stepAdaptive(time, state, stepSize, computeStateDerivative, computeJacobian,
+                     detail::ErrorPerUnitStepNorm<Real>(tolerance), elementaryController,
+                     Tableau::order, minimumStepSize, maximumStepSize);
+    }
+
+    //! Execute single integration step with adaptive step size, error norm and controller.
+    /*!
+     * Executes single numerical integration step with adaptive step size control, based on the
+     * scaled error of the error estimate of the embedded solution, as computed by the given error
+     * norm, e.g., WeightedRootMeanSquareErrorNorm, and with finite-difference Jacobian. See the
+     * corresponding adaptive step function of ExplicitRungeKuttaStepper for details.
+     *
+     * @throws std::runtime_error  If a rejected step has to be repeated with a step size that is
+     *                             smaller than the minimum step size
+     *
+     * @tparam         StateDerivative         Type of callable to compute state derivative, e.g.,
+     *                                         function pointer, functor, lambda or
+     *                                         StateDerivativeFunction
+     * @tparam         ErrorNorm               Type of callable to compute scaled error, e.g.,
+     *                                         WeightedRootMeanSquareErrorNorm
+     * @param[in,out]  time                    Independent variable, which is provided as input and
+     *                                         is updated with output at end of integration step
+     * @param[in,out]  state                   State, which is provided as input and is updated
+     *                                         with output at end of integration step
+     * @param[in,out]  stepSize                Step size to take for integration step, which is
+     *                                         updated with step size for next integration step
+     * @param[in]      computeStateDerivative  Function to compute state derivative for current
+     *                                         time and state
+     * @param[in]      computeError            Function to compute scaled error of error estimate
+     * @param[in,out]  controller              Step size controller, which is updated with scaled
+     *                                         error of accepted step
+     * @param[in]      minimumStepSize         Minimum allowable step size for integration step
+     * @param[in]      maximumStepSize         Maximum allowable step size for integration step
+     */
+    template <typename StateDerivative, typename ErrorNorm>
+    void step(Real& time,
+              State& state,
+              Real& stepSize,
+              const StateDerivative& computeStateDerivative,
+              const ErrorNorm& computeError,
+              StepSizeController<Real>& controller,
+              const Real minimumStepSize,
+              const Real maximumStepSize)
+    {
+        step(time, state, stepSize, computeStateDerivative, detail::FiniteDifferenceJacobian(),
+             computeError, controller, minimumStepSize, maximumStepSize);
+    }
+
+    //! Execute single integration step with adaptive step size, given Jacobian, error norm and
+    //! controller.
+    /*!
+     * Executes single numerical integration step with adaptive step size control, using the
+     * Jacobian that is computed by the given callable, and the given error norm and controller.
+     *
+     * @throws std::runtime_error  If a rejected step has to be repeated with a step size that is
+     *                             smaller than the minimum step size
+     *
+     * @tparam         StateDerivative         Type of callable to compute state derivative, e.g.,
+     *                                         function pointer, functor, lambda or
+     *                                         StateDerivativeFunction
+     * @tparam         Jacobian                Type of callable to compute Jacobian
+     * @tparam         ErrorNorm               Type of callable to compute scaled error, e.g.,
+     *                                         WeightedRootMeanSquareErrorNorm
+     * @param[in,out]  time                    Independent variable, which is provided as input and
+     *                                         is updated with output at end of integration step
+     * @param[in,out]  state                   State, which is provided as input and is updated
+     *                                         with output at end of integration step
+     * @param[in,out]  stepSize                Step size to take for integration step, which is
+     *                                         updated with step size for next integration step
+     * @param[in]      computeStateDerivative  Function to compute state derivative for current
+     *                                         time and state
+     * @param[in]      computeJacobian         Function to compute Jacobian for current time and
+     *                                         state
+     * @param[in]      computeError            Function to compute scaled error of error estimate
+     * @param[in,out]  controller              Step size controller, which is updated with scaled
+     *                                         error of accepted step
+     * @param[in]      minimumStepSize         Minimum allowable step size for integration step
+     * @param[in]      maximumStepSize         Maximum allowable step size for integration step
+     */
+    template <typename StateDerivative, typename Jacobian, typename ErrorNorm>
+    void step(Real& time,
+              State& state,
+              Real& stepSize,
+              const StateDerivative& computeStateDerivative,
+              const Jacobian& computeJacobian,
+              const ErrorNorm& computeError,
+              StepSizeController<Real>& controller,
+              const Real minimumStepSize,
+              const Real maximumStepSize)
+    {
+        stepAdaptive(time, state, stepSize, computeStateDerivative, computeJacobian, computeError,
+                     controller, Tableau::embeddedOrder + 1, minimumStepSize, maximumStepSize);
+    }
+
+    //! Reset stepper.
+    /*!
+     * Discards the Jacobian and the LU decomposition, so that they are evaluated again at the
+     * next step, e.g., because the dynamical model has changed between steps.
+     */
+    void reset()
+    {
+        isJacobianValid = false;
+        decompositionStepSize = 0.0;
+        isLastStateValid = false;
+    }
+
+    //! Get number of Jacobian evaluations (including finite-difference approximations).
+    long getNumberOfJacobianEvaluations() const { return numberOfJacobianEvaluations; }
+
+    //! Get number of LU decompositions of the iteration matrix.
+    long getNumberOfDecompositions() const { return numberOfDecompositions; }
+
+    //! Get statistics collected by stepper.
+    const Statistics& getStatistics() const { return statistics; }
+
+    //! Get statistics collected by stepper, e.g., to reset them.
+    Statistics& getStatistics() { return statistics; }
+
+protected:
+private:
+
+    //! Number of stages.
+    static const int numberOfStages = Tableau::numberOfStages;
+
+    //! Index of stage state in workspace.
+    static const int stageStateIndex = numberOfStages;
+
+    //! Index of stage state derivative in workspace.
+    static const int stageStateDerivativeIndex = numberOfStages + 1;
+
+    //! Index of state derivative at start of step in workspace.
+    static const int initialStateDerivativeIndex = numberOfStages + 2;
+
+    //! Index of time derivative of state derivative in workspace.
+    static const int timeDerivativeIndex = numberOfStages + 3;
+
+    //! Index of propagated state in workspace, which is computed before a step is accepted.
+    static const int nextStateIndex = numberOfStages + 4;
+
+    //! Index of error estimate in workspace.
+    static const int errorEstimateIndex = numberOfStages + 5;
+
+    //! Index of state at end of last accepted step in workspace.
+    static const int lastStateIndex = numberOfStages + 6;
+
+    //! Number of states in workspace.
+    static const int workspaceSize = numberOfStages + 7;
+
+    //! Minimum factor by which the step size is increased, so that the LU decomposition is kept.
+    static constexpr Real minimumStepSizeIncrease = 1.2;
+
+    //! Execute single integration step with adaptive step size control.
+    template <typename StateDerivative, typename Jacobian, typename ErrorNorm>
+    void stepAdaptive(Real& time,
+                      State& state,
+                      Real& stepSize,
+                      const StateDerivative& computeStateDerivative,
+                      const Jacobian& computeJacobian,
+                      const ErrorNorm& computeError,
+                      StepSizeController<Real>& controller,
+                      const int errorEstimateOrder,
+                      const Real minimumStepSize,
+                      const Real maximumStepSize)
+    {
+        statistics.startStep();
+        const detail::RecordedStateDerivative<Real, State, StateDerivative, Statistics>
+            recordedStateDerivative(computeStateDerivative, statistics);
+
+        const int size = static_cast<int>(state.size());
+        if (workspace.empty() || static_cast<int>(workspace[0].size()) != size)
+        {
+            workspace.assign(workspaceSize, state);
+            jacobian.assign(static_cast<std::size_t>(size) * size, 0.0);
+            iterationMatrix.assign(static_cast<std::size_t>(size) * size, 0.0);
+            pivots.assign(size, 0);
+            solutionStorage.assign(size, 0.0);
+            reset();
+        }
+
+        if (!isContinuation(time, state))
+        {
+            isJacobianValid = false;
+        }
+
+        // The state derivative at the start of the step is the first stage state derivative of
+        // every attempt, and is used to approximate the Jacobian.
+        recordedStateDerivative(time, state, workspace[initialStateDerivativeIndex]);
+
+        while (true)
+        {
+            if (!isJacobianValid)
+            {
+                evaluateJacobian(time, state, recordedStateDerivative, computeJacobian);
+            }
+
+            bool isAccepted = false;
+            Real stepSizeFactor = 0.5;
+            if (stepSize == decompositionStepSize || decomposeIterationMatrix(stepSize))
+            {
+                computeStages(time, state, stepSize, recordedStateDerivative);
+
+                State& nextState = workspace[nextStateIndex];
+                State& errorEstimate = workspace[errorEstimateIndex];
+                computeSolution(nextState, &state, Tableau::b);
+                computeSolution(errorEstimate, nullptr, errorWeights);
+
+                const Real error = computeError(errorEstimate, state, nextState, stepSize);
+                isAccepted = error <= 1.0;
+                stepSizeFactor
+                    = controller.computeStepSizeFactor(error, errorEstimateOrder, isAccepted);
+            }
+
+            if (isAccepted)
+            {
+                statistics.recordAcceptedStep(stepSize);
+                time += stepSize;
+                using std::swap;
+                swap(state, workspace[nextStateIndex]);
+                workspace[lastStateIndex] = state;
+                lastTime = time;
+                isLastStateValid = true;
+                if (++jacobianAge >= maximumJacobianAge)
+                {
+                    isJacobianValid = false;
+                }
+
+                // Keep step size, and thus the LU decomposition, for small increases.
+                if (!isJacobianValid
+                    || stepSizeFactor < 1.0
+                    || stepSizeFactor >= minimumStepSizeIncrease)
+                {
+                    stepSize = stepSizeFactor * stepSize;
+                }
+                if (stepSize > maximumStepSize)
+                {
+                    stepSize = maximumStepSize;
+                }
+                else if (stepSize < minimumStepSize)
+                {
+                    stepSize = minimumStepSize;
+                }
+                statistics.stopStep();
+                return;
+            }
+
+            // A rejected step may be caused by an outdated Jacobian, which is then evaluated
+            // again at the start of the step.
+            statistics.recordRejectedStep(stepSize);
+            if (jacobianAge > 0)
+            {
+                isJacobianValid = false;
+            }
+            stepSize = stepSizeFactor * stepSize;
+            if (stepSize > maximumStepSize)
+            {
+                stepSize = maximumStepSize;
+            }
+            else if (stepSize < minimumStepSize)
+            {
+                statistics.stopStep();
+                throw std::runtime_error("Minimum step size exceeded!");
+            }
+        }
+    }
+
+    //! Check if step starts from time and state at which the previous step ended.
+    bool isContinuation(const Real time, const State& state) const
+    {
+        return isLastStateValid
+               && time == lastTime
+               && detail::isEqualState(state, workspace[lastStateIndex], std::true_type());
+    }
+
+    //! Evaluate Jacobian using given callable, and approximate time derivative.
+    template <typename RecordedStateDerivative, typename Jacobian>
+    void evaluateJacobian(const Real time,
+                          const State& state,
+                          const RecordedStateDerivative& recordedStateDerivative,
+                          const Jacobian& computeJacobian)
+    {
+        computeJacobian(time, state, jacobian);
+        approximateTimeDerivative(time, state, recordedStateDerivative);
+        updateJacobianStatus();
+    }
+
+    //! Approximate Jacobian and time derivative with forward differences.
+    /*!
+     * Approximates column j of the Jacobian with a forward difference, with increment
+     * sqrt(epsilon * max(1e-5, |x_j|)) (Hairer & Wanner, 1996, Section IV.8).
+     */
+    template <typename RecordedStateDerivative>
+    void evaluateJacobian(const Real time,
+                          const State& state,
+                          const RecordedStateDerivative& recordedStateDerivative,
+                          const detail::FiniteDifferenceJacobian&)
+    {
+        const int size = static_cast<int>(state.size());
+        const State& stateDerivative = workspace[initialStateDerivativeIndex];
+        State& perturbedState = workspace[stageStateIndex];
+        State& perturbedStateDerivative = workspace[stageStateDerivativeIndex];
+        perturbedState = state;
+        for (int j = 0; j < size; ++j)
+        {
+            const Real element = state[j];
+            const Real increment = computeIncrement(element);
+            perturbedState[j] = element + increment;
+            recordedStateDerivative(time, perturbedState, perturbedStateDerivative);
+            perturbedState[j] = element;
+
+            const Real inverseIncrement = 1.0 / ((element + increment) - element);
+            for (int i = 0; i < size; ++i)
+            {
+                jacobian[i * size + j]
+                    = (perturbedStateDerivative[i] - stateDerivative[i]) * inverseIncrement;
+            }
+        }
+
+        approximateTimeDerivative(time, state, recordedStateDerivative);
+        updateJacobianStatus();
+    }
+
+    //! Approximate time derivative of state derivative with forward difference.
+    template <typename RecordedStateDerivative>
+    void approximateTimeDerivative(const Real time,
+                                   const State& state,
+                                   const RecordedStateDerivative& recordedStateDerivative)
+    {
+        const Real increment = computeIncrement(time);
+        State& timeDerivative = workspace[timeDerivativeIndex];
+        recordedStateDerivative(time + increment, state, timeDerivative);
+        computeWeightedSum(timeDerivative, 1.0 / ((time + increment) - time),
+                           1.0, timeDerivative, -1.0, workspace[initialStateDerivativeIndex]);
+    }
+
+    //! Mark Jacobian as valid and LU decomposition as outdated after Jacobian evaluation.
+    void updateJacobianStatus()
+    {
+        isJacobianValid = true;
+        jacobianAge = 0;
+        decompositionStepSize = 0.0;
+        ++numberOfJacobianEvaluations;
+    }
+
+    //! Compute increment of forward difference for given element.
+    static Real computeIncrement(const Real element)
+    {
+        return std::sqrt(std::numeric_limits<Real>::epsilon()
+                         * std::max(static_cast<Real>(1.0e-5), std::fabs(element)));
+    }
+
+    //! Compute LU decomposition of iteration matrix I - h gamma J for given step size.
+    /*!
+     * Computes LU decomposition of iteration matrix. If the iteration matrix is singular, false
+     * is returned, and the step is repeated with half the step size.
+     */
+    bool decomposeIterationMatrix(const Real stepSize)
+    {
+        const int size = static_cast<int>(pivots.size());
+        const Real scale = -stepSize * Tableau::gamma;
+        for (int i = 0; i < size * size; ++i)
+        {
+            iterationMatrix[i] = scale * jacobian[i];
+        }
+        for (int i = 0; i < size; ++i)
+        {
+            iterationMatrix[i * size + i] += 1.0;
+        }
+
+        ++numberOfDecompositions;
+        if (!detail::computeLUDecomposition(iterationMatrix.data(), size, pivots.data()))
+        {
+            decompositionStepSize = 0.0;
+            return false;
+        }
+        decompositionStepSize = stepSize;
+        return true;
+    }
+
+    //! Compute stages k_i by solving linear systems with the iteration matrix.
+    template <typename RecordedStateDerivative>
+    void computeStages(const Real time,
+                       const State& state,
+                       const Real stepSize,
+                       const RecordedStateDerivative& recordedStateDerivative)
+    {
+        const int size = static_cast<int>(pivots.size());
+        State& stageState = workspace[stageStateIndex];
+        State& stageStateDerivative = workspace[stageStateDerivativeIndex];
+        const State& timeDerivative = workspace[timeDerivativeIndex];
+
+        Real coefficients[numberOfStages];
+        const State* terms[numberOfStages];
+        for (int stage = 0; stage < numberOfStages; ++stage)
+        {
+            // Evaluate state derivative at stage state.
+            Real stageTime = time;
+            for (int j = 0; j < stage; ++j)
+            {
+                coefficients[j] = Tableau::a[stage][j];
+                terms[j] = &workspace[j];
+                stageTime += Tableau::a[stage][j] * stepSize;
+            }
+            const State* stageStateDerivativePointer = &workspace[initialStateDerivativeIndex];
+            if (stage > 0)
+            {
+                detail::computeLinearCombination<Real, State>(
+                    stageState, &state, 1.0, coefficients, terms,
+                    static_cast<std::size_t>(stage), typename detail::StateTag<State>::type());
+                recordedStateDerivative(stageTime, stageState, stageStateDerivative);
+                stageStateDerivativePointer = &stageStateDerivative;
+            }
+
+            // Compute coupling term sum_j g_ij k_j, and gamma_i.
+            Real stageGamma = Tableau::gamma;
+            for (int j = 0; j < stage; ++j)
+            {
+                coefficients[j] = Tableau::g[stage][j];
+                stageGamma += Tableau::g[stage][j];
+            }
+            if (stage > 0)
+            {
+                detail::computeLinearCombination<Real, State>(
+                    stageState, nullptr, 1.0, coefficients, terms,
+                    static_cast<std::size_t>(stage), typename detail::StateTag<State>::type());
+            }
+
+            // Assemble right-hand side h f + h J sum_j g_ij k_j + h^2 gamma_i df/dt, and solve.
+            State& increment = workspace[stage];
+            const State& stageDerivative = *stageStateDerivativePointer;
+            const Real timeDerivativeScale = stepSize * stepSize * stageGamma;
+            for (int i = 0; i < size; ++i)
+            {
+                Real coupling = 0.0;
+                if (stage > 0)
+                {
+                    const Real* const row = jacobian.data() + i * size;
+                    for (int j = 0; j < size; ++j)
+                    {
+                        coupling += row[j] * stageState[j];
+                    }
+                }
+                increment[i] = stepSize * (stageDerivative[i] + coupling)
+                             + timeDerivativeScale * timeDerivative[i];
+            }
+            detail::solveLUSystem(iterationMatrix.data(), size, pivots.data(), increment,
+                                  solutionStorage.data());
+        }
+    }
+
+    //! Compute weighted sum of stages, added to given base state (if any).
+    void computeSolution(State& result, const State* const base, const Real* const weights)
+    {
+        Real coefficients[numberOfStages];
+        const State* terms[numberOfStages];
+        for (int stage = 0; stage < numberOfStages; ++stage)
+        {
+            coefficients[stage] = weights[stage];
+            terms[stage] = &workspace[stage];
+        }
+        detail::computeLinearCombination<Real, State>(
+            result, base, 1.0, coefficients, terms, static_cast<std::size_t>(numberOfStages),
+            typename detail::StateTag<State>::type());
+    }
+
+    //! Maximum number of accepted steps for which a Jacobian is used.
+    int maximumJacobianAge;
+
+    //! Flag that indicates if Jacobian can be used for next attempt.
+    bool isJacobianValid;
+
+    //! Number of accepted steps for which current Jacobian has been used.
+    int jacobianAge;
+
+    //! Step size for which LU decomposition of iteration matrix is valid (zero if invalid).
+    Real decompositionStepSize;
+
+    //! Time at end of last accepted step.
+    Real lastTime;
+
+    //! Flag that indicates if state at end of last accepted step is kept.
+    bool isLastStateValid;
+
+    //! Number of Jacobian evaluations.
+    long numberOfJacobianEvaluations;
+
+    //! Number of LU decompositions.
+    long numberOfDecompositions;
+
+    //! Weights of error estimate, i.e., difference between propagated and embedded weights.
+    Real errorWeights[numberOfStages];
+
+    //! Storage for stages and intermediate states.
+    std::vector<State> workspace;
+
+    //! Jacobian, in row-major order.
+    std::vector<Real> jacobian;
+
+    //! LU decomposition of iteration matrix, in row-major order.
+    std::vector<Real> iterationMatrix;
+
+    //! Row permutation of LU decomposition.
+    std::vector<int> pivots;
+
+    //! Storage for solution of linear system.
+    std::vector<Real> solutionStorage;
+
+    //! Statistics collected by stepper.
+    Statistics statistics;
+};
+
+} // namespace integrate
@@ -0,0 +1,481 @@
+/*
+ * Copyright (c) 2014-2025 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include "integrate/explicitRungeKutta.hpp"
+#include "integrate/linearCombination.hpp"
+#include "integrate/stateDerivative.hpp"
+#include "integrate/statistics.hpp"
+#include "integrate/stepSizeControl.hpp"
+
+namespace integrate
+{
+namespace detail
+{
+
+//! Coefficients to compute propagated velocity from stage accelerations.
+template <typename Real, typename Tableau>
+struct VelocitySolutionCoefficients
+{
+    //! Number of stage accelerations that are combined.
+    static const int numberOfTerms = Tableau::numberOfStages;
+
+    //! Get coefficient of given stage acceleration.
+    static constexpr Real get(const int term) { return Tableau::bPrime[term]; }
+};
+
+//! Coefficients to compute error estimate of velocity from stage accelerations.
+template <typename Real, typename Tableau>
+struct VelocityErrorEstimateCoefficients
+{
+    //! Number of stage accelerations that are combined.
+    static const int numberOfTerms = Tableau::numberOfStages;
+
+    //! Get coefficient of given stage acceleration.
+    static constexpr Real get(const int term)
+    {
+        return Tableau::bPrime[term] - Tableau::bHatPrime[term];
+    }
+};
+
+} // namespace detail
+
+//! Runge-Kutta-Nystrom stepper.
+/*!
+ * Stepper that executes integration steps using an explicit Runge-Kutta-Nystrom scheme for
+ * second-order systems of the form
+ *
+ * \f[
+ *      xddot = a(t,x)
+ * \f]
+ *
+ * where the position x and the velocity v = xdot are integrated as separate states of the same
+ * type (Hairer et al., 1993, Section II.14). Compared to an explicit Runge-Kutta scheme applied to
+ * the equivalent first-order system with a doubled state, no stages are spent on the trivial
+ * velocity half of the state derivative, so that fewer acceleration evaluations are required for
+ * the same accuracy. The scheme is defined by a tableau with the following static members:
+ *
+ *  - numberOfStages: number of stages s
+ *  - order: order of the propagated solution
+ *  - isEmbedded: flag that indicates if the tableau contains an embedded solution
+ *  - embeddedOrder: order of the embedded solution (optional, defaults to order - 1)
+ *  - isFirstSameAsLast: flag that indicates if the last stage is evaluated at the end of the step
+ *    with the propagated position (optional, defaults to false)
+ *  - c[s]: nodes
+ *  - a[s][s]: Runge-Kutta-Nystrom matrix for the stage positions (strictly lower-triangular)
+ *  - b[s]: weights of the propagated position
+ *  - bPrime[s]: weights of the propagated velocity
+ *  - bHat[s], bHatPrime[s]: weights of the embedded position and velocity (only required for
+ *    embedded tableaus)
+ *
+ * The stage positions, propagated position and propagated velocity are
+ *
+ *     X_i = x + c_i h v + h^2 sum_j a_ij k_j,   k_i = a(t + c_i h, X_i),
+ *     xNext = x + h v + h^2 sum_i b_i k_i,      vNext = v + h sum_i bPrime_i k_i.
+ *
+ * As for ExplicitRungeKuttaStepper, all coefficients are constexpr, terms with zero coefficients
+ * are skipped at compile-time, the storage for the stages is reused across steps, and the last
+ * stage acceleration of a FSAL tableau is kept and reused as the first stage of the next step.
+ *
+ * The adaptive step functions take the same tolerance, error norm and step size controller as
+ * the adaptive step functions of ExplicitRungeKuttaStepper. The error norm is applied separately
+ * to the error estimates of the position and the velocity, and the larger of both scaled errors
+ * controls the step size.
+ *
+ * The acceleration is computed by a callable of either form accepted by evaluateStateDerivative(),
+ * i.e., State computeAcceleration(const Real time, const State& position), or
+ * void computeAcceleration(const Real time, const State& position, State& acceleration).
+ *
+ * @tparam  Real        Type for floating-point number
+ * @tparam  State       Type for position, velocity and acceleration
+ * @tparam  Tableau     Tableau that defines Runge-Kutta-Nystrom scheme
+ * @tparam  Statistics  Statistics policy, e.g., NullStatistics or IntegrationStatistics
+ */
+template <typename Real, typename State, typename Tableau, typename Statistics = NullStatistics>
+class RungeKuttaNystromStepper
+{
+public:
+
+    //! Construct stepper.
+    RungeKuttaNystromStepper()
+        : isFirstStageAccelerationValid(false),
+          firstStageTime(0.0)
+    { }
+
+    //! Execute single integration step with fixed step size.
+    /*!
+     * Executes single numerical integration step with given step size. For embedded tableaus,
+     * the error estimate is not computed.
+     *
+     * @tparam         Acceleration         Type of callable to compute acceleration, e.g.,
+     *                                      function pointer, functor, lambda or
+     *                                      StateDerivativeFunction
+     * @param[in,out]  time                 Independent variable, which is provided as input and
+     *                                      is updated with output at end of integration step
+     * @param[in,out]  position             Position, which is provided as input and is updated
+     *                                      with output at end of integration step
+     * @param[in,out]  velocity             Velocity, which is provided as input and is updated
+     *                                      with output at end of integration step
+     * @param[in]      stepSize             Step size to take for integration step
+     * @param[in]      computeAcceleration  Function to compute acceleration for current time and
+     *                                      position
+     */
+    template <typename Acceleration>
+    void step(Real& time,
+              State& position,
+              State& velocity,
+              const Real stepSize,
+              const Acceleration& computeAcceleration)
+    {
+        statistics.startStep();
+        computeFirstStage(time, position, computeAcceleration);
+        computeStage(time, position, velocity, stepSize, computeAcceleration,
+                     std::integral_constant<int, 1>());
+
+        time += stepSize;
+        detail::computeTableauCombination<
+            Real, State, detail::VelocitySolutionCoefficients<Real, Tableau>, true>(
+                workspace[nextVelocityIndex], velocity, stepSize, workspace.data());
+        computeLinearCombination(position, position, stepSize, 1.0, velocity);
+        detail::computeTableauCombination<
+            Real, State, detail::SolutionCoefficients<Real, Tableau>, true>(
+                position, position, stepSize * stepSize, workspace.data());
+        using std::swap;
+        swap(velocity, workspace[nextVelocityIndex]);
+        keepLastStageAcceleration(time, position,
+                                  std::integral_constant<bool, isFirstSameAsLast>());
+
+        statistics.recordAcceptedStep(stepSize);
+        statistics.stopStep();
+    }
+
+    //! Execute single integration step with adaptive step size.
+    /*!
+     * Executes single numerical integration step with adaptive step size control, based on the
+     * error estimates of the embedded position and velocity. If the maximum norm of either error
+     * estimate exceeds the tolerance times the step size, the step is rejected and repeated with
+     * a smaller step size, until it is accepted. The step size is scaled by the elementary
+     * controller, as for the adaptive step function of ExplicitRungeKuttaStepper that takes a
+     * tolerance.
+     *
+     * @throws std::runtime_error  If a rejected step has to be repeated with a step size that is
+     *                             smaller than the minimum step size
+     *
+     * @tparam         Acceleration         Type of callable to compute acceleration, e.g.,
+     *                                      function pointer, functor, lambda or
+     *                                      StateDerivativeFunction
+     * @param[in,out]  time                 Independent variable, which is provided as input and
+     *                                      is updated with output at end of integration step
+     * @param[in,out]  position             Position, which is provided as input and is updated
+     *                                      with output at end of integration step
+     * @param[in,out]  velocity             Velocity, which is provided as input and is updated
+     *                                      with output at end of integration step
+     * @param[in,out]  stepSize             Step size to take for integration step, which is
+     *                                      updated with step size for next integration step
+     * @param[in]      computeAcceleration  Function to compute acceleration for current time and
+     *                                      position
+     * @param[in]      tolerance            Local truncation error tolerance
+     * @param[in]      minimumStepSize      Minimum allowable step size for integration step
+     * @param[in]      maximumStepSize      Maximum allowable step size for integration step
+     */
+    template <typename Acceleration>
+    void step(Real& time,
+              State& position,
+              State& velocity,
+              Real& stepSize,
+              const Acceleration& computeAcceleration,
+              const Real tolerance,
+              const Real minimumStepSize,
+              const Real maximumStepSize)
+    {
+        StepSizeController<Real> elementaryController(1.0, 0.0, 0.0, 0.84, 0.1, 4.0);
+        stepAdaptive(time, position, velocity, stepSize, computeAcceleration,
+                     detail::ErrorPerUnitStepNorm<Real>(tolerance), elementaryController,
+                     Tableau::order, minimumStepSize, maximumStepSize);
+    }
+
+    //! Execute single integration step with adaptive step size, error norm and controller.
+    /*!
+     * Executes single numerical integration step with adaptive step size control, based on the
+     * larger of the scaled errors of the error estimates of the embedded position and velocity,
+     * as computed by the given error norm, e.g., WeightedRootMeanSquareErrorNorm. See the
+     * corresponding adaptive step function of ExplicitRungeKuttaStepper for details.
+     *
+     * @throws std::runtime_error  If a rejected step has to be repeated with a step size that is
+     *                             smaller than the minimum step size
+     *
+     * @tparam         Acceleration         Type of callable to compute acceleration, e.g.,
+     *                                      function pointer, functor, lambda or
+     *                                      StateDerivativeFunction
+     * @tparam         ErrorNorm            Type of callable to compute scaled error, e.g.,
+     *                                      WeightedRootMeanSquareErrorNorm
+     * @param[in,out]  time                 Independent variable, which is provided as input and
+     *                                      is updated with output at end of integration step
+     * @param[in,out]  position             Position, which is provided as input and is updated
+     *                                      with output at end of integration step
+     * @param[in,out]  velocity             Velocity, which is provided as input and is updated
+     *                                      with output at end of integration step
+     * @param[in,out]  stepSize             Step size to take for integration step, which is
+     *                                      updated with step size for next integration step
+     * @param[in]      computeAcceleration  Function to compute acceleration for current time and
+     *                                      position
+     * @param[in]      computeError         Function to compute scaled error of error estimate
+     * @param[in,out]  controller           Step size controller, which is updated with scaled
+     *                                      error of accepted step
+     * @param[in]      minimumStepSize      Minimum allowable step size for integration step
+     * @param[in]      maximumStepSize      Maximum allowable step size for integration step
+     */
+    template <typename Acceleration, typename ErrorNorm>
+    void step(Real& time,
+              State& position,
+              State& velocity,
+              Real& stepSize,
+              const Acceleration& computeAcceleration,
+              const ErrorNorm& computeError,
+              StepSizeController<Real>& controller,
+              const Real minimumStepSize,
+              const Real maximumStepSize)
+    {
+        stepAdaptive(time, position, velocity, stepSize, computeAcceleration, computeError,
+                     controller, detail::ErrorEstimateOrder<Tableau>::value, minimumStepSize,
+                     maximumStepSize);
+    }
+
+    //! Reset stepper.
+    /*!
+     * Discards the acceleration that is kept for reuse in the next step, e.g., because the
+     * dynamical model has changed between steps.
+     */
+    void reset()
+    {
+        isFirstStageAccelerationValid = false;
+    }
+
+    //! Get statistics collected by stepper.
+    const Statistics& getStatistics() const { return statistics; }
+
+    //! Get statistics collected by stepper, e.g., to reset them.
+    Statistics& getStatistics() { return statistics; }
+
+protected:
+private:
+
+    //! Flag that indicates if tableau has First-Same-As-Last property.
+    static const bool isFirstSameAsLast = detail::IsFirstSameAsLast<Tableau>::value;
+
+    //! Index of stage position in workspace, which is reused for error estimate of position.
+    static const int stagePositionIndex = Tableau::numberOfStages;
+
+    //! Index of error estimate of velocity in workspace.
+    static const int velocityErrorEstimateIndex = Tableau::numberOfStages + 1;
+
+    //! Index of propagated position in workspace, which is computed before a step is accepted.
+    static const int nextPositionIndex = Tableau::numberOfStages + 2;
+
+    //! Index of propagated velocity in workspace, which is computed before a step is accepted.
+    static const int nextVelocityIndex = Tableau::numberOfStages + 3;
+
+    //! Index of position in workspace at which the kept first stage acceleration was evaluated.
+    static const int firstStagePositionIndex = Tableau::numberOfStages + 4;
+
+    //! Execute single integration step with adaptive step size control.
+    template <typename Acceleration, typename ErrorNorm>
+    void stepAdaptive(Real& time,
+                      State& position,
+                      State& velocity,
+                      Real& stepSize,
+                      const Acceleration& computeAcceleration,
+                      const ErrorNorm& computeError,
+                      StepSizeController<Real>& controller,
+                      const int errorEstimateOrder,
+                      const Real minimumStepSize,
+                      const Real maximumStepSize)
+    {
+        static_assert(Tableau::isEmbedded,
+                      "Adaptive step size control requires tableau with embedded solution");
+
+        statistics.startStep();
+
+        // The first stage does not depend on the step size, so it is evaluated once and reused
+        // for all attempts of this step.
+        computeFirstStage(time, position, computeAcceleration);
+
+        while (true)
+        {
+            computeStage(time, position, velocity, stepSize, computeAcceleration,
+                         std::integral_constant<int, 1>());
+
+            // Reuse stage position as storage for the error estimate of the position. The
+            // propagated solution is computed before the step is accepted, since relative
+            // tolerances depend on it.
+            State& positionErrorEstimate = workspace[stagePositionIndex];
+            State& velocityErrorEstimate = workspace[velocityErrorEstimateIndex];
+            State& nextPosition = workspace[nextPositionIndex];
+            State& nextVelocity = workspace[nextVelocityIndex];
+            const Real stepSizeSquared = stepSize * stepSize;
+            detail::computeTableauCombination<
+                Real, State, detail::ErrorEstimateCoefficients<Real, Tableau>, false>(
+                    positionErrorEstimate, position, stepSizeSquared, workspace.data());
+            detail::computeTableauCombination<
+                Real, State, detail::VelocityErrorEstimateCoefficients<Real, Tableau>, false>(
+                    velocityErrorEstimate, velocity, stepSize, workspace.data());
+            computeLinearCombination(nextPosition, position, stepSize, 1.0, velocity);
+            detail::computeTableauCombination<
+                Real, State, detail::SolutionCoefficients<Real, Tableau>, true>(
+                    nextPosition, nextPosition, stepSizeSquared, workspace.data());
+            detail::computeTableauCombination<
+                Real, State, detail::VelocitySolutionCoefficients<Real, Tableau>, true>(
+                    nextVelocity, velocity, stepSize, workspace.data());
+
+            const Real error = std::max(
+                computeError(positionErrorEstimate, position, nextPosition, stepSize),
+                computeError(velocityErrorEstimate, velocity, nextVelocity, stepSize));
+            const bool isAccepted = error <= 1.0;
+            const Real stepSizeFactor
+                = controller.computeStepSizeFactor(error, errorEstimateOrder, isAccepted);
+
+            if (isAccepted)
+            {
+                statistics.recordAcceptedStep(stepSize);
+                time += stepSize;
+                using std::swap;
+                swap(position, nextPosition);
+                swap(velocity, nextVelocity);
+                keepLastStageAcceleration(time, position,
+                                          std::integral_constant<bool, isFirstSameAsLast>());
+
+                stepSize = stepSizeFactor * stepSize;
+                if (stepSize > maximumStepSize)
+                {
+                    stepSize = maximumStepSize;
+                }
+                else if (stepSize < minimumStepSize)
+                {
+                    stepSize = minimumStepSize;
+                }
+                statistics.stopStep();
+                return;
+            }
+
+            statistics.recordRejectedStep(stepSize);
+            stepSize = stepSizeFactor * stepSize;
+            if (stepSize > maximumStepSize)
+            {
+                stepSize = maximumStepSize;
+            }
+            else if (stepSize < minimumStepSize)
+            {
+                statistics.stopStep();
+                throw std::runtime_error("Minimum step size exceeded!");
+            }
+        }
+    }
+
+    //! Compute first stage acceleration, unless it was kept from previous step.
+    template <typename Acceleration>
+    void computeFirstStage(const Real time,
+                           const State& position,
+                           const Acceleration& computeAcceleration)
+    {
+        // The workspace is set up again if the number of elements of the position has changed,
+        // since accelerations may be written in-place.
+        if (workspace.empty()
+            || !detail::hasSameSize(workspace[0], position,
+                                    typename detail::StateTag<State>::type()))
+        {
+            workspace.assign(Tableau::numberOfStages + (isFirstSameAsLast ? 5 : 4), position);
+            isFirstStageAccelerationValid = false;
+        }
+
+        if (!(isFirstStageAccelerationValid
+              && time == firstStageTime
+              && detail::isEqualState(
+                  position, workspace[firstStagePositionIndex],
+                  std::integral_constant<bool, StateTraits<State>::isIndexable>())))
+        {
+            evaluateStageAcceleration(computeAcceleration, time, position, workspace[0]);
+        }
+        isFirstStageAccelerationValid = false;
+    }
+
+    //! Compute stage position and stage acceleration of given stage and all subsequent stages.
+    template <typename Acceleration, int Stage>
+    void computeStage(const Real time,
+                      const State& position,
+                      const State& velocity,
+                      const Real stepSize,
+                      const Acceleration& computeAcceleration,
+                      std::integral_constant<int, Stage>)
+    {
+        State& stagePosition = workspace[stagePositionIndex];
+        computeLinearCombination(stagePosition, position, stepSize, Tableau::c[Stage], velocity);
+        detail::computeTableauCombination<
+            Real, State, detail::StageCoefficients<Real, Tableau, Stage>, true>(
+                stagePosition, stagePosition, stepSize * stepSize, workspace.data());
+        evaluateStageAcceleration(computeAcceleration,
+                                  time + Tableau::c[Stage] * stepSize,
+                                  stagePosition,
+                                  workspace[Stage]);
+        computeStage(time, position, velocity, stepSize, computeAcceleration,
+                     std::integral_constant<int, Stage + 1>());
+    }
+
+    //! Compute stage position and stage acceleration (recursion end).
+    template <typename Acceleration>
+    void computeStage(const Real,
+                      const State&,
+                      const State&,
+                      const Real,
+                      const Acceleration&,
+                      std::integral_constant<int, Tableau::numberOfStages>)
+    { }
+
+    //! Evaluate stage acceleration and record evaluation in statistics.
+    template <typename Acceleration>
+    void evaluateStageAcceleration(const Acceleration& computeAcceleration,
+                                   const Real time,
+                                   const State& position,
+                                   State& acceleration)
+    {
+        statistics.startStateDerivativeEvaluation();
+        evaluateStateDerivative(computeAcceleration, time, position, acceleration);
+        statistics.stopStateDerivativeEvaluation();
+    }
+
+    //! Keep last stage acceleration for reuse as first stage of next step.
+    void keepLastStageAcceleration(const Real time, const State& position, std::true_type)
+    {
+        using std::swap;
+        swap(workspace[0], workspace[Tableau::numberOfStages - 1]);
+        workspace[firstStagePositionIndex] = position;
+        firstStageTime = time;
+        isFirstStageAccelerationValid = true;
+    }
+
+    //! Keep last stage acceleration (not applicable if tableau is not FSAL).
+    void keepLastStageAcceleration(const Real, const State&, std::false_type)
+    { }
+
+    //! Storage for stages, error estimates, propagated solution and FSAL position.
+    std::vector<State> workspace;
+
+    //! Flag that indicates if first stage acceleration of next step is available.
+    bool isFirstStageAccelerationValid;
+
+    //! Time at which first stage acceleration of next step was evaluated.
+    Real firstStageTime;
+
+    //! Statistics collected by stepper.
+    Statistics statistics;
+};
+
+} // namespace integrate
@@ -0,0 +1,433 @@
+/*
+ * Copyright (c) 2014-2025 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <initializer_list>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace integrate
+{
+
+//! State with fixed number of elements.
+/*!
+ * State with a number of elements that is known at compile-time, which stores its elements in a
+ * std::array, i.e., without heap allocation. The size is a constexpr static member function, so
+ * that the element-wise kernels of the integrators (see StateTraits) have a constant trip count
+ * after inlining, which the compiler can unroll completely. For small systems, e.g., the 6
+ * elements of an orbit, the states of a step can thus be kept entirely in registers.
+ *
+ * The state is contiguous and indexable (see StateTraits), and provides the State operators, so
+ * it can be used with all integrators.
+ *
+ * @tparam  Real  Type for floating-point number
+ * @tparam  N     Number of elements
+ */
+template <typename Real, std::size_t N>
+class FixedState
+{
+public:
+
+    //! Construct state with all elements set to zero.
+    FixedState()
+        : elements()
+    { }
+
+    //! Construct state from list of elements.
+    /*!
+     * Constructs state from list of elements, e.g., FixedState<double, 2>({1.0, 0.0}).
+     *
+     * @throws std::invalid_argument  If number of values differs from number of elements
+     *
+     * @param[in]  values  Values of elements
+     */
+    FixedState(const std::initializer_list<Real> values)
+        : elements()
+    {
+        if (values.size() != N)
+        {
+            throw std::invalid_argument("Number of values differs from size of fixed state!");
+        }
+        std::copy(values.begin(), values.end(), elements.begin());
+    }
+
+    //! Construct state from array of elements.
+    explicit FixedState(const std::array<Real, N>& elements)
+        : elements(elements)
+    { }
+
+    //! Get number of elements.
+    static constexpr std::size_t size() { return N; }
+
+    //! Get element with given index.
+    Real& operator[](const std::size_t index) { return elements[index]; }
+
+    //! Get element with given index.
+    const Real& operator[](const std::size_t index) const { return elements[index]; }
+
+    //! Get pointer to contiguous elements.
+    Real* data() { return elements.data(); }
+
+    //! Get pointer to contiguous elements.
+    const Real* data() const { return elements.data(); }
+
+    //! Get pointer to first element.
+    Real* begin() { return elements.data(); }
+
+    //! Get pointer to first element.
+    const Real* begin() const { return elements.data(); }
+
+    //! Get pointer past last element.
+    Real* end() { return elements.data() + N; }
+
+    //! Get pointer past last element.
+    const Real* end() const { return elements.data() + N; }
+
+    //! Add state element-wise.
+    FixedState& operator+=(const FixedState& state)
+    {
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            elements[i] += state.elements[i];
+        }
+        return *this;
+    }
+
+    //! Subtract state element-wise.
+    FixedState& operator-=(const FixedState& state)
+    {
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            elements[i] -= state.elements[i];
+        }
+        return *this;
+    }
+
+    //! Multiply all elements by scalar.
+    FixedState& operator*=(const Real scalar)
+    {
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            elements[i] *= scalar;
+        }
+        return *this;
+    }
+
+    //! Add states element-wise.
+    friend FixedState operator+(FixedState state, const FixedState& otherState)
+    {
+        return state += otherState;
+    }
+
+    //! Subtract states element-wise.
+    friend FixedState operator-(FixedState state, const FixedState& otherState)
+    {
+        return state -= otherState;
+    }
+
+    //! Negate all elements of state.
+    friend FixedState operator-(FixedState state)
+    {
+        return state *= Real(-1);
+    }
+
+    //! Multiply all elements of state by scalar.
+    friend FixedState operator*(const Real scalar, FixedState state)
+    {
+        return state *= scalar;
+    }
+
+    //! Multiply all elements of state by scalar.
+    friend FixedState operator*(FixedState state, const Real scalar)
+    {
+        return state *= scalar;
+    }
+
+    //! Check if all elements of states are equal.
+    friend bool operator==(const FixedState& state, const FixedState& otherState)
+    {
+        return state.elements == otherState.elements;
+    }
+
+    //! Check if any elements of states differ.
+    friend bool operator!=(const FixedState& state, const FixedState& otherState)
+    {
+        return !(state == otherState);
+    }
+
+protected:
+private:
+
+    //! Elements of state.
+    std::array<Real, N> elements;
+};
+
+//! State with number of elements set at run-time, stored in aligned contiguous buffer.
+/*!
+ * State with a number of elements that is set on construction, which stores its elements in a
+ * heap-allocated buffer that is aligned to a cache line, so that the contiguous kernels of the
+ * integrators (see StateTraits) start on a cache line and SIMD loads do not cross cache lines.
+ * Copy-assignment reuses the buffer if the number of elements is the same, so that the
+ * integrators do not allocate memory once their workspace is set up, and move operations
+ * transfer the buffer.
+ *
+ * The state is contiguous and indexable (see StateTraits), and provides the State operators, so
+ * it can be used with all integrators. The element-wise operators require states of the same
+ * size.
+ *
+ * @tparam  Real  Type for floating-point number
+ */
+template <typename Real>
+class DynamicState
+{
+public:
+
+    static_assert(std::is_arithmetic<Real>::value, "DynamicState requires arithmetic elements");
+
+    //! Alignment of buffer in bytes, i.e., size of cache line.
+    static const std::size_t alignment = 64;
+
+    //! Construct state without elements.
+    DynamicState()
+        : numberOfElements(0),
+          allocation(nullptr),
+          elements(nullptr)
+    { }
+
+    //! Construct state with given number of elements.
+    /*!
+     * Constructs state with given number of elements, which are set to the given value.
+     *
+     * @throws std::bad_alloc  If buffer cannot be allocated
+     *
+     * @param[in]  size   Number of elements
+     * @param[in]  value  Value of all elements (default: 0)
+     */
+    explicit DynamicState(const std::size_t size, const Real value = Real(0))
+        : numberOfElements(0),
+          allocation(nullptr),
+          elements(nullptr)
+    {
+        allocate(size);
+        std::fill(begin(), end(), value);
+    }
+
+    //! Construct state from list of elements.
+    /*!
+     * Constructs state from list of elements, e.g., DynamicState<double>({1.0, 0.0}).
+     *
+     * @throws std::bad_alloc  If buffer cannot be allocated
+     *
+     * @param[in]  values  Values of elements
+     */
+    DynamicState(const std::initializer_list<Real> values)
+        : numberOfElements(0),
+          allocation(nullptr),
+          elements(nullptr)
+    {
+        allocate(values.size());
+        std::copy(values.begin(), values.end(), begin());
+    }
+
+    //! Construct copy of state.
+    DynamicState(const DynamicState& state)
+        : numberOfElements(0),
+          allocation(nullptr),
+          elements(nullptr)
+    {
+        allocate(state.numberOfElements);
+        std::copy(state.begin(), state.end(), begin());
+    }
+
+    //! Construct state from buffer of other state, which is left without elements.
+    DynamicState(DynamicState&& state) noexcept
+        : numberOfElements(state.numberOfElements),
+          allocation(state.allocation),
+          elements(state.elements)
+    {
+        state.numberOfElements = 0;
+        state.allocation = nullptr;
+        state.elements = nullptr;
+    }
+
+    //! Free buffer.
+    ~DynamicState()
+    {
+        std::free(allocation);
+    }
+
+    //! Copy elements of state, reusing buffer if number of elements is the same.
+    DynamicState& operator=(const DynamicState& state)
+    {
+        if (this != &state)
+        {
+            if (numberOfElements != state.numberOfElements)
+            {
+                allocate(state.numberOfElements);
+            }
+            std::copy(state.begin(), state.end(), begin());
+        }
+        return *this;
+    }
+
+    //! Exchange buffer with other state.
+    DynamicState& operator=(DynamicState&& state) noexcept
+    {
+        std::swap(numberOfElements, state.numberOfElements);
+        std::swap(allocation, state.allocation);
+        std::swap(elements, state.elements);
+        return *this;
+    }
+
+    //! Get number of elements.
+    std::size_t size() const { return numberOfElements; }
+
+    //! Get element with given index.
+    Real& operator[](const std::size_t index) { return elements[index]; }
+
+    //! Get element with given index.
+    const Real& operator[](const std::size_t index) const { return elements[index]; }
+
+    //! Get pointer to contiguous elements, which is aligned to alignment bytes.
+    Real* data() { return elements; }
+
+    //! Get pointer to contiguous elements, which is aligned to alignment bytes.
+    const Real* data() const { return elements; }
+
+    //! Get pointer to first element.
+    Real* begin() { return elements; }
+
+    //! Get pointer to first element.
+    const Real* begin() const { return elements; }
+
+    //! Get pointer past last element.
+    Real* end() { return elements + numberOfElements; }
+
+    //! Get pointer past last element.
+    const Real* end() const { return elements + numberOfElements; }
+
+    //! Add state element-wise.
+    DynamicState& operator+=(const DynamicState& state)
+    {
+        for (std::size_t i = 0; i < numberOfElements; ++i)
+        {
+            elements[i] += state.elements[i];
+        }
+        return *this;
+    }
+
+    //! Subtract state element-wise.
+    DynamicState& operator-=(const DynamicState& state)
+    {
+        for (std::size_t i = 0; i < numberOfElements; ++i)
+        {
+            elements[i] -= state.elements[i];
+        }
+        return *this;
+    }
+
+    //! Multiply all elements by scalar.
+    DynamicState& operator*=(const Real scalar)
+    {
+        for (std::size_t i = 0; i < numberOfElements; ++i)
+        {
+            elements[i] *= scalar;
+        }
+        return *this;
+    }
+
+    //! Add states element-wise (reuses buffer of temporary left operand).
+    friend DynamicState operator+(DynamicState state, const DynamicState& otherState)
+    {
+        state += otherState;
+        return state;
+    }
+
+    //! Subtract states element-wise (reuses buffer of temporary left operand).
+    friend DynamicState operator-(DynamicState state, const DynamicState& otherState)
+    {
+        state -= otherState;
+        return state;
+    }
+
+    //! Negate all elements of state.
+    friend DynamicState operator-(DynamicState state)
+    {
+        state *= Real(-1);
+        return state;
+    }
+
+    //! Multiply all elements of state by scalar.
+    friend DynamicState operator*(const Real scalar, DynamicState state)
+    {
+        state *= scalar;
+        return state;
+    }
+
+    //! Multiply all elements of state by scalar.
+    friend DynamicState operator*(DynamicState state, const Real scalar)
+    {
+        state *= scalar;
+        return state;
+    }
+
+    //! Check if states have same number of elements and all elements are equal.
+    friend bool operator==(const DynamicState& state, const DynamicState& otherState)
+    {
+        return state.numberOfElements == otherState.numberOfElements
+               && std::equal(state.begin(), state.end(), otherState.begin());
+    }
+
+    //! Check if states differ in number of elements or any element.
+    friend bool operator!=(const DynamicState& state, const DynamicState& otherState)
+    {
+        return !(state == otherState);
+    }
+
+protected:
+private:
+
+    //! Replace buffer by aligned buffer for given number of elements (uninitialized).
+    void allocate(const std::size_t size)
+    {
+        std::free(allocation);
+        numberOfElements = 0;
+        allocation = nullptr;
+        elements = nullptr;
+        if (size == 0)
+        {
+            return;
+        }
+
+        allocation = std::malloc(size * sizeof(Real) + alignment - 1);
+        if (allocation == nullptr)
+        {
+            throw std::bad_alloc();
+        }
+        const std::uintptr_t address = reinterpret_cast<std::uintptr_t>(allocation);
+        elements = reinterpret_cast<Real*>((address + alignment - 1) & ~(alignment - 1));
+        numberOfElements = size;
+    }
+
+    //! Number of elements.
+    std::size_t numberOfElements;
+
+    //! Start of allocated memory, which contains aligned buffer.
+    void* allocation;
+
+    //! Aligned buffer that stores elements.
+    Real* elements;
+};
+
+} // namespace integrate
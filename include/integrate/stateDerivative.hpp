@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2014-2025 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include <functional>
+#include <type_traits>
+
+namespace integrate
+{
+
+//! Type-erased function to compute state derivative.
+/*!
+ * Type-erased wrapper for any callable that computes the state derivative for a given time and
+ * state. All steppers accept the state derivative as a template parameter, so that function
+ * pointers, functors and lambdas can be inlined into the stage evaluations. Passing an object of
+ * this type instead yields a single instantiation of each stepper per (Real, State) pair,
+ * irrespective of the callable that is wrapped, which is useful when the dynamical model is only
+ * known at run-time, e.g., when it is loaded from a plugin. This comes at the cost of an indirect
+ * call per state derivative evaluation.
+ *
+ * @tparam  Real   Type for floating-point number
+ * @tparam  State  Type for state and state derivative
+ */
+template <typename Real, typename State>
+using StateDerivativeFunction = std::function<const State(const Real time, const State& state)>;
+
+namespace detail
+{
+
+//! Evaluate state derivative using callable that writes state derivative in-place.
+template <typename Real, typename State, typename StateDerivative>
+inline auto evaluateStateDerivative(const StateDerivative& computeStateDerivative,
+                                    const Real time,
+                                    const State& state,
+                                    State& stateDerivative,
+                                    int)
+    -> typename std::enable_if<
+        std::is_void<decltype(computeStateDerivative(time, state, stateDerivative))>::value>::type
+{
+    computeStateDerivative(time, state, stateDerivative);
+}
+
+//! Evaluate state derivative using callable that returns state derivative.
+template <typename Real, typename State, typename StateDerivative>
+inline void evaluateStateDerivative(const StateDerivative& computeStateDerivative,
+                                    const Real time,
+                                    const State& state,
+                                    State& stateDerivative,
+                                    long)
+{
+    stateDerivative = computeStateDerivative(time, state);
+}
+
+} // namespace detail
+
+//! Evaluate state derivative and store it in given state.
+/*!
+ * Evaluates state derivative for given time and state and stores it in a state that is provided
+ * by the caller, so that steppers can reuse preallocated storage for their stages. Two forms of
+ * callable are supported:
+ *
+ *  - State computeStateDerivative(const Real time, const State& state), which returns the state
+ *    derivative; the returned state is copy-assigned to the output state.
+ *  - void computeStateDerivative(const Real time, const State& state, State& stateDerivative),
+ *    which writes the state derivative in-place and thus avoids creating a temporary state.
+ *
+ * A callable is considered to be of the in-place form if it can be called with three arguments
+ * and returns void. If a callable provides both forms, the in-place form is used.
+ *
+ * @tparam       Real                    Type for floating-point number
+ * @tparam       State                   Type for state and state derivative
+ * @tparam       StateDerivative         Type of callable to compute state derivative
+ * @param[in]    computeStateDerivative  Function to compute state derivative for current time
+ *                                       and state
+ * @param[in]    time                    Current time
+ * @param[in]    state                   Current state
+ * @param[out]   stateDerivative         Computed state derivative
+ */
+template <typename Real, typename State, typename StateDerivative>
+inline void evaluateStateDerivative(const StateDerivative& computeStateDerivative,
+                                    const Real time,
+                                    const State& state,
+                                    State& stateDerivative)
+{
+    detail::evaluateStateDerivative<Real, State>(
+        computeStateDerivative, time, state, stateDerivative, 0);
+}
+
+namespace detail
+{
+
+//! State derivative that records its evaluations in a statistics policy.
+template <typename Real, typename State, typename StateDerivative, typename Statistics>
+class RecordedStateDerivative
+{
+public:
+
+    //! Construct state derivative that records evaluations of given state derivative.
+    RecordedStateDerivative(const StateDerivative& computeStateDerivative, Statistics& statistics)
+        : computeStateDerivative(computeStateDerivative),
+          statistics(&statistics)
+    { }
+
+    //! Evaluate state derivative and record evaluation.
+    void operator()(const Real time, const State& state, State& stateDerivative) const
+    {
+        statistics->startStateDerivativeEvaluation();
+        integrate::evaluateStateDerivative(computeStateDerivative, time, state, stateDerivative);
+        statistics->stopStateDerivativeEvaluation();
+    }
+
+protected:
+private:
+
+    //! Function to compute state derivative.
+    const StateDerivative& computeStateDerivative;
+
+    //! Statistics in which evaluations are recorded.
+    Statistics* statistics;
+};
+
+} // namespace detail
+
+} // namespace integrate
@@ -0,0 +1,229 @@
+/*
+ * Copyright (c) 2014-2025 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+
+#include "integrate/linearCombination.hpp"
+
+namespace integrate
+{
+namespace detail
+{
+
+//! Number of independent accumulators used by contiguous norm reductions.
+/*!
+ * Reductions with a single accumulator form a serial dependency chain that the compiler may not
+ * reorder (floating-point addition is not associative), which prevents vectorization. Using a
+ * fixed number of independent accumulators makes the reduction order explicit and deterministic,
+ * and lets the compiler map the accumulators onto SIMD lanes.
+ */
+const std::size_t numberOfNormAccumulators = 8;
+
+//! Compute maximum absolute value of elements of state using element-wise access.
+template <typename Real, typename State>
+inline Real computeMaximumNorm(const State& state, IndexableStateTag)
+{
+    Real maximum = 0.0;
+    const std::size_t size = static_cast<std::size_t>(state.size());
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        const Real absoluteValue = std::fabs(state[i]);
+        maximum = absoluteValue > maximum ? absoluteValue : maximum;
+    }
+    return maximum;
+}
+
+//! Compute maximum absolute value of elements of state using contiguous storage.
+template <typename Real, typename State>
+inline Real computeMaximumNorm(const State& state, ContiguousStateTag)
+{
+    const std::size_t size = static_cast<std::size_t>(state.size());
+    const auto* const elements = state.data();
+
+    const std::size_t numberOfBlockedElements = size - size % numberOfNormAccumulators;
+
+    Real maxima[numberOfNormAccumulators] = { };
+    for (std::size_t i = 0; i < numberOfBlockedElements; i += numberOfNormAccumulators)
+    {
+        for (std::size_t j = 0; j < numberOfNormAccumulators; ++j)
+        {
+            const Real absoluteValue = std::fabs(elements[i + j]);
+            maxima[j] = absoluteValue > maxima[j] ? absoluteValue : maxima[j];
+        }
+    }
+
+    Real maximum = 0.0;
+    for (std::size_t j = 0; j < numberOfNormAccumulators; ++j)
+    {
+        maximum = maxima[j] > maximum ? maxima[j] : maximum;
+    }
+    for (std::size_t i = numberOfBlockedElements; i < size; ++i)
+    {
+        const Real absoluteValue = std::fabs(elements[i]);
+        maximum = absoluteValue > maximum ? absoluteValue : maximum;
+    }
+    return maximum;
+}
+
+//! Compute sum of squares of elements of state using element-wise access.
+template <typename Real, typename State>
+inline Real computeSumOfSquares(const State& state, IndexableStateTag)
+{
+    Real sum = 0.0;
+    const std::size_t size = static_cast<std::size_t>(state.size());
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        sum += state[i] * state[i];
+    }
+    return sum;
+}
+
+//! Compute sum of squares of elements of state using contiguous storage.
+template <typename Real, typename State>
+inline Real computeSumOfSquares(const State& state, ContiguousStateTag)
+{
+    const std::size_t size = static_cast<std::size_t>(state.size());
+    const auto* const elements = state.data();
+
+    const std::size_t numberOfBlockedElements = size - size % numberOfNormAccumulators;
+
+    Real sums[numberOfNormAccumulators] = { };
+    for (std::size_t i = 0; i < numberOfBlockedElements; i += numberOfNormAccumulators)
+    {
+        for (std::size_t j = 0; j < numberOfNormAccumulators; ++j)
+        {
+            sums[j] += elements[i + j] * elements[i + j];
+        }
+    }
+
+    Real sum = 0.0;
+    for (std::size_t j = 0; j < numberOfNormAccumulators; ++j)
+    {
+        sum += sums[j];
+    }
+    for (std::size_t i = numberOfBlockedElements; i < size; ++i)
+    {
+        sum += elements[i] * elements[i];
+    }
+    return sum;
+}
+
+//! Compute dot product of states using element-wise access.
+template <typename Real, typename State>
+inline Real computeDotProduct(const State& state, const State& otherState, IndexableStateTag)
+{
+    Real sum = 0.0;
+    const std::size_t size = static_cast<std::size_t>(state.size());
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        sum += state[i] * otherState[i];
+    }
+    return sum;
+}
+
+//! Compute dot product of states using contiguous storage.
+template <typename Real, typename State>
+inline Real computeDotProduct(const State& state, const State& otherState, ContiguousStateTag)
+{
+    const std::size_t size = static_cast<std::size_t>(state.size());
+    const auto* const elements = state.data();
+    const auto* const otherElements = otherState.data();
+
+    const std::size_t numberOfBlockedElements = size - size % numberOfNormAccumulators;
+
+    Real sums[numberOfNormAccumulators] = { };
+    for (std::size_t i = 0; i < numberOfBlockedElements; i += numberOfNormAccumulators)
+    {
+        for (std::size_t j = 0; j < numberOfNormAccumulators; ++j)
+        {
+            sums[j] += elements[i + j] * otherElements[i + j];
+        }
+    }
+
+    Real sum = 0.0;
+    for (std::size_t j = 0; j < numberOfNormAccumulators; ++j)
+    {
+        sum += sums[j];
+    }
+    for (std::size_t i = numberOfBlockedElements; i < size; ++i)
+    {
+        sum += elements[i] * otherElements[i];
+    }
+    return sum;
+}
+
+} // namespace detail
+
+//! Compute maximum norm of state.
+/*!
+ * Computes maximum norm of state, i.e., the maximum absolute value of its elements. For
+ * contiguous states (see StateTraits), the reduction operates on the raw storage and is
+ * vectorized by the compiler.
+ *
+ * @tparam     Real   Type for floating-point number
+ * @tparam     State  Type for state, which must be indexable or contiguous
+ * @param[in]  state  State
+ * @return            Maximum norm of state
+ */
+template <typename Real, typename State>
+inline Real computeMaximumNorm(const State& state)
+{
+    static_assert(StateTraits<State>::isIndexable || StateTraits<State>::isContiguous,
+                  "Norm of state requires indexable or contiguous state");
+    return detail::computeMaximumNorm<Real>(state, typename detail::StateTag<State>::type());
+}
+
+//! Compute root-mean-square norm of state.
+/*!
+ * Computes root-mean-square norm of state, i.e., sqrt(sum_i state_i^2 / n). For contiguous states
+ * (see StateTraits), the reduction operates on the raw storage and is vectorized by the
+ * compiler. The norm of an empty state is zero.
+ *
+ * @tparam     Real   Type for floating-point number
+ * @tparam     State  Type for state, which must be indexable or contiguous
+ * @param[in]  state  State
+ * @return            Root-mean-square norm of state
+ */
+template <typename Real, typename State>
+inline Real computeRootMeanSquareNorm(const State& state)
+{
+    static_assert(StateTraits<State>::isIndexable || StateTraits<State>::isContiguous,
+                  "Norm of state requires indexable or contiguous state");
+    const std::size_t size = static_cast<std::size_t>(state.size());
+    if (size == 0)
+    {
+        return 0.0;
+    }
+    return std::sqrt(detail::computeSumOfSquares<Real>(state,
+                                                       typename detail::StateTag<State>::type())
+                     / static_cast<Real>(size));
+}
+
+//! Compute dot product of states.
+/*!
+ * Computes dot product of states, i.e., sum_i state_i * otherState_i, e.g., for the Krylov
+ * subspace methods that solve the linear systems of implicit steppers. For contiguous states (see
+ * StateTraits), the reduction operates on the raw storage and is vectorized by the compiler.
+ *
+ * @tparam     Real        Type for floating-point number
+ * @tparam     State       Type for state, which must be indexable or contiguous
+ * @param[in]  state       State
+ * @param[in]  otherState  Other state, with the same size as state
+ * @return                 Dot product of states
+ */
+template <typename Real, typename State>
+inline Real computeDotProduct(const State& state, const State& otherState)
+{
+    static_assert(StateTraits<State>::isIndexable || StateTraits<State>::isContiguous,
+                  "Dot product of states requires indexable or contiguous states");
+    return detail::computeDotProduct<Real>(state, otherState,
+                                           typename detail::StateTag<State>::type());
+}
+
+} // namespace integrate
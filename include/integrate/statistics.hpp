@@ -0,0 +1,257 @@
+/*
+ * Copyright (c) 2014-2025 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include <chrono>
+#include <cmath>
+#include <limits>
+
+namespace integrate
+{
+
+//! Statistics policy that does not collect statistics.
+/*!
+ * Statistics policy that does not collect statistics, which is the default for all steppers. All
+ * member functions are empty and inlined, so that the statistics are compiled out entirely.
+ */
+class NullStatistics
+{
+public:
+
+    //! Flag that indicates if statistics are collected.
+    static const bool isEnabled = false;
+
+    //! Add statistics of other integration (ignored).
+    NullStatistics& operator+=(const NullStatistics&) { return *this; }
+
+    //! Reset statistics (ignored).
+    void reset() { }
+
+    //! Start integration step (ignored).
+    void startStep() { }
+
+    //! Stop integration step (ignored).
+    void stopStep() { }
+
+    //! Start state derivative evaluation (ignored).
+    void startStateDerivativeEvaluation() { }
+
+    //! Stop state derivative evaluation (ignored).
+    void stopStateDerivativeEvaluation() { }
+
+    //! Record accepted integration step (ignored).
+    template <typename Real>
+    void recordAcceptedStep(const Real) { }
+
+    //! Record rejected integration step attempt (ignored).
+    template <typename Real>
+    void recordRejectedStep(const Real) { }
+
+    //! Write statistics to checkpoint (ignored).
+    template <typename Checkpoint>
+    void writeCheckpoint(Checkpoint&) const { }
+
+    //! Read statistics from checkpoint (ignored).
+    template <typename Checkpoint>
+    void readCheckpoint(Checkpoint&) { }
+};
+
+//! Integration statistics.
+/*!
+ * Statistics policy that counts the state derivative evaluations, accepted steps and rejected
+ * step attempts, keeps the minimum, maximum and mean step size of the accepted steps, and
+ * measures the time spent inside the state derivative function and inside the integration steps.
+ * The difference between the two times is the overhead of the integrator.
+ *
+ * The statistics are collected by a stepper that is instantiated with this policy, e.g.,
+ * RKF78Stepper<Real, State, IntegrationStatistics<Real> >, and accumulate over all steps until
+ * they are reset. Statistics of several steppers, e.g., of the worker threads of an
+ * EnsembleRunner, can be combined using operator+=.
+ *
+ * @tparam  Real  Type for floating-point number
+ */
+template <typename Real>
+class IntegrationStatistics
+{
+public:
+
+    //! Flag that indicates if statistics are collected.
+    static const bool isEnabled = true;
+
+    //! Construct empty statistics.
+    IntegrationStatistics()
+    {
+        reset();
+    }
+
+    //! Get number of state derivative evaluations.
+    long getNumberOfStateDerivativeEvaluations() const
+    {
+        return numberOfStateDerivativeEvaluations;
+    }
+
+    //! Get number of accepted integration steps.
+    long getNumberOfAcceptedSteps() const { return numberOfAcceptedSteps; }
+
+    //! Get number of rejected integration step attempts.
+    long getNumberOfRejectedSteps() const { return numberOfRejectedSteps; }
+
+    //! Get minimum absolute step size of accepted steps (zero if no steps were accepted).
+    Real getMinimumStepSize() const
+    {
+        return numberOfAcceptedSteps > 0 ? minimumStepSize : 0.0;
+    }
+
+    //! Get maximum absolute step size of accepted steps (zero if no steps were accepted).
+    Real getMaximumStepSize() const { return maximumStepSize; }
+
+    //! Get mean absolute step size of accepted steps (zero if no steps were accepted).
+    Real getMeanStepSize() const
+    {
+        return numberOfAcceptedSteps > 0 ? sumOfStepSizes / numberOfAcceptedSteps : 0.0;
+    }
+
+    //! Get time spent inside state derivative function [s].
+    double getStateDerivativeTime() const { return stateDerivativeTime; }
+
+    //! Get time spent inside integration steps, including state derivative function [s].
+    double getStepTime() const { return stepTime; }
+
+    //! Get time spent inside integration steps, excluding state derivative function [s].
+    double getIntegratorTime() const { return stepTime - stateDerivativeTime; }
+
+    //! Reset statistics.
+    void reset()
+    {
+        numberOfStateDerivativeEvaluations = 0;
+        numberOfAcceptedSteps = 0;
+        numberOfRejectedSteps = 0;
+        minimumStepSize = std::numeric_limits<Real>::infinity();
+        maximumStepSize = 0.0;
+        sumOfStepSizes = 0.0;
+        stateDerivativeTime = 0.0;
+        stepTime = 0.0;
+    }
+
+    //! Add statistics of other integration.
+    IntegrationStatistics& operator+=(const IntegrationStatistics& statistics)
+    {
+        numberOfStateDerivativeEvaluations += statistics.numberOfStateDerivativeEvaluations;
+        numberOfAcceptedSteps += statistics.numberOfAcceptedSteps;
+        numberOfRejectedSteps += statistics.numberOfRejectedSteps;
+        minimumStepSize = std::fmin(minimumStepSize, statistics.minimumStepSize);
+        maximumStepSize = std::fmax(maximumStepSize, statistics.maximumStepSize);
+        sumOfStepSizes += statistics.sumOfStepSizes;
+        stateDerivativeTime += statistics.stateDerivativeTime;
+        stepTime += statistics.stepTime;
+        return *this;
+    }
+
+    //! Start integration step.
+    void startStep() { stepStartTime = Clock::now(); }
+
+    //! Stop integration step.
+    void stopStep() { stepTime += getElapsedTime(stepStartTime); }
+
+    //! Start state derivative evaluation.
+    void startStateDerivativeEvaluation() { stateDerivativeStartTime = Clock::now(); }
+
+    //! Stop state derivative evaluation.
+    void stopStateDerivativeEvaluation()
+    {
+        stateDerivativeTime += getElapsedTime(stateDerivativeStartTime);
+        ++numberOfStateDerivativeEvaluations;
+    }
+
+    //! Record accepted integration step with given step size.
+    void recordAcceptedStep(const Real stepSize)
+    {
+        const Real absoluteStepSize = std::fabs(stepSize);
+        minimumStepSize = std::fmin(minimumStepSize, absoluteStepSize);
+        maximumStepSize = std::fmax(maximumStepSize, absoluteStepSize);
+        sumOfStepSizes += absoluteStepSize;
+        ++numberOfAcceptedSteps;
+    }
+
+    //! Record rejected integration step attempt with given step size.
+    void recordRejectedStep(const Real)
+    {
+        ++numberOfRejectedSteps;
+    }
+
+    //! Write statistics to checkpoint (see Checkpoint).
+    template <typename Checkpoint>
+    void writeCheckpoint(Checkpoint& checkpoint) const
+    {
+        checkpoint.write(numberOfStateDerivativeEvaluations);
+        checkpoint.write(numberOfAcceptedSteps);
+        checkpoint.write(numberOfRejectedSteps);
+        checkpoint.write(minimumStepSize);
+        checkpoint.write(maximumStepSize);
+        checkpoint.write(sumOfStepSizes);
+        checkpoint.write(stateDerivativeTime);
+        checkpoint.write(stepTime);
+    }
+
+    //! Read statistics from checkpoint (see Checkpoint).
+    template <typename Checkpoint>
+    void readCheckpoint(Checkpoint& checkpoint)
+    {
+        checkpoint.read(numberOfStateDerivativeEvaluations);
+        checkpoint.read(numberOfAcceptedSteps);
+        checkpoint.read(numberOfRejectedSteps);
+        checkpoint.read(minimumStepSize);
+        checkpoint.read(maximumStepSize);
+        checkpoint.read(sumOfStepSizes);
+        checkpoint.read(stateDerivativeTime);
+        checkpoint.read(stepTime);
+    }
+
+protected:
+private:
+
+    //! Clock used to measure time.
+    typedef std::chrono::steady_clock Clock;
+
+    //! Get time elapsed since given start time [s].
+    static double getElapsedTime(const Clock::time_point startTime)
+    {
+        return std::chrono::duration<double>(Clock::now() - startTime).count();
+    }
+
+    //! Number of state derivative evaluations.
+    long numberOfStateDerivativeEvaluations;
+
+    //! Number of accepted integration steps.
+    long numberOfAcceptedSteps;
+
+    //! Number of rejected integration step attempts.
+    long numberOfRejectedSteps;
+
+    //! Minimum absolute step size of accepted steps.
+    Real minimumStepSize;
+
+    //! Maximum absolute step size of accepted steps.
+    Real maximumStepSize;
+
+    //! Sum of absolute step sizes of accepted steps.
+    Real sumOfStepSizes;
+
+    //! Time spent inside state derivative function [s].
+    double stateDerivativeTime;
+
+    //! Time spent inside integration steps [s].
+    double stepTime;
+
+    //! Start time of current integration step.
+    Clock::time_point stepStartTime;
+
+    //! Start time of current state derivative evaluation.
+    Clock::time_point stateDerivativeStartTime;
+};
+
+} // namespace integrate
@@ -0,0 +1,351 @@
+/*
+ * Copyright (c) 2014-2025 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include "integrate/linearCombination.hpp"
+#include "integrate/stateNorm.hpp"
+
+namespace integrate
+{
+namespace detail
+{
+
+//! Error norm that compares maximum norm of error estimate to tolerance per unit step size.
+/*!
+ * Error norm that reproduces the scalar tolerance of the adaptive step function of
+ * ExplicitRungeKuttaStepper, i.e., the error estimate is accepted if its maximum norm is smaller
+ * than the tolerance times the step size.
+ */
+template <typename Real>
+class ErrorPerUnitStepNorm
+{
+public:
+
+    //! Construct error norm with given local truncation error tolerance.
+    explicit ErrorPerUnitStepNorm(const Real tolerance)
+        : tolerance(tolerance)
+    { }
+
+    //! Compute scaled error of error estimate.
+    template <typename State>
+    Real operator()(const State& errorEstimate,
+                    const State&,
+                    const State&,
+                    const Real stepSize) const
+    {
+        return integrate::computeMaximumNorm<Real>(errorEstimate) / (tolerance * stepSize);
+    }
+
+protected:
+private:
+
+    //! Local truncation error tolerance.
+    Real tolerance;
+};
+
+} // namespace detail
+
+//! Weighted root-mean-square error norm.
+/*!
+ * Error norm that scales each element of the error estimate with its own mixed absolute and
+ * relative tolerance (Hairer et al., 1993, Section II.4):
+ *
+ *     error = sqrt(1/n sum_i (e_i / (atol_i + rtol_i max(|y_i|, |yNext_i|)))^2),
+ *
+ * where y is the state at the start of the step and yNext is the propagated solution. A step is
+ * accepted if the error is at most 1. Since each element is scaled with its own tolerance,
+ * elements with very different magnitudes, e.g., positions and velocities, are controlled to the
+ * same relative accuracy, instead of the elements with the largest magnitude determining the
+ * step size for all elements.
+ *
+ * Error norms are callables with the signature
+ *
+ *     Real computeError(const State& errorEstimate,
+ *                       const State& state,
+ *                       const State& nextState,
+ *                       const Real stepSize),
+ *
+ * so that other norms can be passed to the adaptive step functions instead.
+ *
+ * @tparam  Real   Type for floating-point number
+ * @tparam  State  Type for state, which must be indexable (see StateTraits)
+ */
+template <typename Real, typename State>
+class WeightedRootMeanSquareErrorNorm
+{
+public:
+
+    //! Construct error norm with same tolerances for all elements.
+    /*!
+     * Constructs error norm with same absolute and relative tolerance for all elements.
+     *
+     * @param[in]  absoluteTolerance  Absolute tolerance
+     * @param[in]  relativeTolerance  Relative tolerance
+     */
+    WeightedRootMeanSquareErrorNorm(const Real absoluteTolerance, const Real relativeTolerance)
+        : absoluteTolerance(absoluteTolerance),
+          relativeTolerance(relativeTolerance),
+          isPerElement(false)
+    { }
+
+    //! Construct error norm with tolerances per element.
+    /*!
+     * Constructs error norm with absolute and relative tolerance per element of the state.
+     *
+     * @throws std::invalid_argument  If the sizes of the tolerance vectors are not equal
+     *
+     * @param[in]  absoluteTolerances  Absolute tolerances per element
+     * @param[in]  relativeTolerances  Relative tolerances per element
+     */
+    WeightedRootMeanSquareErrorNorm(const State& absoluteTolerances,
+                                    const State& relativeTolerances)
+        : absoluteTolerance(0.0),
+          relativeTolerance(0.0),
+          isPerElement(true)
+    {
+        static_assert(StateTraits<State>::isIndexable,
+                      "Weighted error norm requires indexable state");
+
+        if (absoluteTolerances.size() != relativeTolerances.size())
+        {
+            throw std::invalid_argument("Sizes of tolerance vectors are not equal!");
+        }
+
+        const std::size_t size = static_cast<std::size_t>(absoluteTolerances.size());
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            this->absoluteTolerances.push_back(absoluteTolerances[i]);
+            this->relativeTolerances.push_back(relativeTolerances[i]);
+        }
+    }
+
+    //! Compute scaled error of error estimate.
+    /*!
+     * Computes scaled error of error estimate, i.e., weighted root-mean-square norm of error
+     * estimate.
+     *
+     * @throws std::invalid_argument  If the sizes of the tolerance vectors are not equal to the
+     *                                size of the state
+     *
+     * @param[in]  errorEstimate  Error estimate of integration step
+     * @param[in]  state          State at start of integration step
+     * @param[in]  nextState      Propagated solution at end of integration step
+     * @return                    Scaled error, which is at most 1 if step is accepted
+     */
+    Real operator()(const State& errorEstimate,
+                    const State& state,
+                    const State& nextState,
+                    const Real) const
+    {
+        static_assert(StateTraits<State>::isIndexable,
+                      "Weighted error norm requires indexable state");
+
+        const std::size_t size = static_cast<std::size_t>(errorEstimate.size());
+        if (isPerElement && absoluteTolerances.size() != size)
+        {
+            throw std::invalid_argument("Size of tolerance vectors is not equal to size of state!");
+        }
+        else if (size == 0)
+        {
+            return 0.0;
+        }
+
+        Real sum = 0.0;
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            const Real magnitude = std::fmax(std::fabs(state[i]), std::fabs(nextState[i]));
+            const Real scale = isPerElement
+                               ? absoluteTolerances[i] + relativeTolerances[i] * magnitude
+                               : absoluteTolerance + relativeTolerance * magnitude;
+            const Real scaledError = errorEstimate[i] / scale;
+            sum += scaledError * scaledError;
+        }
+        return std::sqrt(sum / static_cast<Real>(size));
+    }
+
+protected:
+private:
+
+    //! Absolute tolerance for all elements.
+    Real absoluteTolerance;
+
+    //! Relative tolerance for all elements.
+    Real relativeTolerance;
+
+    //! Absolute tolerances per element.
+    std::vector<Real> absoluteTolerances;
+
+    //! Relative tolerances per element.
+    std::vector<Real> relativeTolerances;
+
+    //! Flag that indicates if tolerances per element are used.
+    bool isPerElement;
+};
+
+//! Step size controller.
+/*!
+ * Step size controller that computes the factor by which the step size is scaled from the scaled
+ * error of the current step and of the two previous accepted steps, i.e., a PID controller in the
+ * digital filter form (Söderlind, 2003):
+ *
+ *     factor = safety err_n^(-beta1/k) err_(n-1)^(-beta2/k) err_(n-2)^(-beta3/k),
+ *
+ * where k is the order of the error estimate, i.e., the lowest order of the propagated and
+ * embedded solutions plus one. The default gains (0.7, -0.4, 0) yield the PI controller of
+ * Gustafsson (1991), which reduces the number of rejected steps and the oscillation of the step
+ * size compared with the elementary controller, which is obtained with gains (1, 0, 0).
+ *
+ * The factor is bounded by the minimum and maximum factors on every step. After a rejected step,
+ * the factor is computed with the elementary controller and is at most 1, i.e., the step size is
+ * not increased directly after a rejection.
+ *
+ * The controller keeps the scaled errors of the previous accepted steps, so a controller instance
+ * should be used for a single trajectory, and should be reset when a new trajectory starts.
+ *
+ * @tparam  Real  Type for floating-point number
+ */
+template <typename Real>
+class StepSizeController
+{
+public:
+
+    //! Construct step size controller.
+    /*!
+     * Constructs step size controller.
+     *
+     * @param[in]  beta1          Gain for scaled error of current step
+     * @param[in]  beta2          Gain for scaled error of previous accepted step
+     * @param[in]  beta3          Gain for scaled error of accepted step before previous step
+     * @param[in]  safetyFactor   Safety factor by which proposed factor is multiplied
+     * @param[in]  minimumFactor  Minimum factor by which step size is scaled
+     * @param[in]  maximumFactor  Maximum factor by which step size is scaled
+     */
+    StepSizeController(const Real beta1 = 0.7,
+                       const Real beta2 = -0.4,
+                       const Real beta3 = 0.0,
+                       const Real safetyFactor = 0.9,
+                       const Real minimumFactor = 0.2,
+                       const Real maximumFactor = 5.0)
+        : beta1(beta1),
+          beta2(beta2),
+          beta3(beta3),
+          safetyFactor(safetyFactor),
+          minimumFactor(minimumFactor),
+          maximumFactor(maximumFactor),
+          previousError(1.0),
+          secondPreviousError(1.0)
+    { }
+
+    //! Compute factor by which step size is scaled.
+    /*!
+     * Computes factor by which step size is scaled, for given scaled error of current step. If
+     * the step is accepted, the scaled error is kept for the next steps.
+     *
+     * @param[in]  error               Scaled error of current step
+     * @param[in]  errorEstimateOrder  Order of error estimate (k)
+     * @param[in]  isAccepted          Flag that indicates if current step is accepted
+     * @return                         Factor by which step size is scaled
+     */
+    Real computeStepSizeFactor(const Real error,
+                               const int errorEstimateOrder,
+                               const bool isAccepted)
+    {
+        const Real exponentScale = 1.0 / errorEstimateOrder;
+        Real factor = 0.0;
+        if (isAccepted)
+        {
+            factor = safetyFactor * std::pow(error, -beta1 * exponentScale)
+                                  * std::pow(previousError, -beta2 * exponentScale)
+                                  * std::pow(secondPreviousError, -beta3 * exponentScale);
+
+            // Bound kept errors from below, so that an exact step does not disable the controller.
+            secondPreviousError = previousError;
+            previousError = std::fmax(error, minimumKeptError);
+        }
+        else
+        {
+            factor = safetyFactor * std::pow(error, -exponentScale);
+        }
+
+        const Real maximum = isAccepted ? maximumFactor : std::fmin(maximumFactor, 1.0);
+        if (!(factor > minimumFactor))
+        {
+            return minimumFactor;
+        }
+        else if (factor > maximum)
+        {
+            return maximum;
+        }
+        return factor;
+    }
+
+    //! Reset step size controller.
+    /*!
+     * Discards the scaled errors of the previous accepted steps, e.g., because a new trajectory
+     * is started.
+     */
+    void reset()
+    {
+        previousError = 1.0;
+        secondPreviousError = 1.0;
+    }
+
+    //! Write scaled errors of previous accepted steps to checkpoint (see Checkpoint).
+    template <typename Checkpoint>
+    void writeCheckpoint(Checkpoint& checkpoint) const
+    {
+        checkpoint.write(previousError);
+        checkpoint.write(secondPreviousError);
+    }
+
+    //! Read scaled errors of previous accepted steps from checkpoint (see Checkpoint).
+    template <typename Checkpoint>
+    void readCheckpoint(Checkpoint& checkpoint)
+    {
+        checkpoint.read(previousError);
+        checkpoint.read(secondPreviousError);
+    }
+
+protected:
+private:
+
+    //! Lower bound for kept scaled errors of previous steps.
+    static constexpr Real minimumKeptError = 1.0e-4;
+
+    //! Gain for scaled error of current step.
+    Real beta1;
+
+    //! Gain for scaled error of previous accepted step.
+    Real beta2;
+
+    //! Gain for scaled error of accepted step before previous step.
+    Real beta3;
+
+    //! Safety factor.
+    Real safetyFactor;
+
+    //! Minimum factor by which step size is scaled.
+    Real minimumFactor;
+
+    //! Maximum factor by which step size is scaled.
+    Real maximumFactor;
+
+    //! Scaled error of previous accepted step.
+    Real previousError;
+
+    //! Scaled error of accepted step before previous step.
+    Real secondPreviousError;
+};
+
+template <typename Real> constexpr Real StepSizeController<Real>::minimumKeptError;
+
+} // namespace integrate
@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2014-2025 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include <type_traits>
+#include <vector>
+
+#include "integrate/linearCombination.hpp"
+#include "integrate/stateDerivative.hpp"
+#include "integrate/statistics.hpp"
+
+namespace integrate
+{
+
+//! Symplectic stepper.
+/*!
+ * Stepper that executes integration steps using an explicit symplectic scheme for separable
+ * Hamiltonian systems, i.e., second-order systems of the form
+ *
+ * \f[
+ *      xdot = v, \quad vdot = a(t,x)
+ * \f]
+ *
+ * where the position x and the velocity v are integrated as separate states of the same type. The
+ * scheme is a sequence of drifts (position updates) and kicks (velocity updates) that is defined
+ * by a class with the following static members:
+ *
+ *  - numberOfStages: number of kicks s
+ *  - order: order of the scheme
+ *  - c[s + 1]: drift coefficients
+ *  - d[s]: kick coefficients
+ *
+ * For i = 0, ..., s - 1, the stepper drifts the position by c[i] * h * v and kicks the velocity by
+ * d[i] * h * a(t, x), evaluated at the drifted position, and it finishes with a drift by
+ * c[s] * h * v. Each drift also advances the time at which the acceleration is evaluated. Unlike
+ * the explicit Runge-Kutta schemes, these schemes do not exhibit a secular drift of the energy
+ * of conservative systems; the energy error remains bounded over very long integration horizons,
+ * so that large fixed step sizes can be taken.
+ *
+ * If the first and last drift coefficients are zero, the first kick of a step is evaluated at the
+ * position at which the last kick of the previous step was evaluated (First-Same-As-Last). The
+ * stepper keeps the last acceleration and reuses it in the next step, provided that the next step
+ * starts from the time and position at which the previous step ended, which saves one acceleration
+ * evaluation per step.
+ *
+ * The acceleration is computed by a callable of either form accepted by evaluateStateDerivative(),
+ * i.e., State computeAcceleration(const Real time, const State& position), or
+ * void computeAcceleration(const Real time, const State& position, State& acceleration).
+ *
+ * @tparam  Real          Type for floating-point number
+ * @tparam  State         Type for position, velocity and acceleration
+ * @tparam  Coefficients  Drift and kick coefficients that define symplectic scheme
+ * @tparam  Statistics    Statistics policy, e.g., NullStatistics or IntegrationStatistics
+ */
+template <typename Real,
+          typename State,
+          typename Coefficients,
+          typename Statistics = NullStatistics>
+class SymplecticStepper
+{
+public:
+
+    //! Construct stepper.
+    SymplecticStepper()
+        : isAccelerationValid(false),
+          accelerationTime(0.0)
+    { }
+
+    //! Execute single integration step with fixed step size.
+    /*!
+     * Executes single numerical integration step with given step size.
+     *
+     * @tparam         Acceleration         Type of callable to compute acceleration, e.g.,
+     *                                      function pointer, functor, lambda or
+     *                                      StateDerivativeFunction
+     * @param[in,out]  time                 Independent variable, which is provided as input and
+     *                                      is updated with output at end of integration step
+     * @param[in,out]  position             Position, which is provided as input and is updated
+     *                                      with output at end of integration step
+     * @param[in,out]  velocity             Velocity, which is provided as input and is updated
+     *                                      with output at end of integration step
+     * @param[in]      stepSize             Step size to take for integration step
+     * @param[in]      computeAcceleration  Function to compute acceleration for current time and
+     *                                      position
+     */
+    template <typename Acceleration>
+    void step(Real& time,
+              State& position,
+              State& velocity,
+              const Real stepSize,
+              const Acceleration& computeAcceleration)
+    {
+        statistics.startStep();
+
+        // The workspace is set up again if the number of elements of the position has changed,
+        // since accelerations may be written in-place.
+        if (workspace.empty()
+            || !detail::hasSameSize(workspace[0], position,
+                                    typename detail::StateTag<State>::type()))
+        {
+            workspace.assign(isFirstSameAsLast ? 2 : 1, position);
+            isAccelerationValid = false;
+        }
+
+        State& acceleration = workspace[0];
+        Real driftedFraction = 0.0;
+        for (int i = 0; i < Coefficients::numberOfStages; ++i)
+        {
+            if (Coefficients::c[i] != 0.0)
+            {
+                computeLinearCombination(position, position, stepSize,
+                                         Coefficients::c[i], velocity);
+                driftedFraction += Coefficients::c[i];
+            }
+
+            if (!(i == 0 && isKeptAccelerationValid(time, position)))
+            {
+                statistics.startStateDerivativeEvaluation();
+                evaluateStateDerivative(computeAcceleration, time + driftedFraction * stepSize,
+                                        position, acceleration);
+                statistics.stopStateDerivativeEvaluation();
+            }
+
+            computeLinearCombination(velocity, velocity, stepSize,
+                                     Coefficients::d[i], acceleration);
+        }
+
+        if (Coefficients::c[Coefficients::numberOfStages] != 0.0)
+        {
+            computeLinearCombination(position, position, stepSize,
+                                     Coefficients::c[Coefficients::numberOfStages], velocity);
+        }
+
+        time += stepSize;
+        keepAcceleration(time, position, std::integral_constant<bool, isFirstSameAsLast>());
+        statistics.recordAcceptedStep(stepSize);
+        statistics.stopStep();
+    }
+
+    //! Reset stepper.
+    /*!
+     * Discards the acceleration that is kept for reuse in the next step, e.g., because the
+     * dynamical model has changed between steps.
+     */
+    void reset()
+    {
+        isAccelerationValid = false;
+    }
+
+    //! Get statistics collected by stepper.
+    const Statistics& getStatistics() const { return statistics; }
+
+    //! Get statistics collected by stepper, e.g., to reset them.
+    Statistics& getStatistics() { return statistics; }
+
+protected:
+private:
+
+    //! Flag that indicates if first kick of step reuses acceleration of last kick of previous step.
+    static const bool isFirstSameAsLast
+        = Coefficients::c[0] == 0.0 && Coefficients::c[Coefficients::numberOfStages] == 0.0;
+
+    //! Check if kept acceleration was evaluated at given time and position.
+    bool isKeptAccelerationValid(const Real time, const State& position) const
+    {
+        return isFirstSameAsLast
+               && isAccelerationValid
+               && time == accelerationTime
+               && detail::isEqualState(
+                   position, workspace[isFirstSameAsLast ? 1 : 0],
+                   std::integral_constant<bool, StateTraits<State>::isIndexable>());
+    }
+
+    //! Keep acceleration of last kick for reuse in first kick of next step.
+    void keepAcceleration(const Real time, const State& position, std::true_type)
+    {
+        workspace[1] = position;
+        accelerationTime = time;
+        isAccelerationValid = true;
+    }
+
+    //! Keep acceleration of last kick (not applicable if scheme is not FSAL).
+    void keepAcceleration(const Real, const State&, std::false_type)
+    { }
+
+    //! Storage for acceleration and position at which kept acceleration was evaluated.
+    std::vector<State> workspace;
+
+    //! Flag that indicates if acceleration for first kick of next step is available.
+    bool isAccelerationValid;
+
+    //! Time at which kept acceleration was evaluated.
+    Real accelerationTime;
+
+    //! Statistics collected by stepper.
+    Statistics statistics;
+};
+
+} // namespace integrate
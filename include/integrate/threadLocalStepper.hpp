@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2014-2025 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+namespace integrate
+{
+
+namespace detail
+{
+
+//! Stepper that is reused by the free step functions of the calling thread.
+/*!
+ * Provides a stepper of given type that is kept per thread, so that the free step functions,
+ * e.g., stepRK4(), only allocate its workspace on the first call of each thread, instead of on
+ * every call. The stepper is reset and its statistics are cleared on construction, so that no
+ * state derivative or statistics are carried over from previous calls. If the stepper of the
+ * thread is already in use, e.g., because a free step function is called from within a state
+ * derivative, a temporary stepper is used instead.
+ *
+ * @tparam  Stepper  Type of stepper, e.g., RK4Stepper
+ */
+template <typename Stepper>
+class ThreadLocalStepper
+{
+public:
+
+    //! Acquire stepper of calling thread, or temporary stepper if it is in use.
+    ThreadLocalStepper()
+        : isShared(!getIsInUse()),
+          stepper(isShared ? getSharedStepper() : temporaryStepper)
+    {
+        if (isShared)
+        {
+            getIsInUse() = true;
+            stepper.reset();
+            stepper.getStatistics().reset();
+        }
+    }
+
+    ThreadLocalStepper(const ThreadLocalStepper&) = delete;
+    ThreadLocalStepper& operator=(const ThreadLocalStepper&) = delete;
+
+    //! Release stepper of calling thread.
+    ~ThreadLocalStepper()
+    {
+        if (isShared)
+        {
+            getIsInUse() = false;
+        }
+    }
+
+    //! Get stepper.
+    Stepper& get() { return stepper; }
+
+protected:
+private:
+
+    //! Get flag that indicates if stepper of calling thread is in use.
+    static bool& getIsInUse()
+    {
+        static thread_local bool isInUse = false;
+        return isInUse;
+    }
+
+    //! Get stepper of calling thread.
+    static Stepper& getSharedStepper()
+    {
+        static thread_local Stepper sharedStepper;
+        return sharedStepper;
+    }
+
+    //! Flag that indicates if stepper of calling thread is used.
+    const bool isShared;
+
+    //! Stepper that is used if stepper of calling thread is in use.
+    Stepper temporaryStepper;
+
+    //! Stepper that is used.
+    Stepper& stepper;
+};
+
+} // namespace detail
+
+} // namespace integrate
@@ -0,0 +1,481 @@
+/*
+ * Copyright (c) 2014-2025 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "integrate/linearCombination.hpp"
+#include "integrate/ringBuffer.hpp"
+
+namespace integrate
+{
+
+//! Writer of trajectories to binary files in columnar layout.
+/*!
+ * Writer that appends samples of a trajectory, i.e., a time and the elements of a state, to a
+ * binary file, in which the samples are stored in chunks of consecutive samples. Within a chunk,
+ * the values are stored per column, i.e., all times, followed by all values of the first state
+ * element, and so on, so that a single quantity can be read contiguously. The writer buffers a
+ * single chunk, so that its memory does not depend on the length of the trajectory. The file
+ * consists of a header, followed by the chunks:
+ *
+ *  - header: magic "ITRJCOL" (8 bytes, including terminating zero), format version (uint32),
+ *    number of bytes per value (uint32), number of state elements n (uint64) and maximum number
+ *    of samples per chunk (uint64)
+ *  - chunk: number of samples m (uint64), followed by m times and m values of each of the n
+ *    state elements, in native byte order
+ *
+ * @tparam  Real  Type for floating-point number
+ */
+template <typename Real>
+class ColumnarTrajectoryWriter
+{
+public:
+
+    //! Version of file format.
+    static const std::uint32_t formatVersion = 1;
+
+    //! Construct writer and write file header.
+    /*!
+     * Constructs writer, creates file with given name (or overwrites existing file) and writes
+     * file header.
+     *
+     * @throws std::invalid_argument  If number of state elements or chunk size is smaller than 1
+     * @throws std::runtime_error     If file cannot be opened
+     *
+     * @param[in]  fileName             Name of trajectory file
+     * @param[in]  numberOfElements     Number of state elements per sample
+     * @param[in]  samplesPerChunk      Maximum number of samples per chunk
+     */
+    ColumnarTrajectoryWriter(const std::string& fileName,
+                             const std::size_t numberOfElements,
+                             const std::size_t samplesPerChunk = 1024)
+        : numberOfElements(numberOfElements),
+          samplesPerChunk(samplesPerChunk),
+          numberOfChunkSamples(0),
+          numberOfSamples(0)
+    {
+        if (numberOfElements < 1 || samplesPerChunk < 1)
+        {
+            throw std::invalid_argument(
+                "Number of state elements and samples per chunk must be at least 1!");
+        }
+        file.open(fileName.c_str(), std::ios::binary | std::ios::trunc);
+        if (!file)
+        {
+            throw std::runtime_error("Trajectory file could not be opened!");
+        }
+        chunk.resize((numberOfElements + 1) * samplesPerChunk);
+
+        const char magic[8] = "ITRJCOL";
+        const std::uint32_t version = formatVersion;
+        const std::uint32_t bytesPerValue = sizeof(Real);
+        const std::uint64_t elements = numberOfElements;
+        const std::uint64_t chunkSize = samplesPerChunk;
+        writeBytes(magic, sizeof(magic));
+        writeBytes(&version, sizeof(version));
+        writeBytes(&bytesPerValue, sizeof(bytesPerValue));
+        writeBytes(&elements, sizeof(elements));
+        writeBytes(&chunkSize, sizeof(chunkSize));
+    }
+
+    //! Write remaining samples and close file.
+    ~ColumnarTrajectoryWriter()
+    {
+        try
+        {
+            flush();
+        }
+        catch (...)
+        { }
+    }
+
+    ColumnarTrajectoryWriter(const ColumnarTrajectoryWriter&) = delete;
+    ColumnarTrajectoryWriter& operator=(const ColumnarTrajectoryWriter&) = delete;
+
+    //! Get number of state elements per sample.
+    std::size_t getNumberOfElements() const { return numberOfElements; }
+
+    //! Get number of samples written, including buffered samples.
+    std::size_t getNumberOfSamples() const { return numberOfSamples; }
+
+    //! Append sample.
+    /*!
+     * Appends sample to current chunk, and writes the chunk to the file if it is full.
+     *
+     * @throws std::runtime_error  If chunk cannot be written
+     *
+     * @param[in]  time      Time of sample
+     * @param[in]  elements  State elements of sample (numberOfElements values)
+     */
+    void write(const Real time, const Real* const elements)
+    {
+        chunk[numberOfChunkSamples] = time;
+        for (std::size_t j = 0; j < numberOfElements; ++j)
+        {
+            chunk[(j + 1) * samplesPerChunk + numberOfChunkSamples] = elements[j];
+        }
+        ++numberOfChunkSamples;
+        ++numberOfSamples;
+        if (numberOfChunkSamples == samplesPerChunk)
+        {
+            writeChunk();
+        }
+    }
+
+    //! Write buffered samples to file.
+    /*!
+     * Writes the current chunk, even if it is not full, and flushes the file.
+     *
+     * @throws std::runtime_error  If chunk cannot be written
+     */
+    void flush()
+    {
+        if (numberOfChunkSamples > 0)
+        {
+            writeChunk();
+        }
+        file.flush();
+        if (!file)
+        {
+            throw std::runtime_error("Trajectory file could not be written!");
+        }
+    }
+
+protected:
+private:
+
+    //! Write current chunk, i.e., the columns of the buffered samples, to file.
+    void writeChunk()
+    {
+        const std::uint64_t count = numberOfChunkSamples;
+        writeBytes(&count, sizeof(count));
+        for (std::size_t column = 0; column <= numberOfElements; ++column)
+        {
+            writeBytes(&chunk[column * samplesPerChunk], numberOfChunkSamples * sizeof(Real));
+        }
+        numberOfChunkSamples = 0;
+    }
+
+    //! Write bytes to file.
+    void writeBytes(const void* const data, const std::size_t size)
+    {
+        file.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+        if (!file)
+        {
+            throw std::runtime_error("Trajectory file could not be written!");
+        }
+    }
+
+    //! Number of state elements per sample.
+    std::size_t numberOfElements;
+
+    //! Maximum number of samples per chunk.
+    std::size_t samplesPerChunk;
+
+    //! Number of samples in current chunk.
+    std::size_t numberOfChunkSamples;
+
+    //! Number of samples written, including buffered samples.
+    std::size_t numberOfSamples;
+
+    //! Values of current chunk, per column.
+    std::vector<Real> chunk;
+
+    //! Trajectory file.
+    std::ofstream file;
+};
+
+//! Read trajectory from binary file in columnar layout.
+/*!
+ * Reads all samples of a trajectory file that was written by ColumnarTrajectoryWriter.
+ *
+ * @throws std::runtime_error  If file cannot be read, or is not a trajectory file of the current
+ *                             format version with values of type Real
+ *
+ * @tparam      Real      Type for floating-point number
+ * @param[in]   fileName  Name of trajectory file
+ * @param[out]  times     Times of samples
+ * @param[out]  elements  State elements of samples, per sample (row-major)
+ * @return                Number of state elements per sample
+ */
+template <typename Real>
+std::size_t readColumnarTrajectory(const std::string& fileName,
+                                   std::vector<Real>& times,
+                                   std::vector<Real>& elements)
+{
+    std::ifstream file(fileName.c_str(), std::ios::binary);
+    const auto readBytes = [&file](void* const data, const std::size_t size)
+    {
+        file.read(static_cast<char*>(data), static_cast<std::streamsize>(size));
+        return static_cast<std::size_t>(file.gcount()) == size;
+    };
+
+    char magic[8];
+    std::uint32_t version = 0;
+    std::uint32_t bytesPerValue = 0;
+    std::uint64_t numberOfElements = 0;
+    std::uint64_t samplesPerChunk = 0;
+    if (!file
+        || !readBytes(magic, sizeof(magic))
+        || std::strncmp(magic, "ITRJCOL", 8) != 0
+        || !readBytes(&version, sizeof(version))
+        || version != ColumnarTrajectoryWriter<Real>::formatVersion
+        || !readBytes(&bytesPerValue, sizeof(bytesPerValue))
+        || bytesPerValue != sizeof(Real)
+        || !readBytes(&numberOfElements, sizeof(numberOfElements))
+        || !readBytes(&samplesPerChunk, sizeof(samplesPerChunk)))
+    {
+        throw std::runtime_error("Trajectory file could not be read!");
+    }
+
+    times.clear();
+    elements.clear();
+    std::vector<Real> column;
+    std::uint64_t count = 0;
+    while (readBytes(&count, sizeof(count)))
+    {
+        if (count < 1 || count > samplesPerChunk)
+        {
+            throw std::runtime_error("Trajectory file could not be read!");
+        }
+        const std::size_t firstSample = times.size();
+        times.resize(firstSample + count);
+        elements.resize((firstSample + count) * numberOfElements);
+        column.resize(count);
+        for (std::size_t j = 0; j <= numberOfElements; ++j)
+        {
+            if (!readBytes(column.data(), count * sizeof(Real)))
+            {
+                throw std::runtime_error("Trajectory file could not be read!");
+            }
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                if (j == 0)
+                {
+                    times[firstSample + i] = column[i];
+                }
+                else
+                {
+                    elements[(firstSample + i) * numberOfElements + j - 1] = column[i];
+                }
+            }
+        }
+    }
+    return static_cast<std::size_t>(numberOfElements);
+}
+
+//! Observer that streams trajectory to binary file from a writer thread.
+/*!
+ * Observer for the integration drivers, e.g., integrateObserved() or integrateDenseOutput(), that
+ * copies the time and the elements of each observed state into a SampleRingBuffer, from which a
+ * writer thread writes them to a file with ColumnarTrajectoryWriter. The integration thread never
+ * performs I/O, allocates, or takes locks; its memory and that of the writer thread are bounded
+ * by the capacity of the ring buffer and the chunk size, regardless of the length of the
+ * trajectory.
+ *
+ * If the ring buffer is full, because the writer thread does not keep up with the integration,
+ * the integration thread waits for space (back-pressure), rather than dropping samples; the number
+ * of samples for which it had to wait is available from getNumberOfStalls(), e.g., to size the
+ * buffer. The writer thread polls the buffer, and sleeps briefly when it is empty.
+ *
+ * @tparam  Real   Type for floating-point number
+ * @tparam  State  Type for state (indexable)
+ */
+template <typename Real, typename State>
+class StreamingTrajectorySink
+{
+public:
+
+    static_assert(StateTraits<State>::isIndexable,
+                  "Streaming trajectory sink requires indexable state");
+
+    //! Construct sink and start writer thread.
+    /*!
+     * Constructs sink, creates trajectory file and starts writer thread.
+     *
+     * @throws std::invalid_argument  If number of state elements, buffer capacity or chunk size is
+     *                                smaller than 1
+     * @throws std::runtime_error     If file cannot be opened
+     *
+     * @param[in]  fileName          Name of trajectory file
+     * @param[in]  numberOfElements  Number of state elements
+     * @param[in]  bufferCapacity    Minimum number of samples in ring buffer
+     * @param[in]  samplesPerChunk   Maximum number of samples per chunk of trajectory file
+     */
+    StreamingTrajectorySink(const std::string& fileName,
+                            const std::size_t numberOfElements,
+                            const std::size_t bufferCapacity = 4096,
+                            const std::size_t samplesPerChunk = 1024)
+        : buffer(new SampleRingBuffer<Real>(bufferCapacity, numberOfElements + 1)),
+          writer(new ColumnarTrajectoryWriter<Real>(fileName, numberOfElements, samplesPerChunk)),
+          sample(numberOfElements + 1),
+          numberOfElements(numberOfElements),
+          numberOfStalls(0),
+          isClosed(false),
+          isWriterFailed(false)
+    {
+        writerThread = std::thread(&StreamingTrajectorySink::runWriter, this);
+    }
+
+    //! Close sink, i.e., write remaining samples and stop writer thread.
+    ~StreamingTrajectorySink()
+    {
+        try
+        {
+            close();
+        }
+        catch (...)
+        { }
+    }
+
+    StreamingTrajectorySink(const StreamingTrajectorySink&) = delete;
+    StreamingTrajectorySink& operator=(const StreamingTrajectorySink&) = delete;
+
+    //! Hand sample to writer thread.
+    /*!
+     * Copies time and state elements into the ring buffer, and waits for space if the buffer is
+     * full.
+     *
+     * @throws std::invalid_argument  If size of state differs from number of state elements
+     * @throws std::runtime_error     If sink is closed, or if writer thread failed to write file
+     *
+     * @param[in]  time   Time of sample
+     * @param[in]  state  State of sample
+     */
+    void operator()(const Real time, const State& state) const
+    {
+        if (static_cast<std::size_t>(state.size()) != numberOfElements)
+        {
+            throw std::invalid_argument("State size differs from number of state elements!");
+        }
+        if (isClosed)
+        {
+            throw std::runtime_error("Trajectory sink is closed!");
+        }
+
+        sample[0] = time;
+        for (std::size_t i = 0; i < numberOfElements; ++i)
+        {
+            sample[i + 1] = state[i];
+        }
+        if (!buffer->tryPush(sample.data()))
+        {
+            ++numberOfStalls;
+            while (!buffer->tryPush(sample.data()))
+            {
+                if (isWriterFailed.load(std::memory_order_acquire))
+                {
+                    throw std::runtime_error("Trajectory file could not be written!");
+                }
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    //! Get number of samples for which the integration thread waited for space in buffer.
+    long getNumberOfStalls() const { return numberOfStalls; }
+
+    //! Close sink.
+    /*!
+     * Waits until the writer thread has written all samples in the buffer, stops it and flushes
+     * the trajectory file. Subsequent calls have no effect.
+     *
+     * @throws std::runtime_error  If writer thread failed to write file
+     */
+    void close()
+    {
+        if (isClosed)
+        {
+            return;
+        }
+        isClosed.store(true, std::memory_order_release);
+        writerThread.join();
+        if (writerException)
+        {
+            std::rethrow_exception(writerException);
+        }
+    }
+
+protected:
+private:
+
+    //! Write samples from buffer to file, until sink is closed and buffer is empty.
+    void runWriter()
+    {
+        std::vector<Real> writerSample(numberOfElements + 1);
+        try
+        {
+            while (true)
+            {
+                if (buffer->tryPop(writerSample.data()))
+                {
+                    writer->write(writerSample[0], &writerSample[1]);
+                }
+                else if (isClosed.load(std::memory_order_acquire))
+                {
+                    // Samples that were pushed before the sink was closed are visible now.
+                    while (buffer->tryPop(writerSample.data()))
+                    {
+                        writer->write(writerSample[0], &writerSample[1]);
+                    }
+                    writer->flush();
+                    return;
+                }
+                else
+                {
+                    std::this_thread::sleep_for(std::chrono::microseconds(50));
+                }
+            }
+        }
+        catch (...)
+        {
+            writerException = std::current_exception();
+            isWriterFailed.store(true, std::memory_order_release);
+        }
+    }
+
+    //! Ring buffer that hands samples from integration thread to writer thread.
+    std::unique_ptr<SampleRingBuffer<Real> > buffer;
+
+    //! Writer of trajectory file, used by writer thread only.
+    std::unique_ptr<ColumnarTrajectoryWriter<Real> > writer;
+
+    //! Storage for sample that is pushed by integration thread.
+    mutable std::vector<Real> sample;
+
+    //! Number of state elements.
+    std::size_t numberOfElements;
+
+    //! Number of samples for which the integration thread waited for space in buffer.
+    mutable long numberOfStalls;
+
+    //! Flag that indicates if sink is closed.
+    std::atomic<bool> isClosed;
+
+    //! Flag that indicates if writer thread failed.
+    std::atomic<bool> isWriterFailed;
+
+    //! Exception thrown by writer thread.
+    std::exception_ptr writerException;
+
+    //! Writer thread.
+    std::thread writerThread;
+};
+
+} // namespace integrate
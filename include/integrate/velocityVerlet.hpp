@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2014-2025 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "integrate/stateDerivative.hpp"
+#include "integrate/symplectic.hpp"
+#include "integrate/threadLocalStepper.hpp"
+
+namespace integrate
+{
+
+//! Coefficients for velocity Verlet (leapfrog) scheme.
+/*!
+ * Drift and kick coefficients for the 2nd-order velocity Verlet scheme, i.e., the kick-drift-kick
+ * form of the leapfrog scheme (Verlet, 1967; Swope et al., 1982). The first and last drift
+ * coefficients are zero, so that an accepted step costs a single acceleration evaluation when the
+ * acceleration is reused by VelocityVerletStepper.
+ *
+ * @tparam  Real  Type for floating-point number
+ */
+template <typename Real>
+struct VelocityVerletCoefficients
+{
+    //! Number of kicks.
+    static const int numberOfStages = 2;
+
+    //! Order of scheme.
+    static const int order = 2;
+
+    //! Drift coefficients.
+    static constexpr Real c[3] = {0.0, 1.0, 0.0};
+
+    //! Kick coefficients.
+    static constexpr Real d[2] = {1.0 / 2.0, 1.0 / 2.0};
+};
+
+template <typename Real> constexpr Real VelocityVerletCoefficients<Real>::c[3];
+template <typename Real> constexpr Real VelocityVerletCoefficients<Real>::d[2];
+
+//! Velocity Verlet stepper.
+/*!
+ * Stepper that executes integration steps using velocity Verlet scheme. The stepper keeps the
+ * acceleration at the end of each step and reuses it for the first kick of the next step. See
+ * SymplecticStepper for details.
+ *
+ * @tparam  Real        Type for floating-point number
+ * @tparam  State       Type for position, velocity and acceleration
+ * @tparam  Statistics  Statistics policy, e.g., NullStatistics or IntegrationStatistics
+ */
+template <typename Real, typename State, typename Statistics = NullStatistics>
+using VelocityVerletStepper
+    = SymplecticStepper<Real, State, VelocityVerletCoefficients<Real>, Statistics>;
+
+//! Execute single integration step using velocity Verlet scheme.
+/*!
+ * Executes single numerical integration step using velocity Verlet scheme. The stepper that holds
+ * the storage for the acceleration is kept per thread and reused across calls, so that memory is
+ * only allocated on the first call of each thread. Since the stepper is reset on each call, the
+ * acceleration at the end of the step is not reused; use VelocityVerletStepper instead to reuse the
+ * acceleration across steps.
+ *
+ * @tparam         Real                 Type for floating-point number
+ * @tparam         State                Type for position, velocity and acceleration
+ * @tparam         Acceleration         Type of callable to compute acceleration, e.g., function
+ *                                      pointer, functor, lambda or StateDerivativeFunction
+ * @param[in,out]  time                 Independent variable, which is provided as input and is
+ *                                      updated with output at end of integration step
+ * @param[in,out]  position             Position, which is provided as input and is updated with
+ *                                      output at end of integration step
+ * @param[in,out]  velocity             Velocity, which is provided as input and is updated with
+ *                                      output at end of integration step
+ * @param[in]      stepSize             Step size to take for integration step
+ * @param[in]      computeAcceleration  Function to compute acceleration for current time and
+ *                                      position
+ */
+template <typename Real, typename State, typename Acceleration>
+const void stepVelocityVerlet(
+    Real& time,
+    State& position,
+    State& velocity,
+    const Real stepSize,
+    const Acceleration& computeAcceleration)
+{
+    detail::ThreadLocalStepper<VelocityVerletStepper<Real, State> > threadLocalStepper;
+    VelocityVerletStepper<Real, State>& stepper = threadLocalStepper.get();
+    stepper.step(time, position, velocity, stepSize, computeAcceleration);
+};
+
+} // namespace integrate
@@ -0,0 +1,276 @@
+/*
+ * Copyright (c) 2014-2025 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#pragma once
+
+#include "integrate/stateDerivative.hpp"
+#include "integrate/symplectic.hpp"
+#include "integrate/threadLocalStepper.hpp"
+
+namespace integrate
+{
+
+//! Coefficients for Yoshida 4th-order scheme.
+/*!
+ * Drift and kick coefficients for the 4th-order Yoshida scheme, i.e., the symmetric composition
+ * of three velocity Verlet steps with weights {w1, w0, w1}, where w1 = 1 / (2 - 2^(1/3)) and
+ * w0 = 1 - 2 w1 (Yoshida, 1990). The drift coefficients are the weights, and the kick coefficients
+ * are the means of consecutive weights, since the kicks of consecutive velocity Verlet steps are
+ * merged. The first and last drift coefficients are zero, so that an accepted step costs three
+ * acceleration evaluations when the acceleration is reused by Yoshida4Stepper.
+ *
+ * @tparam  Real  Type for floating-point number
+ */
+template <typename Real>
+struct Yoshida4Coefficients
+{
+    //! Number of kicks.
+    static const int numberOfStages = 4;
+
+    //! Order of scheme.
+    static const int order = 4;
+
+    //! Drift coefficients.
+    static constexpr Real c[5] = {
+        0.0, 1.35120719195965763404768780897146083, -1.70241438391931526809537561794292165,
+        1.35120719195965763404768780897146083, 0.0
+    };
+
+    //! Kick coefficients.
+    static constexpr Real d[4] = {
+        0.675603595979828817023843904485730413, -0.175603595979828817023843904485730413,
+        -0.175603595979828817023843904485730413, 0.675603595979828817023843904485730413
+    };
+};
+
+template <typename Real> constexpr Real Yoshida4Coefficients<Real>::c[5];
+template <typename Real> constexpr Real Yoshida4Coefficients<Real>::d[4];
+
+//! Coefficients for Yoshida 6th-order scheme.
+/*!
+ * Drift and kick coefficients for the 6th-order Yoshida scheme, i.e., the symmetric composition
+ * of seven velocity Verlet steps with weights {w3, w2, w1, w0, w1, w2, w3} of solution A given by
+ * Yoshida (1990). See Yoshida4Coefficients for the relation between weights and coefficients. An
+ * accepted step costs seven acceleration evaluations when the acceleration is reused by
+ * Yoshida6Stepper.
+ *
+ * @tparam  Real  Type for floating-point number
+ */
+template <typename Real>
+struct Yoshida6Coefficients
+{
+    //! Number of kicks.
+    static const int numberOfStages = 8;
+
+    //! Order of scheme.
+    static const int order = 6;
+
+    //! Drift coefficients.
+    static constexpr Real c[9] = {
+        0.0,
+        0.784513610477557263819497633866375808, 0.235573213359358133684793182978534602,
+        -1.17767998417887100694641568096431573, 1.31518632068391121888424972823881064,
+        -1.17767998417887100694641568096431573, 0.235573213359358133684793182978534602,
+        0.784513610477557263819497633866375808,
+        0.0
+    };
+
+    //! Kick coefficients.
+    static constexpr Real d[8] = {
+        0.392256805238778631909748816933187904, 0.510043411918457698752145408422455205,
+        -0.471053385409756436630811249992890564, 0.0687531682525201059689170236372474550,
+        0.0687531682525201059689170236372474550, -0.471053385409756436630811249992890564,
+        0.510043411918457698752145408422455205, 0.392256805238778631909748816933187904
+    };
+};
+
+template <typename Real> constexpr Real Yoshida6Coefficients<Real>::c[9];
+template <typename Real> constexpr Real Yoshida6Coefficients<Real>::d[8];
+
+//! Coefficients for Yoshida 8th-order scheme.
+/*!
+ * Drift and kick coefficients for the 8th-order Yoshida scheme, i.e., the symmetric composition
+ * of fifteen velocity Verlet steps with weights {w7, ..., w1, w0, w1, ..., w7} of solution D given
+ * by Yoshida (1990). See Yoshida4Coefficients for the relation between weights and coefficients.
+ * An accepted step costs fifteen acceleration evaluations when the acceleration is reused by
+ * Yoshida8Stepper. The weights are only published with 15 significant digits, which limits the
+ * accuracy of the order conditions to about 1e-14.
+ *
+ * @tparam  Real  Type for floating-point number
+ */
+template <typename Real>
+struct Yoshida8Coefficients
+{
+    //! Number of kicks.
+    static const int numberOfStages = 16;
+
+    //! Order of scheme.
+    static const int order = 8;
+
+    //! Drift coefficients.
+    static constexpr Real c[17] = {
+        0.0,
+        0.914844246229740, 0.253693336566229, -1.44485223686048, -0.158240635368243,
+        1.93813913762276, -1.96061023297549, 0.102799849391985, 1.708453070786998,
+        0.102799849391985, -1.96061023297549, 1.93813913762276, -0.158240635368243,
+        -1.44485223686048, 0.253693336566229, 0.914844246229740,
+        0.0
+    };
+
+    //! Kick coefficients.
+    static constexpr Real d[16] = {
+        0.457422123114870, 0.5842687913979845, -0.5955794501471255, -0.8015464361143615,
+        0.8899492511272585, -0.011235547676365, -0.9289051917917525, 0.9056264600894915,
+        0.9056264600894915, -0.9289051917917525, -0.011235547676365, 0.8899492511272585,
+        -0.8015464361143615, -0.5955794501471255, 0.5842687913979845, 0.457422123114870
+    };
+};
+
+template <typename Real> constexpr Real Yoshida8Coefficients<Real>::c[17];
+template <typename Real> constexpr Real Yoshida8Coefficients<Real>::d[16];
+
+//! Yoshida 4th-order stepper.
+/*!
+ * Stepper that executes integration steps using Yoshida 4th-order scheme. See SymplecticStepper
+ * for details.
+ *
+ * @tparam  Real        Type for floating-point number
+ * @tparam  State       Type for position, velocity and acceleration
+ * @tparam  Statistics  Statistics policy, e.g., NullStatistics or IntegrationStatistics
+ */
+template <typename Real, typename State, typename Statistics = NullStatistics>
+using Yoshida4Stepper = SymplecticStepper<Real, State, Yoshida4Coefficients<Real>, Statistics>;
+
+//! Yoshida 6th-order stepper.
+/*!
+ * Stepper that executes integration steps using Yoshida 6th-order scheme. See SymplecticStepper
+ * for details.
+ *
+ * @tparam  Real        Type for floating-point number
+ * @tparam  State       Type for position, velocity and acceleration
+ * @tparam  Statistics  Statistics policy, e.g., NullStatistics or IntegrationStatistics
+ */
+template <typename Real, typename State, typename Statistics = NullStatistics>
+using Yoshida6Stepper = SymplecticStepper<Real, State, Yoshida6Coefficients<Real>, Statistics>;
+
+//! Yoshida 8th-order stepper.
+/*!
+ * Stepper that executes integration steps using Yoshida 8th-order scheme. See SymplecticStepper
+ * for details.
+ *
+ * @tparam  Real        Type for floating-point number
+ * @tparam  State       Type for position, velocity and acceleration
+ * @tparam  Statistics  Statistics policy, e.g., NullStatistics or IntegrationStatistics
+ */
+template <typename Real, typename State, typename Statistics = NullStatistics>
+using Yoshida8Stepper = SymplecticStepper<Real, State, Yoshida8Coefficients<Real>, Statistics>;
+
+//! Execute single integration step using Yoshida 4th-order scheme.
+/*!
+ * Executes single numerical integration step using Yoshida 4th-order scheme. The stepper that holds
+ * the storage for the acceleration is kept per thread and reused across calls, so that memory is
+ * only allocated on the first call of each thread. Since the stepper is reset on each call, the
+ * acceleration at the end of the step is not reused; use Yoshida4Stepper instead to reuse the
+ * acceleration across steps.
+ *
+ * @tparam         Real                 Type for floating-point number
+ * @tparam         State                Type for position, velocity and acceleration
+ * @tparam         Acceleration         Type of callable to compute acceleration, e.g., function
+ *                                      pointer, functor, lambda or StateDerivativeFunction
+ * @param[in,out]  time                 Independent variable, which is provided as input and is
+ *                                      updated with output at end of integration step
+ * @param[in,out]  position             Position, which is provided as input and is updated with
+ *                                      output at end of integration step
+ * @param[in,out]  velocity             Velocity, which is provided as input and is updated with
+ *                                      output at end of integration step
+ * @param[in]      stepSize             Step size to take for integration step
+ * @param[in]      computeAcceleration  Function to compute acceleration for current time and
+ *                                      position
+ */
+template <typename Real, typename State, typename Acceleration>
+const void stepYoshida4(
+    Real& time,
+    State& position,
+    State& velocity,
+    const Real stepSize,
+    const Acceleration& computeAcceleration)
+{
+    detail::ThreadLocalStepper<Yoshida4Stepper<Real, State> > threadLocalStepper;
+    Yoshida4Stepper<Real, State>& stepper = threadLocalStepper.get();
+    stepper.step(time, position, velocity, stepSize, computeAcceleration);
+};
+
+//! Execute single integration step using Yoshida 6th-order scheme.
+/*!
+ * Executes single numerical integration step using Yoshida 6th-order scheme. The stepper that holds
+ * the storage for the acceleration is kept per thread and reused across calls, so that memory is
+ * only allocated on the first call of each thread. Since the stepper is reset on each call, the
+ * acceleration at the end of the step is not reused; use Yoshida6Stepper instead to reuse the
+ * acceleration across steps.
+ *
+ * @tparam         Real                 Type for floating-point number
+ * @tparam         State                Type for position, velocity and acceleration
+ * @tparam         Acceleration         Type of callable to compute acceleration, e.g., function
+ *                                      pointer, functor, lambda or StateDerivativeFunction
+ * @param[in,out]  time                 Independent variable, which is provided as input and is
+ *                                      updated with output at end of integration step
+ * @param[in,out]  position             Position, which is provided as input and is updated with
+ *                                      output at end of integration step
+ * @param[in,out]  velocity             Velocity, which is provided as input and is updated with
+ *                                      output at end of integration step
+ * @param[in]      stepSize             Step size to take for integration step
+ * @param[in]      computeAcceleration  Function to compute acceleration for current time and
+ *                                      position
+ */
+template <typename Real, typename State, typename Acceleration>
+const void stepYoshida6(
+    Real& time,
+    State& position,
+    State& velocity,
+    const Real stepSize,
+    const Acceleration& computeAcceleration)
+{
+    detail::ThreadLocalStepper<Yoshida6Stepper<Real, State> > threadLocalStepper;
+    Yoshida6Stepper<Real, State>& stepper = threadLocalStepper.get();
+    stepper.step(time, position, velocity, stepSize, computeAcceleration);
+};
+
+//! Execute single integration step using Yoshida 8th-order scheme.
+/*!
+ * Executes single numerical integration step using Yoshida 8th-order scheme. The stepper that holds
+ * the storage for the acceleration is kept per thread and reused across calls, so that memory is
+ * only allocated on the first call of each thread. Since the stepper is reset on each call, the
+ * acceleration at the end of the step is not reused; use Yoshida8Stepper instead to reuse the
+ * acceleration across steps.
+ *
+ * @tparam         Real                 Type for floating-point number
+ * @tparam         State                Type for position, velocity and acceleration
+ * @tparam         Acceleration         Type of callable to compute acceleration, e.g., function
+ *                                      pointer, functor, lambda or StateDerivativeFunction
+ * @param[in,out]  time                 Independent variable, which is provided as input and is
+ *                                      updated with output at end of integration step
+ * @param[in,out]  position             Position, which is provided as input and is updated with
+ *                                      output at end of integration step
+ * @param[in,out]  velocity             Velocity, which is provided as input and is updated with
+ *                                      output at end of integration step
+ * @param[in]      stepSize             Step size to take for integration step
+ * @param[in]      computeAcceleration  Function to compute acceleration for current time and
+ *                                      position
+ */
+template <typename Real, typename State, typename Acceleration>
+const void stepYoshida8(
+    Real& time,
+    State& position,
+    State& velocity,
+    const Real stepSize,
+    const Acceleration& computeAcceleration)
+{
+    detail::ThreadLocalStepper<Yoshida8Stepper<Real, State> > threadLocalStepper;
+    Yoshida8Stepper<Real, State>& stepper = threadLocalStepper.get();
+    stepper.step(time, position, velocity, stepSize, computeAcceleration);
+};
+
+} // namespace integrate
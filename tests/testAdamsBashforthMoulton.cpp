@@ -0,0 +1,225 @@
+/*
+ * Copyright (c) 2014-2025 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <array>
+#include <cmath>
+#include <stdexcept>
+
+#include "integrate/adamsBashforthMoulton.hpp"
+#include "integrate/integrateAdaptive.hpp"
+#include "integrate/rkf78.hpp"
+#include "integrate/statistics.hpp"
+#include "integrate/stepSizeControl.hpp"
+
+#include "testDynamicalModels.hpp"
+#include "testState.hpp"
+
+namespace integrate
+{
+namespace tests
+{
+
+//! Statistics collected by steppers.
+typedef IntegrationStatistics<Real> MultistepStatistics;
+
+//! State of planar Kepler orbit, i.e., position and velocity.
+typedef std::array<Real, 4> MultistepOrbitState;
+
+//! Compute state derivative of circular Kepler orbit with unit gravitational parameter.
+void computeMultistepOrbitStateDerivative(const Real,
+                                          const MultistepOrbitState& state,
+                                          MultistepOrbitState& stateDerivative)
+{
+    const Real radius = std::sqrt(state[0] * state[0] + state[1] * state[1]);
+    const Real factor = -1.0 / (radius * radius * radius);
+    stateDerivative[0] = state[2];
+    stateDerivative[1] = state[3];
+    stateDerivative[2] = factor * state[0];
+    stateDerivative[3] = factor * state[1];
+}
+
+//! Integrate circular Kepler orbit over given number of revolutions with adaptive step size.
+/*!
+ * Integrates circular Kepler orbit with unit radius with given stepper, error norm (mixed
+ * tolerance) and PI step size controller, and returns the position error at the final time. The
+ * number of state derivative evaluations is returned as output.
+ */
+template <typename Stepper>
+Real integrateMultistepOrbit(Stepper& stepper,
+                             const int numberOfRevolutions,
+                             const Real tolerance,
+                             long& numberOfEvaluations)
+{
+    const WeightedRootMeanSquareErrorNorm<Real, MultistepOrbitState> errorNorm(tolerance,
+                                                                               tolerance);
+    StepSizeController<Real> controller;
+    const Real finalTime = numberOfRevolutions * 2.0 * 3.14159265358979323846;
+
+    Real time = 0.0;
+    MultistepOrbitState state = {{1.0, 0.0, 0.0, 1.0}};
+    Real stepSize = 1.0e-3;
+    integrateAdaptive(stepper, time, state, stepSize, finalTime,
+                      &computeMultistepOrbitStateDerivative, errorNorm, controller, 1.0e-12, 1.0);
+    numberOfEvaluations = stepper.getStatistics().getNumberOfStateDerivativeEvaluations();
+    return std::sqrt((state[0] - 1.0) * (state[0] - 1.0) + state[1] * state[1]);
+}
+
+TEST_CASE("Test Adams-Bashforth-Moulton integrator for Burden & Faires dynamics",
+          "[adams_bashforth_moulton]")
+{
+    const Real finalTime = 2.0;
+
+    // Analytical solution: y(t) = (t + 1)^2 - 0.5 * exp(t).
+    const Real expectedState = (finalTime + 1.0) * (finalTime + 1.0) - 0.5 * std::exp(finalTime);
+
+    Real time = 0.0;
+    State state({0.5});
+    Real stepSize = 0.01;
+
+    AdamsBashforthMoultonStepper<Real, State, MultistepStatistics> stepper;
+    const int numberOfSteps = integrateAdaptive(stepper, time, state, stepSize, finalTime,
+                                                BurdenFaires(), 1.0e-10, 1.0e-8, 0.5);
+
+    REQUIRE(numberOfSteps > 4);
+    REQUIRE(time == finalTime);
+    REQUIRE(state[0] == Catch::Approx(expectedState).epsilon(1.0e-8));
+    REQUIRE(stepper.getOrder() > 4);
+}
+
+TEST_CASE("Test number of state derivative evaluations of Adams-Bashforth-Moulton integrator",
+          "[adams_bashforth_moulton]")
+{
+    typedef AdamsBashforthMoultonStepper<Real, MultistepOrbitState, MultistepStatistics>
+        MultistepStepper;
+
+    MultistepStepper stepper;
+    long numberOfEvaluations = 0;
+    integrateMultistepOrbit(stepper, 1, 1.0e-10, numberOfEvaluations);
+
+    // One evaluation at the initial state, three RKF78 starting steps with an evaluation for the
+    // history each, two evaluations per accepted predictor-corrector step and one per rejected
+    // attempt.
+    const MultistepStatistics& statistics = stepper.getStatistics();
+    REQUIRE(numberOfEvaluations == 1 + 3 * (13 + 1)
+                                   + 2 * (statistics.getNumberOfAcceptedSteps() - 3)
+                                   + statistics.getNumberOfRejectedSteps());
+}
+
+TEST_CASE("Test Adams-Bashforth-Moulton integrator restarts for new trajectory",
+          "[adams_bashforth_moulton]")
+{
+    Real time = 0.0;
+    MultistepOrbitState state = {{1.0, 0.0, 0.0, 1.0}};
+    Real stepSize = 1.0e-2;
+
+    AdamsBashforthMoultonStepper<Real, MultistepOrbitState, MultistepStatistics> stepper;
+    for (int i = 0; i < 20; ++i)
+    {
+        stepper.step(time, state, stepSize, &computeMultistepOrbitStateDerivative, 1.0e-10,
+                     1.0e-12, 1.0);
+    }
+    REQUIRE(stepper.getOrder() > 4);
+
+    SECTION("Stepper reset between steps")
+    {
+        stepper.reset();
+    }
+
+    SECTION("State changed between steps")
+    {
+        state[2] += 1.0e-3;
+    }
+
+    // The first step of the new trajectory is a starting step, after which the history contains
+    // the state derivatives at the start and at the end of the step.
+    const long numberOfEvaluations
+        = stepper.getStatistics().getNumberOfStateDerivativeEvaluations();
+    stepper.step(time, state, stepSize, &computeMultistepOrbitStateDerivative, 1.0e-10, 1.0e-12,
+                 1.0);
+    REQUIRE(stepper.getOrder() == 2);
+    REQUIRE(stepper.getStatistics().getNumberOfStateDerivativeEvaluations()
+            >= numberOfEvaluations + 15);
+}
+
+TEST_CASE("Test Adams-Bashforth-Moulton integrator reused for state of other size",
+          "[adams_bashforth_moulton]")
+{
+    // The state derivative is written in-place, so that the history must match the size of the
+    // state.
+    const auto computeDecay = [](const Real, const State& state, State& stateDerivative)
+    {
+        for (int i = 0; i < state.size(); ++i)
+        {
+            stateDerivative[i] = -state[i];
+        }
+    };
+
+    Real time = 0.0;
+    State state(Vector(1, 1.0));
+    Real stepSize = 1.0e-2;
+    AdamsBashforthMoultonStepper<Real, State> stepper;
+    for (int i = 0; i < 10; ++i)
+    {
+        stepper.step(time, state, stepSize, computeDecay, 1.0e-10, 1.0e-12, 1.0);
+    }
+
+    time = 0.0;
+    state = State(Vector(8, 1.0));
+    stepSize = 1.0e-2;
+    Real expectedTime = 0.0;
+    State expectedState(Vector(8, 1.0));
+    Real expectedStepSize = 1.0e-2;
+    AdamsBashforthMoultonStepper<Real, State> newStepper;
+    for (int i = 0; i < 10; ++i)
+    {
+        stepper.step(time, state, stepSize, computeDecay, 1.0e-10, 1.0e-12, 1.0);
+        newStepper.step(expectedTime, expectedState, expectedStepSize, computeDecay, 1.0e-10,
+                        1.0e-12, 1.0);
+    }
+    REQUIRE(time == expectedTime);
+    REQUIRE(state == expectedState);
+}
+
+TEST_CASE("Test Adams-Bashforth-Moulton integrator requires fewer evaluations than RKF78",
+          "[adams_bashforth_moulton]")
+{
+    AdamsBashforthMoultonStepper<Real, MultistepOrbitState, MultistepStatistics> multistepStepper;
+    RKF78Stepper<Real, MultistepOrbitState, MultistepStatistics> rkf78Stepper;
+
+    long numberOfMultistepEvaluations = 0;
+    long numberOfRKF78Evaluations = 0;
+    const Real multistepError
+        = integrateMultistepOrbit(multistepStepper, 20, 1.0e-10, numberOfMultistepEvaluations);
+    const Real rkf78Error
+        = integrateMultistepOrbit(rkf78Stepper, 20, 1.0e-12, numberOfRKF78Evaluations);
+
+    // On a long smooth arc, the multistep integrator reaches a similar accuracy with at least five
+    // times fewer evaluations.
+    REQUIRE(multistepError < 1.0e-6);
+    REQUIRE(rkf78Error < 1.0e-6);
+    REQUIRE(5 * numberOfMultistepEvaluations < numberOfRKF78Evaluations);
+}
+
+TEST_CASE("Test Adams-Bashforth-Moulton integrator with invalid settings",
+          "[adams_bashforth_moulton]")
+{
+    REQUIRE_THROWS_AS((AdamsBashforthMoultonStepper<Real, MultistepOrbitState>(0)),
+                      std::invalid_argument);
+
+    Real time = 0.0;
+    MultistepOrbitState state = {{1.0, 0.0, 0.0, 1.0}};
+    Real stepSize = 1.0;
+    AdamsBashforthMoultonStepper<Real, MultistepOrbitState> stepper;
+    REQUIRE_THROWS_AS(stepper.step(time, state, stepSize, &computeMultistepOrbitStateDerivative,
+                                   1.0e-15, 0.5, 1.0),
+                      std::runtime_error);
+}
+
+} // namespace tests
+} // namespace integrate
@@ -0,0 +1,363 @@
+/*
+ * Copyright (c) 2014-2025 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include "integrate/bdf.hpp"
+#include "integrate/gmres.hpp"
+#include "integrate/integrateAdaptive.hpp"
+#include "integrate/rkf45.hpp"
+#include "integrate/statistics.hpp"
+#include "integrate/stepSizeControl.hpp"
+
+#include "testDynamicalModels.hpp"
+#include "testState.hpp"
+
+namespace integrate
+{
+namespace tests
+{
+
+//! Statistics collected by steppers.
+typedef IntegrationStatistics<Real> StiffStatistics;
+
+//! BDF stepper for vector states.
+typedef BDFStepper<Real, Vector, StiffStatistics> VectorBDFStepper;
+
+//! Number of interior grid points of heat equation.
+const int numberOfGridPoints = 50;
+
+//! Pi.
+const Real pi = 3.14159265358979323846;
+
+//! Grid spacing of heat equation on unit interval.
+const Real gridSpacing = 1.0 / (numberOfGridPoints + 1);
+
+//! Compute state derivative of heat equation u_t = u_xx on unit interval, with u = 0 at ends.
+/*!
+ * Computes state derivative of heat equation, discretized with central differences. The
+ * eigenvalues of the discretized operator range from about -pi^2 to -4 / dx^2, so that the step
+ * size of explicit schemes is limited to the order of dx^2.
+ */
+void computeHeatStateDerivative(const Real, const Vector& state, Vector& stateDerivative)
+{
+    const Real scale = 1.0 / (gridSpacing * gridSpacing);
+    for (int i = 0; i < numberOfGridPoints; ++i)
+    {
+        const Real left = i > 0 ? state[i - 1] : 0.0;
+        const Real right = i + 1 < numberOfGridPoints ? state[i + 1] : 0.0;
+        stateDerivative[i] = scale * (left - 2.0 * state[i] + right);
+    }
+}
+
+//! Preconditioner that solves linear system with I - gamma J of heat equation exactly.
+/*!
+ * Preconditioner that solves the tridiagonal linear system with the iteration matrix of the heat
+ * equation with the Thomas algorithm, so that GMRES converges in a single iteration, up to the
+ * error of the finite-difference Jacobian-vector products.
+ */
+class HeatPreconditioner
+{
+public:
+
+    HeatPreconditioner()
+        : upperCoefficients(numberOfGridPoints)
+    { }
+
+    void operator()(const Real,
+                    const Vector&,
+                    const Real gamma,
+                    const Vector& vector,
+                    Vector& result) const
+    {
+        const Real offDiagonal = -gamma / (gridSpacing * gridSpacing);
+        const Real diagonal = 1.0 - 2.0 * offDiagonal;
+
+        // Forward elimination and back substitution.
+        Real pivot = diagonal;
+        result[0] = vector[0] / pivot;
+        for (int i = 1; i < numberOfGridPoints; ++i)
+        {
+            upperCoefficients[i - 1] = offDiagonal / pivot;
+            pivot = diagonal - offDiagonal * upperCoefficients[i - 1];
+            result[i] = (vector[i] - offDiagonal * result[i - 1]) / pivot;
+        }
+        for (int i = numberOfGridPoints - 2; i >= 0; --i)
+        {
+            result[i] -= upperCoefficients[i] * result[i + 1];
+        }
+    }
+
+private:
+
+    //! Storage for upper coefficients of the eliminated system.
+    mutable Vector upperCoefficients;
+};
+
+//! Get initial state of heat equation, i.e., lowest eigenmode sin(pi x).
+Vector getHeatInitialState()
+{
+    Vector state(numberOfGridPoints);
+    for (int i = 0; i < numberOfGridPoints; ++i)
+    {
+        state[i] = std::sin(pi * (i + 1) * gridSpacing);
+    }
+    return state;
+}
+
+//! Get decay rate of lowest eigenmode of discretized heat equation.
+Real getHeatDecayRate()
+{
+    const Real sine = std::sin(0.5 * pi * gridSpacing);
+    return 4.0 * sine * sine / (gridSpacing * gridSpacing);
+}
+
+TEST_CASE("Test GMRES solver for non-symmetric linear system", "[bdf]")
+{
+    // Tridiagonal, non-symmetric matrix with 4 on the diagonal, -1 below and 2 above.
+    const std::size_t size = 10;
+    const auto applyMatrix = [size](const Vector& vector, Vector& result)
+    {
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            result[i] = 4.0 * vector[i];
+            if (i > 0)
+            {
+                result[i] -= vector[i - 1];
+            }
+            if (i + 1 < size)
+            {
+                result[i] += 2.0 * vector[i + 1];
+            }
+        }
+    };
+    const auto applyIdentity = [](const Vector& vector, Vector& result) { result = vector; };
+
+    Vector expectedSolution(size);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        expectedSolution[i] = 1.0 + 0.1 * i;
+    }
+    Vector rightHandSide(size);
+    applyMatrix(expectedSolution, rightHandSide);
+
+    Vector solution(size);
+    int numberOfIterations = 0;
+
+    SECTION("Full Krylov subspace")
+    {
+        detail::GMRESSolver<Real, Vector> solver(10);
+        numberOfIterations = solver.solve(applyMatrix, applyIdentity, rightHandSide, solution,
+                                          1.0e-12, 100);
+
+        // GMRES terminates after at most n iterations in exact arithmetic.
+        REQUIRE(numberOfIterations <= 10);
+    }
+
+    SECTION("Restarted after three iterations")
+    {
+        detail::GMRESSolver<Real, Vector> solver(3);
+        numberOfIterations = solver.solve(applyMatrix, applyIdentity, rightHandSide, solution,
+                                          1.0e-12, 100);
+        REQUIRE(numberOfIterations > 3);
+    }
+
+    REQUIRE(numberOfIterations < 100);
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        REQUIRE(solution[i] == Catch::Approx(expectedSolution[i]).epsilon(1.0e-10));
+    }
+}
+
+TEST_CASE("Test GMRES solver reused for system of other size", "[bdf]")
+{
+    // The product of the diagonal matrix with entries 1, 2, ..., n is written in-place, so that
+    // the Krylov basis must match the size of the system.
+    const auto applyMatrix = [](const Vector& vector, Vector& result)
+    {
+        for (std::size_t i = 0; i < vector.size(); ++i)
+        {
+            result[i] = (i + 1.0) * vector[i];
+        }
+    };
+    const auto applyIdentity = [](const Vector& vector, Vector& result) { result = vector; };
+
+    detail::GMRESSolver<Real, Vector> solver(10);
+    for (std::size_t size = 2; size <= 8; size *= 2)
+    {
+        const Vector rightHandSide(size, 1.0);
+        Vector solution(size);
+        solver.solve(applyMatrix, applyIdentity, rightHandSide, solution, 1.0e-12, 100);
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            REQUIRE(solution[i] == Catch::Approx(1.0 / (i + 1.0)).epsilon(1.0e-10));
+        }
+    }
+}
+
+TEST_CASE("Test BDF integrator for Burden & Faires dynamics", "[bdf]")
+{
+    const Real finalTime = 2.0;
+
+    // Analytical solution: y(t) = (t + 1)^2 - 0.5 * exp(t).
+    const Real expectedState = (finalTime + 1.0) * (finalTime + 1.0) - 0.5 * std::exp(finalTime);
+
+    Real time = 0.0;
+    State state({0.5});
+    Real stepSize = 0.001;
+
+    BDFStepper<Real, State> stepper;
+    integrateAdaptive(stepper, time, state, stepSize, finalTime, BurdenFaires(), 1.0e-6,
+                      1.0e-12, 0.5);
+
+    REQUIRE(time == finalTime);
+    REQUIRE(state[0] == Catch::Approx(expectedState).epsilon(1.0e-5));
+
+    // The order is raised from the starting order 1, at which the step size is small.
+    REQUIRE(stepper.getOrder() > 1);
+}
+
+TEST_CASE("Test BDF integrator for stiff heat equation", "[bdf]")
+{
+    const Real finalTime = 0.1;
+    const WeightedRootMeanSquareErrorNorm<Real, Vector> errorNorm(1.0e-6, 1.0e-6);
+
+    Real time = 0.0;
+    Vector state = getHeatInitialState();
+    Real stepSize = 1.0e-5;
+    StepSizeController<Real> controller;
+    VectorBDFStepper stepper;
+
+    integrateAdaptive(stepper, time, state, stepSize, finalTime, &computeHeatStateDerivative,
+                      errorNorm, controller, 1.0e-12, 1.0);
+    const StiffStatistics& statistics = stepper.getStatistics();
+
+    // The lowest eigenmode decays with the smallest eigenvalue of the discretized operator.
+    const Real decay = std::exp(-getHeatDecayRate() * finalTime);
+    const Vector initialState = getHeatInitialState();
+    REQUIRE(time == Catch::Approx(finalTime));
+    for (int i = 0; i < numberOfGridPoints; ++i)
+    {
+        REQUIRE(state[i] == Catch::Approx(decay * initialState[i]).margin(1.0e-4));
+    }
+
+    // Each Newton iteration evaluates the state derivative at the iterate, and each GMRES
+    // iteration evaluates one Jacobian-vector product; the first predictor uses the state
+    // derivative at the initial state.
+    REQUIRE(statistics.getNumberOfStateDerivativeEvaluations()
+            == 1 + stepper.getNumberOfNewtonIterations()
+               + stepper.getNumberOfLinearIterations());
+
+    // The step size of RKF45 is limited by stability rather than accuracy.
+    Real rkf45Time = 0.0;
+    Vector rkf45State = getHeatInitialState();
+    Real rkf45StepSize = 1.0e-5;
+    StepSizeController<Real> rkf45Controller;
+    RKF45Stepper<Real, Vector, StiffStatistics> rkf45Stepper;
+    integrateAdaptive(rkf45Stepper, rkf45Time, rkf45State, rkf45StepSize, finalTime,
+                      &computeHeatStateDerivative, errorNorm, rkf45Controller, 1.0e-12, 1.0);
+    REQUIRE(10 * statistics.getNumberOfAcceptedSteps()
+            < rkf45Stepper.getStatistics().getNumberOfAcceptedSteps());
+
+    SECTION("Tridiagonal preconditioner")
+    {
+        Real preconditionedTime = 0.0;
+        Vector preconditionedState = getHeatInitialState();
+        Real preconditionedStepSize = 1.0e-5;
+        StepSizeController<Real> preconditionedController;
+        VectorBDFStepper preconditionedStepper;
+        while (preconditionedTime < finalTime)
+        {
+            if (preconditionedTime + preconditionedStepSize > finalTime)
+            {
+                preconditionedStepSize = finalTime - preconditionedTime;
+            }
+            preconditionedStepper.step(preconditionedTime, preconditionedState,
+                                       preconditionedStepSize, &computeHeatStateDerivative,
+                                       HeatPreconditioner(), errorNorm,
+                                       preconditionedController, 1.0e-12, 1.0);
+        }
+
+        for (int i = 0; i < numberOfGridPoints; ++i)
+        {
+            REQUIRE(preconditionedState[i]
+                    == Catch::Approx(decay * initialState[i]).margin(1.0e-4));
+        }
+
+        // The preconditioner inverts the iteration matrix, so that GMRES needs a single iteration
+        // per Newton iteration, instead of several.
+        const Real linearIterationsPerNewtonIteration
+            = static_cast<Real>(stepper.getNumberOfLinearIterations())
+              / stepper.getNumberOfNewtonIterations();
+        const Real preconditionedLinearIterationsPerNewtonIteration
+            = static_cast<Real>(preconditionedStepper.getNumberOfLinearIterations())
+              / preconditionedStepper.getNumberOfNewtonIterations();
+        REQUIRE(preconditionedLinearIterationsPerNewtonIteration == Catch::Approx(1.0));
+        REQUIRE(linearIterationsPerNewtonIteration > 2.0);
+    }
+}
+
+TEST_CASE("Test BDF integrator reused for state of other size", "[bdf]")
+{
+    // The state derivative and the products of the GMRES solver are written in-place, so that the
+    // history and the Krylov basis must match the size of the state.
+    const auto computeDecay = [](const Real, const Vector& state, Vector& stateDerivative)
+    {
+        for (std::size_t i = 0; i < state.size(); ++i)
+        {
+            stateDerivative[i] = -state[i];
+        }
+    };
+
+    Real time = 0.0;
+    Vector state(1, 1.0);
+    Real stepSize = 1.0e-3;
+    BDFStepper<Real, Vector> stepper;
+    for (int i = 0; i < 10; ++i)
+    {
+        stepper.step(time, state, stepSize, computeDecay, 1.0e-6, 1.0e-12, 1.0);
+    }
+
+    time = 0.0;
+    state.assign(8, 1.0);
+    stepSize = 1.0e-3;
+    Real expectedTime = 0.0;
+    Vector expectedState(8, 1.0);
+    Real expectedStepSize = 1.0e-3;
+    BDFStepper<Real, Vector> newStepper;
+    for (int i = 0; i < 10; ++i)
+    {
+        stepper.step(time, state, stepSize, computeDecay, 1.0e-6, 1.0e-12, 1.0);
+        newStepper.step(expectedTime, expectedState, expectedStepSize, computeDecay, 1.0e-6,
+                        1.0e-12, 1.0);
+    }
+    REQUIRE(time == expectedTime);
+    REQUIRE(state == expectedState);
+}
+
+TEST_CASE("Test BDF integrator with invalid settings", "[bdf]")
+{
+    REQUIRE_THROWS_AS((BDFStepper<Real, Vector>(0)), std::invalid_argument);
+    REQUIRE_THROWS_AS((BDFStepper<Real, Vector>(6)), std::invalid_argument);
+    REQUIRE_THROWS_AS((BDFStepper<Real, Vector>(5, 0)), std::invalid_argument);
+
+    Real time = 0.0;
+    Vector state(numberOfGridPoints, 1.0);
+    Real stepSize = 1.0;
+    BDFStepper<Real, Vector> stepper;
+    REQUIRE_THROWS_AS(stepper.step(time, state, stepSize, &computeHeatStateDerivative, 1.0e-15,
+                                   0.5, 1.0),
+                      std::runtime_error);
+}
+
+} // namespace tests
+} // namespace integrate
@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) 2014-2025 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <array>
+#include <cmath>
+#include <stdexcept>
+
+#include "integrate/bulirschStoer.hpp"
+#include "integrate/integrateAdaptive.hpp"
+#include "integrate/rkf78.hpp"
+#include "integrate/statistics.hpp"
+#include "integrate/stepSizeControl.hpp"
+
+#include "testDynamicalModels.hpp"
+#include "testState.hpp"
+
+namespace integrate
+{
+namespace tests
+{
+
+//! Statistics collected by steppers.
+typedef IntegrationStatistics<Real> ExtrapolationStatistics;
+
+//! State of planar Kepler orbit, i.e., position and velocity.
+typedef std::array<Real, 4> ExtrapolationOrbitState;
+
+//! Bulirsch-Stoer stepper for planar Kepler orbit.
+typedef BulirschStoerStepper<Real, ExtrapolationOrbitState, ExtrapolationStatistics>
+    OrbitBulirschStoerStepper;
+
+//! Compute state derivative of Kepler orbit with unit gravitational parameter.
+void computeExtrapolationOrbitStateDerivative(const Real,
+                                              const ExtrapolationOrbitState& state,
+                                              ExtrapolationOrbitState& stateDerivative)
+{
+    const Real radius = std::sqrt(state[0] * state[0] + state[1] * state[1]);
+    const Real factor = -1.0 / (radius * radius * radius);
+    stateDerivative[0] = state[2];
+    stateDerivative[1] = state[3];
+    stateDerivative[2] = factor * state[0];
+    stateDerivative[3] = factor * state[1];
+}
+
+//! Kepler orbit state derivative that throws after given time.
+struct ThrowingOrbitStateDerivative
+{
+    void operator()(const Real time,
+                    const ExtrapolationOrbitState& state,
+                    ExtrapolationOrbitState& stateDerivative) const
+    {
+        if (time > 1.0)
+        {
+            throw std::domain_error("Dynamical model not defined after t = 1!");
+        }
+        computeExtrapolationOrbitStateDerivative(time, state, stateDerivative);
+    }
+};
+
+//! Integrate eccentric Kepler orbit over one revolution with adaptive step size.
+/*!
+ * Integrates Kepler orbit with eccentricity 0.5, starting at periapsis, over one revolution with
+ * given stepper, error norm (mixed tolerance) and PI step size controller, and returns the
+ * position error at the final time, which equals the initial position. The final state is
+ * returned as output.
+ */
+template <typename Stepper>
+Real integrateExtrapolationOrbit(Stepper& stepper,
+                                 const Real tolerance,
+                                 ExtrapolationOrbitState& state)
+{
+    const WeightedRootMeanSquareErrorNorm<Real, ExtrapolationOrbitState> errorNorm(tolerance,
+                                                                                   tolerance);
+    StepSizeController<Real> controller;
+    const Real semiMajorAxis = 1.0;
+    const Real eccentricity = 0.5;
+    const Real finalTime = 2.0 * 3.14159265358979323846;
+    const Real periapsisRadius = semiMajorAxis * (1.0 - eccentricity);
+
+    Real time = 0.0;
+    state[0] = periapsisRadius;
+    state[1] = 0.0;
+    state[2] = 0.0;
+    state[3] = std::sqrt((1.0 + eccentricity) / periapsisRadius);
+    Real stepSize = 1.0e-3;
+    integrateAdaptive(stepper, time, state, stepSize, finalTime,
+                      &computeExtrapolationOrbitStateDerivative, errorNorm, controller, 1.0e-12,
+                      1.0);
+    return std::sqrt((state[0] - periapsisRadius) * (state[0] - periapsisRadius)
+                     + state[1] * state[1]);
+}
+
+TEST_CASE("Test Bulirsch-Stoer integrator for Burden & Faires dynamics", "[bulirsch_stoer]")
+{
+    const Real finalTime = 2.0;
+
+    // Analytical solution: y(t) = (t + 1)^2 - 0.5 * exp(t).
+    const Real expectedState = (finalTime + 1.0) * (finalTime + 1.0) - 0.5 * std::exp(finalTime);
+
+    Real time = 0.0;
+    State state({0.5});
+    Real stepSize = 0.01;
+
+    BulirschStoerStepper<Real, State> stepper;
+    const int numberOfSteps = integrateAdaptive(stepper, time, state, stepSize, finalTime,
+                                                BurdenFaires(), 1.0e-12, 1.0e-8, 1.0);
+
+    REQUIRE(numberOfSteps > 1);
+    REQUIRE(time == finalTime);
+    REQUIRE(state[0] == Catch::Approx(expectedState).epsilon(1.0e-10));
+}
+
+TEST_CASE("Test number of state derivative evaluations of Bulirsch-Stoer integrator",
+          "[bulirsch_stoer]")
+{
+    Real time = 0.0;
+    ExtrapolationOrbitState state = {{1.0, 0.0, 0.0, 1.0}};
+    Real stepSize = 1.0e-2;
+
+    // The first step uses four columns; the state derivative at the start of the step is shared,
+    // so that column j costs 2j - 1 further evaluations.
+    OrbitBulirschStoerStepper stepper;
+    REQUIRE(stepper.getNumberOfColumns() == 4);
+    stepper.step(time, state, stepSize, &computeExtrapolationOrbitStateDerivative, 1.0e-6,
+                 1.0e-12, 1.0);
+
+    REQUIRE(time == 1.0e-2);
+    REQUIRE(stepper.getStatistics().getNumberOfAcceptedSteps() == 1);
+    REQUIRE(stepper.getStatistics().getNumberOfStateDerivativeEvaluations() == 1 + 4 * 4);
+}
+
+TEST_CASE("Test Bulirsch-Stoer integrator requires fewer steps than RKF78 at high accuracy",
+          "[bulirsch_stoer]")
+{
+    OrbitBulirschStoerStepper extrapolationStepper;
+    RKF78Stepper<Real, ExtrapolationOrbitState, ExtrapolationStatistics> rkf78Stepper;
+
+    ExtrapolationOrbitState extrapolationState;
+    ExtrapolationOrbitState rkf78State;
+    const Real extrapolationError
+        = integrateExtrapolationOrbit(extrapolationStepper, 1.0e-13, extrapolationState);
+    const Real rkf78Error = integrateExtrapolationOrbit(rkf78Stepper, 1.0e-13, rkf78State);
+
+    const ExtrapolationStatistics& extrapolationStatistics = extrapolationStepper.getStatistics();
+    const ExtrapolationStatistics& rkf78Statistics = rkf78Stepper.getStatistics();
+    REQUIRE(extrapolationError < 1.0e-10);
+    REQUIRE(rkf78Error < 1.0e-10);
+    REQUIRE(2 * extrapolationStatistics.getNumberOfAcceptedSteps()
+            < rkf78Statistics.getNumberOfAcceptedSteps());
+    REQUIRE(extrapolationStepper.getNumberOfColumns() > 4);
+}
+
+TEST_CASE("Test Bulirsch-Stoer integrator gives same result in parallel mode",
+          "[bulirsch_stoer]")
+{
+    OrbitBulirschStoerStepper sequentialStepper;
+    OrbitBulirschStoerStepper parallelStepper(8, 3);
+    REQUIRE(sequentialStepper.getNumberOfThreads() == 1);
+    REQUIRE(parallelStepper.getNumberOfThreads() == 3);
+
+    ExtrapolationOrbitState sequentialState;
+    ExtrapolationOrbitState parallelState;
+    integrateExtrapolationOrbit(sequentialStepper, 1.0e-12, sequentialState);
+    integrateExtrapolationOrbit(parallelStepper, 1.0e-12, parallelState);
+
+    REQUIRE(parallelState == sequentialState);
+    REQUIRE(parallelStepper.getStatistics().getNumberOfStateDerivativeEvaluations()
+            == sequentialStepper.getStatistics().getNumberOfStateDerivativeEvaluations());
+    REQUIRE(parallelStepper.getStatistics().getNumberOfAcceptedSteps()
+            == sequentialStepper.getStatistics().getNumberOfAcceptedSteps());
+}
+
+TEST_CASE("Test Bulirsch-Stoer integrator reused for state of other size", "[bulirsch_stoer]")
+{
+    // The state derivative is written in-place, so that the workspace must match the size of the
+    // state.
+    const auto computeDecay = [](const Real, const State& state, State& stateDerivative)
+    {
+        for (int i = 0; i < state.size(); ++i)
+        {
+            stateDerivative[i] = -state[i];
+        }
+    };
+
+    Real time = 0.0;
+    State state(Vector(1, 1.0));
+    Real stepSize = 0.1;
+    BulirschStoerStepper<Real, State> stepper;
+    stepper.step(time, state, stepSize, computeDecay, 1.0e-10, 1.0e-12, 1.0);
+
+    // The number of columns is reset, so that the step is the same as the first step of a new
+    // stepper.
+    stepper.reset();
+    time = 0.0;
+    state = State(Vector(8, 1.0));
+    stepSize = 0.1;
+    stepper.step(time, state, stepSize, computeDecay, 1.0e-10, 1.0e-12, 1.0);
+
+    Real expectedTime = 0.0;
+    State expectedState(Vector(8, 1.0));
+    Real expectedStepSize = 0.1;
+    BulirschStoerStepper<Real, State> newStepper;
+    newStepper.step(expectedTime, expectedState, expectedStepSize, computeDecay, 1.0e-10,
+                    1.0e-12, 1.0);
+    REQUIRE(time == expectedTime);
+    REQUIRE(state == expectedState);
+}
+
+TEST_CASE("Test Bulirsch-Stoer integrator with invalid settings", "[bulirsch_stoer]")
+{
+    REQUIRE_THROWS_AS((BulirschStoerStepper<Real, ExtrapolationOrbitState>(3)),
+                      std::invalid_argument);
+
+    Real time = 0.0;
+    ExtrapolationOrbitState state = {{1.0, 0.0, 0.0, 1.0}};
+    Real stepSize = 1.0;
+
+    SECTION("Minimum step size exceeded")
+    {
+        BulirschStoerStepper<Real, ExtrapolationOrbitState> stepper;
+        REQUIRE_THROWS_AS(stepper.step(time, state, stepSize,
+                                       &computeExtrapolationOrbitStateDerivative, 1.0e-15, 0.5,
+                                       1.0),
+                          std::runtime_error);
+    }
+
+    SECTION("Exception thrown by state derivative in parallel mode")
+    {
+        BulirschStoerStepper<Real, ExtrapolationOrbitState> stepper(8, 4);
+        stepSize = 2.0;
+        time = 0.0;
+        REQUIRE_THROWS_AS(stepper.step(time, state, stepSize, ThrowingOrbitStateDerivative(),
+                                       1.0e-6, 1.0e-3, 2.0),
+                          std::domain_error);
+        REQUIRE(time == 0.0);
+    }
+}
+
+} // namespace tests
+} // namespace integrate
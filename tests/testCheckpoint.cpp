@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) 2014-2025 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+
+#include "integrate/adamsBashforthMoulton.hpp"
+#include "integrate/bdf.hpp"
+#include "integrate/checkpoint.hpp"
+#include "integrate/dopri5.hpp"
+#include "integrate/integrateAdaptive.hpp"
+#include "integrate/rkf45.hpp"
+#include "integrate/statistics.hpp"
+#include "integrate/stepSizeControl.hpp"
+
+#include "testState.hpp"
+
+namespace integrate
+{
+namespace tests
+{
+
+//! Name of checkpoint file written by tests.
+const std::string checkpointFileName = "testCheckpoint.bin";
+
+//! Compute state derivative of Van der Pol oscillator with mu = 1, with state (x, x').
+const State computeVanDerPolStateDerivative(const Real, const State& state)
+{
+    return State({state[1], (1.0 - state[0] * state[0]) * state[1] - state[0]});
+}
+
+//! Check that integration restored from checkpoint continues bit-identically.
+/*!
+ * Integrates to t = 5 with the given stepper, takes a checkpoint and saves it to file, and
+ * continues to t = 10. The other stepper, which is constructed in the same way, is restored from
+ * the checkpoint file and continues to t = 10 as well.
+ */
+template <typename Stepper>
+void checkRestart(Stepper& stepper, Stepper& restoredStepper)
+{
+    const WeightedRootMeanSquareErrorNorm<Real, State> errorNorm(1.0e-8, 1.0e-8);
+
+    Real time = 0.0;
+    State state({2.0, 0.0});
+    Real stepSize = 0.01;
+    StepSizeController<Real> controller;
+    integrateAdaptive(stepper, time, state, stepSize, 5.0, &computeVanDerPolStateDerivative,
+                      errorNorm, controller, 1.0e-12, 1.0);
+
+    Checkpoint<Real> checkpoint;
+    saveCheckpoint(checkpoint, time, state, stepSize, stepper, controller);
+    checkpoint.save(checkpointFileName);
+
+    integrateAdaptive(stepper, time, state, stepSize, 10.0, &computeVanDerPolStateDerivative,
+                      errorNorm, controller, 1.0e-12, 1.0);
+
+    Checkpoint<Real> loadedCheckpoint;
+    loadedCheckpoint.load(checkpointFileName);
+    std::remove(checkpointFileName.c_str());
+    REQUIRE(loadedCheckpoint.getSize() == checkpoint.getSize());
+
+    Real restoredTime = 0.0;
+    State restoredState({0.0, 0.0});
+    Real restoredStepSize = 0.0;
+    StepSizeController<Real> restoredController;
+    restoreCheckpoint(loadedCheckpoint, restoredTime, restoredState, restoredStepSize,
+                      restoredStepper, restoredController);
+    REQUIRE(restoredTime == 5.0);
+    integrateAdaptive(restoredStepper, restoredTime, restoredState, restoredStepSize, 10.0,
+                      &computeVanDerPolStateDerivative, errorNorm, restoredController, 1.0e-12,
+                      1.0);
+
+    REQUIRE(restoredTime == time);
+    REQUIRE(restoredState[0] == state[0]);
+    REQUIRE(restoredState[1] == state[1]);
+    REQUIRE(restoredStepSize == stepSize);
+
+    const IntegrationStatistics<Real>& statistics = stepper.getStatistics();
+    const IntegrationStatistics<Real>& restoredStatistics = restoredStepper.getStatistics();
+    REQUIRE(restoredStatistics.getNumberOfStateDerivativeEvaluations()
+            == statistics.getNumberOfStateDerivativeEvaluations());
+    REQUIRE(restoredStatistics.getNumberOfAcceptedSteps() == statistics.getNumberOfAcceptedSteps());
+    REQUIRE(restoredStatistics.getNumberOfRejectedSteps() == statistics.getNumberOfRejectedSteps());
+    REQUIRE(restoredStatistics.getMeanStepSize() == statistics.getMeanStepSize());
+}
+
+TEST_CASE("Test restart of integration from checkpoint", "[checkpoint]")
+{
+    typedef IntegrationStatistics<Real> Statistics;
+
+    SECTION("DOPRI5 (FSAL state derivative)")
+    {
+        DOPRI5Stepper<Real, State, Statistics> stepper;
+        DOPRI5Stepper<Real, State, Statistics> restoredStepper;
+        checkRestart(stepper, restoredStepper);
+    }
+
+    SECTION("DOPRI5 restored into stepper that was used for state of other size")
+    {
+        DOPRI5Stepper<Real, State, Statistics> stepper;
+        DOPRI5Stepper<Real, State, Statistics> restoredStepper;
+        Real time = 0.0;
+        State state({1.0});
+        restoredStepper.step(time, state, 0.1, [](const Real, const State& x) { return x; });
+        checkRestart(stepper, restoredStepper);
+    }
+
+    SECTION("Adams-Bashforth-Moulton (history of state derivatives)")
+    {
+        AdamsBashforthMoultonStepper<Real, State, Statistics> stepper;
+        AdamsBashforthMoultonStepper<Real, State, Statistics> restoredStepper;
+        checkRestart(stepper, restoredStepper);
+        REQUIRE(restoredStepper.getOrder() == stepper.getOrder());
+    }
+
+    SECTION("BDF (history of states)")
+    {
+        BDFStepper<Real, State, Statistics> stepper;
+        BDFStepper<Real, State, Statistics> restoredStepper;
+        checkRestart(stepper, restoredStepper);
+        REQUIRE(restoredStepper.getOrder() == stepper.getOrder());
+        REQUIRE(restoredStepper.getNumberOfNewtonIterations()
+                == stepper.getNumberOfNewtonIterations());
+    }
+}
+
+TEST_CASE("Test invalid checkpoints", "[checkpoint]")
+{
+    Real time = 1.0;
+    State state({2.0, 0.0});
+    Real stepSize = 0.1;
+    AdamsBashforthMoultonStepper<Real, State> stepper;
+    integrateAdaptive(stepper, time, state, stepSize, 2.0, &computeVanDerPolStateDerivative,
+                      1.0e-8, 1.0e-12, 1.0);
+
+    Checkpoint<Real> checkpoint;
+    saveCheckpoint(checkpoint, time, state, stepSize, stepper);
+
+    // Snapshots reuse the storage of the checkpoint and replace its data.
+    const std::size_t size = checkpoint.getSize();
+    saveCheckpoint(checkpoint, time, state, stepSize, stepper);
+    REQUIRE(checkpoint.getSize() == size);
+
+    SECTION("State size differs")
+    {
+        State largerState({0.0, 0.0, 0.0});
+        AdamsBashforthMoultonStepper<Real, State> restoredStepper;
+        REQUIRE_THROWS_AS(restoreCheckpoint(checkpoint, time, largerState, stepSize,
+                                            restoredStepper),
+                          std::runtime_error);
+    }
+
+    SECTION("Checkpoint contains other components")
+    {
+        StepSizeController<Real> controller;
+        saveCheckpoint(checkpoint, time, state, stepSize, stepper, controller);
+        AdamsBashforthMoultonStepper<Real, State> restoredStepper;
+        REQUIRE_THROWS_AS(restoreCheckpoint(checkpoint, time, state, stepSize, restoredStepper),
+                          std::runtime_error);
+    }
+
+    SECTION("Checkpoint written by stepper with other configuration")
+    {
+        // The stepper with dense output keeps the state derivative at the end of the step, which
+        // the stepper without dense output has no storage for.
+        RKF45Stepper<Real, State> denseOutputStepper(true);
+        Real denseOutputTime = 1.0;
+        State denseOutputState({2.0, 0.0});
+        Real denseOutputStepSize = 0.1;
+        integrateAdaptive(denseOutputStepper, denseOutputTime, denseOutputState,
+                          denseOutputStepSize, 2.0, &computeVanDerPolStateDerivative, 1.0e-8,
+                          1.0e-12, 1.0);
+        Checkpoint<Real> denseOutputCheckpoint;
+        saveCheckpoint(denseOutputCheckpoint, denseOutputTime, denseOutputState,
+                       denseOutputStepSize, denseOutputStepper);
+
+        RKF45Stepper<Real, State> restoredStepper;
+        REQUIRE_THROWS_AS(restoreCheckpoint(denseOutputCheckpoint, time, state, stepSize,
+                                            restoredStepper),
+                          std::runtime_error);
+
+        DOPRI5Stepper<Real, State> otherTableauStepper;
+        REQUIRE_THROWS_AS(restoreCheckpoint(denseOutputCheckpoint, time, state, stepSize,
+                                            otherTableauStepper),
+                          std::runtime_error);
+
+        RKF45Stepper<Real, State> matchingStepper(true);
+        restoreCheckpoint(denseOutputCheckpoint, time, state, stepSize, matchingStepper);
+        REQUIRE(time == denseOutputTime);
+    }
+
+    SECTION("Checkpoint files")
+    {
+        REQUIRE_THROWS_AS(checkpoint.load(checkpointFileName), std::runtime_error);
+        REQUIRE_THROWS_AS(checkpoint.save("missingDirectory/checkpoint.bin"), std::runtime_error);
+
+        // An existing checkpoint file is replaced.
+        checkpoint.save(checkpointFileName);
+        checkpoint.save(checkpointFileName);
+        Checkpoint<Real> loadedCheckpoint;
+        loadedCheckpoint.load(checkpointFileName);
+        REQUIRE(loadedCheckpoint.getSize() == size);
+
+        // The reader checks the type of the values.
+        Checkpoint<float> floatCheckpoint;
+        REQUIRE_THROWS_AS(floatCheckpoint.load(checkpointFileName), std::runtime_error);
+
+        std::FILE* const file = std::fopen(checkpointFileName.c_str(), "ab");
+        std::fputc(0, file);
+        std::fclose(file);
+        REQUIRE_THROWS_AS(loadedCheckpoint.load(checkpointFileName), std::runtime_error);
+        REQUIRE(loadedCheckpoint.getSize() == 0);
+        std::remove(checkpointFileName.c_str());
+    }
+}
+
+} // namespace tests
+} // namespace integrate
@@ -0,0 +1,249 @@
+/*
+ * Copyright (c) 2014-2025 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <cmath>
+
+#include "integrate/dopri5.hpp"
+#include "integrate/rkf45.hpp"
+
+#include "testDynamicalModels.hpp"
+#include "testState.hpp"
+
+namespace integrate
+{
+namespace tests
+{
+
+TEST_CASE("Test Dormand-Prince 5(4) integrator for zero dynamics lambda", "[dopri5]")
+{
+    const Real initialTime = 1.0;
+    const State initialState({1.2, 2.3, -3.6});
+    const Real initialStepSize = 0.1;
+    const Real tolerance = 1.0e-6;
+    const Real minimumStepSize = 0.01;
+    const Real maximumStepSize = 1.0;
+
+    Real currentTime = initialTime;
+    State currentState = initialState;
+    Real currentStepSize = initialStepSize;
+
+    auto computeStateDerivative = [](const Real, const State&)
+    {
+        return State({0.0, 0.0, 0.0});
+    };
+    stepDOPRI5<Real, State>(currentTime,
+                            currentState,
+                            currentStepSize,
+                            computeStateDerivative,
+                            tolerance,
+                            minimumStepSize,
+                            maximumStepSize);
+
+    REQUIRE(currentTime  == (initialTime + initialStepSize));
+    REQUIRE(currentState == initialState);
+}
+
+TEST_CASE("Test Dormand-Prince 5(4) stepper using Burden & Faires analytical solution",
+          "[dopri5]")
+{
+    const Real initialTime = 0.0;
+    const State initialState({0.5});
+    const Real initialStepSize = 0.25;
+    const Real tolerance = 1.0e-5;
+    const Real minimumStepSize = 0.01;
+    const Real maximumStepSize = 0.25;
+    const Real finalTime = 2.0;
+
+    const Real testTolerance = 1.0e-5;
+
+    Real currentTime = initialTime;
+    State currentState = initialState;
+    Real currentStepSize = initialStepSize;
+
+    DOPRI5Stepper<Real, State> stepper;
+    while (currentTime < finalTime)
+    {
+        stepper.step(currentTime,
+                     currentState,
+                     currentStepSize,
+                     BurdenFaires(),
+                     tolerance,
+                     minimumStepSize,
+                     maximumStepSize);
+
+        // Analytical solution: y(t) = (t + 1)^2 - 0.5 * exp(t).
+        const Real expectedState = (currentTime + 1.0) * (currentTime + 1.0)
+                                   - 0.5 * std::exp(currentTime);
+        REQUIRE(currentState[0] == Catch::Approx(expectedState).epsilon(testTolerance));
+    }
+}
+
+TEST_CASE("Test Dormand-Prince 5(4) stepper reuses last stage of accepted step", "[dopri5]")
+{
+    const Real initialTime = 0.0;
+    const State initialState({0.5});
+    const Real stepSize = 0.1;
+    const int numberOfSteps = 10;
+
+    int numberOfEvaluations = 0;
+    auto computeStateDerivative = [&numberOfEvaluations](const Real time, const State& state)
+    {
+        ++numberOfEvaluations;
+        return BurdenFaires()(time, state);
+    };
+
+    Real currentTime = initialTime;
+    State currentState = initialState;
+
+    DOPRI5Stepper<Real, State> stepper;
+    for (int i = 0; i < numberOfSteps; ++i)
+    {
+        stepper.step(currentTime, currentState, stepSize, computeStateDerivative);
+    }
+
+    // All stages are evaluated for the first step; all subsequent steps reuse the last stage.
+    REQUIRE(numberOfEvaluations == 7 + (numberOfSteps - 1) * 6);
+
+    // Reused stages yield the same solution as a stepper that evaluates all stages for each step.
+    Real referenceTime = initialTime;
+    State referenceState = initialState;
+    for (int i = 0; i < numberOfSteps; ++i)
+    {
+        DOPRI5Stepper<Real, State> referenceStepper;
+        referenceStepper.step(referenceTime, referenceState, stepSize, BurdenFaires());
+    }
+
+    REQUIRE(currentTime == Catch::Approx(referenceTime));
+    REQUIRE(currentState[0] == Catch::Approx(referenceState[0]).epsilon(1.0e-14));
+
+    // The last stage is not reused if the state is changed between steps.
+    numberOfEvaluations = 0;
+    currentState[0] += 1.0;
+    stepper.step(currentTime, currentState, stepSize, computeStateDerivative);
+    REQUIRE(numberOfEvaluations == 7);
+
+    // The last stage is not reused after the stepper is reset.
+    numberOfEvaluations = 0;
+    stepper.reset();
+    stepper.step(currentTime, currentState, stepSize, computeStateDerivative);
+    REQUIRE(numberOfEvaluations == 7);
+}
+
+TEST_CASE("Test Dormand-Prince 5(4) stepper does not reuse last stage of rejected step",
+          "[dopri5]")
+{
+    const Real initialTime = 0.0;
+    const State initialState({0.5});
+    const Real tolerance = 1.0e-12;
+    const Real minimumStepSize = 1.0e-6;
+    const Real maximumStepSize = 1.0;
+
+    Real currentTime = initialTime;
+    State currentState = initialState;
+
+    // The first step is rejected, because the initial step size is too large for the tolerance.
+    Real currentStepSize = 1.0;
+
+    DOPRI5Stepper<Real, State> stepper;
+    stepper.step(currentTime,
+                 currentState,
+                 currentStepSize,
+                 BurdenFaires(),
+                 tolerance,
+                 minimumStepSize,
+                 maximumStepSize);
+
+    const Real expectedState = (currentTime + 1.0) * (currentTime + 1.0)
+                               - 0.5 * std::exp(currentTime);
+    REQUIRE(currentTime < 1.0);
+    REQUIRE(currentState[0] == Catch::Approx(expectedState).epsilon(1.0e-8));
+}
+
+TEST_CASE("Test Dormand-Prince 5(4) stepper against Runge-Kutta-Fehlberg 4(5) stepper",
+          "[dopri5]")
+{
+    const Real initialTime = 0.0;
+    const State initialState({0.5});
+    const Real stepSize = 0.2;
+    const int numberOfSteps = 10;
+
+    int numberOfEvaluationsDOPRI5 = 0;
+    auto computeStateDerivativeDOPRI5
+        = [&numberOfEvaluationsDOPRI5](const Real time, const State& state)
+    {
+        ++numberOfEvaluationsDOPRI5;
+        return BurdenFaires()(time, state);
+    };
+
+    int numberOfEvaluationsRKF45 = 0;
+    auto computeStateDerivativeRKF45
+        = [&numberOfEvaluationsRKF45](const Real time, const State& state)
+    {
+        ++numberOfEvaluationsRKF45;
+        return BurdenFaires()(time, state);
+    };
+
+    Real currentTimeDOPRI5 = initialTime;
+    State currentStateDOPRI5 = initialState;
+    DOPRI5Stepper<Real, State> stepperDOPRI5;
+
+    Real currentTimeRKF45 = initialTime;
+    State currentStateRKF45 = initialState;
+    RKF45Stepper<Real, State> stepperRKF45;
+
+    for (int i = 0; i < numberOfSteps; ++i)
+    {
+        stepperDOPRI5.step(
+            currentTimeDOPRI5, currentStateDOPRI5, stepSize, computeStateDerivativeDOPRI5);
+        stepperRKF45.step(
+            currentTimeRKF45, currentStateRKF45, stepSize, computeStateDerivativeRKF45);
+    }
+
+    // Analytical solution: y(t) = (t + 1)^2 - 0.5 * exp(t).
+    const Real finalTime = initialTime + numberOfSteps * stepSize;
+    const Real expectedState = (finalTime + 1.0) * (finalTime + 1.0) - 0.5 * std::exp(finalTime);
+    const Real errorDOPRI5 = std::fabs(currentStateDOPRI5[0] - expectedState);
+    const Real errorRKF45 = std::fabs(currentStateRKF45[0] - expectedState);
+
+    // Both steppers take 6 evaluations per step (apart from the first step for Dormand-Prince),
+    // but Dormand-Prince propagates the 5th-order solution and is thus more accurate.
+    REQUIRE(numberOfEvaluationsRKF45 == 6 * numberOfSteps);
+    REQUIRE(numberOfEvaluationsDOPRI5 == 6 * numberOfSteps + 1);
+    REQUIRE(errorDOPRI5 < 0.1 * errorRKF45);
+}
+
+TEST_CASE("Test Dormand-Prince 5(4) stepper reused for state of other size", "[dopri5]")
+{
+    auto computeDecay = [](const Real, const State& state, State& stateDerivative)
+    {
+        for (int i = 0; i < state.size(); ++i)
+        {
+            stateDerivative[i] = -state[i];
+        }
+    };
+
+    Real time = 0.0;
+    State state({1.0});
+    DOPRI5Stepper<Real, State> stepper;
+    stepper.step(time, state, 0.1, computeDecay);
+
+    // The step starts at the time at which the previous step ended, but the last stage of the
+    // previous step is not reused, since the number of elements of the state has changed.
+    State largerState({1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0});
+    stepper.step(time, largerState, 0.1, computeDecay);
+
+    Real expectedTime = 0.1;
+    State expectedState({1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0});
+    DOPRI5Stepper<Real, State> newStepper;
+    newStepper.step(expectedTime, expectedState, 0.1, computeDecay);
+    REQUIRE(largerState == expectedState);
+}
+
+} // namespace tests
+} // namespace integrate
@@ -0,0 +1,244 @@
+/*
+ * Copyright (c) 2014-2025 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include "integrate/denseOutput.hpp"
+#include "integrate/dopri5.hpp"
+#include "integrate/integrateAdaptive.hpp"
+#include "integrate/rkf45.hpp"
+#include "integrate/rkf78.hpp"
+#include "integrate/statistics.hpp"
+
+#include "testDynamicalModels.hpp"
+#include "testState.hpp"
+
+namespace integrate
+{
+namespace tests
+{
+
+//! Compute analytical solution of Burden & Faires dynamics, with y(0) = 0.5.
+Real computeBurdenFairesSolution(const Real time)
+{
+    return (time + 1.0) * (time + 1.0) - 0.5 * std::exp(time);
+}
+
+//! Compute error of dense output at middle of single step of given size from t = 0.
+/*!
+ * Computes the error of the state interpolated at the middle of a single accepted step of the
+ * Burden & Faires dynamics with given size, with respect to the analytical solution.
+ */
+template <typename Stepper>
+Real computeMidpointError(Stepper& stepper, const Real stepSize)
+{
+    Real time = 0.0;
+    State state({0.5});
+    Real currentStepSize = stepSize;
+
+    // The tolerance is large, so that the step is accepted with the given step size.
+    stepper.step(time, state, currentStepSize, BurdenFaires(), 1.0e3, stepSize, stepSize);
+    REQUIRE(time == stepSize);
+
+    State interpolatedState({0.0});
+    stepper.interpolate(0.5 * stepSize, interpolatedState);
+    return std::fabs(interpolatedState[0] - computeBurdenFairesSolution(0.5 * stepSize));
+}
+
+TEST_CASE("Test cubic Hermite interpolation of cubic polynomial", "[denseOutput]")
+{
+    // Polynomial y(t) = t^3 - 2 t + 1 and derivative y'(t) = 3 t^2 - 2 on [1, 1.5].
+    const Real startTime = 1.0;
+    const Real stepSize = 0.5;
+    const Real endTime = startTime + stepSize;
+    const State startState({startTime * startTime * startTime - 2.0 * startTime + 1.0});
+    const State startDerivative({3.0 * startTime * startTime - 2.0});
+    const State endState({endTime * endTime * endTime - 2.0 * endTime + 1.0});
+    const State endDerivative({3.0 * endTime * endTime - 2.0});
+
+    State result({0.0});
+    for (int i = 0; i <= 4; ++i)
+    {
+        const Real stepFraction = 0.25 * i;
+        const Real time = startTime + stepFraction * stepSize;
+        computeHermiteInterpolation(result, stepFraction, stepSize, startState, startDerivative,
+                                    endState, endDerivative);
+        REQUIRE(result[0] == Catch::Approx(time * time * time - 2.0 * time + 1.0));
+    }
+}
+
+TEST_CASE("Test dense output of Dormand-Prince 5(4) stepper", "[denseOutput]")
+{
+    SECTION("Interpolant matches states at ends of steps")
+    {
+        Real time = 0.0;
+        State state({0.5});
+        Real stepSize = 0.1;
+        DOPRI5Stepper<Real, State> stepper;
+        State interpolatedState({0.0});
+
+        for (int i = 0; i < 5; ++i)
+        {
+            const Real startTime = time;
+            const State startState = state;
+            stepper.step(time, state, stepSize, BurdenFaires(), 1.0e-8, 1.0e-12, 1.0);
+
+            stepper.interpolate(startTime, interpolatedState);
+            REQUIRE(interpolatedState[0] == Catch::Approx(startState[0]).epsilon(1.0e-14));
+            stepper.interpolate(time, interpolatedState);
+            REQUIRE(interpolatedState[0] == Catch::Approx(state[0]).epsilon(1.0e-14));
+            stepper.interpolate(0.5 * (startTime + time), interpolatedState);
+            REQUIRE(interpolatedState[0]
+                    == Catch::Approx(computeBurdenFairesSolution(0.5 * (startTime + time)))
+                           .epsilon(1.0e-8));
+        }
+    }
+
+    SECTION("Continuous extension is 4th-order accurate")
+    {
+        // The local error of a 4th-order interpolant decreases by a factor 2^5 when the step size
+        // is halved.
+        DOPRI5Stepper<Real, State> stepper;
+        const Real error = computeMidpointError(stepper, 0.4);
+        const Real halvedError = computeMidpointError(stepper, 0.2);
+        REQUIRE(error / halvedError > 24.0);
+    }
+
+    SECTION("Dense output is discarded if step fails")
+    {
+        Real time = 0.0;
+        State state({0.5});
+        Real stepSize = 0.1;
+        DOPRI5Stepper<Real, State> stepper;
+        stepper.step(time, state, stepSize, BurdenFaires(), 1.0e-8, 1.0e-12, 1.0);
+
+        // The tolerance cannot be met without reducing the step size below the minimum.
+        State interpolatedState({0.0});
+        REQUIRE_THROWS_AS(stepper.step(time, state, stepSize, BurdenFaires(), 1.0e-20,
+                                       stepSize, stepSize),
+                          std::runtime_error);
+        REQUIRE_THROWS_AS(stepper.interpolate(time, interpolatedState), std::runtime_error);
+        REQUIRE_THROWS_AS(stepper.getEndStateDerivative(), std::runtime_error);
+    }
+}
+
+TEST_CASE("Test dense output of stepper for tableau that is not FSAL", "[denseOutput]")
+{
+    typedef IntegrationStatistics<Real> Statistics;
+
+    SECTION("Dense output is not available unless it is enabled")
+    {
+        Real time = 0.0;
+        State state({0.5});
+        Real stepSize = 0.1;
+        RKF45Stepper<Real, State> stepper;
+        State interpolatedState({0.0});
+        REQUIRE_THROWS_AS(stepper.interpolate(0.0, interpolatedState), std::runtime_error);
+        stepper.step(time, state, stepSize, BurdenFaires(), 1.0e-6, 1.0e-12, 1.0);
+        REQUIRE_THROWS_AS(stepper.interpolate(0.5 * time, interpolatedState),
+                          std::runtime_error);
+
+        RKF45Stepper<Real, State> enabledStepper(true);
+        enabledStepper.step(time, state, stepSize, BurdenFaires(), 1.0e-6, 1.0e-12, 1.0);
+        enabledStepper.step(time, state, 0.1, BurdenFaires());
+        REQUIRE_THROWS_AS(enabledStepper.interpolate(time, interpolatedState),
+                          std::runtime_error);
+    }
+
+    SECTION("Cubic Hermite interpolation is 3rd-order accurate")
+    {
+        // The local error of a 3rd-order interpolant decreases by a factor 2^4 when the step size
+        // is halved.
+        RKF78Stepper<Real, State> stepper(true);
+        const Real error = computeMidpointError(stepper, 0.4);
+        const Real halvedError = computeMidpointError(stepper, 0.2);
+        REQUIRE(error / halvedError > 12.0);
+    }
+
+    SECTION("State derivative at end of step is reused as first stage of next step")
+    {
+        Real time = 0.0;
+        State state({0.5});
+        Real stepSize = 0.1;
+        RKF45Stepper<Real, State, Statistics> stepper(true);
+        integrateAdaptive(stepper, time, state, stepSize, 2.0, BurdenFaires(), 1.0e-6, 1.0e-12,
+                          1.0);
+
+        // The first stage is evaluated once at the start, and the state derivative at the end of
+        // each accepted step is evaluated once, instead of the first stage of the next step.
+        const Statistics& statistics = stepper.getStatistics();
+        REQUIRE(statistics.getNumberOfStateDerivativeEvaluations()
+                == 1 + 5 * (statistics.getNumberOfAcceptedSteps()
+                            + statistics.getNumberOfRejectedSteps())
+                   + statistics.getNumberOfAcceptedSteps());
+    }
+}
+
+TEST_CASE("Test integration with output at fixed times", "[denseOutput]")
+{
+    // Output at intervals of 0.01 on [0, 2], which are much smaller than the step size.
+    std::vector<Real> outputTimes;
+    for (int i = 0; i <= 200; ++i)
+    {
+        outputTimes.push_back(0.01 * i);
+    }
+
+    std::vector<Real> reportedTimes;
+    std::vector<Real> reportedStates;
+    const auto observe = [&](const Real time, const State& state)
+    {
+        reportedTimes.push_back(time);
+        reportedStates.push_back(state[0]);
+    };
+
+    Real time = 0.0;
+    State state({0.5});
+    Real stepSize = 0.01;
+    DOPRI5Stepper<Real, State> stepper;
+    const int numberOfSteps = integrateDenseOutput(stepper, time, state, stepSize, outputTimes,
+                                                   BurdenFaires(), 1.0e-8, 1.0e-12, 1.0,
+                                                   observe);
+
+    REQUIRE(time == outputTimes.back());
+    REQUIRE(reportedTimes == outputTimes);
+    for (std::size_t i = 0; i < outputTimes.size(); ++i)
+    {
+        REQUIRE(reportedStates[i]
+                == Catch::Approx(computeBurdenFairesSolution(outputTimes[i])).epsilon(1.0e-7));
+    }
+
+    // The steps are not shortened to hit the output times, so the integration takes the same
+    // steps as without output.
+    Real referenceTime = 0.0;
+    State referenceState({0.5});
+    Real referenceStepSize = 0.01;
+    DOPRI5Stepper<Real, State> referenceStepper;
+    const int referenceNumberOfSteps
+        = integrateAdaptive(referenceStepper, referenceTime, referenceState, referenceStepSize,
+                            outputTimes.back(), BurdenFaires(), 1.0e-8, 1.0e-12, 1.0);
+    REQUIRE(numberOfSteps == referenceNumberOfSteps);
+    REQUIRE(numberOfSteps < static_cast<int>(outputTimes.size()));
+    REQUIRE(state[0] == referenceState[0]);
+
+    SECTION("Unsorted output times")
+    {
+        std::vector<Real> unsortedOutputTimes;
+        unsortedOutputTimes.push_back(time + 1.0);
+        unsortedOutputTimes.push_back(time + 0.5);
+        REQUIRE_THROWS_AS(integrateDenseOutput(stepper, time, state, stepSize,
+                                               unsortedOutputTimes, BurdenFaires(), 1.0e-8,
+                                               1.0e-12, 1.0, observe),
+                          std::runtime_error);
+    }
+}
+
+} // namespace tests
+} // namespace integrate
@@ -0,0 +1,299 @@
+/*
+ * Copyright (c) 2014-2025 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include "integrate/dopri5.hpp"
+#include "integrate/ensemble.hpp"
+#include "integrate/integrateAdaptive.hpp"
+#include "integrate/rk4.hpp"
+#include "integrate/rkf45.hpp"
+
+#include "testDynamicalModels.hpp"
+#include "testState.hpp"
+
+namespace integrate
+{
+namespace tests
+{
+
+//! Burden & Faires dynamics for all lanes of an ensemble, i.e., ydot = y - t^2 + 1.
+struct EnsembleBurdenFaires
+{
+    void operator()(const std::vector<Real>& times,
+                    const EnsembleState<Real>& states,
+                    EnsembleState<Real>& stateDerivatives) const
+    {
+        const Real* const state = states.getElement(0);
+        Real* const stateDerivative = stateDerivatives.getElement(0);
+        for (int lane = 0; lane < states.getNumberOfLanes(); ++lane)
+        {
+            stateDerivative[lane] = state[lane] - times[lane] * times[lane] + 1.0;
+        }
+    }
+};
+
+TEST_CASE("Test ensemble state layout", "[ensemble]")
+{
+    EnsembleState<Real> states(3, 2);
+    states.setLane(1, State({1.5, -2.5}));
+
+    REQUIRE(states.getNumberOfLanes() == 3);
+    REQUIRE(states.getStateDimension() == 2);
+    REQUIRE(states(1, 0) == 1.5);
+    REQUIRE(states(1, 1) == -2.5);
+    REQUIRE(states.getElement(1)[1] == -2.5);
+    REQUIRE(states.getElement(1) - states.getElement(0) == 3);
+
+    State state({0.0, 0.0});
+    states.getLane(1, state);
+    REQUIRE(state == State({1.5, -2.5}));
+}
+
+TEST_CASE("Test ensemble Runge-Kutta 4 stepper against scalar stepper", "[ensemble]")
+{
+    const int numberOfLanes = 5;
+    const Real stepSize = 0.1;
+    const int numberOfSteps = 20;
+
+    std::vector<Real> times(numberOfLanes, 0.0);
+    EnsembleState<Real> states(numberOfLanes, 1);
+    for (int lane = 0; lane < numberOfLanes; ++lane)
+    {
+        times[lane] = 0.1 * lane;
+        states(lane, 0) = 0.5 + 0.25 * lane;
+    }
+
+    EnsembleRungeKuttaStepper<Real, RK4Tableau<Real> > stepper;
+    for (int i = 0; i < numberOfSteps; ++i)
+    {
+        stepper.step(times, states, stepSize, EnsembleBurdenFaires());
+    }
+
+    for (int lane = 0; lane < numberOfLanes; ++lane)
+    {
+        Real currentTime = 0.1 * lane;
+        State currentState({0.5 + 0.25 * lane});
+        RK4Stepper<Real, State> scalarStepper;
+        for (int i = 0; i < numberOfSteps; ++i)
+        {
+            scalarStepper.step(currentTime, currentState, stepSize, BurdenFaires());
+        }
+
+        REQUIRE(times[lane] == Catch::Approx(currentTime));
+        REQUIRE(states(lane, 0) == Catch::Approx(currentState[0]).epsilon(1.0e-14));
+    }
+}
+
+TEST_CASE("Test ensemble adaptive step uses step size and acceptance per lane", "[ensemble]")
+{
+    const Real tolerance = 1.0e-8;
+    const Real minimumStepSize = 1.0e-8;
+    const Real maximumStepSize = 1.0;
+
+    // Both lanes start from the same time and state, but the step size of the second lane is too
+    // large for the tolerance, so only the first lane is accepted.
+    std::vector<Real> times(2, 0.0);
+    EnsembleState<Real> states(2, 1);
+    states(0, 0) = 0.5;
+    states(1, 0) = 0.5;
+    std::vector<Real> stepSizes = {0.01, 1.0};
+
+    EnsembleRungeKuttaStepper<Real, RKF45Tableau<Real> > stepper;
+    const int numberOfAcceptedLanes = stepper.step(times,
+                                                   states,
+                                                   stepSizes,
+                                                   EnsembleBurdenFaires(),
+                                                   tolerance,
+                                                   minimumStepSize,
+                                                   maximumStepSize);
+
+    REQUIRE(numberOfAcceptedLanes == 1);
+    REQUIRE(stepper.getAcceptedLanes()[0] != 0);
+    REQUIRE(stepper.getAcceptedLanes()[1] == 0);
+    REQUIRE(times[0] == Catch::Approx(0.01));
+    REQUIRE(times[1] == 0.0);
+    REQUIRE(states(1, 0) == 0.5);
+    REQUIRE(stepSizes[1] < 1.0);
+
+    // The accepted lane matches the scalar stepper.
+    Real currentTime = 0.0;
+    State currentState({0.5});
+    Real currentStepSize = 0.01;
+    RKF45Stepper<Real, State> scalarStepper;
+    scalarStepper.step(currentTime,
+                       currentState,
+                       currentStepSize,
+                       BurdenFaires(),
+                       tolerance,
+                       minimumStepSize,
+                       maximumStepSize);
+
+    REQUIRE(states(0, 0) == Catch::Approx(currentState[0]).epsilon(1.0e-14));
+    REQUIRE(stepSizes[0] == Catch::Approx(currentStepSize));
+}
+
+TEST_CASE("Test ensemble adaptive step leaves all lanes unchanged if a lane fails", "[ensemble]")
+{
+    const Real tolerance = 1.0e-8;
+    const Real minimumStepSize = 0.5;
+    const Real maximumStepSize = 1.0;
+
+    // The first lane is accepted, but the second lane would have to be repeated with a step size
+    // below the minimum step size, so the step fails for the ensemble.
+    std::vector<Real> times = {0.0, 0.0};
+    EnsembleState<Real> states(2, 1);
+    states(0, 0) = 0.5;
+    states(1, 0) = 0.5;
+    std::vector<Real> stepSizes = {0.01, 1.0};
+
+    EnsembleRungeKuttaStepper<Real, RKF45Tableau<Real> > stepper;
+    REQUIRE_THROWS_AS(stepper.step(times,
+                                   states,
+                                   stepSizes,
+                                   EnsembleBurdenFaires(),
+                                   tolerance,
+                                   minimumStepSize,
+                                   maximumStepSize),
+                      std::runtime_error);
+
+    REQUIRE(times[0] == 0.0);
+    REQUIRE(times[1] == 0.0);
+    REQUIRE(states(0, 0) == 0.5);
+    REQUIRE(states(1, 0) == 0.5);
+    REQUIRE(stepSizes[0] == 0.01);
+    REQUIRE(stepSizes[1] == 1.0);
+    REQUIRE(stepper.getAcceptedLanes()[0] == 0);
+    REQUIRE(stepper.getAcceptedLanes()[1] == 0);
+}
+
+TEST_CASE("Test ensemble adaptive integration against scalar adaptive integration", "[ensemble]")
+{
+    const int numberOfLanes = 8;
+    const Real finalTime = 2.0;
+    const Real tolerance = 1.0e-8;
+    const Real minimumStepSize = 1.0e-8;
+    const Real maximumStepSize = 0.5;
+
+    std::vector<Real> times(numberOfLanes, 0.0);
+    std::vector<Real> stepSizes(numberOfLanes, 0.01);
+    EnsembleState<Real> states(numberOfLanes, 1);
+    for (int lane = 0; lane < numberOfLanes; ++lane)
+    {
+        states(lane, 0) = -2.0 + 0.5 * lane;
+    }
+
+    EnsembleRungeKuttaStepper<Real, DOPRI5Tableau<Real> > stepper;
+    integrateEnsemble(stepper,
+                      times,
+                      states,
+                      stepSizes,
+                      finalTime,
+                      EnsembleBurdenFaires(),
+                      tolerance,
+                      minimumStepSize,
+                      maximumStepSize);
+
+    for (int lane = 0; lane < numberOfLanes; ++lane)
+    {
+        // Analytical solution: y(t) = (t + 1)^2 - (1 - y0) * exp(t).
+        const Real initialState = -2.0 + 0.5 * lane;
+        const Real expectedState = (finalTime + 1.0) * (finalTime + 1.0)
+                                   - (1.0 - initialState) * std::exp(finalTime);
+
+        REQUIRE(times[lane] == finalTime);
+        REQUIRE(states(lane, 0) == Catch::Approx(expectedState).epsilon(1.0e-6));
+    }
+}
+
+TEST_CASE("Test ensemble adaptive integration with step size that does not advance a lane",
+          "[ensemble]")
+{
+    std::vector<Real> times = {0.0, 0.0};
+    EnsembleState<Real> states(2, 1);
+    states(0, 0) = 0.5;
+    states(1, 0) = 0.5;
+    std::vector<Real> stepSizes = {0.01, 0.0};
+
+    EnsembleRungeKuttaStepper<Real, RKF45Tableau<Real> > stepper;
+    REQUIRE_THROWS_AS(integrateEnsemble(stepper,
+                                        times,
+                                        states,
+                                        stepSizes,
+                                        1.0,
+                                        EnsembleBurdenFaires(),
+                                        1.0e-8,
+                                        0.0,
+                                        1.0),
+                      std::runtime_error);
+
+    stepSizes = {0.01, -0.01};
+    REQUIRE_THROWS_AS(integrateEnsemble(stepper,
+                                        times,
+                                        states,
+                                        stepSizes,
+                                        1.0,
+                                        EnsembleBurdenFaires(),
+                                        1.0e-8,
+                                        0.0,
+                                        1.0),
+                      std::runtime_error);
+}
+
+TEST_CASE("Test ensemble adaptive integration lowers minimum step size per lane", "[ensemble]")
+{
+    const Real finalTime = 2.0;
+    const Real tolerance = 1.0e-8;
+    const Real minimumStepSize = 0.5;
+    const Real maximumStepSize = 1.0;
+
+    // The first lane is close to the final time, so that its last step is shorter than the minimum
+    // step size. This must not lower the minimum step size of the second lane, which would have to
+    // be repeated with a step size below the minimum step size, so the first attempt fails.
+    std::vector<Real> times = {finalTime - 0.01, 0.0};
+    EnsembleState<Real> states(2, 1);
+    states(0, 0) = 0.5;
+    states(1, 0) = 0.5;
+    std::vector<Real> stepSizes = {1.0, 1.0};
+
+    EnsembleRungeKuttaStepper<Real, RKF45Tableau<Real> > stepper;
+    REQUIRE_THROWS_AS(integrateEnsemble(stepper,
+                                        times,
+                                        states,
+                                        stepSizes,
+                                        finalTime,
+                                        EnsembleBurdenFaires(),
+                                        tolerance,
+                                        minimumStepSize,
+                                        maximumStepSize),
+                      std::runtime_error);
+    REQUIRE(times[0] == finalTime - 0.01);
+    REQUIRE(times[1] == 0.0);
+
+    // On its own, the first lane reaches the final time with a step below the minimum step size.
+    std::vector<Real> laneTimes = {finalTime - 0.01};
+    EnsembleState<Real> laneStates(1, 1);
+    laneStates(0, 0) = 0.5;
+    std::vector<Real> laneStepSizes = {1.0};
+    integrateEnsemble(stepper,
+                      laneTimes,
+                      laneStates,
+                      laneStepSizes,
+                      finalTime,
+                      EnsembleBurdenFaires(),
+                      tolerance,
+                      minimumStepSize,
+                      maximumStepSize);
+    REQUIRE(laneTimes[0] == finalTime);
+}
+
+} // namespace tests
+} // namespace integrate
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2014-2025 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <atomic>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include "integrate/dopri5.hpp"
+#include "integrate/ensembleRunner.hpp"
+#include "integrate/integrateAdaptive.hpp"
+
+#include "testDynamicalModels.hpp"
+#include "testState.hpp"
+
+namespace integrate
+{
+namespace tests
+{
+
+//! Integrate Burden & Faires dynamics to final time for given initial state.
+State integrateTrajectory(DOPRI5Stepper<Real, State>& stepper, const Real initialState)
+{
+    Real currentTime = 0.0;
+    State currentState({initialState});
+    Real currentStepSize = 0.01;
+    integrateAdaptive(stepper,
+                      currentTime,
+                      currentState,
+                      currentStepSize,
+                      2.0,
+                      BurdenFaires(),
+                      1.0e-10,
+                      1.0e-10,
+                      0.5);
+    return currentState;
+}
+
+TEST_CASE("Test ensemble runner executes each task exactly once", "[ensemble_runner]")
+{
+    const int numberOfTasks = 1000;
+
+    for (int numberOfThreads = 1; numberOfThreads <= 4; ++numberOfThreads)
+    {
+        std::vector<std::atomic<int> > numberOfExecutions(numberOfTasks);
+        for (int i = 0; i < numberOfTasks; ++i)
+        {
+            numberOfExecutions[i] = 0;
+        }
+
+        EnsembleRunner runner(numberOfThreads);
+        REQUIRE(runner.getNumberOfThreads() == numberOfThreads);
+
+        runner.run<DOPRI5Stepper<Real, State> >(
+            numberOfTasks,
+            [&numberOfExecutions](DOPRI5Stepper<Real, State>&, const int taskIndex)
+        {
+            // Make the amount of work per task uneven, so that tasks are stolen.
+            volatile double sum = 0.0;
+            for (int i = 0; i < (taskIndex % 7) * 1000; ++i)
+            {
+                sum = sum + 1.0;
+            }
+            ++numberOfExecutions[taskIndex];
+        });
+
+        for (int i = 0; i < numberOfTasks; ++i)
+        {
+            REQUIRE(numberOfExecutions[i] == 1);
+        }
+    }
+}
+
+TEST_CASE("Test ensemble runner results do not depend on number of threads",
+          "[ensemble_runner]")
+{
+    const int numberOfTrajectories = 64;
+
+    std::vector<Real> referenceStates(numberOfTrajectories);
+    EnsembleRunner serialRunner(1);
+    serialRunner.run<DOPRI5Stepper<Real, State> >(
+        numberOfTrajectories,
+        [&referenceStates](DOPRI5Stepper<Real, State>& stepper, const int taskIndex)
+    {
+        referenceStates[taskIndex] = integrateTrajectory(stepper, 0.1 * taskIndex)[0];
+    });
+
+    for (int numberOfThreads = 2; numberOfThreads <= 5; ++numberOfThreads)
+    {
+        std::vector<Real> finalStates(numberOfTrajectories);
+        EnsembleRunner runner(numberOfThreads, true);
+        runner.run<DOPRI5Stepper<Real, State> >(
+            numberOfTrajectories,
+            [&finalStates](DOPRI5Stepper<Real, State>& stepper, const int taskIndex)
+        {
+            finalStates[taskIndex] = integrateTrajectory(stepper, 0.1 * taskIndex)[0];
+        });
+
+        for (int i = 0; i < numberOfTrajectories; ++i)
+        {
+            REQUIRE(finalStates[i] == referenceStates[i]);
+        }
+    }
+
+    // Analytical solution: y(t) = (t + 1)^2 - (1 - y0) * exp(t).
+    const Real expectedState = 9.0 - (1.0 - 0.1 * 5) * std::exp(2.0);
+    REQUIRE(referenceStates[5] == Catch::Approx(expectedState).epsilon(1.0e-8));
+}
+
+TEST_CASE("Test ensemble runner rethrows exception of task", "[ensemble_runner]")
+{
+    typedef DOPRI5Stepper<Real, State> Stepper;
+    auto task = [](Stepper&, const int taskIndex)
+    {
+        if (taskIndex == 42)
+        {
+            throw std::runtime_error("Task failed!");
+        }
+    };
+
+    EnsembleRunner runner(3);
+    REQUIRE_THROWS_AS(runner.run<Stepper>(100, task), std::runtime_error);
+}
+
+} // namespace tests
+} // namespace integrate
@@ -64,6 +64,28 @@ TEST_CASE("Test Euler integrator for zero dynamics class", "[euler]")
     REQUIRE(currentState == initialState);
 }
 
+TEST_CASE("Test Euler integrator for zero dynamics lambda", "[euler]")
+{
+    const Real initialTime = 1.0;
+    const State initialState({1.2, 2.3, -3.6});
+    const Real stepSize = 0.1;
+
+    Real currentTime = initialTime;
+    State currentState = initialState;
+
+    auto computeStateDerivative = [](const Real, const State&)
+    {
+        return State({0.0, 0.0, 0.0});
+    };
+    stepEuler<Real, State>(currentTime,
+                           currentState,
+                           stepSize,
+                           computeStateDerivative);
+
+    REQUIRE(currentTime  == (initialTime + stepSize));
+    REQUIRE(currentState == initialState);
+}
+
 TEST_CASE("Test Euler integrator for Burden & Faires (9th ed.): Table 5.1", "[euler]")
 {
     const Real initialTime = 0.0;
@@ -336,5 +358,38 @@ TEST_CASE("Test Euler integrator for Burden & Faires (9th ed.): Table 5.1 using
     }
 }
 
+TEST_CASE("Test Euler stepper for Burden & Faires (9th ed.): Table 5.1 using in-place state "
+          "derivative", "[euler]")
+{
+    const Real initialTime = 0.0;
+    const State initialState({0.5});
+    const Real stepSize = 0.2;
+
+    Real currentTime = initialTime;
+    State currentState = initialState;
+
+    const Real testTolerance = 1.0e-7;
+
+    std::map<Real, State> burdenFairesTable5_1Data;
+    burdenFairesTable5_1Data.insert({0.2, State({0.8000000})});
+    burdenFairesTable5_1Data.insert({0.4, State({1.1520000})});
+    burdenFairesTable5_1Data.insert({0.6, State({1.5504000})});
+    burdenFairesTable5_1Data.insert({0.8, State({1.9884800})});
+    burdenFairesTable5_1Data.insert({1.0, State({2.4581760})});
+
+    auto computeStateDerivative = [](const Real time, const State& state, State& stateDerivative)
+    {
+        stateDerivative[0] = state[0] - (time * time) + 1.0;
+    };
+
+    EulerStepper<Real, State> stepper;
+    for (const auto& pair : burdenFairesTable5_1Data)
+    {
+        stepper.step(currentTime, currentState, stepSize, computeStateDerivative);
+        REQUIRE(pair.first == Catch::Approx(currentTime).epsilon(testTolerance));
+        REQUIRE(pair.second[0] == Catch::Approx(currentState[0]).epsilon(testTolerance));
+    }
+}
+
 } // namespace tests
 } // namespace integrate
@@ -0,0 +1,172 @@
+/*
+ * Copyright (c) 2014-2025 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <cmath>
+#include <vector>
+
+#include "integrate/dopri5.hpp"
+#include "integrate/events.hpp"
+#include "integrate/integrateAdaptive.hpp"
+#include "integrate/statistics.hpp"
+
+#include "testState.hpp"
+
+namespace integrate
+{
+namespace tests
+{
+
+//! Pi.
+const Real pi = 3.14159265358979323846;
+
+//! Compute state derivative of harmonic oscillator x'' = -x, with state (x, x').
+const State computeOscillatorStateDerivative(const Real, const State& state)
+{
+    return State({state[1], -state[0]});
+}
+
+//! Event that is reported to observer.
+struct ReportedEvent
+{
+    int index;
+    Real time;
+    Real position;
+};
+
+TEST_CASE("Test location of events of harmonic oscillator", "[events]")
+{
+    // Solution: x(t) = sin(t), with roots at multiples of pi.
+    Real time = 0.0;
+    State state({0.0, 1.0});
+    Real stepSize = 0.01;
+    DOPRI5Stepper<Real, State> stepper;
+
+    std::vector<ReportedEvent> reportedEvents;
+    const auto observe = [&](const int index, const Real eventTime, const State& eventState)
+    {
+        const ReportedEvent event = {index, eventTime, eventState[0]};
+        reportedEvents.push_back(event);
+    };
+    const auto computePosition = [](const Real, const State& eventState)
+    {
+        return eventState[0];
+    };
+
+    EventLocator<Real, State> eventLocator;
+
+    SECTION("Non-terminal events in either direction")
+    {
+        eventLocator.addEvent(computePosition);
+        integrateEvents(stepper, time, state, stepSize, 10.0, &computeOscillatorStateDerivative,
+                        1.0e-10, 1.0e-12, 1.0, eventLocator, observe);
+
+        // The root at the initial time is not reported.
+        REQUIRE(time == 10.0);
+        REQUIRE(eventLocator.getTerminalEventIndex() == -1);
+        REQUIRE(reportedEvents.size() == 3);
+        for (std::size_t i = 0; i < reportedEvents.size(); ++i)
+        {
+            REQUIRE(reportedEvents[i].index == 0);
+            REQUIRE(reportedEvents[i].time == Catch::Approx((i + 1) * pi).epsilon(1.0e-9));
+            REQUIRE(std::fabs(reportedEvents[i].position) < 1.0e-9);
+        }
+    }
+
+    SECTION("Non-terminal events in increasing direction")
+    {
+        eventLocator.addEvent(computePosition, EventDirection::increasing);
+        integrateEvents(stepper, time, state, stepSize, 10.0, &computeOscillatorStateDerivative,
+                        1.0e-10, 1.0e-12, 1.0, eventLocator, observe);
+
+        REQUIRE(reportedEvents.size() == 1);
+        REQUIRE(reportedEvents[0].time == Catch::Approx(2.0 * pi).epsilon(1.0e-9));
+    }
+
+    SECTION("Terminal event")
+    {
+        // The velocity decreases through zero at the maximum position.
+        const auto computeVelocity = [](const Real, const State& eventState)
+        {
+            return eventState[1];
+        };
+        eventLocator.addEvent(computePosition);
+        const int apoapsisIndex
+            = eventLocator.addEvent(computeVelocity, EventDirection::decreasing, true);
+        integrateEvents(stepper, time, state, stepSize, 10.0, &computeOscillatorStateDerivative,
+                        1.0e-10, 1.0e-12, 1.0, eventLocator, observe);
+
+        REQUIRE(time == Catch::Approx(0.5 * pi).epsilon(1.0e-9));
+        REQUIRE(state[0] == Catch::Approx(1.0).epsilon(1.0e-9));
+        REQUIRE(eventLocator.getTerminalEventIndex() == apoapsisIndex);
+        REQUIRE(reportedEvents.size() == 1);
+
+        // Continuing from the terminal event does not trigger it again, and events in between are
+        // reported.
+        integrateEvents(stepper, time, state, stepSize, 10.0, &computeOscillatorStateDerivative,
+                        1.0e-10, 1.0e-12, 1.0, eventLocator, observe);
+        REQUIRE(time == Catch::Approx(2.5 * pi).epsilon(1.0e-9));
+        REQUIRE(reportedEvents.size() == 4);
+        REQUIRE(reportedEvents[1].time == Catch::Approx(pi).epsilon(1.0e-9));
+        REQUIRE(reportedEvents[2].time == Catch::Approx(2.0 * pi).epsilon(1.0e-9));
+        REQUIRE(reportedEvents[3].index == apoapsisIndex);
+    }
+}
+
+TEST_CASE("Test location of many simultaneous events", "[events]")
+{
+    typedef IntegrationStatistics<Real> Statistics;
+    const Real finalTime = 2.0 * pi;
+
+    // Crossings of 40 position levels between -1 and 1, which are each crossed twice per period.
+    const int numberOfLevels = 40;
+    EventLocator<Real, State> eventLocator;
+    for (int i = 0; i < numberOfLevels; ++i)
+    {
+        const Real level = -0.975 + 0.05 * i;
+        eventLocator.addEvent([level](const Real, const State& eventState)
+        {
+            return eventState[0] - level;
+        });
+    }
+
+    std::vector<Real> eventTimes;
+    Real time = 0.0;
+    State state({0.0, 1.0});
+    Real stepSize = 0.01;
+    DOPRI5Stepper<Real, State, Statistics> stepper;
+    const int numberOfSteps = integrateEvents(
+        stepper, time, state, stepSize, finalTime, &computeOscillatorStateDerivative, 1.0e-10,
+        1.0e-12, 1.0, eventLocator,
+        [&](const int index, const Real eventTime, const State& eventState)
+    {
+        REQUIRE(eventState[0] == Catch::Approx(-0.975 + 0.05 * index).margin(1.0e-9));
+        eventTimes.push_back(eventTime);
+    });
+
+    REQUIRE(eventTimes.size() == 2 * numberOfLevels);
+    for (std::size_t i = 1; i < eventTimes.size(); ++i)
+    {
+        REQUIRE(eventTimes[i - 1] <= eventTimes[i]);
+    }
+
+    // Events are located on the dense output, without additional state derivative evaluations.
+    Real referenceTime = 0.0;
+    State referenceState({0.0, 1.0});
+    Real referenceStepSize = 0.01;
+    DOPRI5Stepper<Real, State, Statistics> referenceStepper;
+    const int referenceNumberOfSteps = integrateAdaptive(
+        referenceStepper, referenceTime, referenceState, referenceStepSize, finalTime,
+        &computeOscillatorStateDerivative, 1.0e-10, 1.0e-12, 1.0);
+    REQUIRE(numberOfSteps == referenceNumberOfSteps);
+    REQUIRE(stepper.getStatistics().getNumberOfStateDerivativeEvaluations()
+            == referenceStepper.getStatistics().getNumberOfStateDerivativeEvaluations());
+}
+
+} // namespace tests
+} // namespace integrate
@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2014-2025 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "integrate/explicitRungeKutta.hpp"
+#include "integrate/rkf78.hpp"
+
+#include "testDynamicalModels.hpp"
+#include "testState.hpp"
+
+namespace integrate
+{
+namespace tests
+{
+
+//! Butcher tableau for Heun-Euler 2(1) scheme, defined here to test user-defined tableaus.
+template <typename Real>
+struct HeunEulerTableau
+{
+    static const int numberOfStages = 2;
+    static const int order = 2;
+    static const bool isEmbedded = true;
+    static constexpr Real c[2] = {0.0, 1.0};
+    static constexpr Real a[2][2] = {{}, {1.0}};
+    static constexpr Real b[2] = {0.5, 0.5};
+    static constexpr Real bHat[2] = {1.0, 0.0};
+};
+
+template <typename Real> constexpr Real HeunEulerTableau<Real>::c[2];
+template <typename Real> constexpr Real HeunEulerTableau<Real>::a[2][2];
+template <typename Real> constexpr Real HeunEulerTableau<Real>::b[2];
+template <typename Real> constexpr Real HeunEulerTableau<Real>::bHat[2];
+
+TEST_CASE("Test explicit Runge-Kutta stepper for user-defined tableau with fixed step size",
+          "[explicit_runge_kutta]")
+{
+    const Real initialTime = 0.0;
+    const State initialState({0.5});
+    const Real stepSize = 0.2;
+
+    Real currentTime = initialTime;
+    State currentState = initialState;
+
+    ExplicitRungeKuttaStepper<Real, State, HeunEulerTableau<Real> > stepper;
+    stepper.step(currentTime, currentState, stepSize, BurdenFaires());
+
+    // Heun's method: y1 = y0 + h/2 * (f(t0, y0) + f(t0 + h, y0 + h * f(t0, y0))).
+    const Real k1 = initialState[0] - initialTime * initialTime + 1.0;
+    const Real k2 = (initialState[0] + stepSize * k1)
+                    - (initialTime + stepSize) * (initialTime + stepSize) + 1.0;
+    const Real expectedState = initialState[0] + 0.5 * stepSize * (k1 + k2);
+
+    REQUIRE(currentTime == Catch::Approx(initialTime + stepSize));
+    REQUIRE(currentState[0] == Catch::Approx(expectedState).epsilon(1.0e-15));
+}
+
+TEST_CASE("Test explicit Runge-Kutta stepper for user-defined tableau with adaptive step size",
+          "[explicit_runge_kutta]")
+{
+    const Real initialTime = 0.0;
+    const State initialState({0.5});
+    const Real finalTime = 2.0;
+    const Real tolerance = 1.0e-6;
+    const Real minimumStepSize = 1.0e-8;
+    const Real maximumStepSize = 0.1;
+
+    Real currentTime = initialTime;
+    State currentState = initialState;
+    Real currentStepSize = 0.01;
+
+    ExplicitRungeKuttaStepper<Real, State, HeunEulerTableau<Real> > stepper;
+    while (currentTime < finalTime)
+    {
+        currentStepSize = std::min(currentStepSize, finalTime - currentTime);
+        stepper.step(currentTime,
+                     currentState,
+                     currentStepSize,
+                     BurdenFaires(),
+                     tolerance,
+                     minimumStepSize,
+                     maximumStepSize);
+    }
+
+    // Analytical solution for Burden & Faires dynamics: y(t) = (t + 1)^2 - 0.5 * exp(t).
+    const Real expectedState = (finalTime + 1.0) * (finalTime + 1.0) - 0.5 * std::exp(finalTime);
+    REQUIRE(currentTime == Catch::Approx(finalTime));
+    REQUIRE(currentState[0] == Catch::Approx(expectedState).epsilon(1.0e-4));
+}
+
+TEST_CASE("Test explicit Runge-Kutta stepper for contiguous state", "[explicit_runge_kutta]")
+{
+    // Use a size that is not a multiple of the block size of the contiguous kernels.
+    const int size = 600;
+    const Real tolerance = 1.0e-10;
+    const Real minimumStepSize = 1.0e-8;
+    const Real maximumStepSize = 0.25;
+
+    // Decoupled Burden & Faires dynamics with a different initial state for each element.
+    auto computeStateDerivative = [](const Real time,
+                                     const std::vector<Real>& state,
+                                     std::vector<Real>& stateDerivative)
+    {
+        for (std::size_t i = 0; i < state.size(); ++i)
+        {
+            stateDerivative[i] = state[i] - time * time + 1.0;
+        }
+    };
+
+    Real contiguousTime = 0.0;
+    std::vector<Real> contiguousState(size);
+    Real contiguousStepSize = 0.1;
+    for (int i = 0; i < size; ++i)
+    {
+        contiguousState[i] = 0.5 + 0.001 * i;
+    }
+
+    Real indexableTime = contiguousTime;
+    State indexableState(contiguousState);
+    Real indexableStepSize = contiguousStepSize;
+
+    auto computeIndexableStateDerivative = [](const Real time,
+                                              const State& state,
+                                              State& stateDerivative)
+    {
+        for (int i = 0; i < state.size(); ++i)
+        {
+            stateDerivative[i] = state[i] - time * time + 1.0;
+        }
+    };
+
+    RKF78Stepper<Real, std::vector<Real> > contiguousStepper;
+    RKF78Stepper<Real, State> indexableStepper;
+    for (int step = 0; step < 5; ++step)
+    {
+        contiguousStepper.step(contiguousTime,
+                               contiguousState,
+                               contiguousStepSize,
+                               computeStateDerivative,
+                               tolerance,
+                               minimumStepSize,
+                               maximumStepSize);
+        indexableStepper.step(indexableTime,
+                              indexableState,
+                              indexableStepSize,
+                              computeIndexableStateDerivative,
+                              tolerance,
+                              minimumStepSize,
+                              maximumStepSize);
+    }
+
+    REQUIRE(contiguousTime == Catch::Approx(indexableTime));
+    REQUIRE(contiguousStepSize == Catch::Approx(indexableStepSize));
+    for (int i = 0; i < size; ++i)
+    {
+        REQUIRE(contiguousState[i] == Catch::Approx(indexableState[i]).epsilon(1.0e-13));
+    }
+}
+
+} // namespace tests
+} // namespace integrate
@@ -0,0 +1,284 @@
+/*
+ * Copyright (c) 2014-2025 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+
+#include "integrate/dopri5.hpp"
+#include "integrate/indexedTrajectory.hpp"
+#include "integrate/integrateAdaptive.hpp"
+#include "integrate/rkf45.hpp"
+
+#include "testState.hpp"
+
+namespace integrate
+{
+namespace tests
+{
+
+//! Name of trajectory file written by tests.
+const std::string indexedTrajectoryFileName = "testIndexedTrajectory.bin";
+
+//! Compute state derivative of harmonic oscillator x'' = -x, with state (x, x').
+const State computeRecordedOscillatorStateDerivative(const Real, const State& state)
+{
+    return State({state[1], -state[0]});
+}
+
+//! Get time of record of test trajectory, with irregular spacing.
+Real getRecordTime(const int recordIndex)
+{
+    return 0.1 * recordIndex + 0.01 * (recordIndex % 3);
+}
+
+TEST_CASE("Test indexed trajectory writer and reader", "[indexedTrajectory]")
+{
+    // 1000 records of a cubic and a linear polynomial, which are interpolated exactly, in index
+    // entries of 16 records, so that the last entry is partially filled.
+    const int numberOfRecords = 1000;
+    {
+        IndexedTrajectoryWriter<Real> writer(indexedTrajectoryFileName, 2, true, 16);
+        for (int i = 0; i < numberOfRecords; ++i)
+        {
+            const Real time = getRecordTime(i);
+            const Real state[2] = {time * time * time, 2.0 * time + 1.0};
+            const Real stateDerivative[2] = {3.0 * time * time, 2.0};
+            writer.write(time, state, stateDerivative);
+        }
+        REQUIRE(writer.getNumberOfRecords() == numberOfRecords);
+
+        // The trajectory cannot be read until the writer is closed.
+        REQUIRE_THROWS_AS(IndexedTrajectory<Real>(indexedTrajectoryFileName),
+                          std::runtime_error);
+    }
+
+    const IndexedTrajectory<Real> trajectory(indexedTrajectoryFileName);
+    REQUIRE(trajectory.getNumberOfRecords() == numberOfRecords);
+    REQUIRE(trajectory.getNumberOfElements() == 2);
+    REQUIRE(trajectory.hasStateDerivatives());
+    REQUIRE(trajectory.getStartTime() == 0.0);
+    REQUIRE(trajectory.getEndTime() == getRecordTime(numberOfRecords - 1));
+
+    SECTION("Records")
+    {
+        for (int i = 0; i < numberOfRecords; ++i)
+        {
+            const Real time = getRecordTime(i);
+            REQUIRE(trajectory.getTime(i) == time);
+            REQUIRE(trajectory.getState(i)[0] == time * time * time);
+            REQUIRE(trajectory.getState(i)[1] == 2.0 * time + 1.0);
+            REQUIRE(trajectory.getStateDerivative(i)[0] == 3.0 * time * time);
+        }
+    }
+
+    SECTION("Lookup")
+    {
+        for (int i = 0; i < numberOfRecords - 1; ++i)
+        {
+            const Real time = getRecordTime(i);
+            REQUIRE(trajectory.findRecord(time) == static_cast<std::size_t>(i));
+            REQUIRE(trajectory.findRecord(0.5 * (time + getRecordTime(i + 1)))
+                    == static_cast<std::size_t>(i));
+        }
+        REQUIRE(trajectory.findRecord(trajectory.getEndTime()) == numberOfRecords - 2);
+        REQUIRE_THROWS_AS(trajectory.findRecord(-0.01), std::out_of_range);
+        REQUIRE_THROWS_AS(trajectory.findRecord(trajectory.getEndTime() + 0.01),
+                          std::out_of_range);
+    }
+
+    SECTION("Interpolation")
+    {
+        Real state[2];
+        for (int i = 0; i < 400; ++i)
+        {
+            const Real time = 0.25 * i + 0.003;
+            trajectory.interpolate(time, state);
+            REQUIRE(state[0] == Catch::Approx(time * time * time).epsilon(1.0e-12));
+            REQUIRE(state[1] == Catch::Approx(2.0 * time + 1.0).epsilon(1.0e-12));
+        }
+        trajectory.interpolate(trajectory.getEndTime(), state);
+        REQUIRE(state[1] == Catch::Approx(2.0 * trajectory.getEndTime() + 1.0).epsilon(1.0e-14));
+    }
+
+    std::remove(indexedTrajectoryFileName.c_str());
+}
+
+TEST_CASE("Test indexed trajectory without state derivatives", "[indexedTrajectory]")
+{
+    {
+        IndexedTrajectoryWriter<Real> writer(indexedTrajectoryFileName, 1);
+        const Real firstState = 1.0;
+        writer.write(0.0, &firstState);
+
+        // A single record is interpolated at its time only.
+        writer.close();
+        const IndexedTrajectory<Real> trajectory(indexedTrajectoryFileName);
+        Real state = 0.0;
+        trajectory.interpolate(0.0, &state);
+        REQUIRE(state == 1.0);
+        REQUIRE(trajectory.getStateDerivative(0) == 0);
+        REQUIRE_THROWS_AS(trajectory.interpolate(0.1, &state), std::out_of_range);
+        REQUIRE_THROWS_AS(writer.write(1.0, &firstState), std::runtime_error);
+    }
+    {
+        IndexedTrajectoryWriter<Real> writer(indexedTrajectoryFileName, 1);
+        const Real states[3] = {1.0, 3.0, 2.0};
+        writer.write(0.0, &states[0]);
+        writer.write(1.0, &states[1]);
+        writer.write(3.0, &states[2]);
+        REQUIRE_THROWS_AS(writer.write(3.0, &states[2]), std::invalid_argument);
+    }
+
+    // Without state derivatives, the state is interpolated linearly.
+    const IndexedTrajectory<Real> trajectory(indexedTrajectoryFileName);
+    REQUIRE(!trajectory.hasStateDerivatives());
+    REQUIRE(trajectory.getNumberOfRecords() == 3);
+    Real state = 0.0;
+    trajectory.interpolate(0.5, &state);
+    REQUIRE(state == Catch::Approx(2.0));
+    trajectory.interpolate(2.0, &state);
+    REQUIRE(state == Catch::Approx(2.5));
+
+    // The reader checks the type of the values.
+    REQUIRE_THROWS_AS(IndexedTrajectory<float>(indexedTrajectoryFileName), std::runtime_error);
+    std::remove(indexedTrajectoryFileName.c_str());
+}
+
+TEST_CASE("Test invalid indexed trajectory files", "[indexedTrajectory]")
+{
+    REQUIRE_THROWS_AS(IndexedTrajectory<Real>(indexedTrajectoryFileName), std::runtime_error);
+    REQUIRE_THROWS_AS(IndexedTrajectoryWriter<Real>("missingDirectory/trajectory.bin", 2),
+                      std::runtime_error);
+    REQUIRE_THROWS_AS(IndexedTrajectoryWriter<Real>(indexedTrajectoryFileName, 0),
+                      std::invalid_argument);
+    REQUIRE_THROWS_AS(IndexedTrajectoryWriter<Real>(indexedTrajectoryFileName, 1, true, 0),
+                      std::invalid_argument);
+
+    {
+        IndexedTrajectoryWriter<Real> writer(indexedTrajectoryFileName, 1, true);
+        const Real state = 1.0;
+        REQUIRE_THROWS_AS(writer.write(0.0, &state), std::invalid_argument);
+    }
+
+    // A file without records cannot be read.
+    REQUIRE_THROWS_AS(IndexedTrajectory<Real>(indexedTrajectoryFileName), std::runtime_error);
+    std::remove(indexedTrajectoryFileName.c_str());
+}
+
+TEST_CASE("Test recording of integration to indexed trajectory", "[indexedTrajectory]")
+{
+    const Real finalTime = 20.0;
+    int numberOfEvaluations = 0;
+    const auto computeStateDerivative
+        = [&numberOfEvaluations](const Real time, const State& state)
+    {
+        ++numberOfEvaluations;
+        return computeRecordedOscillatorStateDerivative(time, state);
+    };
+
+    Real time = 0.0;
+    State state({0.0, 1.0});
+    Real stepSize = 0.01;
+    DOPRI5Stepper<Real, State> stepper;
+    int numberOfSteps = 0;
+    {
+        IndexedTrajectoryWriter<Real> writer(indexedTrajectoryFileName, 2, true);
+        numberOfSteps = integrateRecorded(stepper, time, state, stepSize, finalTime,
+                                          computeStateDerivative, 1.0e-10, 1.0e-12, 1.0, writer);
+    }
+    REQUIRE(time == finalTime);
+
+    // The state derivatives are taken from the stepper, except at the initial state.
+    const int numberOfRecordedEvaluations = numberOfEvaluations;
+    numberOfEvaluations = 0;
+    Real referenceTime = 0.0;
+    State referenceState({0.0, 1.0});
+    Real referenceStepSize = 0.01;
+    DOPRI5Stepper<Real, State> referenceStepper;
+    integrateAdaptive(referenceStepper, referenceTime, referenceState, referenceStepSize,
+                      finalTime, computeStateDerivative, 1.0e-10, 1.0e-12, 1.0);
+    REQUIRE(numberOfRecordedEvaluations == numberOfEvaluations + 1);
+
+    // Solution: x(t) = sin(t), x'(t) = cos(t).
+    const IndexedTrajectory<Real> trajectory(indexedTrajectoryFileName);
+    REQUIRE(trajectory.getNumberOfRecords() == static_cast<std::size_t>(numberOfSteps) + 1);
+    REQUIRE(trajectory.getEndTime() == finalTime);
+    REQUIRE(trajectory.getState(numberOfSteps)[0] == state[0]);
+    for (int i = 0; i <= 2000; ++i)
+    {
+        const Real outputTime = 0.01 * i;
+        Real outputState[2];
+        trajectory.interpolate(outputTime, outputState);
+        REQUIRE(std::fabs(outputState[0] - std::sin(outputTime)) < 1.0e-6);
+        REQUIRE(std::fabs(outputState[1] - std::cos(outputTime)) < 1.0e-6);
+    }
+
+    // Steppers without dense output cannot provide the state derivatives.
+    time = 0.0;
+    state = State({0.0, 1.0});
+    stepSize = 0.01;
+    RKF45Stepper<Real, State> rkf45Stepper;
+    IndexedTrajectoryWriter<Real> writer(indexedTrajectoryFileName, 2, true);
+    REQUIRE_THROWS_AS(integrateRecorded(rkf45Stepper, time, state, stepSize, finalTime,
+                                        &computeRecordedOscillatorStateDerivative, 1.0e-10, 1.0e-12,
+                                        1.0, writer),
+                      std::runtime_error);
+    writer.close();
+    std::remove(indexedTrajectoryFileName.c_str());
+}
+
+TEST_CASE("Test recording of consecutive integrations to indexed trajectory",
+          "[indexedTrajectory]")
+{
+    Real time = 0.0;
+    State state({0.0, 1.0});
+    Real stepSize = 0.01;
+    DOPRI5Stepper<Real, State> stepper;
+    int numberOfSteps = 0;
+    {
+        IndexedTrajectoryWriter<Real> writer(indexedTrajectoryFileName, 2, true);
+        numberOfSteps += integrateRecorded(stepper, time, state, stepSize, 1.0,
+                                           &computeRecordedOscillatorStateDerivative, 1.0e-10,
+                                           1.0e-12, 1.0, writer);
+        REQUIRE(writer.getLastTime() == 1.0);
+
+        // The second integration continues from the last record of the first integration.
+        numberOfSteps += integrateRecorded(stepper, time, state, stepSize, 2.0,
+                                           &computeRecordedOscillatorStateDerivative, 1.0e-10,
+                                           1.0e-12, 1.0, writer);
+        REQUIRE(writer.getNumberOfRecords() == static_cast<std::size_t>(numberOfSteps) + 1);
+
+        // An integration to the time of the last record appends no records.
+        REQUIRE(integrateRecorded(stepper, time, state, stepSize, 2.0,
+                                  &computeRecordedOscillatorStateDerivative, 1.0e-10, 1.0e-12, 1.0,
+                                  writer) == 0);
+        REQUIRE(writer.getNumberOfRecords() == static_cast<std::size_t>(numberOfSteps) + 1);
+    }
+
+    // Solution: x(t) = sin(t), x'(t) = cos(t).
+    const IndexedTrajectory<Real> trajectory(indexedTrajectoryFileName);
+    REQUIRE(trajectory.getNumberOfRecords() == static_cast<std::size_t>(numberOfSteps) + 1);
+    REQUIRE(trajectory.getStartTime() == 0.0);
+    REQUIRE(trajectory.getEndTime() == 2.0);
+    for (int i = 0; i <= 200; ++i)
+    {
+        const Real outputTime = 0.01 * i;
+        Real outputState[2];
+        trajectory.interpolate(outputTime, outputState);
+        REQUIRE(std::fabs(outputState[0] - std::sin(outputTime)) < 1.0e-6);
+        REQUIRE(std::fabs(outputState[1] - std::cos(outputTime)) < 1.0e-6);
+    }
+    std::remove(indexedTrajectoryFileName.c_str());
+}
+
+} // namespace tests
+} // namespace integrate
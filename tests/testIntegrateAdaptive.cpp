@@ -0,0 +1,269 @@
+/*
+ * Copyright (c) 2014-2025 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <cmath>
+#include <stdexcept>
+
+#include "integrate/dopri5.hpp"
+#include "integrate/integrateAdaptive.hpp"
+#include "integrate/rkf45.hpp"
+#include "integrate/rkf78.hpp"
+
+#include "testDynamicalModels.hpp"
+#include "testState.hpp"
+
+namespace integrate
+{
+namespace tests
+{
+
+TEST_CASE("Test adaptive integration lands exactly on final time", "[integrate_adaptive]")
+{
+    const Real initialTime = 0.0;
+    const State initialState({0.5});
+    const Real finalTime = 2.0;
+    const Real tolerance = 1.0e-8;
+    const Real minimumStepSize = 1.0e-6;
+    const Real maximumStepSize = 0.3;
+
+    // Analytical solution: y(t) = (t + 1)^2 - 0.5 * exp(t).
+    const Real expectedState = (finalTime + 1.0) * (finalTime + 1.0) - 0.5 * std::exp(finalTime);
+
+    SECTION("Runge-Kutta-Fehlberg 4(5)")
+    {
+        Real currentTime = initialTime;
+        State currentState = initialState;
+        Real currentStepSize = 0.01;
+
+        RKF45Stepper<Real, State> stepper;
+        const int numberOfSteps = integrateAdaptive(stepper,
+                                                    currentTime,
+                                                    currentState,
+                                                    currentStepSize,
+                                                    finalTime,
+                                                    BurdenFaires(),
+                                                    tolerance,
+                                                    minimumStepSize,
+                                                    maximumStepSize);
+
+        REQUIRE(numberOfSteps > 1);
+        REQUIRE(currentTime == finalTime);
+        REQUIRE(currentState[0] == Catch::Approx(expectedState).epsilon(1.0e-7));
+    }
+
+    SECTION("Runge-Kutta-Fehlberg 7(8)")
+    {
+        Real currentTime = initialTime;
+        State currentState = initialState;
+        Real currentStepSize = 0.01;
+
+        RKF78Stepper<Real, State> stepper;
+        integrateAdaptive(stepper,
+                          currentTime,
+                          currentState,
+                          currentStepSize,
+                          finalTime,
+                          BurdenFaires(),
+                          tolerance,
+                          minimumStepSize,
+                          maximumStepSize);
+
+        REQUIRE(currentTime == finalTime);
+        REQUIRE(currentState[0] == Catch::Approx(expectedState).epsilon(1.0e-7));
+    }
+
+    SECTION("Dormand-Prince 5(4) with output at fixed intervals")
+    {
+        Real currentTime = initialTime;
+        State currentState = initialState;
+        Real currentStepSize = 0.01;
+
+        DOPRI5Stepper<Real, State> stepper;
+        for (int i = 1; i <= 10; ++i)
+        {
+            const Real outputTime = 0.1 * i * finalTime;
+            integrateAdaptive(stepper,
+                              currentTime,
+                              currentState,
+                              currentStepSize,
+                              outputTime,
+                              BurdenFaires(),
+                              tolerance,
+                              minimumStepSize,
+                              maximumStepSize);
+
+            const Real expectedOutputState = (outputTime + 1.0) * (outputTime + 1.0)
+                                             - 0.5 * std::exp(outputTime);
+            REQUIRE(currentTime == outputTime);
+            REQUIRE(currentState[0] == Catch::Approx(expectedOutputState).epsilon(1.0e-7));
+        }
+    }
+}
+
+TEST_CASE("Test adaptive step reuses first stage for rejected attempts", "[integrate_adaptive]")
+{
+    const Real initialTime = 0.0;
+    const State initialState({0.5});
+    const Real tolerance = 1.0e-10;
+    const Real minimumStepSize = 1.0e-8;
+    const Real maximumStepSize = 1.0;
+
+    int numberOfEvaluations = 0;
+    int numberOfInitialTimeEvaluations = 0;
+    auto computeStateDerivative = [&](const Real time, const State& state)
+    {
+        ++numberOfEvaluations;
+        if (time == initialTime)
+        {
+            ++numberOfInitialTimeEvaluations;
+        }
+        return BurdenFaires()(time, state);
+    };
+
+    Real currentTime = initialTime;
+    State currentState = initialState;
+
+    // The initial step size is far too large for the tolerance, so the step is rejected several
+    // times before it is accepted.
+    Real currentStepSize = 1.0;
+
+    RKF45Stepper<Real, State> stepper;
+    stepper.step(currentTime,
+                 currentState,
+                 currentStepSize,
+                 computeStateDerivative,
+                 tolerance,
+                 minimumStepSize,
+                 maximumStepSize);
+
+    REQUIRE(currentTime > initialTime);
+    REQUIRE(currentTime < 1.0);
+    REQUIRE(numberOfInitialTimeEvaluations == 1);
+    REQUIRE(numberOfEvaluations > 6);
+    REQUIRE((numberOfEvaluations - 1) % 5 == 0);
+}
+
+TEST_CASE("Test adaptive step throws if minimum step size is exceeded", "[integrate_adaptive]")
+{
+    const Real tolerance = 1.0e-14;
+    const Real minimumStepSize = 0.1;
+    const Real maximumStepSize = 1.0;
+
+    Real currentTime = 0.0;
+    State currentState({0.5});
+    Real currentStepSize = 1.0;
+
+    RKF45Stepper<Real, State> stepper;
+    REQUIRE_THROWS_AS(integrateAdaptive(stepper,
+                                        currentTime,
+                                        currentState,
+                                        currentStepSize,
+                                        2.0,
+                                        BurdenFaires(),
+                                        tolerance,
+                                        minimumStepSize,
+                                        maximumStepSize),
+                      std::runtime_error);
+
+    REQUIRE_THROWS_AS(integrateAdaptive(stepper,
+                                        currentTime,
+                                        currentState,
+                                        currentStepSize,
+                                        -1.0,
+                                        BurdenFaires(),
+                                        tolerance,
+                                        minimumStepSize,
+                                        maximumStepSize),
+                      std::runtime_error);
+}
+
+TEST_CASE("Test adaptive integration throws if step size does not advance time",
+          "[integrate_adaptive]")
+{
+    const Real tolerance = 1.0e-8;
+    const Real minimumStepSize = 0.0;
+    const Real maximumStepSize = 1.0;
+
+    SECTION("Step size that is not positive")
+    {
+        Real currentTime = 0.0;
+        State currentState({0.5});
+        Real currentStepSize = 0.0;
+
+        RKF45Stepper<Real, State> stepper;
+        REQUIRE_THROWS_AS(integrateAdaptive(stepper,
+                                            currentTime,
+                                            currentState,
+                                            currentStepSize,
+                                            2.0,
+                                            BurdenFaires(),
+                                            tolerance,
+                                            minimumStepSize,
+                                            maximumStepSize),
+                          std::runtime_error);
+
+        currentStepSize = -0.1;
+        REQUIRE_THROWS_AS(integrateAdaptive(stepper,
+                                            currentTime,
+                                            currentState,
+                                            currentStepSize,
+                                            2.0,
+                                            BurdenFaires(),
+                                            tolerance,
+                                            minimumStepSize,
+                                            maximumStepSize),
+                          std::runtime_error);
+        REQUIRE(currentTime == 0.0);
+        REQUIRE(currentState[0] == 0.5);
+    }
+
+    SECTION("Step that proposes step size of zero for next step")
+    {
+        Real currentTime = 0.0;
+        Real currentStepSize = 0.5;
+        int numberOfCalls = 0;
+        const auto executeStep = [&](Real& stepSize, const Real)
+        {
+            currentTime += stepSize;
+            stepSize = 0.0;
+            ++numberOfCalls;
+        };
+        REQUIRE_THROWS_AS(detail::integrateAdaptive(currentTime,
+                                                    currentStepSize,
+                                                    2.0,
+                                                    minimumStepSize,
+                                                    executeStep),
+                          std::runtime_error);
+        REQUIRE(numberOfCalls == 1);
+        REQUIRE(currentTime == 0.5);
+    }
+
+    SECTION("Step size below resolution of time")
+    {
+        Real currentTime = 1.0e20;
+        State currentState({0.5});
+        Real currentStepSize = 1.0;
+
+        RKF45Stepper<Real, State> stepper;
+        REQUIRE_THROWS_AS(integrateAdaptive(stepper,
+                                            currentTime,
+                                            currentState,
+                                            currentStepSize,
+                                            2.0e20,
+                                            BurdenFaires(),
+                                            tolerance,
+                                            minimumStepSize,
+                                            maximumStepSize),
+                          std::runtime_error);
+        REQUIRE(currentTime == 1.0e20);
+    }
+}
+
+} // namespace tests
+} // namespace integrate
@@ -0,0 +1,168 @@
+/*
+ * Copyright (c) 2014-2025 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <array>
+#include <vector>
+
+#include "integrate/linearCombination.hpp"
+
+#include "testState.hpp"
+
+namespace integrate
+{
+namespace tests
+{
+
+//! State that only provides the operators used by the original integrators.
+class OperatorOnlyState
+{
+public:
+
+    OperatorOnlyState(const Vector& aVector) : vector(aVector) { }
+
+    const int size() const { return vector.size(); }
+    const Real operator[](const int i) const { return vector[i]; }
+
+    friend OperatorOnlyState operator+(const OperatorOnlyState& leftHandSide,
+                                       const OperatorOnlyState& rightHandSide)
+    {
+        Vector vector(leftHandSide.size());
+        for (unsigned int i = 0; i < vector.size(); i++)
+        {
+            vector[i] = leftHandSide[i] + rightHandSide[i];
+        }
+        return OperatorOnlyState(vector);
+    }
+
+    friend OperatorOnlyState operator*(const Real multiplier, const OperatorOnlyState& state)
+    {
+        Vector vector(state.size());
+        for (unsigned int i = 0; i < vector.size(); i++)
+        {
+            vector[i] = multiplier * state[i];
+        }
+        return OperatorOnlyState(vector);
+    }
+
+private:
+
+    Vector vector;
+};
+
+TEST_CASE("Test detection of indexable states", "[linear_combination]")
+{
+    REQUIRE(StateTraits<State>::isIndexable);
+    REQUIRE(StateTraits<std::vector<double> >::isIndexable);
+    REQUIRE(!StateTraits<OperatorOnlyState>::isIndexable);
+    REQUIRE(!StateTraits<double>::isIndexable);
+}
+
+TEST_CASE("Test detection of contiguous states", "[linear_combination]")
+{
+    REQUIRE(StateTraits<std::vector<double> >::isContiguous);
+    REQUIRE(StateTraits<std::array<double, 6> >::isContiguous);
+    REQUIRE(!StateTraits<State>::isContiguous);
+    REQUIRE(!StateTraits<OperatorOnlyState>::isContiguous);
+    REQUIRE(!StateTraits<double>::isContiguous);
+}
+
+TEST_CASE("Test linear combination for indexable state", "[linear_combination]")
+{
+    const State base({1.0, 2.0, 3.0});
+    const State k1({0.5, -1.0, 2.0});
+    const State k2({4.0, 0.25, -8.0});
+
+    State result({0.0});
+    computeLinearCombination(result, base, 2.0, 0.5, k1, -0.25, k2);
+    REQUIRE(result.size() == 3);
+    REQUIRE(result[0] == Catch::Approx(1.0 + 2.0 * (0.25 - 1.0)));
+    REQUIRE(result[1] == Catch::Approx(2.0 + 2.0 * (-0.5 - 0.0625)));
+    REQUIRE(result[2] == Catch::Approx(3.0 + 2.0 * (1.0 + 2.0)));
+
+    const Real coefficients[] = {0.5, -0.25};
+    const State* const terms[] = {&k1, &k2};
+    State arrayResult = base;
+    computeLinearCombination(arrayResult, base, 2.0, coefficients, terms);
+    REQUIRE(arrayResult == result);
+
+    State weightedSum = base;
+    computeWeightedSum(weightedSum, 2.0, 0.5, k1, -0.25, k2);
+    REQUIRE(weightedSum[0] == Catch::Approx(2.0 * (0.25 - 1.0)));
+    REQUIRE(weightedSum[1] == Catch::Approx(2.0 * (-0.5 - 0.0625)));
+    REQUIRE(weightedSum[2] == Catch::Approx(2.0 * (1.0 + 2.0)));
+}
+
+TEST_CASE("Test linear combination in-place for indexable state", "[linear_combination]")
+{
+    State state({1.0, 2.0});
+    const State k1({0.5, -1.0});
+
+    computeLinearCombination(state, state, 0.1, 1.0, k1, 2.0, state);
+    REQUIRE(state[0] == Catch::Approx(1.0 + 0.1 * (0.5 + 2.0)));
+    REQUIRE(state[1] == Catch::Approx(2.0 + 0.1 * (-1.0 + 4.0)));
+}
+
+TEST_CASE("Test linear combination for contiguous state", "[linear_combination]")
+{
+    // Use a size that is not a multiple of the block size of the contiguous kernels.
+    const int size = 1001;
+    std::vector<double> base(size);
+    std::vector<double> k1(size);
+    std::vector<double> k2(size);
+    for (int i = 0; i < size; ++i)
+    {
+        base[i] = 0.5 * i;
+        k1[i] = 1.0 - 0.25 * i;
+        k2[i] = 0.125 * i * i;
+    }
+
+    std::vector<double> result;
+    computeLinearCombination(result, base, 0.1, 2.0, k1, -4.0, k2);
+    REQUIRE(result.size() == static_cast<std::size_t>(size));
+
+    std::vector<double> weightedSum(size);
+    computeWeightedSum(weightedSum, 0.1, 2.0, k1, -4.0, k2);
+
+    for (int i = 0; i < size; ++i)
+    {
+        REQUIRE(result[i] == Catch::Approx(base[i] + 0.1 * (2.0 * k1[i] - 4.0 * k2[i])));
+        REQUIRE(weightedSum[i] == Catch::Approx(0.1 * (2.0 * k1[i] - 4.0 * k2[i])));
+    }
+
+    // The result may be the same object as the base or any of the terms.
+    std::vector<double> state = base;
+    computeLinearCombination(state, state, 0.1, 2.0, k1, -4.0, state);
+    for (int i = 0; i < size; ++i)
+    {
+        REQUIRE(state[i] == Catch::Approx(base[i] + 0.1 * (2.0 * k1[i] - 4.0 * base[i])));
+    }
+}
+
+TEST_CASE("Test linear combination for state that only provides operators",
+          "[linear_combination]")
+{
+    const OperatorOnlyState base({1.0, 2.0, 3.0});
+    const OperatorOnlyState k1({0.5, -1.0, 2.0});
+    const OperatorOnlyState k2({4.0, 0.25, -8.0});
+
+    OperatorOnlyState result({0.0});
+    computeLinearCombination(result, base, 2.0, 0.5, k1, -0.25, k2);
+    REQUIRE(result.size() == 3);
+    REQUIRE(result[0] == Catch::Approx(1.0 + 2.0 * (0.25 - 1.0)));
+    REQUIRE(result[1] == Catch::Approx(2.0 + 2.0 * (-0.5 - 0.0625)));
+    REQUIRE(result[2] == Catch::Approx(3.0 + 2.0 * (1.0 + 2.0)));
+
+    computeWeightedSum(result, 2.0, 0.5, k1, -0.25, k2);
+    REQUIRE(result[0] == Catch::Approx(2.0 * (0.25 - 1.0)));
+    REQUIRE(result[1] == Catch::Approx(2.0 * (-0.5 - 0.0625)));
+    REQUIRE(result[2] == Catch::Approx(2.0 * (1.0 + 2.0)));
+}
+
+} // namespace tests
+} // namespace integrate
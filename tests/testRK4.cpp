@@ -64,6 +64,28 @@ TEST_CASE("Test Runge-Kutta 4 integrator integrator for zero dynamics class", "[
     REQUIRE(currentState == initialState);
 }
 
+TEST_CASE("Test Runge-Kutta 4 integrator for zero dynamics lambda", "[rk4]")
+{
+    const Real initialTime = 1.0;
+    const State initialState({1.2, 2.3, -3.6});
+    const Real stepSize = 0.1;
+
+    Real currentTime = initialTime;
+    State currentState = initialState;
+
+    auto computeStateDerivative = [](const Real, const State&)
+    {
+        return State({0.0, 0.0, 0.0});
+    };
+    stepRK4<Real, State>(currentTime,
+                         currentState,
+                         stepSize,
+                         computeStateDerivative);
+
+    REQUIRE(currentTime  == (initialTime + stepSize));
+    REQUIRE(currentState == initialState);
+}
+
 TEST_CASE("Test Runge-Kutta 4 integrator for Burden & Faires (9th ed.): Table 5.8", "[rk4]")
 {
     const Real initialTime = 0.0;
@@ -104,5 +126,103 @@ TEST_CASE("Test Runge-Kutta 4 integrator for Burden & Faires (9th ed.): Table 5.
    }
 }
 
+TEST_CASE("Test Runge-Kutta 4 integrator for Burden & Faires (9th ed.): Table 5.8 using "
+          "type-erased state derivative function", "[rk4]")
+{
+    const Real initialTime = 0.0;
+    const State initialState({0.5});
+    const Real stepSize = 0.2;
+
+    Real currentTime = initialTime;
+    State currentState = initialState;
+
+    const Real testTolerance = 1.0e-7;
+
+    std::map<Real, State> burdenFairesTable5_1Data;
+    burdenFairesTable5_1Data.insert({0.2, State({0.8292933})});
+    burdenFairesTable5_1Data.insert({0.4, State({1.2140762})});
+    burdenFairesTable5_1Data.insert({0.6, State({1.6489220})});
+    burdenFairesTable5_1Data.insert({0.8, State({2.1272027})});
+    burdenFairesTable5_1Data.insert({1.0, State({2.6408227})});
+
+    const StateDerivativeFunction<Real, State> computeStateDerivative = BurdenFaires();
+
+    for (const auto& pair : burdenFairesTable5_1Data)
+    {
+        stepRK4<Real, State>(currentTime,
+                             currentState,
+                             stepSize,
+                             computeStateDerivative);
+        REQUIRE(pair.first == Catch::Approx(currentTime).epsilon(testTolerance));
+        REQUIRE(pair.second[0] == Catch::Approx(currentState[0]).epsilon(testTolerance));
+   }
+}
+
+TEST_CASE("Test Runge-Kutta 4 stepper for Burden & Faires (9th ed.): Table 5.8", "[rk4]")
+{
+    const Real initialTime = 0.0;
+    const State initialState({0.5});
+    const Real stepSize = 0.2;
+
+    Real currentTime = initialTime;
+    State currentState = initialState;
+
+    const Real testTolerance = 1.0e-7;
+
+    std::map<Real, State> burdenFairesTable5_1Data;
+    burdenFairesTable5_1Data.insert({0.2, State({0.8292933})});
+    burdenFairesTable5_1Data.insert({0.4, State({1.2140762})});
+    burdenFairesTable5_1Data.insert({0.6, State({1.6489220})});
+    burdenFairesTable5_1Data.insert({0.8, State({2.1272027})});
+    burdenFairesTable5_1Data.insert({1.0, State({2.6408227})});
+
+    RK4Stepper<Real, State> stepper;
+    for (const auto& pair : burdenFairesTable5_1Data)
+    {
+        stepper.step(currentTime, currentState, stepSize, BurdenFaires());
+        REQUIRE(pair.first == Catch::Approx(currentTime).epsilon(testTolerance));
+        REQUIRE(pair.second[0] == Catch::Approx(currentState[0]).epsilon(testTolerance));
+   }
+}
+
+TEST_CASE("Test Runge-Kutta 4 free function with stepper that is reused across calls", "[rk4]")
+{
+    const Real stepSize = 0.2;
+
+    // The in-place state derivative writes into the storage for the stages, which must be set up
+    // again if the number of elements of the state changes between calls.
+    auto computeDecay = [](const Real, const State& state, State& stateDerivative)
+    {
+        for (int i = 0; i < state.size(); ++i)
+        {
+            stateDerivative[i] = -state[i];
+        }
+    };
+
+    Real time = 0.0;
+    State state({1.0});
+    stepRK4<Real, State>(time, state, stepSize, computeDecay);
+    const Real decayFactor = state[0];
+
+    time = 0.0;
+    State largerState({1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0});
+    stepRK4<Real, State>(time, largerState, stepSize, computeDecay);
+    REQUIRE(largerState[0] == decayFactor);
+    REQUIRE(largerState[7] == Catch::Approx(8.0 * decayFactor));
+
+    // The free function can be called from within the state derivative of another call.
+    auto computeNestedDecay = [&computeDecay, stepSize](const Real, const State& state)
+    {
+        Real nestedTime = 0.0;
+        State nestedState = state;
+        stepRK4<Real, State>(nestedTime, nestedState, stepSize, computeDecay);
+        return State({-state[0]});
+    };
+    time = 0.0;
+    state = State({1.0});
+    stepRK4<Real, State>(time, state, stepSize, computeNestedDecay);
+    REQUIRE(state[0] == decayFactor);
+}
+
 } // namespace tests
 } // namespace integrate
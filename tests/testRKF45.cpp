@@ -89,6 +89,35 @@ TEST_CASE("Test Runge-Kutta-Fehlberg 4(5) integrator integrator for zero dynamic
     REQUIRE(finalStepSize == initialStepSize);
 }
 
+TEST_CASE("Test Runge-Kutta-Fehlberg 4(5) integrator for zero dynamics lambda", "[rkf45]")
+{
+    const Real initialTime = 1.0;
+    const State initialState({1.2, 2.3, -3.6});
+    const Real initialStepSize = 0.1;
+    const Real tolerance = 1.0e-6;
+    const Real minimumStepSize = 0.01;
+    const Real maximumStepSize = 1.0;
+
+    Real currentTime = initialTime;
+    State currentState = initialState;
+    Real currentStepSize = initialStepSize;
+
+    auto computeStateDerivative = [](const Real, const State&)
+    {
+        return State({0.0, 0.0, 0.0});
+    };
+    stepRKF45<Real, State>(currentTime,
+                           currentState,
+                           currentStepSize,
+                           computeStateDerivative,
+                           tolerance,
+                           minimumStepSize,
+                           maximumStepSize);
+
+    REQUIRE(currentTime  == (initialTime + initialStepSize));
+    REQUIRE(currentState == initialState);
+}
+
 TEST_CASE("Test Runge-Kutta-Fehlberg 4(5) integrator using Burden & Faires (9th ed.): Table 5.11",
            "[rkf45]")
 {
@@ -145,5 +174,53 @@ TEST_CASE("Test Runge-Kutta-Fehlberg 4(5) integrator using Burden & Faires (9th
    }
 }
 
+TEST_CASE("Test Runge-Kutta-Fehlberg 4(5) stepper using Burden & Faires (9th ed.): Table 5.11",
+           "[rkf45]")
+{
+    const Real initialTime = 0.0;
+    const State initialState({0.5});
+    const Real initialStepSize = 0.25;
+    const Real tolerance = 1.0e-5;
+    const Real minimumStepSize = 0.01;
+    const Real maximumStepSize = 0.25;
+
+    const Real testTolerance = 1.0e-5;
+
+    Real currentTime = initialTime;
+    State currentState = initialState;
+    Real currentStepSize = initialStepSize;
+
+    std::map<Real, State> burdenFairesTable5_9Data;
+    burdenFairesTable5_9Data.insert({0.2500000, State({0.9204873})});
+    burdenFairesTable5_9Data.insert({0.4865522, State({1.3964884})});
+    burdenFairesTable5_9Data.insert({0.7293332, State({1.9537446})});
+    burdenFairesTable5_9Data.insert({0.9793332, State({2.5864198})});
+    burdenFairesTable5_9Data.insert({1.2293332, State({3.2604520})});
+
+    RKF45Stepper<Real, State> stepper;
+    std::map<Real, State>::iterator mapIterator = burdenFairesTable5_9Data.begin();
+    for (const auto& pair : burdenFairesTable5_9Data)
+    {
+        stepper.step(currentTime,
+                     currentState,
+                     currentStepSize,
+                     BurdenFaires(),
+                     tolerance,
+                     minimumStepSize,
+                     maximumStepSize);
+        REQUIRE(pair.first == Catch::Approx(currentTime).epsilon(testTolerance));
+        REQUIRE(pair.second[0] == Catch::Approx(currentState[0]).epsilon(testTolerance));
+
+        // Force time, state and step size to coincide with test data (see above).
+        currentTime = pair.first;
+        currentState = pair.second;
+        std::advance(mapIterator, 1);
+        if (mapIterator != burdenFairesTable5_9Data.end())
+        {
+            currentStepSize = mapIterator->first - pair.first;
+        }
+   }
+}
+
 } // namespace tests
 } // namespace integrate
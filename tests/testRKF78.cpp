@@ -90,6 +90,65 @@ TEST_CASE("Test Runge-Kutta-Fehlberg 7(8) integrator integrator for zero dynamic
     REQUIRE(finalStepSize == initialStepSize);
 }
 
+TEST_CASE("Test Runge-Kutta-Fehlberg 7(8) integrator for zero dynamics lambda", "[rkf78]")
+{
+    const Real initialTime = 1.0;
+    const State initialState({1.2, 2.3, -3.6});
+    const Real initialStepSize = 0.1;
+    const Real tolerance = 1.0e-6;
+    const Real minimumStepSize = 0.01;
+    const Real maximumStepSize = 1.0;
+
+    Real currentTime = initialTime;
+    State currentState = initialState;
+    Real currentStepSize = initialStepSize;
+
+    auto computeStateDerivative = [](const Real, const State&)
+    {
+        return State({0.0, 0.0, 0.0});
+    };
+    stepRKF78<Real, State>(currentTime,
+                           currentState,
+                           currentStepSize,
+                           computeStateDerivative,
+                           tolerance,
+                           minimumStepSize,
+                           maximumStepSize);
+
+    REQUIRE(currentTime  == (initialTime + initialStepSize));
+    REQUIRE(currentState == initialState);
+}
+
+TEST_CASE("Test Runge-Kutta-Fehlberg 7(8) stepper for zero dynamics over multiple steps",
+          "[rkf78]")
+{
+    const Real initialTime = 1.0;
+    const State initialState({1.2, 2.3, -3.6});
+    const Real stepSize = 0.1;
+    const Real tolerance = 1.0e-6;
+    const Real minimumStepSize = 0.01;
+    const Real maximumStepSize = 0.1;
+
+    Real currentTime = initialTime;
+    State currentState = initialState;
+
+    RKF78Stepper<Real, State> stepper;
+    for (int i = 0; i < 10; ++i)
+    {
+        Real currentStepSize = stepSize;
+        stepper.step(currentTime,
+                     currentState,
+                     currentStepSize,
+                     ZeroDynamics(),
+                     tolerance,
+                     minimumStepSize,
+                     maximumStepSize);
+    }
+
+    REQUIRE(currentTime == Catch::Approx(initialTime + 10 * stepSize));
+    REQUIRE(currentState == initialState);
+}
+
 // TEST_CASE("Test Runge-Kutta-Fehlberg 7(8) integrator using ...", "[rkf78]")
 // {
 //     @TODO: Add a test case from a source like Tudat, MATLAB, etc.
@@ -0,0 +1,231 @@
+/*
+ * Copyright (c) 2014-2025 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include "integrate/integrateAdaptive.hpp"
+#include "integrate/luDecomposition.hpp"
+#include "integrate/rkf45.hpp"
+#include "integrate/ros34pw2.hpp"
+#include "integrate/statistics.hpp"
+#include "integrate/stepSizeControl.hpp"
+
+#include "testDynamicalModels.hpp"
+#include "testState.hpp"
+
+namespace integrate
+{
+namespace tests
+{
+
+//! Statistics collected by steppers.
+typedef IntegrationStatistics<Real> StiffStatistics;
+
+//! Rosenbrock-W stepper for vector states.
+typedef ROS34PW2Stepper<Real, Vector, StiffStatistics> VectorROS34PW2Stepper;
+
+//! Stiffness parameter of Prothero-Robinson problem.
+const Real stiffness = -1.0e4;
+
+//! Compute state derivative of Prothero-Robinson problem, y' = lambda (y - cos(t)) - sin(t).
+/*!
+ * Computes state derivative of Prothero-Robinson problem, with solution y(t) = cos(t) for
+ * y(0) = 1. Solutions that start elsewhere decay to this solution with time constant
+ * -1 / lambda, which limits the step size of explicit schemes to the order of -1 / lambda.
+ */
+void computeStiffStateDerivative(const Real time, const Vector& state, Vector& stateDerivative)
+{
+    stateDerivative[0] = stiffness * (state[0] - std::cos(time)) - std::sin(time);
+}
+
+//! Compute Jacobian of Prothero-Robinson problem.
+void computeStiffJacobian(const Real, const Vector&, std::vector<Real>& jacobian)
+{
+    jacobian[0] = stiffness;
+}
+
+//! Compute state derivative of nonlinear, non-autonomous test problem.
+/*!
+ * Computes state derivative of y_0' = -y_0^2 and y_1' = y_1 - t^2 + 1 (Burden & Faires), with
+ * solution y_0(t) = 1 / (1 + t) and y_1(t) = (t + 1)^2 - 0.5 exp(t) for y(0) = (1, 0.5).
+ */
+void computeNonlinearStateDerivative(const Real time,
+                                     const Vector& state,
+                                     Vector& stateDerivative)
+{
+    stateDerivative[0] = -state[0] * state[0];
+    stateDerivative[1] = state[1] - time * time + 1.0;
+}
+
+//! Integrate nonlinear test problem to t = 1 with given number of fixed steps.
+/*!
+ * Integrates nonlinear test problem with fixed step size, by setting the minimum and maximum step
+ * size to the step size and the tolerance to a large value, and returns the maximum error at the
+ * final time.
+ */
+Real integrateNonlinearProblem(const int numberOfSteps, const int maximumJacobianAge)
+{
+    const Real stepSize = 1.0 / numberOfSteps;
+    ROS34PW2Stepper<Real, Vector> stepper(maximumJacobianAge);
+    Real time = 0.0;
+    Vector state(2);
+    state[0] = 1.0;
+    state[1] = 0.5;
+    for (int i = 0; i < numberOfSteps; ++i)
+    {
+        Real currentStepSize = stepSize;
+        stepper.step(time, state, currentStepSize, &computeNonlinearStateDerivative, 1.0e10,
+                     stepSize, stepSize);
+    }
+    return std::max(std::fabs(state[0] - 0.5),
+                    std::fabs(state[1] - (4.0 - 0.5 * std::exp(1.0))));
+}
+
+TEST_CASE("Test LU decomposition with partial pivoting", "[rosenbrock]")
+{
+    // Matrix with zero leading element, which requires pivoting.
+    std::vector<Real> matrix = {0.0, 2.0, 1.0,
+                                1.0, 1.0, 0.0,
+                                4.0, 1.0, 3.0};
+    std::vector<int> pivots(3);
+    REQUIRE(detail::computeLUDecomposition(matrix.data(), 3, pivots.data()));
+
+    // Solution of A x = b for x = (1, 2, 3).
+    Vector vector = {7.0, 3.0, 15.0};
+    std::vector<Real> storage(3);
+    detail::solveLUSystem(matrix.data(), 3, pivots.data(), vector, storage.data());
+    REQUIRE(vector[0] == Catch::Approx(1.0).epsilon(1.0e-14));
+    REQUIRE(vector[1] == Catch::Approx(2.0).epsilon(1.0e-14));
+    REQUIRE(vector[2] == Catch::Approx(3.0).epsilon(1.0e-14));
+
+    std::vector<Real> singularMatrix = {1.0, 2.0,
+                                        2.0, 4.0};
+    REQUIRE(!detail::computeLUDecomposition(singularMatrix.data(), 2, pivots.data()));
+}
+
+TEST_CASE("Test ROS34PW2 integrator for Burden & Faires dynamics", "[rosenbrock]")
+{
+    const Real finalTime = 2.0;
+
+    // Analytical solution: y(t) = (t + 1)^2 - 0.5 * exp(t).
+    const Real expectedState = (finalTime + 1.0) * (finalTime + 1.0) - 0.5 * std::exp(finalTime);
+
+    Real time = 0.0;
+    State state({0.5});
+    Real stepSize = 0.01;
+
+    ROS34PW2Stepper<Real, State> stepper;
+    integrateAdaptive(stepper, time, state, stepSize, finalTime, BurdenFaires(), 1.0e-8,
+                      1.0e-8, 0.5);
+
+    REQUIRE(time == finalTime);
+    REQUIRE(state[0] == Catch::Approx(expectedState).epsilon(1.0e-6));
+}
+
+TEST_CASE("Test convergence order of ROS34PW2 integrator", "[rosenbrock]")
+{
+    // The order does not depend on the accuracy of the Jacobian (W-method), so it is the same if
+    // the Jacobian is evaluated on every step or only at the first step.
+    SECTION("Jacobian evaluated on every step")
+    {
+        const Real error = integrateNonlinearProblem(40, 1);
+        const Real halvedStepSizeError = integrateNonlinearProblem(80, 1);
+        REQUIRE(std::log2(error / halvedStepSizeError) == Catch::Approx(3.0).margin(0.1));
+    }
+
+    SECTION("Jacobian of first step kept")
+    {
+        const Real error = integrateNonlinearProblem(40, 1000);
+        const Real halvedStepSizeError = integrateNonlinearProblem(80, 1000);
+        REQUIRE(std::log2(error / halvedStepSizeError) == Catch::Approx(3.0).margin(0.1));
+    }
+}
+
+TEST_CASE("Test ROS34PW2 integrator for stiff Prothero-Robinson problem", "[rosenbrock]")
+{
+    const Real finalTime = 10.0;
+    const WeightedRootMeanSquareErrorNorm<Real, Vector> errorNorm(1.0e-6, 1.0e-6);
+
+    Real time = 0.0;
+    Vector state(1, 1.0);
+    Real stepSize = 1.0e-3;
+    StepSizeController<Real> controller;
+    VectorROS34PW2Stepper stepper;
+    int numberOfEvaluationsPerJacobian = 0;
+
+    SECTION("User-provided Jacobian")
+    {
+        while (time < finalTime)
+        {
+            if (time + stepSize > finalTime)
+            {
+                stepSize = finalTime - time;
+            }
+            stepper.step(time, state, stepSize, &computeStiffStateDerivative,
+                         &computeStiffJacobian, errorNorm, controller, 1.0e-12, 1.0);
+        }
+
+        // Time derivative.
+        numberOfEvaluationsPerJacobian = 1;
+    }
+
+    SECTION("Finite-difference Jacobian")
+    {
+        integrateAdaptive(stepper, time, state, stepSize, finalTime, &computeStiffStateDerivative,
+                          errorNorm, controller, 1.0e-12, 1.0);
+
+        // One column and time derivative.
+        numberOfEvaluationsPerJacobian = 2;
+    }
+
+    const StiffStatistics& statistics = stepper.getStatistics();
+    REQUIRE(time == Catch::Approx(finalTime));
+    REQUIRE(state[0] == Catch::Approx(std::cos(finalTime)).margin(1.0e-5));
+
+    // The Jacobian and its LU decomposition are kept across steps.
+    REQUIRE(stepper.getNumberOfJacobianEvaluations() < statistics.getNumberOfAcceptedSteps());
+    REQUIRE(stepper.getNumberOfDecompositions() < statistics.getNumberOfAcceptedSteps());
+
+    // The state derivative at the start of each step, three stages per attempt, and the
+    // evaluations of each Jacobian.
+    REQUIRE(statistics.getNumberOfStateDerivativeEvaluations()
+            == statistics.getNumberOfAcceptedSteps()
+               + 3 * (statistics.getNumberOfAcceptedSteps()
+                      + statistics.getNumberOfRejectedSteps())
+               + numberOfEvaluationsPerJacobian * stepper.getNumberOfJacobianEvaluations());
+
+    // The step size of RKF45 is limited by stability rather than accuracy.
+    Real rkf45Time = 0.0;
+    Vector rkf45State(1, 1.0);
+    Real rkf45StepSize = 1.0e-3;
+    StepSizeController<Real> rkf45Controller;
+    RKF45Stepper<Real, Vector, StiffStatistics> rkf45Stepper;
+    integrateAdaptive(rkf45Stepper, rkf45Time, rkf45State, rkf45StepSize, finalTime,
+                      &computeStiffStateDerivative, errorNorm, rkf45Controller, 1.0e-12, 1.0);
+    REQUIRE(100 * statistics.getNumberOfAcceptedSteps()
+            < rkf45Stepper.getStatistics().getNumberOfAcceptedSteps());
+}
+
+TEST_CASE("Test ROS34PW2 integrator with invalid settings", "[rosenbrock]")
+{
+    REQUIRE_THROWS_AS((ROS34PW2Stepper<Real, Vector>(0)), std::invalid_argument);
+
+    Real time = 0.0;
+    Vector state(1, 0.0);
+    Real stepSize = 1.0;
+    ROS34PW2Stepper<Real, Vector> stepper;
+    REQUIRE_THROWS_AS(stepper.step(time, state, stepSize, &computeStiffStateDerivative, 1.0e-15,
+                                   0.5, 1.0),
+                      std::runtime_error);
+}
+
+} // namespace tests
+} // namespace integrate
@@ -0,0 +1,349 @@
+/*
+ * Copyright (c) 2014-2025 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <array>
+#include <cmath>
+#include <stdexcept>
+
+#include "integrate/integrateAdaptive.hpp"
+#include "integrate/rkf78.hpp"
+#include "integrate/rkn43.hpp"
+#include "integrate/rkn64.hpp"
+#include "integrate/statistics.hpp"
+#include "integrate/stepSizeControl.hpp"
+
+#include "testState.hpp"
+
+namespace integrate
+{
+namespace tests
+{
+
+//! Statistics collected by steppers.
+typedef IntegrationStatistics<Real> NystromStatistics;
+
+//! Position or velocity of one-dimensional harmonic oscillator.
+typedef std::array<Real, 1> NystromOscillatorState;
+
+//! Position or velocity of planar Kepler orbit.
+typedef std::array<Real, 2> NystromOrbitVector;
+
+//! State of planar Kepler orbit as first-order system, i.e., position and velocity.
+typedef std::array<Real, 4> NystromOrbitState;
+
+//! Period of Kepler orbit with unit gravitational parameter and semi-major axis.
+const Real nystromOrbitPeriod = 2.0 * 3.14159265358979323846;
+
+//! Compute acceleration of harmonic oscillator with unit angular frequency.
+void computeNystromOscillatorAcceleration(const Real,
+                                          const NystromOscillatorState& position,
+                                          NystromOscillatorState& acceleration)
+{
+    acceleration[0] = -position[0];
+}
+
+//! Compute acceleration of Kepler orbit with unit gravitational parameter.
+void computeNystromOrbitAcceleration(const Real,
+                                     const NystromOrbitVector& position,
+                                     NystromOrbitVector& acceleration)
+{
+    const Real radius = std::sqrt(position[0] * position[0] + position[1] * position[1]);
+    const Real factor = -1.0 / (radius * radius * radius);
+    acceleration[0] = factor * position[0];
+    acceleration[1] = factor * position[1];
+}
+
+//! Compute state derivative of Kepler orbit with unit gravitational parameter.
+void computeNystromOrbitStateDerivative(const Real,
+                                        const NystromOrbitState& state,
+                                        NystromOrbitState& stateDerivative)
+{
+    const Real radius = std::sqrt(state[0] * state[0] + state[1] * state[1]);
+    const Real factor = -1.0 / (radius * radius * radius);
+    stateDerivative[0] = state[2];
+    stateDerivative[1] = state[3];
+    stateDerivative[2] = factor * state[0];
+    stateDerivative[3] = factor * state[1];
+}
+
+//! Integrate harmonic oscillator from t = 0 to t = 4 with given number of fixed steps.
+/*!
+ * Integrates harmonic oscillator, starting at unit position and zero velocity, and returns the
+ * largest of the errors of the position and the velocity at the final time.
+ */
+template <typename Stepper>
+Real computeNystromOscillatorError(const int numberOfSteps)
+{
+    const Real finalTime = 4.0;
+    Real time = 0.0;
+    NystromOscillatorState position = {{1.0}};
+    NystromOscillatorState velocity = {{0.0}};
+
+    Stepper stepper;
+    for (int i = 0; i < numberOfSteps; ++i)
+    {
+        stepper.step(time, position, velocity, finalTime / numberOfSteps,
+                     &computeNystromOscillatorAcceleration);
+    }
+    return std::fmax(std::fabs(position[0] - std::cos(finalTime)),
+                     std::fabs(velocity[0] + std::sin(finalTime)));
+}
+
+//! Compute observed order of convergence from errors for step size h and h/2.
+template <typename Stepper>
+Real computeNystromObservedOrder(const int numberOfSteps)
+{
+    return std::log2(computeNystromOscillatorError<Stepper>(numberOfSteps)
+                     / computeNystromOscillatorError<Stepper>(2 * numberOfSteps));
+}
+
+//! Integrate Kepler orbit (eccentricity 0.5) over one revolution with adaptive step size.
+/*!
+ * Integrates Kepler orbit with given stepper for second-order systems, and returns the position
+ * error after one revolution. The number of acceleration evaluations is returned as output.
+ */
+template <typename Stepper>
+Real integrateNystromOrbit(const Real tolerance, long& numberOfEvaluations)
+{
+    const NystromOrbitVector initialPosition = {{0.5, 0.0}};
+    Real time = 0.0;
+    NystromOrbitVector position = initialPosition;
+    NystromOrbitVector velocity = {{0.0, std::sqrt(3.0)}};
+    Real stepSize = 1.0e-3;
+
+    Stepper stepper;
+    integrateAdaptive(stepper, time, position, velocity, stepSize, nystromOrbitPeriod,
+                      &computeNystromOrbitAcceleration, tolerance, 1.0e-12, 1.0);
+    numberOfEvaluations = stepper.getStatistics().getNumberOfStateDerivativeEvaluations();
+    return std::sqrt((position[0] - initialPosition[0]) * (position[0] - initialPosition[0])
+                     + (position[1] - initialPosition[1]) * (position[1] - initialPosition[1]));
+}
+
+//! Integrate Kepler orbit (eccentricity 0.5) over one revolution with RKF78 for doubled state.
+Real integrateNystromOrbitWithRKF78(const Real tolerance, long& numberOfEvaluations)
+{
+    Real time = 0.0;
+    NystromOrbitState state = {{0.5, 0.0, 0.0, std::sqrt(3.0)}};
+    Real stepSize = 1.0e-3;
+
+    RKF78Stepper<Real, NystromOrbitState, NystromStatistics> stepper;
+    integrateAdaptive(stepper, time, state, stepSize, nystromOrbitPeriod,
+                      &computeNystromOrbitStateDerivative, tolerance, 1.0e-12, 1.0);
+    numberOfEvaluations = stepper.getStatistics().getNumberOfStateDerivativeEvaluations();
+    return std::sqrt((state[0] - 0.5) * (state[0] - 0.5) + state[1] * state[1]);
+}
+
+TEST_CASE("Test Runge-Kutta-Nystrom integrators for zero acceleration", "[runge_kutta_nystrom]")
+{
+    const Real initialTime = 1.0;
+    const State initialPosition({1.2, 2.3, -3.6});
+    const State initialVelocity({0.5, -1.0, 2.0});
+    auto computeAcceleration = [](const Real, const State&)
+    {
+        return State({0.0, 0.0, 0.0});
+    };
+
+    Real currentTime = initialTime;
+    State currentPosition = initialPosition;
+    State currentVelocity = initialVelocity;
+    Real stepSize = 0.1;
+
+    SECTION("Runge-Kutta-Nystrom 4(3)")
+    {
+        stepRKN43(currentTime, currentPosition, currentVelocity, stepSize, computeAcceleration,
+                  1.0e-10, 1.0e-6, 0.1);
+    }
+
+    SECTION("Runge-Kutta-Nystrom 6(4)")
+    {
+        stepRKN64(currentTime, currentPosition, currentVelocity, stepSize, computeAcceleration,
+                  1.0e-10, 1.0e-6, 0.1);
+    }
+
+    REQUIRE(currentTime == Catch::Approx(initialTime + 0.1));
+    REQUIRE(stepSize == Catch::Approx(0.1));
+    REQUIRE(currentVelocity == initialVelocity);
+    for (int i = 0; i < 3; ++i)
+    {
+        REQUIRE(currentPosition[i] == Catch::Approx(initialPosition[i] + 0.1 * initialVelocity[i]));
+    }
+}
+
+TEST_CASE("Test order of convergence of Runge-Kutta-Nystrom integrators",
+          "[runge_kutta_nystrom]")
+{
+    REQUIRE(computeNystromObservedOrder<RKN43Stepper<Real, NystromOscillatorState> >(16)
+            == Catch::Approx(4.0).margin(0.1));
+    REQUIRE(computeNystromObservedOrder<RKN64Stepper<Real, NystromOscillatorState> >(8)
+            == Catch::Approx(6.0).margin(0.2));
+}
+
+TEST_CASE("Test number of acceleration evaluations of Runge-Kutta-Nystrom integrators",
+          "[runge_kutta_nystrom]")
+{
+    const int numberOfSteps = 10;
+    Real time = 0.0;
+    NystromOscillatorState position = {{1.0}};
+    NystromOscillatorState velocity = {{0.0}};
+
+    // Both schemes reuse the acceleration of the last stage as the first stage of the next step.
+    SECTION("Runge-Kutta-Nystrom 4(3)")
+    {
+        RKN43Stepper<Real, NystromOscillatorState, NystromStatistics> stepper;
+        for (int i = 0; i < numberOfSteps; ++i)
+        {
+            stepper.step(time, position, velocity, 0.1, &computeNystromOscillatorAcceleration);
+        }
+        REQUIRE(stepper.getStatistics().getNumberOfStateDerivativeEvaluations()
+                == 3 * numberOfSteps + 1);
+    }
+
+    SECTION("Runge-Kutta-Nystrom 6(4)")
+    {
+        RKN64Stepper<Real, NystromOscillatorState, NystromStatistics> stepper;
+        for (int i = 0; i < numberOfSteps; ++i)
+        {
+            stepper.step(time, position, velocity, 0.1, &computeNystromOscillatorAcceleration);
+        }
+        REQUIRE(stepper.getStatistics().getNumberOfStateDerivativeEvaluations()
+                == 5 * numberOfSteps + 1);
+
+        stepper.reset();
+        stepper.step(time, position, velocity, 0.1, &computeNystromOscillatorAcceleration);
+        REQUIRE(stepper.getStatistics().getNumberOfStateDerivativeEvaluations()
+                == 5 * numberOfSteps + 7);
+    }
+}
+
+TEST_CASE("Test adaptive Runge-Kutta-Nystrom integrators for Kepler orbit",
+          "[runge_kutta_nystrom]")
+{
+    typedef RKN43Stepper<Real, NystromOrbitVector, NystromStatistics> OrbitRKN43Stepper;
+    typedef RKN64Stepper<Real, NystromOrbitVector, NystromStatistics> OrbitRKN64Stepper;
+
+    long numberOfRKN43Evaluations = 0;
+    long numberOfRKN64Evaluations = 0;
+    long numberOfRKF78Evaluations = 0;
+    const Real rkn43Error = integrateNystromOrbit<OrbitRKN43Stepper>(1.0e-8,
+                                                                     numberOfRKN43Evaluations);
+    const Real rkn64Error = integrateNystromOrbit<OrbitRKN64Stepper>(1.0e-6,
+                                                                     numberOfRKN64Evaluations);
+    const Real rkf78Error = integrateNystromOrbitWithRKF78(1.0e-6, numberOfRKF78Evaluations);
+
+    REQUIRE(rkn43Error < 1.0e-7);
+    REQUIRE(rkn64Error < 1.0e-6);
+
+    // At the same tolerance, the Runge-Kutta-Nystrom 6(4) scheme reaches a better accuracy than
+    // RKF78 applied to the doubled state, with fewer evaluations.
+    REQUIRE(rkn64Error < rkf78Error);
+    REQUIRE(numberOfRKN64Evaluations < numberOfRKF78Evaluations);
+}
+
+TEST_CASE("Test adaptive Runge-Kutta-Nystrom integrator with error norm and controller",
+          "[runge_kutta_nystrom]")
+{
+    const NystromOrbitVector initialPosition = {{0.5, 0.0}};
+    const NystromOrbitVector initialVelocity = {{0.0, std::sqrt(3.0)}};
+    const WeightedRootMeanSquareErrorNorm<Real, NystromOrbitVector> errorNorm(1.0e-10, 1.0e-10);
+    StepSizeController<Real> controller;
+
+    Real time = 0.0;
+    NystromOrbitVector position = initialPosition;
+    NystromOrbitVector velocity = initialVelocity;
+    Real stepSize = 1.0e-3;
+
+    RKN64Stepper<Real, NystromOrbitVector> stepper;
+    const int numberOfSteps = integrateAdaptive(stepper, time, position, velocity, stepSize,
+                                                nystromOrbitPeriod,
+                                                &computeNystromOrbitAcceleration, errorNorm,
+                                                controller, 1.0e-12, 1.0);
+
+    REQUIRE(numberOfSteps > 1);
+    REQUIRE(time == nystromOrbitPeriod);
+    REQUIRE(position[0] == Catch::Approx(initialPosition[0]).margin(1.0e-7));
+    REQUIRE(position[1] == Catch::Approx(initialPosition[1]).margin(1.0e-7));
+    REQUIRE(velocity[0] == Catch::Approx(initialVelocity[0]).margin(1.0e-7));
+    REQUIRE(velocity[1] == Catch::Approx(initialVelocity[1]).margin(1.0e-7));
+}
+
+TEST_CASE("Test adaptive Runge-Kutta-Nystrom step throws if minimum step size is exceeded",
+          "[runge_kutta_nystrom]")
+{
+    Real time = 0.0;
+    NystromOscillatorState position = {{1.0}};
+    NystromOscillatorState velocity = {{0.0}};
+    Real stepSize = 1.0;
+
+    RKN64Stepper<Real, NystromOscillatorState> stepper;
+    REQUIRE_THROWS_AS(stepper.step(time, position, velocity, stepSize,
+                                   &computeNystromOscillatorAcceleration, 1.0e-15, 0.5, 1.0),
+                      std::runtime_error);
+}
+
+TEST_CASE("Test Runge-Kutta-Nystrom integrator reused for state of other size",
+          "[runge_kutta_nystrom]")
+{
+    // The acceleration is written in-place, so that the workspace must match the size of the
+    // position.
+    const auto computeAcceleration = [](const Real, const State& position, State& acceleration)
+    {
+        for (int i = 0; i < position.size(); ++i)
+        {
+            acceleration[i] = -position[i];
+        }
+    };
+
+    Real time = 0.0;
+    State position(Vector(1, 1.0));
+    State velocity(Vector(1, 0.0));
+    RKN43Stepper<Real, State> stepper;
+    stepper.step(time, position, velocity, 0.1, computeAcceleration);
+
+    // The step starts at the time at which the previous step ended, but the acceleration of the
+    // previous step is not reused.
+    position = State(Vector(8, 1.0));
+    velocity = State(Vector(8, 0.0));
+    stepper.step(time, position, velocity, 0.1, computeAcceleration);
+
+    Real expectedTime = 0.1;
+    State expectedPosition(Vector(8, 1.0));
+    State expectedVelocity(Vector(8, 0.0));
+    RKN43Stepper<Real, State> newStepper;
+    newStepper.step(expectedTime, expectedPosition, expectedVelocity, 0.1, computeAcceleration);
+    REQUIRE(position == expectedPosition);
+    REQUIRE(velocity == expectedVelocity);
+
+    // The free step functions reuse the stepper of the thread.
+    time = 0.0;
+    position = State(Vector(1, 1.0));
+    velocity = State(Vector(1, 0.0));
+    Real stepSize = 0.1;
+    stepRKN43(time, position, velocity, stepSize, computeAcceleration, 1.0e-10, 1.0e-12, 1.0);
+
+    time = 0.0;
+    position = State(Vector(8, 1.0));
+    velocity = State(Vector(8, 0.0));
+    stepSize = 0.1;
+    stepRKN43(time, position, velocity, stepSize, computeAcceleration, 1.0e-10, 1.0e-12, 1.0);
+
+    expectedTime = 0.0;
+    expectedPosition = State(Vector(8, 1.0));
+    expectedVelocity = State(Vector(8, 0.0));
+    Real expectedStepSize = 0.1;
+    RKN43Stepper<Real, State> adaptiveStepper;
+    adaptiveStepper.step(expectedTime, expectedPosition, expectedVelocity, expectedStepSize,
+                         computeAcceleration, 1.0e-10, 1.0e-12, 1.0);
+    REQUIRE(time == expectedTime);
+    REQUIRE(stepSize == expectedStepSize);
+    REQUIRE(position == expectedPosition);
+    REQUIRE(velocity == expectedVelocity);
+}
+
+} // namespace tests
+} // namespace integrate
@@ -42,6 +42,9 @@ public:
     //! Get value of ith element of state.
     const Real operator[ ] ( const int i ) const { return vector[ i ]; }
 
+    //! Get reference to ith element of state.
+    Real& operator[ ] ( const int i ) { return vector[ i ]; }
+
     //! Overload operators.
     State& operator=( const State& rightHandSide );
     State& operator+=( const State& rightHandSide );
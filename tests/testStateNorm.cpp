@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2014-2025 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "integrate/stateNorm.hpp"
+
+#include "testState.hpp"
+
+namespace integrate
+{
+namespace tests
+{
+
+TEST_CASE("Test norms of indexable state", "[state_norm]")
+{
+    const State state({1.0, -4.0, 2.0});
+
+    REQUIRE(computeMaximumNorm<Real>(state) == 4.0);
+    REQUIRE(computeRootMeanSquareNorm<Real>(state) == Catch::Approx(std::sqrt(21.0 / 3.0)));
+    REQUIRE(computeDotProduct<Real>(state, State({2.0, 1.0, -3.0})) == -8.0);
+}
+
+TEST_CASE("Test norms of contiguous state", "[state_norm]")
+{
+    // Use sizes that are smaller than, equal to and not a multiple of the number of accumulators.
+    const int sizes[] = {0, 3, 8, 1001};
+    for (const int size : sizes)
+    {
+        std::vector<double> state(size);
+        double expectedMaximum = 0.0;
+        double expectedSumOfSquares = 0.0;
+        std::vector<double> otherState(size);
+        double expectedDotProduct = 0.0;
+        for (int i = 0; i < size; ++i)
+        {
+            state[i] = std::sin(0.1 * i) * (i % 3 == 0 ? -1.0 : 1.0) * i;
+            expectedMaximum = std::max(expectedMaximum, std::fabs(state[i]));
+            expectedSumOfSquares += state[i] * state[i];
+            otherState[i] = std::cos(0.1 * i);
+            expectedDotProduct += state[i] * otherState[i];
+        }
+
+        REQUIRE(computeMaximumNorm<double>(state) == expectedMaximum);
+        if (size == 0)
+        {
+            REQUIRE(computeRootMeanSquareNorm<double>(state) == 0.0);
+        }
+        else
+        {
+            REQUIRE(computeRootMeanSquareNorm<double>(state)
+                    == Catch::Approx(std::sqrt(expectedSumOfSquares / size)).epsilon(1.0e-14));
+        }
+        REQUIRE(computeDotProduct<double>(state, otherState)
+                == Catch::Approx(expectedDotProduct).epsilon(1.0e-12));
+    }
+}
+
+} // namespace tests
+} // namespace integrate
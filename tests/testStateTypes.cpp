@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2014-2025 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+
+#include "integrate/dopri5.hpp"
+#include "integrate/integrateAdaptive.hpp"
+#include "integrate/linearCombination.hpp"
+#include "integrate/rkf78.hpp"
+#include "integrate/state.hpp"
+
+#include "testState.hpp"
+
+namespace integrate
+{
+namespace tests
+{
+
+typedef FixedState<Real, 4> FixedState4;
+typedef DynamicState<Real> DynamicStateX;
+
+//! Two-body problem in the plane with gravitational parameter 1, with state (x, y, x', y').
+struct PlanarKepler
+{
+    template <typename State>
+    void operator()(const Real, const State& state, State& stateDerivative) const
+    {
+        const Real radiusSquared = state[0] * state[0] + state[1] * state[1];
+        const Real factor = -1.0 / (radiusSquared * std::sqrt(radiusSquared));
+        stateDerivative[0] = state[2];
+        stateDerivative[1] = state[3];
+        stateDerivative[2] = factor * state[0];
+        stateDerivative[3] = factor * state[1];
+    }
+};
+
+//! Integrate orbit with eccentricity 0.5 over a single period with given stepper.
+template <typename Stepper, typename State>
+State integrateOrbit(const State& initialState)
+{
+    Stepper stepper;
+    Real time = 0.0;
+    State state = initialState;
+    Real stepSize = 0.01;
+    integrateAdaptive(stepper, time, state, stepSize, 2.0 * 3.14159265358979323846,
+                      PlanarKepler(), 1.0e-10, 1.0e-12, 1.0);
+    return state;
+}
+
+TEST_CASE("Test traits of state types", "[state]")
+{
+    REQUIRE(StateTraits<FixedState4>::isIndexable);
+    REQUIRE(StateTraits<FixedState4>::isContiguous);
+    REQUIRE(StateTraits<DynamicStateX>::isIndexable);
+    REQUIRE(StateTraits<DynamicStateX>::isContiguous);
+
+    static_assert(FixedState4::size() == 4, "Size of fixed state must be a constant expression");
+    static_assert(sizeof(FixedState4) == 4 * sizeof(Real), "Fixed state must not add storage");
+}
+
+TEST_CASE("Test operators of fixed state", "[state]")
+{
+    const FixedState4 state({1.0, 2.0, 3.0, 4.0});
+    const FixedState4 otherState({0.5, -1.0, 2.0, 0.0});
+
+    REQUIRE(FixedState4() == FixedState4({0.0, 0.0, 0.0, 0.0}));
+    REQUIRE(state + otherState == FixedState4({1.5, 1.0, 5.0, 4.0}));
+    REQUIRE(state - otherState == FixedState4({0.5, 3.0, 1.0, 4.0}));
+    REQUIRE(-state == FixedState4({-1.0, -2.0, -3.0, -4.0}));
+    REQUIRE(2.0 * state == FixedState4({2.0, 4.0, 6.0, 8.0}));
+    REQUIRE(state * 2.0 == 2.0 * state);
+    REQUIRE(state != otherState);
+
+    FixedState4 result = state;
+    result += state;
+    result -= otherState;
+    result *= 0.5;
+    REQUIRE(result == FixedState4({0.75, 2.5, 2.0, 4.0}));
+
+    std::array<Real, 4> elements = {{1.0, 2.0, 3.0, 4.0}};
+    REQUIRE(FixedState4(elements) == state);
+    REQUIRE(state.end() - state.begin() == 4);
+    REQUIRE(state.data()[3] == 4.0);
+
+    REQUIRE_THROWS_AS(FixedState4({1.0, 2.0}), std::invalid_argument);
+}
+
+TEST_CASE("Test operators and storage of dynamic state", "[state]")
+{
+    const DynamicStateX state({1.0, 2.0, 3.0, 4.0});
+    const DynamicStateX otherState({0.5, -1.0, 2.0, 0.0});
+
+    REQUIRE(DynamicStateX(4) == DynamicStateX({0.0, 0.0, 0.0, 0.0}));
+    REQUIRE(DynamicStateX(2, 3.0) == DynamicStateX({3.0, 3.0}));
+    REQUIRE(state + otherState == DynamicStateX({1.5, 1.0, 5.0, 4.0}));
+    REQUIRE(state - otherState == DynamicStateX({0.5, 3.0, 1.0, 4.0}));
+    REQUIRE(-state == DynamicStateX({-1.0, -2.0, -3.0, -4.0}));
+    REQUIRE(2.0 * state == DynamicStateX({2.0, 4.0, 6.0, 8.0}));
+    REQUIRE(state * 2.0 == 2.0 * state);
+    REQUIRE(state != otherState);
+    REQUIRE(state != DynamicStateX({1.0, 2.0, 3.0}));
+
+    SECTION("Buffer is aligned")
+    {
+        const std::size_t alignment = DynamicStateX::alignment;
+        for (std::size_t size = 1; size < 20; ++size)
+        {
+            const DynamicStateX alignedState(size);
+            REQUIRE(reinterpret_cast<std::uintptr_t>(alignedState.data()) % alignment == 0);
+        }
+        REQUIRE(DynamicStateX().size() == 0);
+        REQUIRE(DynamicStateX().data() == nullptr);
+    }
+
+    SECTION("Copy-assignment reuses buffer of same size")
+    {
+        DynamicStateX result(4);
+        const Real* const buffer = result.data();
+        result = state;
+        REQUIRE(result.data() == buffer);
+        REQUIRE(result == state);
+
+        result += state;
+        result -= otherState;
+        result *= 0.5;
+        REQUIRE(result == DynamicStateX({0.75, 2.5, 2.0, 4.0}));
+        REQUIRE(result.data() == buffer);
+
+        result = DynamicStateX({1.0});
+        REQUIRE(result.size() == 1);
+        REQUIRE(result[0] == 1.0);
+    }
+
+    SECTION("Move transfers buffer")
+    {
+        DynamicStateX source = state;
+        const Real* const buffer = source.data();
+        DynamicStateX target(std::move(source));
+        REQUIRE(target.data() == buffer);
+        REQUIRE(source.size() == 0);
+        REQUIRE(target == state);
+    }
+}
+
+TEST_CASE("Test integration with state types", "[state]")
+{
+    // Compare to the test State, which is indexable but not contiguous. The steps are the same,
+    // except for round-off differences in the error norms.
+    const State initialState({0.5, 0.0, 0.0, std::sqrt(3.0)});
+    const FixedState4 initialFixedState({0.5, 0.0, 0.0, std::sqrt(3.0)});
+    const DynamicStateX initialDynamicState({0.5, 0.0, 0.0, std::sqrt(3.0)});
+
+    SECTION("DOPRI5")
+    {
+        const State state = integrateOrbit<DOPRI5Stepper<Real, State> >(initialState);
+        const FixedState4 fixedState
+            = integrateOrbit<DOPRI5Stepper<Real, FixedState4> >(initialFixedState);
+        const DynamicStateX dynamicState
+            = integrateOrbit<DOPRI5Stepper<Real, DynamicStateX> >(initialDynamicState);
+        for (int i = 0; i < 4; ++i)
+        {
+            REQUIRE(std::fabs(fixedState[i] - state[i]) < 1.0e-12);
+            REQUIRE(dynamicState[i] == fixedState[i]);
+            REQUIRE(std::fabs(state[i] - initialState[i]) < 1.0e-7);
+        }
+    }
+
+    SECTION("RKF78")
+    {
+        const State state = integrateOrbit<RKF78Stepper<Real, State> >(initialState);
+        const FixedState4 fixedState
+            = integrateOrbit<RKF78Stepper<Real, FixedState4> >(initialFixedState);
+        const DynamicStateX dynamicState
+            = integrateOrbit<RKF78Stepper<Real, DynamicStateX> >(initialDynamicState);
+        for (int i = 0; i < 4; ++i)
+        {
+            REQUIRE(std::fabs(fixedState[i] - state[i]) < 1.0e-12);
+            REQUIRE(dynamicState[i] == fixedState[i]);
+            REQUIRE(std::fabs(state[i] - initialState[i]) < 1.0e-7);
+        }
+    }
+}
+
+} // namespace tests
+} // namespace integrate
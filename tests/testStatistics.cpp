@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2014-2025 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <stdexcept>
+#include <type_traits>
+
+#include "integrate/dopri5.hpp"
+#include "integrate/integrateAdaptive.hpp"
+#include "integrate/rk4.hpp"
+#include "integrate/rkf78.hpp"
+#include "integrate/statistics.hpp"
+
+#include "testDynamicalModels.hpp"
+#include "testState.hpp"
+
+namespace integrate
+{
+namespace tests
+{
+
+TEST_CASE("Test statistics are disabled by default", "[statistics]")
+{
+    typedef RK4Stepper<Real, State> Stepper;
+    typedef std::remove_reference<decltype(Stepper().getStatistics())>::type Statistics;
+
+    REQUIRE((std::is_same<Statistics, NullStatistics>::value));
+    REQUIRE(!NullStatistics::isEnabled);
+    REQUIRE(IntegrationStatistics<Real>::isEnabled);
+}
+
+TEST_CASE("Test statistics of fixed step size integration", "[statistics]")
+{
+    Real currentTime = 0.0;
+    State currentState({0.5});
+
+    int numberOfEvaluations = 0;
+    auto computeStateDerivative = [&numberOfEvaluations](const Real time, const State& state)
+    {
+        ++numberOfEvaluations;
+        return BurdenFaires()(time, state);
+    };
+
+    RK4Stepper<Real, State, IntegrationStatistics<Real> > stepper;
+    for (int i = 0; i < 4; ++i)
+    {
+        stepper.step(currentTime, currentState, 0.1 * (i + 1), computeStateDerivative);
+    }
+
+    const IntegrationStatistics<Real>& statistics = stepper.getStatistics();
+    REQUIRE(statistics.getNumberOfStateDerivativeEvaluations() == 16);
+    REQUIRE(statistics.getNumberOfStateDerivativeEvaluations() == numberOfEvaluations);
+    REQUIRE(statistics.getNumberOfAcceptedSteps() == 4);
+    REQUIRE(statistics.getNumberOfRejectedSteps() == 0);
+    REQUIRE(statistics.getMinimumStepSize() == Catch::Approx(0.1));
+    REQUIRE(statistics.getMaximumStepSize() == Catch::Approx(0.4));
+    REQUIRE(statistics.getMeanStepSize() == Catch::Approx(0.25));
+    REQUIRE(statistics.getStateDerivativeTime() >= 0.0);
+    REQUIRE(statistics.getStateDerivativeTime() <= statistics.getStepTime());
+    REQUIRE(statistics.getIntegratorTime() >= 0.0);
+
+    stepper.getStatistics().reset();
+    REQUIRE(stepper.getStatistics().getNumberOfStateDerivativeEvaluations() == 0);
+    REQUIRE(stepper.getStatistics().getNumberOfAcceptedSteps() == 0);
+    REQUIRE(stepper.getStatistics().getMinimumStepSize() == 0.0);
+    REQUIRE(stepper.getStatistics().getMeanStepSize() == 0.0);
+    REQUIRE(stepper.getStatistics().getStepTime() == 0.0);
+}
+
+TEST_CASE("Test statistics of adaptive integration", "[statistics]")
+{
+    const Real initialTime = 0.0;
+    const Real finalTime = 2.0;
+
+    Real currentTime = initialTime;
+    State currentState({0.5});
+
+    // The first step is rejected, because the initial step size is too large for the tolerance.
+    Real currentStepSize = 1.0;
+
+    int numberOfEvaluations = 0;
+    auto computeStateDerivative = [&numberOfEvaluations](const Real time, const State& state)
+    {
+        ++numberOfEvaluations;
+        return BurdenFaires()(time, state);
+    };
+
+    DOPRI5Stepper<Real, State, IntegrationStatistics<Real> > stepper;
+    const int numberOfSteps = integrateAdaptive(stepper, currentTime, currentState,
+                                                currentStepSize, finalTime,
+                                                computeStateDerivative, 1.0e-10, 1.0e-6, 1.0);
+
+    // The first stage is evaluated once per step and reused for rejected attempts; each attempt
+    // evaluates the remaining six stages.
+    const IntegrationStatistics<Real>& statistics = stepper.getStatistics();
+    const long numberOfAttempts = statistics.getNumberOfAcceptedSteps()
+                                  + statistics.getNumberOfRejectedSteps();
+    REQUIRE(statistics.getNumberOfAcceptedSteps() == numberOfSteps);
+    REQUIRE(statistics.getNumberOfRejectedSteps() > 0);
+    REQUIRE(statistics.getNumberOfStateDerivativeEvaluations() == numberOfEvaluations);
+    REQUIRE(statistics.getNumberOfStateDerivativeEvaluations() == 1 + 6 * numberOfAttempts);
+    REQUIRE(statistics.getMinimumStepSize() <= statistics.getMeanStepSize());
+    REQUIRE(statistics.getMeanStepSize() <= statistics.getMaximumStepSize());
+    REQUIRE(statistics.getMeanStepSize() * numberOfSteps
+            == Catch::Approx(finalTime - initialTime));
+}
+
+TEST_CASE("Test statistics of single integration step", "[statistics]")
+{
+    const Real tolerance = 1.0e-12;
+    const Real minimumStepSize = 1.0e-6;
+    const Real maximumStepSize = 1.0;
+
+    IntegrationStatistics<Real> statistics;
+
+    SECTION("Accepted steps")
+    {
+        Real currentTime = 0.0;
+        State currentState({0.5});
+        Real currentStepSize = 1.0;
+
+        stepRKF78(currentTime, currentState, currentStepSize, BurdenFaires(), tolerance,
+                  minimumStepSize, maximumStepSize, statistics);
+        stepRKF78(currentTime, currentState, currentStepSize, BurdenFaires(), tolerance,
+                  minimumStepSize, maximumStepSize, statistics);
+
+        // The first stage is evaluated once per step; each attempt evaluates the other 12 stages.
+        const long numberOfAttempts = statistics.getNumberOfAcceptedSteps()
+                                      + statistics.getNumberOfRejectedSteps();
+        REQUIRE(statistics.getNumberOfAcceptedSteps() == 2);
+        REQUIRE(statistics.getNumberOfRejectedSteps() > 0);
+        REQUIRE(statistics.getNumberOfStateDerivativeEvaluations() == 2 + 12 * numberOfAttempts);
+        REQUIRE(statistics.getMeanStepSize() * 2.0 == Catch::Approx(currentTime));
+    }
+
+    SECTION("Minimum step size exceeded")
+    {
+        Real currentTime = 0.0;
+        State currentState({0.5});
+        Real currentStepSize = 0.1;
+
+        REQUIRE_THROWS_AS(stepDOPRI5(currentTime, currentState, currentStepSize, BurdenFaires(),
+                                     tolerance, 0.05, maximumStepSize, statistics),
+                          std::runtime_error);
+        REQUIRE(statistics.getNumberOfAcceptedSteps() == 0);
+        REQUIRE(statistics.getNumberOfRejectedSteps() == 1);
+        REQUIRE(statistics.getNumberOfStateDerivativeEvaluations() == 7);
+    }
+}
+
+TEST_CASE("Test combination of statistics", "[statistics]")
+{
+    IntegrationStatistics<Real> firstStatistics;
+    firstStatistics.recordAcceptedStep(0.5);
+    firstStatistics.recordRejectedStep(1.0);
+
+    IntegrationStatistics<Real> secondStatistics;
+    secondStatistics.recordAcceptedStep(-0.1);
+    secondStatistics.recordAcceptedStep(-0.3);
+
+    firstStatistics += secondStatistics;
+    REQUIRE(firstStatistics.getNumberOfAcceptedSteps() == 3);
+    REQUIRE(firstStatistics.getNumberOfRejectedSteps() == 1);
+    REQUIRE(firstStatistics.getMinimumStepSize() == 0.1);
+    REQUIRE(firstStatistics.getMaximumStepSize() == 0.5);
+    REQUIRE(firstStatistics.getMeanStepSize() == Catch::Approx(0.3));
+}
+
+} // namespace tests
+} // namespace integrate
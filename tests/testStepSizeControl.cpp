@@ -0,0 +1,276 @@
+/*
+ * Copyright (c) 2014-2025 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <array>
+#include <cmath>
+#include <stdexcept>
+
+#include "integrate/dopri5.hpp"
+#include "integrate/integrateAdaptive.hpp"
+#include "integrate/rkf45.hpp"
+#include "integrate/rkf78.hpp"
+#include "integrate/stepSizeControl.hpp"
+
+#include "testDynamicalModels.hpp"
+#include "testState.hpp"
+
+namespace integrate
+{
+namespace tests
+{
+
+//! Planar Kepler orbit with state (x, y, vx, vy), in units of km and s.
+typedef std::array<Real, 4> OrbitState;
+
+//! Gravitational parameter of Earth [km^3 s^-2].
+const Real earthGravitationalParameter = 398600.4418;
+
+//! Integrate one revolution of Kepler orbit with given eccentricity.
+/*!
+ * Integrates one revolution of Kepler orbit with semi-major axis of 20000 km and given
+ * eccentricity, starting at periapsis, with DOPRI5Stepper and given controller. The numbers of
+ * attempted and accepted steps are returned, together with the position error at the end of the
+ * revolution, relative to the periapsis radius.
+ */
+Real integrateOrbit(const Real eccentricity,
+                    const Real relativeTolerance,
+                    StepSizeController<Real>& controller,
+                    int& numberOfAttempts,
+                    int& numberOfAcceptedSteps)
+{
+    const Real semiMajorAxis = 20000.0;
+    const Real periapsisRadius = semiMajorAxis * (1.0 - eccentricity);
+    const Real periapsisSpeed = std::sqrt(earthGravitationalParameter * (1.0 + eccentricity)
+                                          / periapsisRadius);
+    const Real period = 2.0 * 3.14159265358979323846
+                        * std::sqrt(semiMajorAxis * semiMajorAxis * semiMajorAxis
+                                    / earthGravitationalParameter);
+
+    // Scale absolute tolerances with the magnitudes of the positions and velocities.
+    const OrbitState absoluteTolerances = {{1.0e4 * relativeTolerance, 1.0e4 * relativeTolerance,
+                                            5.0 * relativeTolerance, 5.0 * relativeTolerance}};
+    const OrbitState relativeTolerances = {{relativeTolerance, relativeTolerance,
+                                            relativeTolerance, relativeTolerance}};
+    const WeightedRootMeanSquareErrorNorm<Real, OrbitState> errorNorm(absoluteTolerances,
+                                                                      relativeTolerances);
+
+    numberOfAttempts = 0;
+    auto countingErrorNorm = [&](const OrbitState& errorEstimate,
+                                 const OrbitState& state,
+                                 const OrbitState& nextState,
+                                 const Real stepSize)
+    {
+        ++numberOfAttempts;
+        return errorNorm(errorEstimate, state, nextState, stepSize);
+    };
+
+    auto kepler = [](const Real, const OrbitState& state, OrbitState& stateDerivative)
+    {
+        const Real radiusSquared = state[0] * state[0] + state[1] * state[1];
+        const Real factor = -earthGravitationalParameter
+                            / (radiusSquared * std::sqrt(radiusSquared));
+        stateDerivative[0] = state[2];
+        stateDerivative[1] = state[3];
+        stateDerivative[2] = factor * state[0];
+        stateDerivative[3] = factor * state[1];
+    };
+
+    Real time = 0.0;
+    OrbitState state = {{periapsisRadius, 0.0, 0.0, periapsisSpeed}};
+    Real stepSize = 10.0;
+    DOPRI5Stepper<Real, OrbitState> stepper;
+    numberOfAcceptedSteps = integrateAdaptive(stepper, time, state, stepSize, period, kepler,
+                                              countingErrorNorm, controller, 1.0e-12, 1.0e5);
+
+    return std::hypot(state[0] - periapsisRadius, state[1]) / periapsisRadius;
+}
+
+TEST_CASE("Test weighted root-mean-square error norm", "[step_size_control]")
+{
+    const State errorEstimate({1.0e-6, -4.0e-6});
+    const State state({1.0, -100.0});
+    const State nextState({-2.0, 10.0});
+
+    SECTION("Same tolerances for all elements")
+    {
+        const WeightedRootMeanSquareErrorNorm<Real, State> errorNorm(1.0e-6, 1.0e-3);
+
+        // Scales: 1e-6 + 1e-3 * 2 and 1e-6 + 1e-3 * 100.
+        const Real firstScaledError = 1.0e-6 / 2.001e-3;
+        const Real secondScaledError = 4.0e-6 / 0.100001;
+        const Real expectedError = std::sqrt((firstScaledError * firstScaledError
+                                              + secondScaledError * secondScaledError) / 2.0);
+        REQUIRE(errorNorm(errorEstimate, state, nextState, 0.1)
+                == Catch::Approx(expectedError).epsilon(1.0e-14));
+    }
+
+    SECTION("Tolerances per element")
+    {
+        const WeightedRootMeanSquareErrorNorm<Real, State> errorNorm(State({1.0e-6, 1.0e-3}),
+                                                                     State({0.0, 1.0e-5}));
+
+        // Scales: 1e-6 and 1e-3 + 1e-5 * 100.
+        const Real firstScaledError = 1.0;
+        const Real secondScaledError = 4.0e-6 / 2.0e-3;
+        const Real expectedError = std::sqrt((firstScaledError * firstScaledError
+                                              + secondScaledError * secondScaledError) / 2.0);
+        REQUIRE(errorNorm(errorEstimate, state, nextState, 0.1)
+                == Catch::Approx(expectedError).epsilon(1.0e-14));
+    }
+
+    SECTION("Tolerance vectors of different sizes")
+    {
+        typedef WeightedRootMeanSquareErrorNorm<Real, State> ErrorNorm;
+        REQUIRE_THROWS_AS(ErrorNorm(State({1.0e-6}), State({1.0e-6, 1.0e-6})),
+                          std::invalid_argument);
+
+        const ErrorNorm errorNorm(State({1.0e-6}), State({1.0e-6}));
+        REQUIRE_THROWS_AS(errorNorm(errorEstimate, state, nextState, 0.1), std::invalid_argument);
+    }
+}
+
+TEST_CASE("Test step size controller", "[step_size_control]")
+{
+    SECTION("Elementary controller")
+    {
+        StepSizeController<Real> controller(1.0, 0.0, 0.0, 0.9, 0.2, 5.0);
+
+        REQUIRE(controller.computeStepSizeFactor(0.5, 5, true)
+                == Catch::Approx(0.9 * std::pow(2.0, 0.2)));
+        REQUIRE(controller.computeStepSizeFactor(2.0, 5, false)
+                == Catch::Approx(0.9 * std::pow(0.5, 0.2)));
+
+        // Factors are bounded by the minimum and maximum factors.
+        REQUIRE(controller.computeStepSizeFactor(0.0, 5, true) == 5.0);
+        REQUIRE(controller.computeStepSizeFactor(1.0e10, 5, false) == 0.2);
+        REQUIRE(controller.computeStepSizeFactor(std::nan(""), 5, false) == 0.2);
+    }
+
+    SECTION("Proportional-integral controller")
+    {
+        StepSizeController<Real> controller;
+
+        // The first step uses the neutral error of 1 for the previous step.
+        REQUIRE(controller.computeStepSizeFactor(0.5, 5, true)
+                == Catch::Approx(0.9 * std::pow(0.5, -0.7 / 5.0)));
+        REQUIRE(controller.computeStepSizeFactor(0.25, 5, true)
+                == Catch::Approx(0.9 * std::pow(0.25, -0.7 / 5.0) * std::pow(0.5, 0.4 / 5.0)));
+
+        // Rejected steps use the elementary controller, do not increase the step size and do not
+        // change the kept errors.
+        REQUIRE(controller.computeStepSizeFactor(1.5, 5, false)
+                == Catch::Approx(0.9 * std::pow(1.5, -1.0 / 5.0)));
+        REQUIRE(controller.computeStepSizeFactor(1.0e-20, 5, false) == 1.0);
+        REQUIRE(controller.computeStepSizeFactor(0.5, 5, true)
+                == Catch::Approx(0.9 * std::pow(0.5, -0.7 / 5.0) * std::pow(0.25, 0.4 / 5.0)));
+
+        controller.reset();
+        REQUIRE(controller.computeStepSizeFactor(0.5, 5, true)
+                == Catch::Approx(0.9 * std::pow(0.5, -0.7 / 5.0)));
+    }
+}
+
+TEST_CASE("Test adaptive step with error norm and step size controller", "[step_size_control]")
+{
+    const Real initialTime = 0.0;
+    const State initialState({0.5});
+    const Real finalTime = 2.0;
+
+    // Analytical solution: y(t) = (t + 1)^2 - 0.5 * exp(t).
+    const Real expectedState = (finalTime + 1.0) * (finalTime + 1.0) - 0.5 * std::exp(finalTime);
+
+    const WeightedRootMeanSquareErrorNorm<Real, State> errorNorm(1.0e-10, 1.0e-10);
+
+    SECTION("Runge-Kutta-Fehlberg 4(5)")
+    {
+        Real currentTime = initialTime;
+        State currentState = initialState;
+        Real currentStepSize = 0.01;
+
+        RKF45Stepper<Real, State> stepper;
+        StepSizeController<Real> controller;
+        integrateAdaptive(stepper, currentTime, currentState, currentStepSize, finalTime,
+                          BurdenFaires(), errorNorm, controller, 1.0e-6, 0.3);
+
+        REQUIRE(currentTime == finalTime);
+        REQUIRE(currentState[0] == Catch::Approx(expectedState).epsilon(1.0e-8));
+    }
+
+    SECTION("Runge-Kutta-Fehlberg 7(8)")
+    {
+        Real currentTime = initialTime;
+        State currentState = initialState;
+        Real currentStepSize = 0.01;
+
+        RKF78Stepper<Real, State> stepper;
+        StepSizeController<Real> controller;
+        integrateAdaptive(stepper, currentTime, currentState, currentStepSize, finalTime,
+                          BurdenFaires(), errorNorm, controller, 1.0e-6, 0.3);
+
+        REQUIRE(currentTime == finalTime);
+        REQUIRE(currentState[0] == Catch::Approx(expectedState).epsilon(1.0e-8));
+    }
+
+    SECTION("Dormand-Prince 5(4)")
+    {
+        Real currentTime = initialTime;
+        State currentState = initialState;
+        Real currentStepSize = 0.01;
+
+        DOPRI5Stepper<Real, State> stepper;
+        StepSizeController<Real> controller;
+        integrateAdaptive(stepper, currentTime, currentState, currentStepSize, finalTime,
+                          BurdenFaires(), errorNorm, controller, 1.0e-6, 0.3);
+
+        REQUIRE(currentTime == finalTime);
+        REQUIRE(currentState[0] == Catch::Approx(expectedState).epsilon(1.0e-8));
+    }
+
+    SECTION("Minimum step size exceeded")
+    {
+        Real currentTime = initialTime;
+        State currentState = initialState;
+        Real currentStepSize = 0.1;
+
+        DOPRI5Stepper<Real, State> stepper;
+        StepSizeController<Real> controller;
+        REQUIRE_THROWS_AS(stepper.step(currentTime, currentState, currentStepSize,
+                                       BurdenFaires(), errorNorm, controller, 0.05, 0.3),
+                          std::runtime_error);
+    }
+}
+
+TEST_CASE("Test proportional-integral controller on eccentric orbits", "[step_size_control]")
+{
+    const Real eccentricities[] = {0.5, 0.7, 0.9};
+    for (const Real eccentricity : eccentricities)
+    {
+        StepSizeController<Real> elementaryController(1.0, 0.0, 0.0);
+        int elementaryAttempts = 0;
+        int elementaryAcceptedSteps = 0;
+        const Real elementaryError = integrateOrbit(eccentricity, 1.0e-6, elementaryController,
+                                                    elementaryAttempts, elementaryAcceptedSteps);
+
+        StepSizeController<Real> proportionalIntegralController;
+        int proportionalIntegralAttempts = 0;
+        int proportionalIntegralAcceptedSteps = 0;
+        const Real proportionalIntegralError
+            = integrateOrbit(eccentricity, 1.0e-6, proportionalIntegralController,
+                             proportionalIntegralAttempts, proportionalIntegralAcceptedSteps);
+
+        // The PI controller rejects fewer steps and is more accurate.
+        REQUIRE(proportionalIntegralAttempts - proportionalIntegralAcceptedSteps
+                < elementaryAttempts - elementaryAcceptedSteps);
+        REQUIRE(proportionalIntegralError < elementaryError);
+        REQUIRE(proportionalIntegralError < 1.0e-2);
+    }
+}
+
+} // namespace tests
+} // namespace integrate
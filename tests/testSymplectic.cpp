@@ -0,0 +1,342 @@
+/*
+ * Copyright (c) 2014-2025 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <array>
+#include <cmath>
+
+#include "integrate/forestRuth.hpp"
+#include "integrate/statistics.hpp"
+#include "integrate/velocityVerlet.hpp"
+#include "integrate/yoshida.hpp"
+
+#include "testState.hpp"
+
+namespace integrate
+{
+namespace tests
+{
+
+//! Statistics collected by steppers.
+typedef IntegrationStatistics<Real> Statistics;
+
+//! Position or velocity of one-dimensional harmonic oscillator.
+typedef std::array<Real, 1> OscillatorState;
+
+//! Position or velocity of planar Kepler orbit.
+typedef std::array<Real, 2> OrbitState;
+
+//! Compute acceleration of harmonic oscillator with unit angular frequency.
+void computeOscillatorAcceleration(const Real,
+                                   const OscillatorState& position,
+                                   OscillatorState& acceleration)
+{
+    acceleration[0] = -position[0];
+}
+
+//! Compute acceleration of Kepler orbit with unit gravitational parameter.
+OrbitState computeOrbitAcceleration(const Real, const OrbitState& position)
+{
+    const Real radius = std::sqrt(position[0] * position[0] + position[1] * position[1]);
+    const Real factor = -1.0 / (radius * radius * radius);
+    return OrbitState{{factor * position[0], factor * position[1]}};
+}
+
+//! Compute energy of Kepler orbit with unit gravitational parameter.
+Real computeOrbitEnergy(const OrbitState& position, const OrbitState& velocity)
+{
+    return 0.5 * (velocity[0] * velocity[0] + velocity[1] * velocity[1])
+           - 1.0 / std::sqrt(position[0] * position[0] + position[1] * position[1]);
+}
+
+//! Integrate harmonic oscillator from t = 0 to t = 4 with given number of steps.
+/*!
+ * Integrates harmonic oscillator, starting at unit position and zero velocity, and returns the
+ * error of the position at the final time.
+ */
+template <typename Stepper>
+Real computeOscillatorError(const int numberOfSteps)
+{
+    const Real finalTime = 4.0;
+    Real time = 0.0;
+    OscillatorState position = {{1.0}};
+    OscillatorState velocity = {{0.0}};
+
+    Stepper stepper;
+    for (int i = 0; i < numberOfSteps; ++i)
+    {
+        stepper.step(time, position, velocity, finalTime / numberOfSteps,
+                     &computeOscillatorAcceleration);
+    }
+    return std::fabs(position[0] - std::cos(finalTime));
+}
+
+//! Integrate harmonic oscillator with given number of steps and count acceleration evaluations.
+template <typename Stepper>
+long countEvaluations(const int numberOfSteps)
+{
+    Real time = 0.0;
+    OscillatorState position = {{1.0}};
+    OscillatorState velocity = {{0.0}};
+
+    Stepper stepper;
+    for (int i = 0; i < numberOfSteps; ++i)
+    {
+        stepper.step(time, position, velocity, 0.1, &computeOscillatorAcceleration);
+    }
+    return stepper.getStatistics().getNumberOfStateDerivativeEvaluations();
+}
+
+//! Compute observed order of convergence from errors for step size h and h/2.
+template <typename Stepper>
+Real computeObservedOrder(const int numberOfSteps)
+{
+    return std::log2(computeOscillatorError<Stepper>(numberOfSteps)
+                     / computeOscillatorError<Stepper>(2 * numberOfSteps));
+}
+
+TEST_CASE("Test symplectic integrators for zero acceleration", "[symplectic]")
+{
+    const Real initialTime = 1.0;
+    const State initialPosition({1.2, 2.3, -3.6});
+    const State initialVelocity({0.5, -1.0, 2.0});
+    const Real stepSize = 0.1;
+    auto computeAcceleration = [](const Real, const State&)
+    {
+        return State({0.0, 0.0, 0.0});
+    };
+
+    Real currentTime = initialTime;
+    State currentPosition = initialPosition;
+    State currentVelocity = initialVelocity;
+
+    SECTION("Velocity Verlet")
+    {
+        stepVelocityVerlet(currentTime, currentPosition, currentVelocity, stepSize,
+                           computeAcceleration);
+    }
+
+    SECTION("Forest-Ruth")
+    {
+        stepForestRuth(currentTime, currentPosition, currentVelocity, stepSize,
+                       computeAcceleration);
+    }
+
+    SECTION("Yoshida 4th order")
+    {
+        stepYoshida4(currentTime, currentPosition, currentVelocity, stepSize,
+                     computeAcceleration);
+    }
+
+    SECTION("Yoshida 6th order")
+    {
+        stepYoshida6(currentTime, currentPosition, currentVelocity, stepSize,
+                     computeAcceleration);
+    }
+
+    SECTION("Yoshida 8th order")
+    {
+        stepYoshida8(currentTime, currentPosition, currentVelocity, stepSize,
+                     computeAcceleration);
+    }
+
+    REQUIRE(currentTime == Catch::Approx(initialTime + stepSize));
+    REQUIRE(currentVelocity == initialVelocity);
+    for (int i = 0; i < 3; ++i)
+    {
+        REQUIRE(currentPosition[i]
+                == Catch::Approx(initialPosition[i] + stepSize * initialVelocity[i]));
+    }
+}
+
+TEST_CASE("Test order of convergence of symplectic integrators", "[symplectic]")
+{
+    REQUIRE(computeObservedOrder<VelocityVerletStepper<Real, OscillatorState> >(64)
+            == Catch::Approx(2.0).margin(0.1));
+    REQUIRE(computeObservedOrder<ForestRuthStepper<Real, OscillatorState> >(32)
+            == Catch::Approx(4.0).margin(0.1));
+    REQUIRE(computeObservedOrder<Yoshida4Stepper<Real, OscillatorState> >(32)
+            == Catch::Approx(4.0).margin(0.1));
+    REQUIRE(computeObservedOrder<Yoshida6Stepper<Real, OscillatorState> >(8)
+            == Catch::Approx(6.0).margin(0.2));
+    REQUIRE(computeObservedOrder<Yoshida8Stepper<Real, OscillatorState> >(32)
+            == Catch::Approx(8.0).margin(0.3));
+}
+
+TEST_CASE("Test number of acceleration evaluations of symplectic integrators", "[symplectic]")
+{
+    const int numberOfSteps = 10;
+
+    // All schemes but Forest-Ruth reuse the acceleration of the last kick in the next step.
+    REQUIRE(countEvaluations<VelocityVerletStepper<Real, OscillatorState, Statistics> >(
+        numberOfSteps) == numberOfSteps + 1);
+    REQUIRE(countEvaluations<ForestRuthStepper<Real, OscillatorState, Statistics> >(
+        numberOfSteps) == 3 * numberOfSteps);
+    REQUIRE(countEvaluations<Yoshida4Stepper<Real, OscillatorState, Statistics> >(
+        numberOfSteps) == 3 * numberOfSteps + 1);
+    REQUIRE(countEvaluations<Yoshida6Stepper<Real, OscillatorState, Statistics> >(
+        numberOfSteps) == 7 * numberOfSteps + 1);
+    REQUIRE(countEvaluations<Yoshida8Stepper<Real, OscillatorState, Statistics> >(
+        numberOfSteps) == 15 * numberOfSteps + 1);
+}
+
+TEST_CASE("Test kept acceleration of symplectic integrator", "[symplectic]")
+{
+    Real time = 0.0;
+    OscillatorState position = {{1.0}};
+    OscillatorState velocity = {{0.0}};
+
+    VelocityVerletStepper<Real, OscillatorState, Statistics> stepper;
+    stepper.step(time, position, velocity, 0.1, &computeOscillatorAcceleration);
+    REQUIRE(stepper.getStatistics().getNumberOfStateDerivativeEvaluations() == 2);
+
+    SECTION("Position changed between steps")
+    {
+        position[0] += 0.1;
+        stepper.step(time, position, velocity, 0.1, &computeOscillatorAcceleration);
+        REQUIRE(stepper.getStatistics().getNumberOfStateDerivativeEvaluations() == 4);
+    }
+
+    SECTION("Stepper reset between steps")
+    {
+        stepper.reset();
+        stepper.step(time, position, velocity, 0.1, &computeOscillatorAcceleration);
+        REQUIRE(stepper.getStatistics().getNumberOfStateDerivativeEvaluations() == 4);
+    }
+
+    SECTION("Velocity changed between steps")
+    {
+        velocity[0] = 1.0;
+        stepper.step(time, position, velocity, 0.1, &computeOscillatorAcceleration);
+        REQUIRE(stepper.getStatistics().getNumberOfStateDerivativeEvaluations() == 3);
+    }
+}
+
+TEST_CASE("Test symplectic integrator reused for state of other size", "[symplectic]")
+{
+    // The acceleration is written in-place, so that the workspace must match the size of the
+    // position.
+    const auto computeAcceleration = [](const Real, const State& position, State& acceleration)
+    {
+        for (int i = 0; i < position.size(); ++i)
+        {
+            acceleration[i] = -position[i];
+        }
+    };
+
+    Real time = 0.0;
+    State position(Vector(1, 1.0));
+    State velocity(Vector(1, 0.0));
+    VelocityVerletStepper<Real, State> stepper;
+    stepper.step(time, position, velocity, 0.1, computeAcceleration);
+
+    time = 0.0;
+    position = State(Vector(8, 1.0));
+    velocity = State(Vector(8, 0.0));
+    stepper.step(time, position, velocity, 0.1, computeAcceleration);
+
+    Real expectedTime = 0.0;
+    State expectedPosition(Vector(8, 1.0));
+    State expectedVelocity(Vector(8, 0.0));
+    VelocityVerletStepper<Real, State> newStepper;
+    newStepper.step(expectedTime, expectedPosition, expectedVelocity, 0.1, computeAcceleration);
+    REQUIRE(position == expectedPosition);
+    REQUIRE(velocity == expectedVelocity);
+
+    // The free step functions reuse the stepper of the thread.
+    time = 0.0;
+    position = State(Vector(1, 1.0));
+    velocity = State(Vector(1, 0.0));
+    stepVelocityVerlet(time, position, velocity, 0.1, computeAcceleration);
+
+    time = 0.0;
+    position = State(Vector(8, 1.0));
+    velocity = State(Vector(8, 0.0));
+    stepVelocityVerlet(time, position, velocity, 0.1, computeAcceleration);
+    REQUIRE(position == expectedPosition);
+    REQUIRE(velocity == expectedVelocity);
+}
+
+TEST_CASE("Test time-reversibility of symplectic integrators", "[symplectic]")
+{
+    const OrbitState initialPosition = {{0.5, 0.0}};
+    const OrbitState initialVelocity = {{0.0, std::sqrt(3.0)}};
+    const Real stepSize = 0.01;
+
+    Real time = 0.0;
+    OrbitState position = initialPosition;
+    OrbitState velocity = initialVelocity;
+
+    Yoshida6Stepper<Real, OrbitState> stepper;
+    for (int i = 0; i < 100; ++i)
+    {
+        stepper.step(time, position, velocity, stepSize, &computeOrbitAcceleration);
+    }
+
+    // Integrating backward from the reversed velocity retraces the orbit to the initial position.
+    velocity[0] = -velocity[0];
+    velocity[1] = -velocity[1];
+    for (int i = 0; i < 100; ++i)
+    {
+        stepper.step(time, position, velocity, stepSize, &computeOrbitAcceleration);
+    }
+
+    REQUIRE(position[0] == Catch::Approx(initialPosition[0]).margin(1.0e-12));
+    REQUIRE(position[1] == Catch::Approx(initialPosition[1]).margin(1.0e-12));
+    REQUIRE(velocity[0] == Catch::Approx(-initialVelocity[0]).margin(1.0e-12));
+    REQUIRE(velocity[1] == Catch::Approx(-initialVelocity[1]).margin(1.0e-12));
+}
+
+TEST_CASE("Test bounded energy error of symplectic integrators", "[symplectic]")
+{
+    // Kepler orbit with eccentricity 0.5 and unit semi-major axis (period of 2 pi), integrated for
+    // 1000 revolutions with 200 steps per revolution.
+    const Real period = 2.0 * 3.14159265358979323846;
+    const int numberOfRevolutions = 1000;
+    const int numberOfStepsPerRevolution = 200;
+    const Real stepSize = period / numberOfStepsPerRevolution;
+    const OrbitState initialPosition = {{0.5, 0.0}};
+    const OrbitState initialVelocity = {{0.0, std::sqrt(3.0)}};
+    const Real initialEnergy = computeOrbitEnergy(initialPosition, initialVelocity);
+
+    Real time = 0.0;
+    OrbitState position = initialPosition;
+    OrbitState velocity = initialVelocity;
+
+    Yoshida4Stepper<Real, OrbitState> stepper;
+    Real maximumEnergyErrorFirstRevolution = 0.0;
+    Real maximumEnergyErrorLastRevolution = 0.0;
+    for (int revolution = 0; revolution < numberOfRevolutions; ++revolution)
+    {
+        for (int i = 0; i < numberOfStepsPerRevolution; ++i)
+        {
+            stepper.step(time, position, velocity, stepSize, &computeOrbitAcceleration);
+
+            const Real energyError
+                = std::fabs(computeOrbitEnergy(position, velocity) - initialEnergy);
+            if (revolution == 0)
+            {
+                maximumEnergyErrorFirstRevolution
+                    = std::fmax(maximumEnergyErrorFirstRevolution, energyError);
+            }
+            else if (revolution == numberOfRevolutions - 1)
+            {
+                maximumEnergyErrorLastRevolution
+                    = std::fmax(maximumEnergyErrorLastRevolution, energyError);
+            }
+        }
+    }
+
+    // The energy error oscillates within each revolution, but does not grow over time.
+    REQUIRE(maximumEnergyErrorFirstRevolution > 0.0);
+    REQUIRE(maximumEnergyErrorLastRevolution < 1.1 * maximumEnergyErrorFirstRevolution);
+    REQUIRE(maximumEnergyErrorLastRevolution < 1.0e-4 * std::fabs(initialEnergy));
+}
+
+} // namespace tests
+} // namespace integrate
@@ -0,0 +1,234 @@
+/*
+ * Copyright (c) 2014-2025 Kartik Kumar (me@kartikkumar.com)
+ * Distributed under the MIT License.
+ * See accompanying file LICENSE.md or copy at http://opensource.org/licenses/MIT
+ */
+
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/catch_approx.hpp>
+
+#include <cstddef>
+#include <cstdio>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "integrate/denseOutput.hpp"
+#include "integrate/dopri5.hpp"
+#include "integrate/integrateAdaptive.hpp"
+#include "integrate/ringBuffer.hpp"
+#include "integrate/trajectoryWriter.hpp"
+
+#include "testState.hpp"
+
+namespace integrate
+{
+namespace tests
+{
+
+//! Name of trajectory file written by tests.
+const std::string trajectoryFileName = "testTrajectoryWriter.bin";
+
+//! Compute state derivative of harmonic oscillator x'' = -x, with state (x, x').
+const State computeHarmonicOscillatorStateDerivative(const Real, const State& state)
+{
+    return State({state[1], -state[0]});
+}
+
+TEST_CASE("Test single-producer, single-consumer ring buffer", "[trajectoryWriter]")
+{
+    SECTION("Single thread")
+    {
+        SampleRingBuffer<Real> buffer(5, 2);
+        REQUIRE(buffer.getCapacity() == 8);
+        REQUIRE(buffer.getSampleSize() == 2);
+
+        Real sample[2];
+        REQUIRE(!buffer.tryPop(sample));
+
+        // Fill buffer, remove some samples and fill it again, so that the indices wrap around.
+        int numberOfPushedSamples = 0;
+        int numberOfPoppedSamples = 0;
+        for (int round = 0; round < 3; ++round)
+        {
+            while (true)
+            {
+                const Real pushedSample[2] = {1.0 * numberOfPushedSamples,
+                                              -1.0 * numberOfPushedSamples};
+                if (!buffer.tryPush(pushedSample))
+                {
+                    break;
+                }
+                ++numberOfPushedSamples;
+            }
+            REQUIRE(numberOfPushedSamples - numberOfPoppedSamples == 8);
+
+            for (int i = 0; i < 5; ++i)
+            {
+                REQUIRE(buffer.tryPop(sample));
+                REQUIRE(sample[0] == numberOfPoppedSamples);
+                REQUIRE(sample[1] == -numberOfPoppedSamples);
+                ++numberOfPoppedSamples;
+            }
+        }
+    }
+
+    SECTION("Producer and consumer threads")
+    {
+        const int numberOfSamples = 100000;
+        SampleRingBuffer<Real> buffer(64, 3);
+        std::thread producer([&buffer, numberOfSamples]()
+        {
+            for (int i = 0; i < numberOfSamples; ++i)
+            {
+                const Real sample[3] = {1.0 * i, 2.0 * i, 3.0 * i};
+                while (!buffer.tryPush(sample))
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+
+        bool isOrdered = true;
+        Real sample[3];
+        for (int i = 0; i < numberOfSamples;)
+        {
+            if (buffer.tryPop(sample))
+            {
+                isOrdered = isOrdered
+                    && sample[0] == 1.0 * i && sample[1] == 2.0 * i && sample[2] == 3.0 * i;
+                ++i;
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+        producer.join();
+        REQUIRE(isOrdered);
+        REQUIRE(!buffer.tryPop(sample));
+    }
+
+    REQUIRE_THROWS_AS(SampleRingBuffer<Real>(0, 1), std::invalid_argument);
+    REQUIRE_THROWS_AS(SampleRingBuffer<Real>(1, 0), std::invalid_argument);
+}
+
+TEST_CASE("Test columnar trajectory writer and reader", "[trajectoryWriter]")
+{
+    // Ten samples in chunks of four samples, so that the last chunk is partially filled.
+    {
+        ColumnarTrajectoryWriter<Real> writer(trajectoryFileName, 2, 4);
+        for (int i = 0; i < 10; ++i)
+        {
+            const Real elements[2] = {10.0 + i, 20.0 + i};
+            writer.write(0.5 * i, elements);
+        }
+        REQUIRE(writer.getNumberOfSamples() == 10);
+    }
+
+    std::vector<Real> times;
+    std::vector<Real> elements;
+    REQUIRE(readColumnarTrajectory(trajectoryFileName, times, elements) == 2);
+    REQUIRE(times.size() == 10);
+    REQUIRE(elements.size() == 20);
+    for (int i = 0; i < 10; ++i)
+    {
+        REQUIRE(times[i] == 0.5 * i);
+        REQUIRE(elements[2 * i] == 10.0 + i);
+        REQUIRE(elements[2 * i + 1] == 20.0 + i);
+    }
+    std::remove(trajectoryFileName.c_str());
+
+    REQUIRE_THROWS_AS(readColumnarTrajectory(trajectoryFileName, times, elements),
+                      std::runtime_error);
+    REQUIRE_THROWS_AS(ColumnarTrajectoryWriter<Real>("missingDirectory/trajectory.bin", 2),
+                      std::runtime_error);
+    REQUIRE_THROWS_AS(ColumnarTrajectoryWriter<Real>(trajectoryFileName, 0),
+                      std::invalid_argument);
+    std::remove(trajectoryFileName.c_str());
+}
+
+TEST_CASE("Test streaming trajectory sink with integration drivers", "[trajectoryWriter]")
+{
+    const Real finalTime = 20.0;
+
+    // Reference trajectory collected by observer.
+    std::vector<Real> expectedTimes;
+    std::vector<Real> expectedElements;
+    const auto collect = [&](const Real time, const State& state)
+    {
+        expectedTimes.push_back(time);
+        expectedElements.push_back(state[0]);
+        expectedElements.push_back(state[1]);
+    };
+
+    Real time = 0.0;
+    State state({0.0, 1.0});
+    Real stepSize = 0.01;
+
+    SECTION("Observation of accepted steps")
+    {
+        DOPRI5Stepper<Real, State> referenceStepper;
+        const int numberOfSteps = integrateObserved(
+            referenceStepper, time, state, stepSize, finalTime,
+            &computeHarmonicOscillatorStateDerivative, 1.0e-10, 1.0e-12, 1.0, collect);
+        REQUIRE(expectedTimes.size() == static_cast<std::size_t>(numberOfSteps) + 1);
+        REQUIRE(expectedTimes.front() == 0.0);
+        REQUIRE(expectedTimes.back() == finalTime);
+
+        // A small buffer and small chunks, so that the indices wrap around many times.
+        time = 0.0;
+        state = State({0.0, 1.0});
+        stepSize = 0.01;
+        DOPRI5Stepper<Real, State> stepper;
+        StreamingTrajectorySink<Real, State> sink(trajectoryFileName, 2, 8, 16);
+        integrateObserved(stepper, time, state, stepSize, finalTime,
+                          &computeHarmonicOscillatorStateDerivative, 1.0e-10, 1.0e-12, 1.0, sink);
+        sink.close();
+        REQUIRE_THROWS_AS(sink(time, state), std::runtime_error);
+    }
+
+    SECTION("Observation of output times")
+    {
+        std::vector<Real> outputTimes;
+        for (int i = 0; i <= 2000; ++i)
+        {
+            outputTimes.push_back(0.01 * i);
+        }
+
+        DOPRI5Stepper<Real, State> referenceStepper;
+        integrateDenseOutput(referenceStepper, time, state, stepSize, outputTimes,
+                             &computeHarmonicOscillatorStateDerivative, 1.0e-10, 1.0e-12, 1.0,
+                             collect);
+        REQUIRE(expectedTimes == outputTimes);
+
+        time = 0.0;
+        state = State({0.0, 1.0});
+        stepSize = 0.01;
+        DOPRI5Stepper<Real, State> stepper;
+        StreamingTrajectorySink<Real, State> sink(trajectoryFileName, 2);
+        integrateDenseOutput(stepper, time, state, stepSize, outputTimes,
+                             &computeHarmonicOscillatorStateDerivative, 1.0e-10, 1.0e-12, 1.0,
+                             sink);
+        sink.close();
+    }
+
+    std::vector<Real> times;
+    std::vector<Real> elements;
+    readColumnarTrajectory(trajectoryFileName, times, elements);
+    std::remove(trajectoryFileName.c_str());
+    REQUIRE(times == expectedTimes);
+    REQUIRE(elements == expectedElements);
+}
+
+TEST_CASE("Test streaming trajectory sink with invalid state", "[trajectoryWriter]")
+{
+    StreamingTrajectorySink<Real, State> sink(trajectoryFileName, 3);
+    REQUIRE_THROWS_AS(sink(0.0, State({0.0, 1.0})), std::invalid_argument);
+    sink.close();
+    std::remove(trajectoryFileName.c_str());
+}
+
+} // namespace tests
+} // namespace integrate